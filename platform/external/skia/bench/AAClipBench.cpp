@@ -212,6 +212,42 @@ private:
     typedef Benchmark INHERITED;
 };
 
+////////////////////////////////////////////////////////////////////////////////
+// Builds an AA clip whose rows are almost all different from each other, as from a complex UI
+// path made of many small rounded shapes.
+class AAClipBuilderRowsBench : public Benchmark {
+    SkPath   fPath;
+    SkRegion fRegion;
+
+public:
+    AAClipBuilderRowsBench() {
+        fRegion.setRect(0, 0, 640, 480);
+        SkRandom rand;
+        for (int i = 0; i < 200; ++i) {
+            SkScalar x = rand.nextRangeScalar(0, 600);
+            SkScalar y = rand.nextRangeScalar(0, 440);
+            fPath.addCircle(x + 20, y + 20, rand.nextRangeScalar(4, 20));
+        }
+    }
+
+protected:
+    const char* onGetName() override { return "aaclip_build_rows"; }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            SkAAClip clip;
+            clip.setPath(fPath, &fRegion, true);
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 class AAClipRegionBench : public Benchmark {
 public:
@@ -248,6 +284,7 @@ DEF_BENCH(return new AAClipBuilderBench(false, false);)
 DEF_BENCH(return new AAClipBuilderBench(false, true);)
 DEF_BENCH(return new AAClipBuilderBench(true, false);)
 DEF_BENCH(return new AAClipBuilderBench(true, true);)
+DEF_BENCH(return new AAClipBuilderRowsBench();)
 DEF_BENCH(return new AAClipRegionBench();)
 DEF_BENCH(return new AAClipBench(false, false);)
 DEF_BENCH(return new AAClipBench(false, true);)
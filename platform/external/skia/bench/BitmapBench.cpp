@@ -216,7 +216,8 @@ private:
 class SourceAlphaBitmapBench : public BitmapBench {
 public:
     enum SourceAlpha { kOpaque_SourceAlpha, kTransparent_SourceAlpha,
-                       kTwoStripes_SourceAlpha, kThreeStripes_SourceAlpha};
+                       kTwoStripes_SourceAlpha, kThreeStripes_SourceAlpha,
+                       kTranslucent_SourceAlpha};
 private:
     SkString    fFullName;
     SourceAlpha fSourceAlpha;
@@ -239,6 +240,8 @@ protected:
                 fFullName.append("_source_stripes_two");
         } else if (fSourceAlpha == kThreeStripes_SourceAlpha) {
                 fFullName.append("_source_stripes_three");
+        } else if (fSourceAlpha == kTranslucent_SourceAlpha) {
+                fFullName.append("_source_translucent");
         }
 
         return fFullName.c_str();
@@ -293,6 +296,10 @@ protected:
                 r.set(SkIntToScalar(x), 0, SkIntToScalar(x+1), SkIntToScalar(h));
                 canvas.drawRect(r, p);
             }
+        } else if (kTranslucent_SourceAlpha == fSourceAlpha) {
+            // Every pixel needs blending, so none of the all-transparent or all-opaque
+            // shortcuts apply.
+            bm.eraseColor(SkColorSetARGB(0x80, 0xFF, 0x80, 0x40));
         }
     }
 
@@ -331,3 +338,4 @@ DEF_BENCH( return new SourceAlphaBitmapBench(SourceAlphaBitmapBench::kOpaque_Sou
 DEF_BENCH( return new SourceAlphaBitmapBench(SourceAlphaBitmapBench::kTransparent_SourceAlpha, kN32_SkColorType); )
 DEF_BENCH( return new SourceAlphaBitmapBench(SourceAlphaBitmapBench::kTwoStripes_SourceAlpha, kN32_SkColorType); )
 DEF_BENCH( return new SourceAlphaBitmapBench(SourceAlphaBitmapBench::kThreeStripes_SourceAlpha, kN32_SkColorType); )
+DEF_BENCH( return new SourceAlphaBitmapBench(SourceAlphaBitmapBench::kTranslucent_SourceAlpha, kN32_SkColorType); )
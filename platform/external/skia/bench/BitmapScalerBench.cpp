@@ -0,0 +1,96 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Benchmark.h"
+#include "SkBitmap.h"
+#include "SkBitmapScaler.h"
+#include "SkCanvas.h"
+#include "SkGradientShader.h"
+#include "SkString.h"
+
+// Makes thumbnails of a large photo-like image, with scalePixels() at medium (mipmap) and high
+// (Lanczos) quality, and with SkBitmapScaler's other filter.
+class BitmapScalerBench : public Benchmark {
+public:
+    BitmapScalerBench(SkColorType colorType, int srcSize, int dstSize, SkFilterQuality quality,
+                      bool mitchell = false)
+        : fColorType(colorType)
+        , fSrcSize(srcSize)
+        , fDstSize(dstSize)
+        , fQuality(quality)
+        , fMitchell(mitchell)
+    {
+        static const char* kQualityNames[] = { "none", "low", "medium", "high" };
+        fName.printf("bitmapscaler_%s_%s_%d_%d", mitchell ? "mitchell" : kQualityNames[quality],
+                     kRGBA_F16_SkColorType == colorType ? "f16" : "8888", srcSize, dstSize);
+    }
+
+protected:
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        const SkImageInfo info = SkImageInfo::Make(fSrcSize, fSrcSize, fColorType,
+                                                   kPremul_SkAlphaType);
+        fSrc.allocPixels(info);
+        fDst.allocPixels(info.makeWH(fDstSize, fDstSize));
+
+        SkCanvas canvas(fSrc);
+        const SkPoint pts[] = { { 0, 0 }, { SkIntToScalar(fSrcSize), SkIntToScalar(fSrcSize) } };
+        const SkColor colors[] = { SK_ColorRED, SK_ColorYELLOW, SK_ColorBLUE };
+        SkPaint paint;
+        paint.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 3,
+                                                     SkShader::kMirror_TileMode));
+        canvas.drawPaint(paint);
+        paint.setShader(nullptr);
+        paint.setAntiAlias(true);
+        paint.setColor(0x80FFFFFF);
+        for (int i = 0; i < 64; ++i) {
+            canvas.drawCircle(SkIntToScalar((i * 97) % fSrcSize),
+                              SkIntToScalar((i * 61) % fSrcSize),
+                              SkIntToScalar(fSrcSize / 32 + i % 5), paint);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            if (fMitchell) {
+                SkBitmapScaler::Resize(fDst.pixmap(), fSrc.pixmap(),
+                                       SkBitmapScaler::kMitchell_ResizeMethod);
+            } else {
+                fSrc.pixmap().scalePixels(fDst.pixmap(), fQuality);
+            }
+        }
+    }
+
+private:
+    SkColorType     fColorType;
+    int             fSrcSize;
+    int             fDstSize;
+    SkFilterQuality fQuality;
+    bool            fMitchell;
+    SkString        fName;
+    SkBitmap        fSrc;
+    SkBitmap        fDst;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH(return new BitmapScalerBench(kN32_SkColorType, 1024, 128, kMedium_SkFilterQuality);)
+DEF_BENCH(return new BitmapScalerBench(kN32_SkColorType, 1024, 128, kHigh_SkFilterQuality);)
+DEF_BENCH(return new BitmapScalerBench(kN32_SkColorType, 1024, 128, kHigh_SkFilterQuality, true);)
+DEF_BENCH(return new BitmapScalerBench(kN32_SkColorType, 1024, 600, kMedium_SkFilterQuality);)
+DEF_BENCH(return new BitmapScalerBench(kN32_SkColorType, 1024, 600, kHigh_SkFilterQuality);)
+DEF_BENCH(return new BitmapScalerBench(kRGBA_F16_SkColorType, 1024, 128,
+                                       kMedium_SkFilterQuality);)
+DEF_BENCH(return new BitmapScalerBench(kRGBA_F16_SkColorType, 1024, 128,
+                                       kHigh_SkFilterQuality);)
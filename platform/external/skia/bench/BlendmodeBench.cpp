@@ -9,15 +9,20 @@
 #include "SkBlendModePriv.h"
 #include "SkCanvas.h"
 #include "SkPaint.h"
+#include "SkPath.h"
 #include "SkRandom.h"
 #include "SkString.h"
 
-// Benchmark that draws non-AA rects or AA text with an SkXfermode::Mode.
+// Benchmark that draws non-AA rects, AA text or AA paths with an SkXfermode::Mode.
 class XfermodeBench : public Benchmark {
 public:
-    XfermodeBench(SkBlendMode mode, bool aa) : fBlendMode(mode) {
-        fAA = aa;
-        fName.printf("blendmode_%s_%s", aa ? "mask" : "rect", SkBlendMode_Name(mode));
+    enum Kind { kRect_Kind, kMask_Kind, kPath_Kind };
+
+    XfermodeBench(SkBlendMode mode, bool aa) : XfermodeBench(mode, aa ? kMask_Kind : kRect_Kind) {}
+
+    XfermodeBench(SkBlendMode mode, Kind kind) : fBlendMode(mode), fKind(kind) {
+        static const char* kKindNames[] = { "rect", "mask", "path" };
+        fName.printf("blendmode_%s_%s", kKindNames[kind], SkBlendMode_Name(mode));
     }
 
 protected:
@@ -32,7 +37,23 @@ protected:
             SkPaint paint;
             paint.setBlendMode(fBlendMode);
             paint.setColor(random.nextU());
-            if (fAA) {
+            if (kPath_Kind == fKind) {
+                // Draw small AA ovals, whose edges are runs of partial coverage.
+                paint.setAntiAlias(true);
+                SkScalar w = random.nextRangeScalar(4, 40);
+                SkScalar h = random.nextRangeScalar(4, 40);
+                SkRect oval = SkRect::MakeXYWH(
+                    random.nextUScalar1() * (size.fWidth - w),
+                    random.nextUScalar1() * (size.fHeight - h),
+                    w,
+                    h
+                );
+                SkPath path;
+                path.addOval(oval);
+                for (int j = 0; j < 1000; ++j) {
+                    canvas->drawPath(path, paint);
+                }
+            } else if (kMask_Kind == fKind) {
                 // Draw text to exercise AA code paths.
                 paint.setAntiAlias(true);
                 paint.setTextSize(random.nextRangeScalar(12, 96));
@@ -60,8 +81,8 @@ protected:
 
 private:
     SkBlendMode fBlendMode;
+    Kind        fKind;
     SkString    fName;
-    bool        fAA;
 
     typedef Benchmark INHERITED;
 };
@@ -76,6 +97,7 @@ BENCH(SkBlendMode::kClear)
 BENCH(SkBlendMode::kSrc)
 BENCH(SkBlendMode::kDst)
 BENCH(SkBlendMode::kSrcOver)
+DEF_BENCH( return new XfermodeBench(SkBlendMode::kSrcOver, XfermodeBench::kPath_Kind); )
 BENCH(SkBlendMode::kDstOver)
 BENCH(SkBlendMode::kSrcIn)
 BENCH(SkBlendMode::kDstIn)
@@ -0,0 +1,110 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Benchmark.h"
+#include "SkRandom.h"
+#include "SkString.h"
+#include "SkTDArray.h"
+
+#include "sk_canvas.h"
+#include "sk_paint.h"
+#include "sk_surface.h"
+
+// Draws lots of small rects and circles with a few shared paints through the C API, as another
+// runtime would: one sk_canvas_t call per draw, or the whole frame as a buffer of draw records.
+class CAPIBench : public Benchmark {
+public:
+    explicit CAPIBench(bool batched) : fBatched(batched) {
+        fName.printf("c_api_draws_%s", batched ? "batched" : "percall");
+    }
+
+    ~CAPIBench() override {
+        for (sk_paint_t* paint : fPaints) {
+            sk_paint_delete(paint);
+        }
+        sk_surface_unref(fSurface);
+    }
+
+protected:
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        static const int kSize = 256;
+        static const int kDraws = 2000;
+
+        fPixels.setCount(kSize * kSize);
+        sk_imageinfo_t info = { kSize, kSize, sk_colortype_get_default_8888(),
+                                PREMUL_SK_ALPHATYPE };
+        fSurface = sk_surface_new_raster_direct(&info, fPixels.begin(), kSize * sizeof(uint32_t),
+                                                nullptr);
+
+        SkRandom rand;
+        for (int i = 0; i < 4; ++i) {
+            sk_paint_t* paint = sk_paint_new();
+            sk_paint_set_color(paint, rand.nextU() | 0xFF000000);
+            sk_paint_set_antialias(paint, i % 2);
+            *fPaints.append() = paint;
+        }
+
+        for (int i = 0; i < kDraws; ++i) {
+            sk_draw_record_t& rec = *fRecords.append();
+            memset(&rec, 0, sizeof(rec));
+            rec.paint = rand.nextULessThan(fPaints.count());
+            if (i % 4) {
+                rec.op = DRAW_RECT_SK_DRAW_OP;
+                rec.rect.left = rand.nextRangeF(0, kSize - 4);
+                rec.rect.top = rand.nextRangeF(0, kSize - 4);
+                rec.rect.right = rec.rect.left + 4;
+                rec.rect.bottom = rec.rect.top + 4;
+            } else {
+                rec.op = DRAW_CIRCLE_SK_DRAW_OP;
+                rec.point.x = rand.nextRangeF(0, kSize);
+                rec.point.y = rand.nextRangeF(0, kSize);
+                rec.radius = 2;
+            }
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        sk_canvas_t* canvas = sk_surface_get_canvas(fSurface);
+        for (int i = 0; i < loops; ++i) {
+            if (fBatched) {
+                sk_canvas_draw_records(canvas, fRecords.begin(), fRecords.count(),
+                                       fPaints.begin(), fPaints.count());
+            } else {
+                for (const sk_draw_record_t& rec : fRecords) {
+                    const sk_paint_t* paint = fPaints[rec.paint];
+                    if (DRAW_RECT_SK_DRAW_OP == rec.op) {
+                        sk_canvas_draw_rect(canvas, &rec.rect, paint);
+                    } else {
+                        sk_canvas_draw_circle(canvas, rec.point.x, rec.point.y, rec.radius,
+                                              paint);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    bool                         fBatched;
+    SkString                     fName;
+    SkTDArray<uint32_t>          fPixels;
+    sk_surface_t*                fSurface = nullptr;
+    SkTDArray<sk_paint_t*>       fPaints;
+    SkTDArray<sk_draw_record_t>  fRecords;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH(return new CAPIBench(false);)
+DEF_BENCH(return new CAPIBench(true);)
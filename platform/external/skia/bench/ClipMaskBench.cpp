@@ -10,7 +10,9 @@
 #include "SkCanvas.h"
 #include "SkColorSpace.h"
 #include "SkImage.h"
+#include "SkPath.h"
 #include "SkPictureRecorder.h"
+#include "SkRRect.h"
 #include "SkString.h"
 #include "SkSurface.h"
 
@@ -66,3 +68,55 @@ DEF_BENCH(return new ClipMaskBench("picture", [](int size) -> sk_sp<SkImage> {
                                     SkColorSpace::MakeSRGB());
 });)
 
+// Clips to the same AA geometry inside every save/restore, as when drawing the items of a list.
+class ClipReuseBench : public Benchmark {
+public:
+    ClipReuseBench(const char name[], const SkPath& path)
+        : fName(SkStringPrintf("clipmask_reuse_%s", name))
+        , fPath(path) {}
+
+    ClipReuseBench(const char name[], const SkRRect& rrect)
+        : fName(SkStringPrintf("clipmask_reuse_%s", name))
+        , fRRect(rrect)
+        , fIsRRect(true) {}
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+        paint.setColor(SK_ColorBLUE);
+
+        for (int i = 0; i < loops; ++i) {
+            for (int item = 0; item < kItems; ++item) {
+                canvas->save();
+                if (fIsRRect) {
+                    canvas->clipRRect(fRRect, true);
+                } else {
+                    canvas->clipPath(fPath, true);
+                }
+                canvas->drawRect(SkRect::MakeXYWH(item * 4, item * 4, 100, 100), paint);
+                canvas->restore();
+            }
+        }
+    }
+
+private:
+    static constexpr int kItems = 10;
+
+    SkString fName;
+    SkPath   fPath;
+    SkRRect  fRRect;
+    bool     fIsRRect = false;
+};
+
+DEF_BENCH(return new ClipReuseBench("path", [] {
+    SkPath path;
+    path.addCircle(100, 100, 80);
+    path.addCircle(180, 120, 60);
+    return path;
+}());)
+
+DEF_BENCH(return new ClipReuseBench("rrect",
+                                    SkRRect::MakeRectXY(SkRect::MakeLTRB(10.5f, 10.5f, 250, 200),
+                                                        16, 16));)
@@ -9,12 +9,14 @@
 #include "SkCanvas.h"
 #include "SkPath.h"
 #include "SkPathOps.h"
+#include "SkRRect.h"
 
 class ClipStrategyBench : public Benchmark {
 public:
     enum class Mode {
         kClipPath,
         kMask,
+        kRectInRRect,
     };
 
     ClipStrategyBench(Mode mode, size_t count)
@@ -27,8 +29,10 @@ public:
             this->forEachClipCircle([&](float x, float y, float r) {
                 fClipPath.addCircle(x, y, r);
             });
-        } else {
+        } else if (fMode == Mode::kMask) {
             fName.append("mask_");
+        } else {
+            fName.append("rectinrrect_");
         }
         fName.appendf("%zu", count);
     }
@@ -51,6 +55,18 @@ protected:
             if (fMode == Mode::kClipPath) {
                 canvas->save();
                 canvas->clipPath(fClipPath, true);
+            } else if (fMode == Mode::kRectInRRect) {
+                // Each level clips to a rect and then to an rrect around it, as when drawing
+                // nested rounded cards. None of these clips should need a mask.
+                auto step = static_cast<float>(this->getSize().y()) / (2 * fCount + 2);
+                SkRect rect = SkRect::MakeIWH(this->getSize().x(), this->getSize().y());
+                for (size_t j = 0; j < fCount; ++j) {
+                    rect.inset(step, step);
+                    canvas->save();
+                    canvas->clipRect(rect);
+                    canvas->clipRRect(SkRRect::MakeRectXY(rect.makeOutset(step / 2, step / 2),
+                                                          step / 2, step / 2), true);
+                }
             } else {
                 canvas->saveLayer(nullptr, nullptr);
                 this->forEachClipCircle([&](float x, float y, float r) {
@@ -89,3 +105,7 @@ DEF_BENCH( return new ClipStrategyBench(ClipStrategyBench::Mode::kMask, 1  );)
 DEF_BENCH( return new ClipStrategyBench(ClipStrategyBench::Mode::kMask, 5  );)
 DEF_BENCH( return new ClipStrategyBench(ClipStrategyBench::Mode::kMask, 10 );)
 DEF_BENCH( return new ClipStrategyBench(ClipStrategyBench::Mode::kMask, 100);)
+
+DEF_BENCH( return new ClipStrategyBench(ClipStrategyBench::Mode::kRectInRRect, 1  );)
+DEF_BENCH( return new ClipStrategyBench(ClipStrategyBench::Mode::kRectInRRect, 5  );)
+DEF_BENCH( return new ClipStrategyBench(ClipStrategyBench::Mode::kRectInRRect, 10 );)
@@ -0,0 +1,100 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Benchmark.h"
+#include "SkBitmap.h"
+#include "SkCanvas.h"
+#include "SkDistanceFieldGen.h"
+#include "SkString.h"
+#include "SkTArray.h"
+#include "sk_tool_utils.h"
+
+// Generates distance fields for a set of glyph masks, as when warming up a glyph atlas: one at a
+// time, or all at once with SkGenerateDistanceFields().
+class DistanceFieldBench : public Benchmark {
+public:
+    DistanceFieldBench(SkScalar textSize, bool batch) : fTextSize(textSize), fBatch(batch) {
+        fName.printf("distancefield_glyphs_%d%s", SkScalarRoundToInt(textSize),
+                     batch ? "_batch" : "");
+    }
+
+    ~DistanceFieldBench() override {
+        for (const SkDistanceFieldRequest& request : fRequests) {
+            sk_free(request.fDistanceField);
+        }
+    }
+
+protected:
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        paint.setTextSize(fTextSize);
+        paint.setTypeface(sk_tool_utils::create_portable_typeface("sans-serif", SkFontStyle()));
+
+        for (char c = 'A'; c <= 'z'; ++c) {
+            if (c > 'Z' && c < 'a') {
+                continue;
+            }
+            SkRect bounds;
+            paint.measureText(&c, 1, &bounds);
+            const SkIRect ibounds = bounds.roundOut();
+            if (ibounds.isEmpty()) {
+                continue;
+            }
+            SkBitmap& mask = fMasks.push_back();
+            mask.allocPixels(SkImageInfo::MakeA8(ibounds.width(), ibounds.height()));
+            mask.eraseColor(SK_ColorTRANSPARENT);
+            SkCanvas canvas(mask);
+            canvas.drawText(&c, 1, -SkIntToScalar(ibounds.fLeft), -SkIntToScalar(ibounds.fTop),
+                            paint);
+
+            SkDistanceFieldRequest& request = fRequests.push_back();
+            request.fDistanceField = (unsigned char*)sk_malloc_throw(
+                    SkComputeDistanceFieldSize(mask.width(), mask.height()));
+            request.fImage = (const unsigned char*)mask.getPixels();
+            request.fWidth = mask.width();
+            request.fHeight = mask.height();
+            request.fRowBytes = mask.rowBytes();
+            request.fIsBW = false;
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            if (fBatch) {
+                SkGenerateDistanceFields(fRequests.begin(), fRequests.count());
+            } else {
+                for (const SkDistanceFieldRequest& request : fRequests) {
+                    SkGenerateDistanceFieldFromA8Image(request.fDistanceField, request.fImage,
+                                                       request.fWidth, request.fHeight,
+                                                       request.fRowBytes);
+                }
+            }
+        }
+    }
+
+private:
+    SkScalar                         fTextSize;
+    bool                             fBatch;
+    SkString                         fName;
+    SkTArray<SkBitmap>               fMasks;
+    SkTArray<SkDistanceFieldRequest> fRequests;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH(return new DistanceFieldBench(32, false);)
+DEF_BENCH(return new DistanceFieldBench(162, false);)
+DEF_BENCH(return new DistanceFieldBench(162, true);)
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Benchmark.h"
+#include "Resources.h"
+#include "SkFontMgr.h"
+#include "SkFontMgr_directory.h"
+#include "SkTypeface.h"
+
+#include <stdio.h>
+
+// SkFontMgr::RefDefault() only makes its font manager once, so this makes a directory font
+// manager over the test fonts the way the default one would be made, and matches a first
+// typeface from it (which opens that font file).
+class FontMgrStartupBench : public Benchmark {
+public:
+    FontMgrStartupBench(bool useIndex) : fUseIndex(useIndex) {
+        fName.printf("fontmgr_startup_%s", useIndex ? "index" : "scan");
+    }
+
+    ~FontMgrStartupBench() override {
+        if (fUseIndex) {
+            remove(kIndexPath);
+        }
+    }
+
+protected:
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        fDirectory = GetResourcePath("fonts");
+        fDirectory.append("/");
+        if (fUseIndex) {
+            // Start from a warm index, as every run after the first would.
+            remove(kIndexPath);
+            SkFontMgr_New_Custom_Directory(fDirectory.c_str(), kIndexPath);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            sk_sp<SkFontMgr> fontMgr =
+                    SkFontMgr_New_Custom_Directory(fDirectory.c_str(),
+                                                   fUseIndex ? kIndexPath : nullptr);
+            sk_sp<SkTypeface> typeface = fontMgr->legacyMakeTypeface(nullptr, SkFontStyle());
+            SkUnichar character = 'A';
+            uint16_t glyph;
+            typeface->charsToGlyphs(&character, SkTypeface::kUTF32_Encoding, &glyph, 1);
+        }
+    }
+
+private:
+    static constexpr const char* kIndexPath = "fontmgr_startup_bench.index";
+
+    const bool fUseIndex;
+    SkString   fName;
+    SkString   fDirectory;
+
+    typedef Benchmark INHERITED;
+};
+
+constexpr const char* FontMgrStartupBench::kIndexPath;
+
+DEF_BENCH(return new FontMgrStartupBench(false);)
+DEF_BENCH(return new FontMgrStartupBench(true);)
@@ -12,8 +12,13 @@
 
 #include "Benchmark.h"
 #include "GrMemoryPool.h"
+#include "GrOpArena.h"
+#include "SkExecutor.h"
+#include "SkMutex.h"
 #include "SkRandom.h"
+#include "SkSpinlock.h"
 #include "SkTDArray.h"
+#include "SkTaskGroup.h"
 #include "SkTemplates.h"
 
 // change this to 0 to compare GrMemoryPool to default new / delete
@@ -173,8 +178,133 @@ private:
 
 ///////////////////////////////////////////////////////////////////////////////
 
+/**
+ * This benchmark has several threads record at once, the way SkDeferredDisplayListRecorders do:
+ * each allocates a display list worth of op sized objects, a few of which are freed right away as
+ * if they were combined into another op. The recordings are then handed back to the calling
+ * thread, which frees them. The objects come from one spinlocked GrMemoryPool, as GrOps do without
+ * an arena, from a GrOpArena per recording, or from malloc.
+ */
+class GrMemoryPoolBenchThreads : public Benchmark {
+public:
+    enum class Allocator {
+        kSharedPool,
+        kArena,
+        kMalloc,
+    };
+
+    GrMemoryPoolBenchThreads(Allocator allocator, int threads)
+            : fAllocator(allocator)
+            , fThreads(threads)
+            , fPool(16384, 16384) {
+        static const char* kNames[] = { "shared_pool", "arena", "malloc" };
+        fName.printf("grmemorypool_threads_%s_%d", kNames[(int)allocator], threads);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        fRecordings.reset(fThreads);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; i++) {
+            SkTaskGroup(*fExecutor).batch(fThreads, [this](int thread) {
+                this->record(&fRecordings[thread], thread);
+            });
+            for (int thread = 0; thread < fThreads; ++thread) {
+                for (void* op : fRecordings[thread].fOps) {
+                    this->release(op);
+                }
+                fRecordings[thread].fOps.rewind();
+                fRecordings[thread].fArena.reset();
+            }
+        }
+    }
+
+private:
+    enum {
+        kOpsPerRecording = 1 << 10,
+    };
+
+    struct Recording {
+        sk_sp<GrOpArena> fArena;
+        SkTDArray<void*> fOps;
+    };
+
+    void record(Recording* recording, int thread) {
+        if (Allocator::kArena == fAllocator) {
+            recording->fArena = sk_make_sp<GrOpArena>();
+        }
+        GrOpArena::AutoInstall install(recording->fArena.get());
+        SkRandom r(thread);
+        for (int i = 0; i < kOpsPerRecording; i++) {
+            // Ops vary in size, and their geometry is often allocated along with them.
+            void* op = this->allocate(r.nextRangeU(64, 256));
+            if (i && r.nextULessThan(4) == 0) {
+                this->release(op);
+            } else {
+                *recording->fOps.append() = op;
+            }
+        }
+    }
+
+    void* allocate(size_t size) {
+        switch (fAllocator) {
+            case Allocator::kSharedPool:
+            case Allocator::kArena:
+                return GrOpArena::Allocate(size, [this](size_t poolSize) {
+                    SkAutoMutexAcquire lock(fPoolLock);
+                    return fPool.allocate(poolSize);
+                });
+            case Allocator::kMalloc:
+                return sk_malloc_throw(size);
+        }
+        return nullptr;
+    }
+
+    void release(void* op) {
+        if (Allocator::kMalloc == fAllocator) {
+            sk_free(op);
+            return;
+        }
+        GrOpArena::Release(op, [this](void* poolMem) {
+            SkAutoMutexAcquire lock(fPoolLock);
+            fPool.release(poolMem);
+        });
+    }
+
+    SkString                    fName;
+    Allocator                   fAllocator;
+    int                         fThreads;
+    std::unique_ptr<SkExecutor> fExecutor;
+    SkAutoTArray<Recording>     fRecordings;
+    SkSpinlock                  fPoolLock;
+    GrMemoryPool                fPool;
+
+    typedef Benchmark INHERITED;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
 DEF_BENCH( return new GrMemoryPoolBenchStack(); )
 DEF_BENCH( return new GrMemoryPoolBenchRandom(); )
 DEF_BENCH( return new GrMemoryPoolBenchQueue(); )
 
+using Allocator = GrMemoryPoolBenchThreads::Allocator;
+DEF_BENCH( return new GrMemoryPoolBenchThreads(Allocator::kSharedPool, 1); )
+DEF_BENCH( return new GrMemoryPoolBenchThreads(Allocator::kSharedPool, 4); )
+DEF_BENCH( return new GrMemoryPoolBenchThreads(Allocator::kArena, 1); )
+DEF_BENCH( return new GrMemoryPoolBenchThreads(Allocator::kArena, 4); )
+DEF_BENCH( return new GrMemoryPoolBenchThreads(Allocator::kMalloc, 1); )
+DEF_BENCH( return new GrMemoryPoolBenchThreads(Allocator::kMalloc, 4); )
+
 #endif
@@ -0,0 +1,110 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Benchmark.h"
+
+#if SK_SUPPORT_GPU
+
+#include "GrContext.h"
+#include "GrContextOptions.h"
+#include "SkCanvas.h"
+#include "SkRandom.h"
+#include "SkRRect.h"
+#include "SkSurface.h"
+
+// Records thousands of small draws of a few kinds, interleaved, on a mock context, so that it
+// measures the CPU cost of recording the ops into the opList and combining them, without a GPU.
+// Sparse draws rarely overlap, so most of them can be combined; dense ones are often blocked.
+class GrOpCombiningBench : public Benchmark {
+public:
+    explicit GrOpCombiningBench(bool dense) : fDense(dense) {
+        fName.printf("op_combining_mock_%s", dense ? "dense" : "sparse");
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        fContext = GrContext::MakeMock(nullptr, GrContextOptions());
+        if (!fContext) {
+            return;
+        }
+        SkImageInfo info = SkImageInfo::Make(kSize, kSize, kRGBA_8888_SkColorType,
+                                             kPremul_SkAlphaType);
+        fSurface = SkSurface::MakeRenderTarget(fContext.get(), SkBudgeted::kNo, info);
+
+        SkRandom rand;
+        SkScalar extent = fDense ? kSize / 8 : kSize - kDrawSize;
+        for (int i = 0; i < kDrawCount; i++) {
+            fRects[i] = SkRect::MakeXYWH(rand.nextRangeScalar(0, extent),
+                                         rand.nextRangeScalar(0, extent),
+                                         rand.nextRangeScalar(2, kDrawSize),
+                                         rand.nextRangeScalar(2, kDrawSize));
+            fColors[i] = rand.nextU() | 0xFF000000;
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        if (!fSurface) {
+            return;
+        }
+        SkCanvas* canvas = fSurface->getCanvas();
+        SkPaint fill, aaFill, stroke;
+        aaFill.setAntiAlias(true);
+        stroke.setStyle(SkPaint::kStroke_Style);
+        stroke.setStrokeWidth(2);
+        for (int i = 0; i < loops; i++) {
+            for (int j = 0; j < kDrawCount; j++) {
+                const SkRect& r = fRects[j];
+                switch (j % 4) {
+                    case 0:
+                        fill.setColor(fColors[j]);
+                        canvas->drawRect(r, fill);
+                        break;
+                    case 1:
+                        aaFill.setColor(fColors[j]);
+                        canvas->drawOval(r, aaFill);
+                        break;
+                    case 2:
+                        aaFill.setColor(fColors[j]);
+                        canvas->drawRRect(SkRRect::MakeRectXY(r, 2, 2), aaFill);
+                        break;
+                    case 3:
+                        stroke.setColor(fColors[j]);
+                        canvas->drawRect(r, stroke);
+                        break;
+                }
+            }
+            canvas->flush();
+        }
+    }
+
+private:
+    static constexpr int kSize = 1024;
+    static constexpr int kDrawCount = 4000;
+    static constexpr SkScalar kDrawSize = 12;
+
+    SkString         fName;
+    bool             fDense;
+    sk_sp<GrContext> fContext;
+    sk_sp<SkSurface> fSurface;
+    SkRect           fRects[kDrawCount];
+    SkColor          fColors[kDrawCount];
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH(return new GrOpCombiningBench(false);)
+DEF_BENCH(return new GrOpCombiningBench(true);)
+
+#endif
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Benchmark.h"
+
+#if SK_SUPPORT_GPU
+
+#include "GrContext.h"
+#include "GrContextOptions.h"
+#include "SkCanvas.h"
+#include "SkExecutor.h"
+#include "SkPath.h"
+#include "SkRandom.h"
+#include "SkSurface.h"
+
+// Draws concave paths through GrTessellatingPathRenderer on a mock context, so that it measures
+// the CPU side of tessellation, and getting the vertices into buffers, without a real GPU.
+// Non-AA paths are edited every frame, so that their cached vertex buffers are never reused.
+class GrTessellatorBench : public Benchmark {
+public:
+    GrTessellatorBench(bool antialias, bool threaded)
+            : fAntialias(antialias)
+            , fThreaded(threaded) {
+        fName.printf("tessellating_path_mock_%s%s", antialias ? "aa" : "nonaa",
+                     threaded ? "_threaded" : "");
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        GrContextOptions options;
+        if (fThreaded) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool();
+            options.fExecutor = fExecutor.get();
+        }
+        options.fGpuPathRenderers = GpuPathRenderers::kTessellating;
+        fContext = GrContext::MakeMock(nullptr, options);
+        if (!fContext) {
+            return;
+        }
+        SkImageInfo info = SkImageInfo::Make(kSize, kSize, kRGBA_8888_SkColorType,
+                                             kPremul_SkAlphaType);
+        fSurface = SkSurface::MakeRenderTarget(fContext.get(), SkBudgeted::kNo, info);
+
+        // The AA tessellator only takes paths of up to 10 verbs.
+        const int pointCount = fAntialias ? 8 : 64;
+        SkRandom rand;
+        for (int i = 0; i < kPathCount; i++) {
+            SkPath& path = fPaths[i];
+            SkScalar cx = rand.nextRangeScalar(64, kSize - 64),
+                     cy = rand.nextRangeScalar(64, kSize - 64);
+            for (int j = 0; j < pointCount; j++) {
+                // Alternate between the inner and outer radius for a concave star.
+                SkScalar radius = (j & 1) ? rand.nextRangeScalar(8, 24)
+                                          : rand.nextRangeScalar(40, 64);
+                SkScalar angle = j * 2 * SK_ScalarPI / pointCount;
+                SkPoint pt = SkPoint::Make(cx + radius * SkScalarCos(angle),
+                                           cy + radius * SkScalarSin(angle));
+                if (0 == j) {
+                    path.moveTo(pt);
+                } else if (fAntialias || (j & 3) != 2) {
+                    path.lineTo(pt);
+                } else {
+                    path.quadTo(SkPoint::Make(cx, cy), pt);
+                }
+            }
+            path.close();
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        if (!fSurface) {
+            return;
+        }
+        SkCanvas* canvas = fSurface->getCanvas();
+        SkPaint paint;
+        paint.setAntiAlias(fAntialias);
+        for (int i = 0; i < loops; i++) {
+            for (SkPath& path : fPaths) {
+                if (!fAntialias) {
+                    // Gives the path a new generation ID without changing its shape.
+                    path.setLastPt(path.getPoint(path.countPoints() - 1));
+                }
+                canvas->drawPath(path, paint);
+            }
+            canvas->flush();
+        }
+    }
+
+private:
+    static constexpr int kSize = 512;
+    static constexpr int kPathCount = 50;
+
+    SkString                    fName;
+    bool                        fAntialias;
+    bool                        fThreaded;
+    std::unique_ptr<SkExecutor> fExecutor;
+    sk_sp<GrContext>            fContext;
+    sk_sp<SkSurface>            fSurface;
+    SkPath                      fPaths[kPathCount];
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH(return new GrTessellatorBench(false, false);)
+DEF_BENCH(return new GrTessellatorBench(false, true);)
+DEF_BENCH(return new GrTessellatorBench(true, false);)
+DEF_BENCH(return new GrTessellatorBench(true, true);)
+
+#endif
@@ -6,8 +6,11 @@
  */
 #include "Benchmark.h"
 #include "SkCanvas.h"
+#include "SkImage.h"
+#include "SkImageSource.h"
 #include "SkLightingImageFilter.h"
 #include "SkPoint3.h"
+#include "SkSurface.h"
 
 #define FILTER_WIDTH_SMALL  SkIntToScalar(32)
 #define FILTER_HEIGHT_SMALL SkIntToScalar(32)
@@ -230,6 +233,57 @@ private:
     typedef LightingBaseBench INHERITED;
 };
 
+// The benches above light a solid rect, whose normals all point straight up. This one lights an
+// image whose alpha varies everywhere, like the bump maps SVG content feeds these filters.
+class LightingBumpMapBench : public LightingBaseBench {
+public:
+    LightingBumpMapBench(bool specular) : INHERITED(false), fSpecular(specular) { }
+
+protected:
+    const char* onGetName() override {
+        return fSpecular ? "lightingbumpmap_pointlitspecular" : "lightingbumpmap_distantlitdiffuse";
+    }
+
+    void onDelayedSetup() override {
+        int width = SkScalarRoundToInt(FILTER_WIDTH_LARGE),
+            height = SkScalarRoundToInt(FILTER_HEIGHT_LARGE);
+        auto surface = SkSurface::MakeRasterN32Premul(width, height);
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        for (int y = 0; y < height; y += 16) {
+            for (int x = 0; x < width; x += 16) {
+                paint.setAlpha((x * 7 + y * 3) & 0xFF);
+                surface->getCanvas()->drawCircle(x + 8, y + 8, 7, paint);
+            }
+        }
+        fBumpMap = SkImageSource::Make(surface->makeImageSnapshot());
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkRect r = SkRect::MakeWH(FILTER_WIDTH_LARGE, FILTER_HEIGHT_LARGE);
+        SkPaint paint;
+        for (int i = 0; i < loops; i++) {
+            // A new filter each time, so the image filter cache can't hand back the last result.
+            if (fSpecular) {
+                paint.setImageFilter(SkLightingImageFilter::MakePointLitSpecular(
+                        GetPointLocation(), GetWhite(), GetSurfaceScale(), GetKs(),
+                        GetShininess(), fBumpMap));
+            } else {
+                paint.setImageFilter(SkLightingImageFilter::MakeDistantLitDiffuse(
+                        GetDistantDirection(), GetWhite(), GetSurfaceScale(), GetKd(),
+                        fBumpMap));
+            }
+            canvas->drawRect(r, paint);
+        }
+    }
+
+private:
+    bool                 fSpecular;
+    sk_sp<SkImageFilter> fBumpMap;
+
+    typedef LightingBaseBench INHERITED;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH( return new LightingPointLitDiffuseBench(true); )
@@ -244,3 +298,5 @@ DEF_BENCH( return new LightingDistantLitSpecularBench(true); )
 DEF_BENCH( return new LightingDistantLitSpecularBench(false); )
 DEF_BENCH( return new LightingSpotLitSpecularBench(true); )
 DEF_BENCH( return new LightingSpotLitSpecularBench(false); )
+DEF_BENCH( return new LightingBumpMapBench(false); )
+DEF_BENCH( return new LightingBumpMapBench(true); )
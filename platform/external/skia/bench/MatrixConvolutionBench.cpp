@@ -22,17 +22,31 @@ static const char* name(SkMatrixConvolutionImageFilter::TileMode mode) {
 
 class MatrixConvolutionBench : public Benchmark {
 public:
-    MatrixConvolutionBench(SkMatrixConvolutionImageFilter::TileMode tileMode, bool convolveAlpha)
-        : fName(SkStringPrintf("matrixconvolution_%s%s",
+    MatrixConvolutionBench(SkMatrixConvolutionImageFilter::TileMode tileMode, bool convolveAlpha,
+                           bool bigKernel = false)
+        : fName(SkStringPrintf("matrixconvolution_%s%s%s",
                                name(tileMode),
-                               convolveAlpha ? "" : "_noConvolveAlpha")) {
+                               convolveAlpha ? "" : "_noConvolveAlpha",
+                               bigKernel ? "_5x5" : "")) {
+        SkScalar gain = 0.3f, bias = SkIntToScalar(100);
+        if (bigKernel) {
+            // Mostly interior pixels, where the kernel is applied to several pixels at a time.
+            SkScalar kernel[25];
+            for (int i = 0; i < 25; ++i) {
+                kernel[i] = SkIntToScalar(i == 12 ? -23 : 1);
+            }
+            fFilter = SkMatrixConvolutionImageFilter::Make(SkISize::Make(5, 5), kernel,
+                                                           gain * 0.5f, bias,
+                                                           SkIPoint::Make(2, 2), tileMode,
+                                                           convolveAlpha, nullptr);
+            return;
+        }
         SkISize kernelSize = SkISize::Make(3, 3);
         SkScalar kernel[9] = {
             SkIntToScalar( 1), SkIntToScalar( 1), SkIntToScalar( 1),
             SkIntToScalar( 1), SkIntToScalar(-7), SkIntToScalar( 1),
             SkIntToScalar( 1), SkIntToScalar( 1), SkIntToScalar( 1),
         };
-        SkScalar gain = 0.3f, bias = SkIntToScalar(100);
         SkIPoint kernelOffset = SkIPoint::Make(1, 1);
         fFilter = SkMatrixConvolutionImageFilter::Make(kernelSize, kernel, gain, bias,
                                                        kernelOffset, tileMode, convolveAlpha,
@@ -68,3 +82,5 @@ DEF_BENCH( return new MatrixConvolutionBench(SkMatrixConvolutionImageFilter::kCl
 DEF_BENCH( return new MatrixConvolutionBench(SkMatrixConvolutionImageFilter::kRepeat_TileMode, true); )
 DEF_BENCH( return new MatrixConvolutionBench(SkMatrixConvolutionImageFilter::kClampToBlack_TileMode, true); )
 DEF_BENCH( return new MatrixConvolutionBench(SkMatrixConvolutionImageFilter::kClampToBlack_TileMode, false); )
+DEF_BENCH( return new MatrixConvolutionBench(SkMatrixConvolutionImageFilter::kClamp_TileMode, true, true); )
+DEF_BENCH( return new MatrixConvolutionBench(SkMatrixConvolutionImageFilter::kClampToBlack_TileMode, false, true); )
@@ -9,6 +9,7 @@
 
 #include "Resources.h"
 #include "SkAutoPixmapStorage.h"
+#include "SkCanvas.h"
 #include "SkData.h"
 #include "SkFloatToDecimal.h"
 #include "SkGradientShader.h"
@@ -58,9 +59,14 @@ DEF_BENCH(return new PDFScalarBench;)
 
 #ifdef SK_SUPPORT_PDF
 
+#include "SkDeflate.h"
 #include "SkPDFBitmap.h"
 #include "SkPDFDocument.h"
 #include "SkPDFShader.h"
+#include "SkResourceCache.h"
+#include "SkTypeface.h"
+
+#include <vector>
 
 namespace {
 static void test_pdf_object_serialization(const sk_sp<SkPDFObject> object) {
@@ -183,6 +189,48 @@ private:
     std::unique_ptr<SkStreamAsset> fAsset;
 };
 
+/** Test SkDeflateWStream on 2MB of PDF command streams, at a compression level, serially or in
+    parallel chunks. */
+class PDFDeflateBench : public Benchmark {
+public:
+    PDFDeflateBench(int level, int threads) : fLevel(level), fThreads(threads) {
+        fName.printf("PDFDeflate_level%d_threads%d", level, threads);
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+    void onDelayedSetup() override {
+        sk_sp<SkData> commands = GetResourceAsData("pdf_command_stream.txt");
+        if (!commands) {
+            return;
+        }
+        SkDynamicMemoryWStream input;
+        while (input.bytesWritten() < 2 * 1024 * 1024) {
+            input.write(commands->data(), commands->size());
+        }
+        fInput = input.detachAsData();
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        SkASSERT(fInput);
+        if (!fInput) { return; }
+        while (loops-- > 0) {
+            SkNullWStream nullStream;
+            SkDeflateWStream deflateWStream(&nullStream, fLevel, false, fThreads);
+            deflateWStream.write(fInput->data(), fInput->size());
+            deflateWStream.finalize();
+        }
+    }
+
+private:
+    int           fLevel;
+    int           fThreads;
+    SkString      fName;
+    sk_sp<SkData> fInput;
+};
+
 struct PDFColorComponentBench : public Benchmark {
     bool isSuitableFor(Backend b) override {
         return b == kNonRendering_Backend;
@@ -242,13 +290,62 @@ struct WritePDFTextBenchmark : public Benchmark {
     }
 };
 
+// Writes whole documents of text in a few fonts, as a batch job making many similar documents
+// would. Embedding the fonts is most of the work, unless their subsets are still cached from
+// the documents before.
+struct PDFTextDocumentBench : public Benchmark {
+    PDFTextDocumentBench(bool cached) : fCached(cached) {}
+    const char* onGetName() override {
+        return fCached ? "PDFTextDocument" : "PDFTextDocument_uncached";
+    }
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+    void onDelayedSetup() override {
+        for (const char* font : { "fonts/Em.ttf", "fonts/Funkster.ttf", "fonts/HangingS.ttf" }) {
+            if (sk_sp<SkTypeface> typeface = MakeResourceAsTypeface(font)) {
+                fTypefaces.push_back(std::move(typeface));
+            }
+        }
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        static const char kText[] = "The quick brown fox jumps over the lazy dog.";
+        while (loops-- > 0) {
+            if (!fCached) {
+                SkResourceCache::PurgeAll();
+            }
+            SkNullWStream nullStream;
+            sk_sp<SkDocument> doc = SkDocument::MakePDF(&nullStream);
+            SkCanvas* canvas = doc->beginPage(612, 792);
+            SkPaint paint;
+            paint.setTextSize(12);
+            SkScalar y = 20;
+            for (const sk_sp<SkTypeface>& typeface : fTypefaces) {
+                paint.setTypeface(typeface);
+                canvas->drawText(kText, strlen(kText), 20, y, paint);
+                y += 20;
+            }
+            doc->close();
+        }
+    }
+
+private:
+    bool                           fCached;
+    std::vector<sk_sp<SkTypeface>> fTypefaces;
+};
+
 }  // namespace
 DEF_BENCH(return new PDFImageBench;)
 DEF_BENCH(return new PDFJpegImageBench;)
 DEF_BENCH(return new PDFCompressionBench;)
+DEF_BENCH(return new PDFDeflateBench(1, 1);)
+DEF_BENCH(return new PDFDeflateBench(6, 1);)
+DEF_BENCH(return new PDFDeflateBench(6, 4);)
 DEF_BENCH(return new PDFColorComponentBench;)
 DEF_BENCH(return new PDFShaderBench;)
 DEF_BENCH(return new WritePDFTextBenchmark;)
+DEF_BENCH(return new PDFTextDocumentBench(true);)
+DEF_BENCH(return new PDFTextDocumentBench(false);)
 
 #endif
 
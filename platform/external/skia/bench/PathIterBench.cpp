@@ -31,8 +31,8 @@ class PathIterBench : public Benchmark {
     bool        fRaw;
 
 public:
-    PathIterBench(bool raw)  {
-        fName.printf("pathiter_%s", raw ? "raw" : "consume");
+    PathIterBench(bool raw, bool interned = false)  {
+        fName.printf("pathiter_%s%s", raw ? "raw" : "consume", interned ? "_interned" : "");
         fRaw = raw;
 
         SkRandom rand;
@@ -54,6 +54,9 @@ public:
                     break;
             }
         }
+        if (interned) {
+            fPath.intern();
+        }
     }
 
     bool isSuitableFor(Backend backend) override {
@@ -93,3 +96,5 @@ private:
 
 DEF_BENCH( return new PathIterBench(false); )
 DEF_BENCH( return new PathIterBench(true); )
+DEF_BENCH( return new PathIterBench(false, true); )
+DEF_BENCH( return new PathIterBench(true, true); )
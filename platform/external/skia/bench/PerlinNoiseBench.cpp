@@ -9,21 +9,59 @@
 #include "SkPerlinNoiseShader.h"
 #include "SkShader.h"
 
+enum class NoiseType { kFractal, kTurbulence, kImproved };
+
+static sk_sp<SkShader> make_noise(NoiseType type, int numOctaves, const SkISize* tileSize) {
+    switch (type) {
+        case NoiseType::kFractal:
+            return SkPerlinNoiseShader::MakeFractalNoise(0.1f, 0.1f, numOctaves, 0, tileSize);
+        case NoiseType::kTurbulence:
+            return SkPerlinNoiseShader::MakeTurbulence(0.1f, 0.1f, numOctaves, 0, tileSize);
+        case NoiseType::kImproved:
+            return SkPerlinNoiseShader::MakeImprovedNoise(0.1f, 0.1f, numOctaves, 0);
+    }
+    return nullptr;
+}
+
+static const char* noise_name(NoiseType type) {
+    switch (type) {
+        case NoiseType::kFractal:    return "fractal";
+        case NoiseType::kTurbulence: return "turbulence";
+        case NoiseType::kImproved:   return "improved";
+    }
+    return "";
+}
+
 class PerlinNoiseBench : public Benchmark {
     SkISize fSize;
 
 public:
-    PerlinNoiseBench()  {
+    PerlinNoiseBench(NoiseType type = NoiseType::kFractal, int numOctaves = 3,
+                     bool stitchTiles = false)
+        : fType(type)
+        , fNumOctaves(numOctaves)
+        , fStitchTiles(stitchTiles) {
         fSize = SkISize::Make(80, 80);
+        // The original bench keeps its name.
+        if (NoiseType::kFractal == type && 3 == numOctaves && !stitchTiles) {
+            fName = "perlinnoise";
+        } else {
+            fName.printf("perlinnoise_%s_%d%s", noise_name(type), numOctaves,
+                         stitchTiles ? "_stitch" : "");
+        }
     }
 
 protected:
     const char* onGetName() override {
-        return "perlinnoise";
+        return fName.c_str();
     }
 
     void onDraw(int loops, SkCanvas* canvas) override {
-        this->test(loops, canvas, 0, 0, 0.1f, 0.1f, 3, 0, false);
+        SkPaint paint;
+        paint.setShader(make_noise(fType, fNumOctaves, fStitchTiles ? &fSize : nullptr));
+        for (int i = 0; i < loops; i++) {
+            this->drawClippedRect(canvas, 0, 0, paint);
+        }
     }
 
 private:
@@ -38,17 +76,10 @@ private:
         canvas->restore();
     }
 
-    void test(int loops, SkCanvas* canvas, int x, int y,
-              float baseFrequencyX, float baseFrequencyY, int numOctaves, float seed,
-              bool stitchTiles) {
-        SkPaint paint;
-        paint.setShader(SkPerlinNoiseShader::MakeFractalNoise(baseFrequencyX, baseFrequencyY,
-                                                              numOctaves, seed,
-                                                              stitchTiles ? &fSize : nullptr));
-        for (int i = 0; i < loops; i++) {
-            this->drawClippedRect(canvas, x, y, paint);
-        }
-    }
+    NoiseType fType;
+    int       fNumOctaves;
+    bool      fStitchTiles;
+    SkString  fName;
 
     typedef Benchmark INHERITED;
 };
@@ -56,3 +87,7 @@ private:
 ///////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH( return new PerlinNoiseBench(); )
+DEF_BENCH( return new PerlinNoiseBench(NoiseType::kFractal, 8); )
+DEF_BENCH( return new PerlinNoiseBench(NoiseType::kTurbulence, 3); )
+DEF_BENCH( return new PerlinNoiseBench(NoiseType::kTurbulence, 3, true); )
+DEF_BENCH( return new PerlinNoiseBench(NoiseType::kImproved, 3); )
@@ -7,6 +7,8 @@
 #include "Benchmark.h"
 #include "SkCanvas.h"
 #include "SkColor.h"
+#include "SkLiteDL.h"
+#include "SkLiteRecorder.h"
 #include "SkPaint.h"
 #include "SkPicture.h"
 #include "SkPictureRecorder.h"
@@ -143,8 +145,9 @@ DEF_BENCH( return new PosTextPlaybackBench(false); )
 
 // Chrome draws into small tiles with impl-side painting.
 // This benchmark measures the relative performance of our bounding-box hierarchies,
-// both when querying tiles perfectly and when not.
-enum BBH  { kNone, kRTree };
+// both when querying tiles perfectly and when not, and of SkLiteDL (with and without the
+// per-op bounds makeThreadsafe() computes) against SkRecord.
+enum BBH  { kNone, kRTree, kLiteDL, kLiteDLThreadsafe };
 enum Mode { kTiled, kRandom };
 class TiledPlaybackBench : public Benchmark {
 public:
@@ -152,6 +155,8 @@ public:
         switch (fBBH) {
             case kNone:     fName.append("_none"    ); break;
             case kRTree:    fName.append("_rtree"   ); break;
+            case kLiteDL:   fName.append("_litedl"  ); break;
+            case kLiteDLThreadsafe: fName.append("_litedl_threadsafe"); break;
         }
         switch (fMode) {
             case kTiled:  fName.append("_tiled" ); break;
@@ -167,10 +172,19 @@ public:
         switch (fBBH) {
             case kNone:                                                 break;
             case kRTree:    factory.reset(new SkRTreeFactory);          break;
+            case kLiteDL:                                               break;
+            case kLiteDLThreadsafe:                                     break;
         }
 
         SkPictureRecorder recorder;
-        SkCanvas* canvas = recorder.beginRecording(1024, 1024, factory.get());
+        SkLiteRecorder liteRecorder;
+        SkCanvas* canvas;
+        if (fBBH == kLiteDL || fBBH == kLiteDLThreadsafe) {
+            liteRecorder.reset(&fDL, SkIRect::MakeWH(1024, 1024));
+            canvas = &liteRecorder;
+        } else {
+            canvas = recorder.beginRecording(1024, 1024, factory.get());
+        }
             SkRandom rand;
             for (int i = 0; i < 10000; i++) {
                 SkScalar x = rand.nextRangeScalar(0, 1024),
@@ -182,7 +196,12 @@ public:
                 paint.setAlpha(0xFF);
                 canvas->drawRect(SkRect::MakeXYWH(x,y,w,h), paint);
             }
-        fPic = recorder.finishRecordingAsPicture();
+        if (fBBH == kLiteDLThreadsafe) {
+            fDL.makeThreadsafe();
+        }
+        if (fBBH == kNone || fBBH == kRTree) {
+            fPic = recorder.finishRecordingAsPicture();
+        }
     }
 
     void onDraw(int loops, SkCanvas* canvas) override {
@@ -201,7 +220,11 @@ public:
                 }
                 SkAutoCanvasRestore ar(canvas, true/*save now*/);
                 canvas->clipRect(SkRect::MakeXYWH(x,y,256,256));
-                fPic->playback(canvas);
+                if (fPic) {
+                    fPic->playback(canvas);
+                } else {
+                    fDL.draw(canvas);
+                }
             }
         }
     }
@@ -211,9 +234,14 @@ private:
     Mode                fMode;
     SkString            fName;
     sk_sp<SkPicture>    fPic;
+    SkLiteDL            fDL;
 };
 
 DEF_BENCH( return new TiledPlaybackBench(kNone,     kRandom); )
 DEF_BENCH( return new TiledPlaybackBench(kNone,     kTiled ); )
 DEF_BENCH( return new TiledPlaybackBench(kRTree,    kRandom); )
 DEF_BENCH( return new TiledPlaybackBench(kRTree,    kTiled ); )
+DEF_BENCH( return new TiledPlaybackBench(kLiteDL,   kRandom); )
+DEF_BENCH( return new TiledPlaybackBench(kLiteDL,   kTiled ); )
+DEF_BENCH( return new TiledPlaybackBench(kLiteDLThreadsafe, kRandom); )
+DEF_BENCH( return new TiledPlaybackBench(kLiteDLThreadsafe, kTiled ); )
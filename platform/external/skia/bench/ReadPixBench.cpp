@@ -105,3 +105,65 @@ private:
     typedef Benchmark INHERITED;
 };
 DEF_BENCH( return new PixmapOrientBench(); )
+
+////////////////////////////////////////////////////////////////////////////////
+#include "SkColorSpace.h"
+#include "SkImage.h"
+
+// Reads a whole large image back, converting its color type and color space, as exporting one
+// would. Conversions this large are split into tiles converted in parallel (see --threads).
+class ReadPixConvertBench : public Benchmark {
+public:
+    ReadPixConvertBench(SkColorType srcColorType, SkColorType dstColorType)
+        : fSrcColorType(srcColorType)
+        , fDstColorType(dstColorType)
+    {
+        auto name = [](SkColorType ct) { return kRGBA_F16_SkColorType == ct ? "f16" : "8888"; };
+        fName.printf("readpix_convert_%s_%s", name(srcColorType), name(dstColorType));
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        // F16 is linear, and 8888 sRGB, so the conversion always goes through the pipeline.
+        SkBitmap src;
+        src.allocPixels(this->info(fSrcColorType));
+        src.eraseColor(0x80336699);
+        src.setImmutable();
+        fImage = SkImage::MakeFromBitmap(src);
+        fDst.allocPixels(this->info(fDstColorType));
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; i++) {
+            fImage->readPixels(fDst.pixmap(), 0, 0);
+        }
+    }
+
+private:
+    static const int kSize = 2048;
+
+    SkImageInfo info(SkColorType colorType) const {
+        return SkImageInfo::Make(kSize, kSize, colorType, kPremul_SkAlphaType,
+                                 kRGBA_F16_SkColorType == colorType
+                                         ? SkColorSpace::MakeSRGBLinear()
+                                         : SkColorSpace::MakeSRGB());
+    }
+
+    SkColorType    fSrcColorType;
+    SkColorType    fDstColorType;
+    SkString       fName;
+    sk_sp<SkImage> fImage;
+    SkBitmap       fDst;
+
+    typedef Benchmark INHERITED;
+};
+DEF_BENCH( return new ReadPixConvertBench(kRGBA_F16_SkColorType, kRGBA_8888_SkColorType); )
+DEF_BENCH( return new ReadPixConvertBench(kRGBA_8888_SkColorType, kRGBA_F16_SkColorType); )
@@ -12,18 +12,53 @@
 
 #if SK_SUPPORT_GPU
 
+#include "GrContext.h"
+#include "GrContextOptions.h"
+#include "GrContextPriv.h"
+#include "GrRectanizer_maxrects.h"
 #include "GrRectanizer_pow2.h"
 #include "GrRectanizer_skyline.h"
+#include "SkCanvas.h"
+#include "SkSurface.h"
+#include "SkTypeface.h"
+#include "sk_tool_utils.h"
+
+// The text sizes that glyph benches draw at, with body text sizes repeated to weigh them more.
+static const SkScalar kGlyphTextSizes[] = { 9, 10, 11, 12, 12, 13, 13, 14, 14, 14, 16, 16, 18, 20,
+                                            24, 28, 32, 48 };
+
+// Appends the sizes of the masks of the printable ASCII glyphs of a typeface, at the given size.
+static void append_glyph_sizes(const sk_sp<SkTypeface>& typeface, SkScalar textSize,
+                               SkTDArray<SkISize>* sizes) {
+    SkPaint paint;
+    paint.setTypeface(typeface);
+    paint.setTextSize(textSize);
+    char text[95];
+    for (int i = 0; i < (int)sizeof(text); ++i) {
+        text[i] = ' ' + i;
+    }
+    SkRect bounds[sizeof(text)];
+    int count = paint.getTextWidths(text, sizeof(text), nullptr, bounds);
+    for (int i = 0; i < count; ++i) {
+        SkIRect mask = bounds[i].roundOut();
+        if (!mask.isEmpty()) {
+            *sizes->append() = mask.size();
+        }
+    }
+}
 
 /**
  * This bench exercises Ganesh' GrRectanizer classes. It exercises the following
  * rectanizers:
  *      Pow2 Rectanizer
  *      Skyline Rectanizer
+ *      MaxRects Rectanizer
  * in the following cases:
  *      random rects (e.g., pull-save-layers forward use case)
  *      random power of two rects
- *      small constant sized power of 2 rects (e.g., glyph cache use case)
+ *      small constant sized power of 2 rects
+ *      the masks of real glyphs at common text sizes, into a text atlas sized plot (i.e., the
+ *      glyph cache use case)
  */
 class RectanizerBench : public Benchmark {
 public:
@@ -33,12 +68,14 @@ public:
     enum RectanizerType {
         kPow2_RectanizerType,
         kSkyline_RectanizerType,
+        kMaxRects_RectanizerType,
     };
 
     enum RectType {
         kRand_RectType,
         kRandPow2_RectType,
-        kSmallPow2_RectType
+        kSmallPow2_RectType,
+        kGlyph_RectType
     };
 
     RectanizerBench(RectanizerType rectanizerType, RectType rectType)
@@ -48,18 +85,22 @@ public:
 
         if (kPow2_RectanizerType == fRectanizerType) {
             fName.append("pow2_");
-        } else {
-            SkASSERT(kSkyline_RectanizerType == fRectanizerType);
+        } else if (kSkyline_RectanizerType == fRectanizerType) {
             fName.append("skyline_");
+        } else {
+            SkASSERT(kMaxRects_RectanizerType == fRectanizerType);
+            fName.append("maxrects_");
         }
 
         if (kRand_RectType == fRectType) {
             fName.append("rand");
         } else if (kRandPow2_RectType == fRectType) {
             fName.append("rand2");
-        } else {
-            SkASSERT(kSmallPow2_RectType == fRectType);
+        } else if (kSmallPow2_RectType == fRectType) {
             fName.append("sm2");
+        } else {
+            SkASSERT(kGlyph_RectType == fRectType);
+            fName.append("glyph");
         }
     }
 
@@ -75,11 +116,23 @@ protected:
     void onDelayedSetup() override {
         SkASSERT(nullptr == fRectanizer.get());
 
+        // Glyphs go into the plots of the text atlas, rather than a whole texture.
+        int width = kGlyph_RectType == fRectType ? kGlyphPlotWidth : kWidth;
+        int height = kGlyph_RectType == fRectType ? kGlyphPlotHeight : kHeight;
         if (kPow2_RectanizerType == fRectanizerType) {
-            fRectanizer.reset(new GrRectanizerPow2(kWidth, kHeight));
+            fRectanizer.reset(new GrRectanizerPow2(width, height));
+        } else if (kSkyline_RectanizerType == fRectanizerType) {
+            fRectanizer.reset(new GrRectanizerSkyline(width, height));
         } else {
-            SkASSERT(kSkyline_RectanizerType == fRectanizerType);
-            fRectanizer.reset(new GrRectanizerSkyline(kWidth, kHeight));
+            SkASSERT(kMaxRects_RectanizerType == fRectanizerType);
+            fRectanizer.reset(new GrRectanizerMaxRects(width, height));
+        }
+
+        if (kGlyph_RectType == fRectType) {
+            sk_sp<SkTypeface> typeface = sk_tool_utils::create_portable_typeface(nullptr, SkFontStyle());
+            for (SkScalar textSize : kGlyphTextSizes) {
+                append_glyph_sizes(typeface, textSize, &fGlyphSizes);
+            }
         }
     }
 
@@ -95,9 +148,11 @@ protected:
             } else if (kRandPow2_RectType == fRectType) {
                 size = SkISize::Make(GrNextPow2(rand.nextRangeU(1, kWidth / 2)),
                                      GrNextPow2(rand.nextRangeU(1, kHeight / 2)));
-            } else {
-                SkASSERT(kSmallPow2_RectType == fRectType);
+            } else if (kSmallPow2_RectType == fRectType) {
                 size = SkISize::Make(128, 128);
+            } else {
+                SkASSERT(kGlyph_RectType == fRectType);
+                size = fGlyphSizes[rand.nextULessThan(fGlyphSizes.count())];
             }
 
             if (!fRectanizer->addRect(size.fWidth, size.fHeight, &loc)) {
@@ -112,10 +167,15 @@ protected:
     }
 
 private:
+    // The plot size of the A8 text atlas, with the default maximum atlas size.
+    static const int kGlyphPlotWidth = 512;
+    static const int kGlyphPlotHeight = 256;
+
     SkString                    fName;
     RectanizerType              fRectanizerType;
     RectType                    fRectType;
     std::unique_ptr<GrRectanizer> fRectanizer;
+    SkTDArray<SkISize>          fGlyphSizes;
 
     typedef Benchmark INHERITED;
 };
@@ -134,5 +194,114 @@ DEF_BENCH(return new RectanizerBench(RectanizerBench::kSkyline_RectanizerType,
                                      RectanizerBench::kRandPow2_RectType);)
 DEF_BENCH(return new RectanizerBench(RectanizerBench::kSkyline_RectanizerType,
                                      RectanizerBench::kSmallPow2_RectType);)
+DEF_BENCH(return new RectanizerBench(RectanizerBench::kSkyline_RectanizerType,
+                                     RectanizerBench::kGlyph_RectType);)
+DEF_BENCH(return new RectanizerBench(RectanizerBench::kMaxRects_RectanizerType,
+                                     RectanizerBench::kRand_RectType);)
+DEF_BENCH(return new RectanizerBench(RectanizerBench::kMaxRects_RectanizerType,
+                                     RectanizerBench::kRandPow2_RectType);)
+DEF_BENCH(return new RectanizerBench(RectanizerBench::kMaxRects_RectanizerType,
+                                     RectanizerBench::kSmallPow2_RectType);)
+DEF_BENCH(return new RectanizerBench(RectanizerBench::kMaxRects_RectanizerType,
+                                     RectanizerBench::kGlyph_RectType);)
+DEF_BENCH(return new RectanizerBench(RectanizerBench::kPow2_RectanizerType,
+                                     RectanizerBench::kGlyph_RectType);)
+
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Draws text whose glyphs don't all fit in the text atlas at once, on a mock context, so that it
+ * exercises adding glyphs to the atlas, evicting and compacting its plots. The text moves through
+ * the text sizes over the frames, so some glyphs stay in use while others age out.
+ * With --gpuStatsDump it reports how many bytes were uploaded to the atlas over a fixed number of
+ * frames, and how full the atlas plots end up.
+ */
+class GlyphAtlasBench : public Benchmark {
+public:
+    bool isSuitableFor(Backend backend) override {
+        return kNonRendering_Backend == backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return "glyph_atlas_mock";
+    }
+
+    void onDelayedSetup() override {
+        GrContextOptions options;
+        // The smallest atlas: four 256x256 plots per A8 page.
+        options.fGlyphCacheTextureMaximumBytes = 512 * 256 * 4;
+        fContext = GrContext::MakeMock(nullptr, options);
+        if (!fContext) {
+            return;
+        }
+        SkImageInfo info = SkImageInfo::Make(kSize, kSize, kRGBA_8888_SkColorType,
+                                             kPremul_SkAlphaType);
+        fSurface = SkSurface::MakeRenderTarget(fContext.get(), SkBudgeted::kNo, info);
+        fTypeface = sk_tool_utils::create_portable_typeface(nullptr, SkFontStyle());
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        if (!fSurface) {
+            return;
+        }
+        for (int i = 0; i < loops; ++i) {
+            this->drawFrame();
+        }
+    }
+
+    void getGpuStats(SkCanvas*, SkTArray<SkString>* keys, SkTArray<double>* values) override {
+        if (!fSurface) {
+            return;
+        }
+        fContext->resetGpuStats();
+        for (int i = 0; i < kStatsFrames; ++i) {
+            this->drawFrame();
+        }
+        fContext->dumpGpuStatsKeyValuePairs(keys, values);
+
+        SkTArray<GrDrawOpAtlas::PlotStats> stats;
+        fContext->contextPriv().getFullAtlasManager()->getPlotStats(kA8_GrMaskFormat, &stats);
+        float percentFull = 0;
+        for (const GrDrawOpAtlas::PlotStats& plotStats : stats) {
+            percentFull += plotStats.fPercentFull;
+        }
+        keys->push_back(SkString("atlas_plots"));
+        values->push_back(stats.count());
+        keys->push_back(SkString("atlas_percent_full"));
+        values->push_back(stats.count() ? percentFull / stats.count() : 0);
+    }
+
+private:
+    void drawFrame() {
+        SkCanvas* canvas = fSurface->getCanvas();
+        SkPaint paint;
+        paint.setTypeface(fTypeface);
+        paint.setAntiAlias(true);
+        static const char kText[] = "The quick brown fox jumps over the lazy dog 0123456789";
+        static const int kSizeCount = SK_ARRAY_COUNT(kGlyphTextSizes);
+        // Half of the sizes, in a window that moves by one every few frames. Every pass over the
+        // sizes is offset a little, so that the atlas keeps filling up with new glyphs.
+        for (int i = 0; i < kSizeCount / 2; ++i) {
+            SkScalar offset = ((fFrame / 4 + i) / kSizeCount % 16) * 0.5f;
+            paint.setTextSize(kGlyphTextSizes[(fFrame / 4 + i) % kSizeCount] + offset);
+            canvas->drawText(kText, sizeof(kText) - 1, 0, (i + 1) * 48, paint);
+        }
+        canvas->flush();
+        ++fFrame;
+    }
+
+    static constexpr int kSize = 1024;
+    static constexpr int kStatsFrames = 100;
+
+    sk_sp<GrContext>  fContext;
+    sk_sp<SkSurface>  fSurface;
+    sk_sp<SkTypeface> fTypeface;
+    int               fFrame = 0;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH(return new GlyphAtlasBench();)
 
 #endif
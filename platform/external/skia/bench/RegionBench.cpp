@@ -34,6 +34,14 @@ static bool diffrectbig_proc(SkRegion& a, SkRegion& b) {
     return result.op(a, a.getBounds(), SkRegion::kDifference_Op);
 }
 
+static bool unionrects_proc(SkRegion& a, SkRegion& b) {
+    SkRegion result(a);
+    for (SkRegion::Iterator iter(b); !iter.done(); iter.next()) {
+        result.op(iter.rect(), SkRegion::kUnion_Op);
+    }
+    return !result.isEmpty();
+}
+
 static bool containsrect_proc(SkRegion& a, SkRegion& b) {
     SkIRect r = a.getBounds();
     r.inset(r.width()/4, r.height()/4);
@@ -119,6 +127,7 @@ private:
 ///////////////////////////////////////////////////////////////////////////////
 
 #define SMALL   16
+#define BIG     64
 
 DEF_BENCH(return new RegionBench(SMALL, union_proc, "union");)
 DEF_BENCH(return new RegionBench(SMALL, sect_proc, "intersect");)
@@ -129,3 +138,9 @@ DEF_BENCH(return new RegionBench(SMALL, containsrect_proc, "containsrect");)
 DEF_BENCH(return new RegionBench(SMALL, sectsrgn_proc, "intersectsrgn");)
 DEF_BENCH(return new RegionBench(SMALL, sectsrect_proc, "intersectsrect");)
 DEF_BENCH(return new RegionBench(SMALL, containsxy_proc, "containsxy");)
+
+DEF_BENCH(return new RegionBench(BIG, union_proc, "union");)
+DEF_BENCH(return new RegionBench(BIG, sect_proc, "intersect");)
+DEF_BENCH(return new RegionBench(BIG, diff_proc, "difference");)
+DEF_BENCH(return new RegionBench(SMALL, unionrects_proc, "unionrects");)
+DEF_BENCH(return new RegionBench(BIG, unionrects_proc, "unionrects");)
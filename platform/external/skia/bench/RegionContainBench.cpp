@@ -15,6 +15,20 @@ static bool sect_proc(SkRegion& a, SkRegion& b) {
     return result.op(a, b, SkRegion::kIntersect_Op);
 }
 
+static bool union_proc(SkRegion& a, SkRegion& b) {
+    SkRegion result;
+    return result.op(a, b, SkRegion::kUnion_Op);
+}
+
+static bool diff_proc(SkRegion& a, SkRegion& b) {
+    SkRegion result;
+    return result.op(b, a, SkRegion::kDifference_Op);
+}
+
+static bool contains_proc(SkRegion& a, SkRegion& b) {
+    return b.contains(a);
+}
+
 class RegionContainBench : public Benchmark {
 public:
     typedef bool (*Proc)(SkRegion& a, SkRegion& b);
@@ -65,3 +79,6 @@ private:
 };
 
 DEF_BENCH(return new RegionContainBench(sect_proc, "sect");)
+DEF_BENCH(return new RegionContainBench(union_proc, "union");)
+DEF_BENCH(return new RegionContainBench(diff_proc, "diff");)
+DEF_BENCH(return new RegionContainBench(contains_proc, "contains");)
@@ -16,8 +16,12 @@
 #include "SkOSPath.h"
 #include "SkStream.h"
 #include "SkString.h"
+#include "SkTArray.h"
 #include "SkTypes.h"
 
+#include <functional>
+#include <vector>
+
 /**
  * Base class for writing out the bench results.
  *
@@ -50,10 +54,65 @@ public:
     // Record a list of test metrics.
     virtual void metrics(const char name[], const SkTArray<double>& array) {}
 
+    // Record a list of per-sample flags, e.g. which samples are outliers.
+    virtual void flags(const char name[], const SkTArray<bool>& array) {}
+
     // Flush to storage now please.
     virtual void flush() {}
 };
 
+/**
+ * Records every call so it can be replayed, in order, into another ResultsWriter later.
+ * Concurrently running benches each log into one of these, and the results are copied
+ * into the real log one bench at a time.  flush() is not recorded.
+ */
+class BufferedResultsWriter : public ResultsWriter {
+public:
+    void key(const char name[], const char value[]) override {
+        SkString n(name), v(value);
+        fCalls.push_back([n, v](ResultsWriter* w) { w->key(n.c_str(), v.c_str()); });
+    }
+    void property(const char name[], const char value[]) override {
+        SkString n(name), v(value);
+        fCalls.push_back([n, v](ResultsWriter* w) { w->property(n.c_str(), v.c_str()); });
+    }
+    void bench(const char name[], int32_t x, int32_t y) override {
+        SkString n(name);
+        fCalls.push_back([n, x, y](ResultsWriter* w) { w->bench(n.c_str(), x, y); });
+    }
+    void config(const char name[]) override {
+        SkString n(name);
+        fCalls.push_back([n](ResultsWriter* w) { w->config(n.c_str()); });
+    }
+    void configOption(const char name[], const char* value) override {
+        SkString n(name), v(value);
+        fCalls.push_back([n, v](ResultsWriter* w) { w->configOption(n.c_str(), v.c_str()); });
+    }
+    void metric(const char name[], double ms) override {
+        SkString n(name);
+        fCalls.push_back([n, ms](ResultsWriter* w) { w->metric(n.c_str(), ms); });
+    }
+    void metrics(const char name[], const SkTArray<double>& array) override {
+        SkString n(name);
+        SkTArray<double> a(array);
+        fCalls.push_back([n, a](ResultsWriter* w) { w->metrics(n.c_str(), a); });
+    }
+    void flags(const char name[], const SkTArray<bool>& array) override {
+        SkString n(name);
+        SkTArray<bool> a(array);
+        fCalls.push_back([n, a](ResultsWriter* w) { w->flags(n.c_str(), a); });
+    }
+
+    void replay(ResultsWriter* writer) const {
+        for (const auto& call : fCalls) {
+            call(writer);
+        }
+    }
+
+private:
+    std::vector<std::function<void(ResultsWriter*)>> fCalls;
+};
+
 /**
  NanoJSONResultsWriter writes the test results out in the following
  format:
@@ -71,7 +130,11 @@ public:
         "Xfermode_Luminosity_640_480" : {
            "8888" : {
                  "median_ms" : 143.188128906250,
+                 "median_ci_low_ms" : 142.976562500000,
+                 "median_ci_high_ms" : 143.527343750000,
                  "min_ms" : 143.835957031250,
+                 "samples" : [ ... ],
+                 "outliers" : [ false, true, ... ],
                  ...
               },
           ...
@@ -127,6 +190,15 @@ public:
         }
         (*fConfig)[name] = std::move(value);
     }
+    void flags(const char name[], const SkTArray<bool>& array) override {
+        SkASSERT(fConfig);
+        Json::Value value = Json::Value(Json::arrayValue);
+        value.resize(array.count());
+        for (int i = 0; i < array.count(); i++) {
+            value[i] = array[i];
+        }
+        (*fConfig)[name] = std::move(value);
+    }
 
     // Flush to storage now please.
     void flush() override {
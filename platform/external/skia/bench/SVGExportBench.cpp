@@ -0,0 +1,98 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Benchmark.h"
+
+#ifdef SK_XML
+
+#include "SkBitmap.h"
+#include "SkCanvas.h"
+#include "SkPath.h"
+#include "SkPicture.h"
+#include "SkPictureRecorder.h"
+#include "SkRandom.h"
+#include "SkSVGCanvas.h"
+#include "SkStream.h"
+#include "SkString.h"
+
+// Exports a big, map-like picture to SVG: thousands of paths drawn from a smaller set of shapes,
+// with icons stamped all over it. With repeats == 1 every shape is drawn just once.
+class SVGExportBench : public Benchmark {
+public:
+    explicit SVGExportBench(int repeats) : fRepeats(repeats) {
+        fName.printf("svgexport_map_%d", repeats);
+    }
+
+protected:
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        static const int kDraws = 4000;
+        static const SkScalar kSize = 2048;
+
+        SkRandom rand;
+        SkTArray<SkPath> shapes;
+        for (int i = 0; i < kDraws / fRepeats; ++i) {
+            SkPath& shape = shapes.push_back();
+            shape.moveTo(0, 0);
+            for (int j = 0; j < 12; ++j) {
+                shape.lineTo(rand.nextRangeScalar(0, 40), rand.nextRangeScalar(0, 40));
+            }
+            shape.quadTo(rand.nextRangeScalar(0, 40), rand.nextRangeScalar(0, 40), 0, 40);
+            shape.close();
+        }
+
+        SkBitmap icon;
+        icon.allocN32Pixels(16, 16);
+        icon.eraseColor(SK_ColorRED);
+        icon.eraseArea(SkIRect::MakeXYWH(4, 4, 8, 8), SK_ColorWHITE);
+
+        SkPictureRecorder recorder;
+        SkCanvas* canvas = recorder.beginRecording(kSize, kSize);
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        for (int i = 0; i < kDraws; ++i) {
+            paint.setColor(rand.nextU() | 0xFF000000);
+            paint.setStyle(i % 3 ? SkPaint::kFill_Style : SkPaint::kStroke_Style);
+            canvas->save();
+            canvas->translate(rand.nextRangeScalar(0, kSize), rand.nextRangeScalar(0, kSize));
+            canvas->drawPath(shapes[i % shapes.count()], paint);
+            canvas->restore();
+            if (i % 20 == 0) {
+                canvas->drawBitmap(icon, rand.nextRangeScalar(0, kSize),
+                                   rand.nextRangeScalar(0, kSize));
+            }
+        }
+        fPicture = recorder.finishRecordingAsPicture();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            SkNullWStream stream;
+            std::unique_ptr<SkCanvas> svg = SkSVGCanvas::Make(fPicture->cullRect(), &stream);
+            fPicture->playback(svg.get());
+        }
+    }
+
+private:
+    int              fRepeats;
+    SkString         fName;
+    sk_sp<SkPicture> fPicture;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH(return new SVGExportBench(1);)
+DEF_BENCH(return new SVGExportBench(20);)
+
+#endif
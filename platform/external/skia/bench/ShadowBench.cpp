@@ -9,6 +9,7 @@
 #include "SkDrawShadowInfo.h"
 #include "SkPaint.h"
 #include "SkPath.h"
+#include "SkRRect.h"
 #include "SkShadowUtils.h"
 
 class ShadowBench : public Benchmark {
@@ -105,3 +106,76 @@ DEF_BENCH(return new ShadowBench(false, true);)
 DEF_BENCH(return new ShadowBench(true, false);)
 DEF_BENCH(return new ShadowBench(true, true);)
 
+class ShadowAnimateBench : public Benchmark {
+// Draws shadowed convex occluders while the canvas rotates and scales a little every frame, as it
+// does during an animation, so that the cached tessellations are only reused if they can be
+// transformed. The occluders are rrects, or convex polygons that have no analytic fast path.
+public:
+    explicit ShadowAnimateBench(bool polygons) : fPolygons(polygons) {
+        fName.printf("shadows_animate_%s", polygons ? "poly" : "rrect");
+    }
+
+    bool isVisual() override { return true; }
+
+protected:
+    static constexpr int kCount = 24;
+    static constexpr int kFrames = 60;
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        fRec.fZPlaneParams = SkPoint3::Make(0, 0, 16);
+        fRec.fLightPos = SkPoint3::Make(270, 0, 600);
+        fRec.fLightRadius = 800;
+        fRec.fAmbientColor = 0x19000000;
+        fRec.fSpotColor = 0x40000000;
+        fRec.fFlags = SkShadowFlags::kTransparentOccluder_ShadowFlag;
+
+        for (int i = 0; i < kCount; ++i) {
+            SkRect rect = SkRect::MakeXYWH(40 + (i % 6) * 96, 40 + (i / 6) * 96, 60, 60);
+            if (fPolygons) {
+                // Polygons with more sides than most shape animations use, so that the
+                // tessellation dominates.
+                int sides = 6 + i % 10;
+                fOccluders[i].moveTo(rect.centerX() + 30, rect.centerY());
+                for (int j = 1; j < sides; ++j) {
+                    SkScalar angle = 2 * SK_ScalarPI * j / sides;
+                    fOccluders[i].lineTo(rect.centerX() + 30 * SkScalarCos(angle),
+                                         rect.centerY() + 30 * SkScalarSin(angle));
+                }
+                fOccluders[i].close();
+            } else {
+                fOccluders[i].addRRect(SkRRect::MakeRectXY(rect, 6 + i % 4, 6 + i % 4));
+            }
+        }
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; ++i) {
+            // Half a degree and a little scale per frame, back and forth.
+            int frame = i % (2 * kFrames);
+            SkScalar t = frame < kFrames ? frame : 2 * kFrames - frame;
+            canvas->save();
+            canvas->translate(320, 240);
+            canvas->rotate(0.5f * t);
+            canvas->scale(1 + 0.0005f * t, 1 + 0.0005f * t);
+            canvas->translate(-320, -240);
+            for (const SkPath& occluder : fOccluders) {
+                canvas->private_draw_shadow_rec(occluder, fRec);
+            }
+            canvas->restore();
+        }
+    }
+
+private:
+    SkString        fName;
+    bool            fPolygons;
+    SkPath          fOccluders[kCount];
+    SkDrawShadowRec fRec;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH(return new ShadowAnimateBench(false);)
+DEF_BENCH(return new ShadowAnimateBench(true);)
+
@@ -0,0 +1,173 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkTypes.h"
+
+// This tests the SkSL compiler, which only runs on the CPU but is only built with the GPU backend.
+#if SK_SUPPORT_GPU
+
+#include "Benchmark.h"
+#include "SkSLCompiler.h"
+#include "SkString.h"
+
+static const char* kSolidSrc =
+    "layout(location=0) in half4 vcolor;"
+    "void main() {"
+    "    sk_FragColor = vcolor;"
+    "}";
+
+static const char* kTextureSrc =
+    "layout(set=0, binding=0) uniform sampler2D image;"
+    "layout(location=0) in float2 vcoord;"
+    "layout(location=1) in half4 vcolor;"
+    "half4 luma(half4 c) {"
+    "    half l = dot(half3(0.2126, 0.7152, 0.0722), c.rgb);"
+    "    return half4(0, 0, 0, l);"
+    "}"
+    "void main() {"
+    "    half4 c = texture(image, vcoord) * vcolor.a;"
+    "    if (c.a > 0) {"
+    "        c.rgb /= c.a;"
+    "    }"
+    "    c = clamp(luma(c) + c, 0, 1);"
+    "    c.rgb *= c.a;"
+    "    sk_FragColor = c;"
+    "}";
+
+static const char* kBlurSrc =
+    "layout(set=0, binding=0) uniform sampler2D image;"
+    "layout(set=0, binding=1) uniform float4 kernel[7];"
+    "layout(set=0, binding=2) uniform float2 imageIncrement;"
+    "layout(set=0, binding=3) uniform float4 bounds;"
+    "layout(location=0) in float2 vcoord;"
+    "half4 sample_clamped(float2 coord) {"
+    "    coord = clamp(coord, bounds.xy, bounds.zw);"
+    "    return texture(image, coord);"
+    "}"
+    "half4 blur(float2 coord) {"
+    "    half4 sum = half4(0);"
+    "    coord -= 12 * imageIncrement;"
+    "    for (int i = 0; i < 7; i++) {"
+    "        float4 k = kernel[i];"
+    "        sum += sample_clamped(coord) * half(k.x);"
+    "        coord += imageIncrement;"
+    "        sum += sample_clamped(coord) * half(k.y);"
+    "        coord += imageIncrement;"
+    "        sum += sample_clamped(coord) * half(k.z);"
+    "        coord += imageIncrement;"
+    "        sum += sample_clamped(coord) * half(k.w);"
+    "        coord += imageIncrement;"
+    "    }"
+    "    return sum;"
+    "}"
+    "void main() {"
+    "    half4 color = blur(vcoord);"
+    "    half3 lit = color.rgb;"
+    "    half3 lightDir = normalize(half3(0.5, 0.5, 1));"
+    "    half3 normal = normalize(half3(dFdx(color.a), dFdy(color.a), 1));"
+    "    lit *= max(dot(normal, lightDir), 0);"
+    "    switch (int(color.a * 3)) {"
+    "        case 0: sk_FragColor = half4(0); break;"
+    "        case 1: sk_FragColor = half4(lit * 0.5, color.a); break;"
+    "        default: sk_FragColor = half4(lit, color.a); break;"
+    "    }"
+    "}";
+
+// Compiles one SkSL fragment program to GLSL, SPIR-V or Metal. The compiler is kept across loops,
+// as it is in GrContext, unless the bench is measuring a cold compile.
+class SkSLBench : public Benchmark {
+public:
+    enum Output {
+        kGLSL_Output,
+        kSPIRV_Output,
+        kMetal_Output,
+    };
+
+    SkSLBench(const char* name, const char* src, Output output, bool cold)
+        : fSrc(src)
+        , fOutput(output)
+        , fCold(cold) {
+        static const char* kOutputNames[] = { "glsl", "spirv", "metal" };
+        fName.printf("sksl_%s_%s%s", name, kOutputNames[output], cold ? "_cold" : "");
+        fCaps = SkSL::ShaderCapsFactory::Default();
+        fSettings.fCaps = fCaps.get();
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; i++) {
+            std::unique_ptr<SkSL::Compiler> coldCompiler;
+            SkSL::Compiler* compiler = &fCompiler;
+            if (fCold) {
+                coldCompiler.reset(new SkSL::Compiler());
+                compiler = coldCompiler.get();
+            }
+            std::unique_ptr<SkSL::Program> program =
+                    compiler->convertProgram(SkSL::Program::kFragment_Kind, SkSL::String(fSrc),
+                                             fSettings);
+            if (!program) {
+                SkDebugf("%s failed to compile:\n%s\n", fName.c_str(),
+                         compiler->errorText().c_str());
+                SK_ABORT("SkSL compile failed");
+            }
+            SkSL::String output;
+            bool success = false;
+            switch (fOutput) {
+                case kGLSL_Output:
+                    success = compiler->toGLSL(*program, &output);
+                    break;
+                case kSPIRV_Output:
+                    success = compiler->toSPIRV(*program, &output);
+                    break;
+                case kMetal_Output: {
+                    SkSL::StringStream stream;
+                    success = compiler->toMetal(*program, stream);
+                    break;
+                }
+            }
+            if (!success) {
+                SkDebugf("%s failed to generate code:\n%s\n", fName.c_str(),
+                         compiler->errorText().c_str());
+                SK_ABORT("SkSL code generation failed");
+            }
+        }
+    }
+
+private:
+    SkString fName;
+    const char* fSrc;
+    Output fOutput;
+    bool fCold;
+    sk_sp<GrShaderCaps> fCaps;
+    SkSL::Program::Settings fSettings;
+    SkSL::Compiler fCompiler;
+
+    typedef Benchmark INHERITED;
+};
+
+#define DEF_SKSL_BENCHES(name, src)                                              \
+    DEF_BENCH(return new SkSLBench(name, src, SkSLBench::kGLSL_Output, false);)  \
+    DEF_BENCH(return new SkSLBench(name, src, SkSLBench::kSPIRV_Output, false);) \
+    DEF_BENCH(return new SkSLBench(name, src, SkSLBench::kMetal_Output, false);)
+
+DEF_SKSL_BENCHES("solid", kSolidSrc)
+DEF_SKSL_BENCHES("texture", kTextureSrc)
+DEF_SKSL_BENCHES("blur", kBlurSrc)
+
+// Cold compiles include converting the builtin modules for a brand new Compiler.
+DEF_BENCH(return new SkSLBench("solid", kSolidSrc, SkSLBench::kGLSL_Output, true);)
+DEF_BENCH(return new SkSLBench("blur", kBlurSrc, SkSLBench::kGLSL_Output, true);)
+
+#endif
@@ -6,7 +6,11 @@
  */
 
 #include "Benchmark.h"
+#include "Resources.h"
+#include "SkData.h"
+#include "SkFrontBufferedStream.h"
 #include "SkStream.h"
+#include "SkStreamPriv.h"
 
 class StreamBench : public Benchmark {
     SkString    fName;
@@ -48,3 +52,97 @@ private:
 
 DEF_BENCH(return new StreamBench(false);)
 DEF_BENCH(return new StreamBench(true);)
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Reads a whole resource file front to back, like a decoder would, either through stdio or
+// through a mapping hinted as sequential.
+class FileStreamBench : public Benchmark {
+    SkString    fName;
+    SkString    fPath;
+    const bool  fMapped;
+public:
+    FileStreamBench(bool mapped) : fMapped(mapped) {
+        fName.printf("stream_read_file_%s", mapped ? "mmap" : "FILE");
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        fPath = GetResourcePath("images/mandrill_512.png");
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        char buffer[4096];
+        uint32_t sum = 0;
+        for (int i = 0; i < loops; ++i) {
+            std::unique_ptr<SkStreamAsset> stream;
+            if (fMapped) {
+                stream = SkStreamMakeFromFile(fPath.c_str(), kSequential_SkFILE_Access);
+            } else {
+                stream = SkFILEStream::Make(fPath.c_str());
+            }
+            if (!stream) {
+                return;
+            }
+            while (size_t bytesRead = stream->read(buffer, sizeof(buffer))) {
+                sum += buffer[bytesRead - 1];
+            }
+        }
+        fSum = sum;
+    }
+
+private:
+    uint32_t fSum;
+
+    typedef Benchmark INHERITED;
+};
+
+// Peeks at the front of a stream that is already in memory, rewinds, and reads all of it through
+// an SkFrontBufferedStream, as Android does when decoding.
+class FrontBufferedStreamBench : public Benchmark {
+public:
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override { return "stream_frontbuffered_memory"; }
+
+    void onDelayedSetup() override {
+        fData = SkData::MakeUninitialized(kSize);
+        memset(fData->writable_data(), 0x55, kSize);
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        char buffer[4096];
+        uint32_t sum = 0;
+        for (int i = 0; i < loops * 10; ++i) {
+            auto stream = SkFrontBufferedStream::Make(SkMemoryStream::Make(fData), kBufferSize);
+            stream->peek(buffer, 32);
+            stream->rewind();
+            while (size_t bytesRead = stream->read(buffer, sizeof(buffer))) {
+                sum += buffer[bytesRead - 1];
+            }
+        }
+        fSum = sum;
+    }
+
+private:
+    static constexpr size_t kSize = 1 << 20;
+    static constexpr size_t kBufferSize = 256 << 10;
+
+    sk_sp<SkData> fData;
+    uint32_t      fSum;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH(return new FileStreamBench(false);)
+DEF_BENCH(return new FileStreamBench(true);)
+DEF_BENCH(return new FrontBufferedStreamBench;)
@@ -8,10 +8,11 @@
 #include "Benchmark.h"
 #include "SkBitmap.h"
 #include "SkCanvas.h"
+#include "SkColorPriv.h"
 #include "SkShader.h"
 #include "SkString.h"
 
-static void create_gradient(SkBitmap* bm) {
+static void create_gradient(SkBitmap* bm, bool doAlpha) {
     SkASSERT(1 == bm->width());
     const int height = bm->height();
 
@@ -19,7 +20,12 @@ static void create_gradient(SkBitmap* bm) {
     float blue = 255.0f;
 
     for (int y = 0; y < height; y++) {
-        *bm->getAddr32(0, y) = SkColorSetRGB(0, 0, (U8CPU) blue);
+        if (doAlpha) {
+            // Fades out along with the blue, so every pixel has to be blended.
+            *bm->getAddr32(0, y) = SkPreMultiplyARGB((U8CPU) blue, 0, 0, (U8CPU) blue);
+        } else {
+            *bm->getAddr32(0, y) = SkColorSetRGB(0, 0, (U8CPU) blue);
+        }
         blue -= deltaB;
     }
 }
@@ -40,7 +46,8 @@ public:
                     SkShader::TileMode yTile,
                     bool doFilter,
                     bool doTrans,
-                    bool doScale)
+                    bool doScale,
+                    bool doAlpha = false)
         : fDoFilter(doFilter)
         , fDoTrans(doTrans)
         , fDoScale(doScale) {
@@ -49,7 +56,7 @@ public:
         bm.allocN32Pixels(kWidth, kHeight, true);
         bm.eraseColor(SK_ColorWHITE);
 
-        create_gradient(&bm);
+        create_gradient(&bm, doAlpha);
 
         fPaint.setShader(SkShader::MakeBitmapShader(bm, xTile, yTile));
 
@@ -70,6 +77,10 @@ public:
         if (doScale) {
             fName.append("_scale");
         }
+
+        if (doAlpha) {
+            fName.append("_alpha");
+        }
     }
 
 protected:
@@ -129,3 +140,6 @@ DEF_BENCH(return new ConstXTileBench(SkShader::kClamp_TileMode, SkShader::kClamp
 DEF_BENCH(return new ConstXTileBench(SkShader::kRepeat_TileMode, SkShader::kRepeat_TileMode, true, true, false))
 //DEF_BENCH(return new ConstXTileBench(SkShader::kClamp_TileMode, SkShader::kClamp_TileMode, true, true, true))
 DEF_BENCH(return new ConstXTileBench(SkShader::kMirror_TileMode, SkShader::kMirror_TileMode, true, true, false))
+
+DEF_BENCH(return new ConstXTileBench(SkShader::kClamp_TileMode, SkShader::kClamp_TileMode, false, false, false, true))
+DEF_BENCH(return new ConstXTileBench(SkShader::kRepeat_TileMode, SkShader::kRepeat_TileMode, true, false, false, true))
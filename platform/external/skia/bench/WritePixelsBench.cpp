@@ -8,7 +8,9 @@
 #include "Benchmark.h"
 #include "SkBitmap.h"
 #include "SkCanvas.h"
+#include "SkColorSpace.h"
 #include "SkString.h"
+#include "SkSurface.h"
 
 class WritePixelsBench : public Benchmark {
 public:
@@ -70,7 +72,47 @@ private:
     typedef Benchmark INHERITED;
 };
 
+// Writes a whole large F16 image into an 8888 surface, converting it to sRGB. Conversions this
+// large are split into tiles converted in parallel (see --threads).
+class WritePixelsConvertBench : public Benchmark {
+public:
+    WritePixelsConvertBench() {}
+
+protected:
+    const char* onGetName() override {
+        return "writepix_convert_f16_8888";
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        fSrc.allocPixels(SkImageInfo::Make(kSize, kSize, kRGBA_F16_SkColorType,
+                                           kPremul_SkAlphaType, SkColorSpace::MakeSRGBLinear()));
+        fSrc.eraseColor(0x80336699);
+        fSurface = SkSurface::MakeRaster(SkImageInfo::Make(kSize, kSize, kRGBA_8888_SkColorType,
+                                                           kPremul_SkAlphaType,
+                                                           SkColorSpace::MakeSRGB()));
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int loop = 0; loop < loops; ++loop) {
+            fSurface->writePixels(fSrc.pixmap(), 0, 0);
+        }
+    }
+
+private:
+    static const int kSize = 2048;
+
+    SkBitmap         fSrc;
+    sk_sp<SkSurface> fSurface;
+
+    typedef Benchmark INHERITED;
+};
+
 //////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH(return new WritePixelsBench(kRGBA_8888_SkColorType, kPremul_SkAlphaType);)
 DEF_BENCH(return new WritePixelsBench(kRGBA_8888_SkColorType, kUnpremul_SkAlphaType);)
+DEF_BENCH(return new WritePixelsConvertBench();)
@@ -3,7 +3,6 @@ Created on May 16, 2011
 
 @author: bungeman
 '''
-import bench_util
 import getopt
 import httplib
 import itertools
@@ -31,6 +30,12 @@ FASTER = 1
 # URL prefix for the bench dashboard page. Showing recent 15 days of data.
 DASHBOARD_URL_PREFIX = 'http://go/skpdash/#15'
 
+# Default slowdown, as a fraction, that nanobench JSON comparisons must exceed.
+DEFAULT_JSON_THRESHOLD = 0.05
+
+# Results with more than this fraction of outlier samples are too noisy to judge.
+MAX_OUTLIER_FRACTION = 0.2
+
 def usage():
     """Prints simple usage information."""
 
@@ -43,6 +48,12 @@ def usage():
     print '   See bench_expectations_<builder>.txt for data format / examples.'
     print '-r <revision> the git commit hash or svn revision for checking '
     print '   bench values.'
+    print ''
+    print 'Or, to compare two nanobench --outResultsFile runs:'
+    print '-p <file> nanobench JSON results to compare against.'
+    print '-c <file> nanobench JSON results to check.'
+    print '-t <fraction> slowdown that counts as a regression. Defaults to %s.' % (
+        DEFAULT_JSON_THRESHOLD)
 
 
 class Label:
@@ -190,11 +201,83 @@ def check_expectations(lines, expectations, key_suffix):
         exit(1)
 
 
+def read_nanobench_json(filename):
+    """Reads nanobench --outResultsFile output.
+
+    Returns:
+      a dictionary mapping (bench, config) to that config's result dictionary.
+    """
+    results = {}
+    for bench, configs in json.load(open(filename))['results'].items():
+        for config, result in configs.items():
+            if isinstance(result, dict):
+                results[(bench, config)] = result
+    return results
+
+def median_interval(result):
+    """Returns the (low, high) 95% confidence interval of a result's median.
+
+    Results from nanobench builds that predate confidence intervals only have
+    min_ms, which is used as a zero-width interval.
+    """
+    if 'median_ci_low_ms' in result and 'median_ci_high_ms' in result:
+        return result['median_ci_low_ms'], result['median_ci_high_ms']
+    return result['min_ms'], result['min_ms']
+
+def outlier_fraction(result):
+    """Returns the fraction of a result's samples flagged as outliers."""
+    outliers = result.get('outliers', [])
+    if not outliers:
+        return 0.0
+    return float(sum(1 for o in outliers if o)) / len(outliers)
+
+def check_json_regressions(previous, current, threshold):
+    """Compares two nanobench JSON results and exits with 1 on regressions.
+
+    A bench regressed only if the low end of its current median confidence
+    interval is above the high end of the previous one, by more than threshold.
+    Overlapping intervals are noise. Results with too many outliers on either
+    side are listed as noisy instead of being judged.
+    """
+    regressions = []
+    noisy = []
+    for key, result in sorted(current.items()):
+        if key not in previous or 'min_ms' not in result:
+            continue
+        before = previous[key]
+        if 'min_ms' not in before:
+            continue
+        if (outlier_fraction(result) > MAX_OUTLIER_FRACTION or
+            outlier_fraction(before) > MAX_OUTLIER_FRACTION):
+            noisy.append('%s %s' % key)
+            continue
+        _, before_high = median_interval(before)
+        low, _ = median_interval(result)
+        if before_high > 0 and low > before_high * (1 + threshold):
+            regressions.append((low / before_high,
+                                'Bench %s %s slower: [%s, %s] ms vs [%s, %s] ms.' % (
+                                    key[0], key[1],
+                                    low, median_interval(result)[1],
+                                    median_interval(before)[0], before_high)))
+
+    if noisy:
+        print '%d benches too noisy to compare:' % len(noisy)
+        for name in noisy:
+            print '  ' + name
+    if regressions:
+        regressions.sort(reverse=True)
+        sys.stderr.write('\n'.join(
+            ['Exception:',
+             '%d benches got slower (sorted by %% difference):' % len(regressions)] +
+            [message for _, message in regressions] + ['\n']))
+        exit(1)
+
+
 def main():
     """Parses command line and checks bench expectations."""
     try:
         opts, _ = getopt.getopt(sys.argv[1:],
-                                "a:b:d:e:r:",
+                                "a:b:c:d:e:p:r:t:",
                                 "default-setting=")
     except getopt.GetoptError, err:
         print str(err)
@@ -206,6 +289,9 @@ def main():
     rep = '25th'  # bench representation algorithm, default to 25th
     rev = None  # git commit hash or svn revision number
     bot = None
+    previous_json = None
+    current_json = None
+    threshold = DEFAULT_JSON_THRESHOLD
 
     try:
         for option, value in opts:
@@ -213,12 +299,18 @@ def main():
                 rep = value
             elif option == "-b":
                 bot = value
+            elif option == "-c":
+                current_json = value
             elif option == "-d":
                 directory = value
             elif option == "-e":
                 read_expectations(bench_expectations, value)
+            elif option == "-p":
+                previous_json = value
             elif option == "-r":
                 rev = value
+            elif option == "-t":
+                threshold = float(value)
             else:
                 usage()
                 assert False, "unhandled option"
@@ -226,12 +318,22 @@ def main():
         usage()
         sys.exit(2)
 
+    if previous_json is not None or current_json is not None:
+        if previous_json is None or current_json is None:
+            usage()
+            sys.exit(2)
+        check_json_regressions(read_nanobench_json(previous_json),
+                               read_nanobench_json(current_json), threshold)
+        return
+
     if directory is None or bot is None or rev is None:
         usage()
         sys.exit(2)
 
     platform_and_alg = bot + '-' + rep
 
+    import bench_util
+
     data_points = bench_util.parse_skp_bench_data(directory, rev, rep)
 
     bench_dict = create_bench_dict(data_points)
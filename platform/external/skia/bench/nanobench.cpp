@@ -48,6 +48,10 @@
 #include "Stats.h"
 #include "ios_utils.h"
 
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <stdlib.h>
 #include <thread>
 
@@ -134,6 +138,14 @@ DEFINE_string(benchType,  "",
 
 DEFINE_bool(forceRasterPipeline, false, "sets gSkForceRasterPipelineBlitter");
 
+DEFINE_string(cores, "", "Pin benches to these CPU cores.  "
+                         "Without --concurrentBenches only the first one is used.");
+DEFINE_bool(concurrentBenches, false,
+            "Run CPU benches concurrently, each pinned to its own core from --cores.  "
+            "GPU benches still run alone.");
+DEFINE_bool(hwCounters, false,
+            "Record instructions and cache misses per loop, where perf_event_open is available.");
+
 static double now_ms() { return SkTime::GetNSecs() * 1e-6; }
 
 static SkString humanize(double ms) {
@@ -237,12 +249,16 @@ struct GPUTarget : public Target {
 
 #endif
 
-static double time(int loops, Benchmark* bench, Target* target) {
+static double time(int loops, Benchmark* bench, Target* target,
+                   sk_tools::HardwareCounters* counters = nullptr) {
     SkCanvas* canvas = target->getCanvas();
     if (canvas) {
         canvas->clear(SK_ColorWHITE);
     }
     bench->preDraw(canvas);
+    if (counters) {
+        counters->start();
+    }
     double start = now_ms();
     canvas = target->beginTiming(canvas);
     bench->draw(loops, canvas);
@@ -251,6 +267,9 @@ static double time(int loops, Benchmark* bench, Target* target) {
     }
     target->endTiming();
     double elapsed = now_ms() - start;
+    if (counters) {
+        counters->stop();
+    }
     bench->postDraw(canvas);
     return elapsed;
 }
@@ -1116,6 +1135,315 @@ private:
     int fCurrentAnimSKP;
 };
 
+// Runs one bench on each config that suits it, logging results as it goes.
+// Returns how many configs it ran.
+static int run_bench(Benchmark* bench, const SkTArray<Config>& configs,
+                     const BufferedResultsWriter& options, ResultsWriter* log,
+                     double overhead, bool* warmedUp) {
+    int ran = 0;
+    if (!configs.empty()) {
+        log->bench(bench->getUniqueName(), bench->getSize().fX, bench->getSize().fY);
+        bench->delayedSetup();
+    }
+    for (int i = 0; i < configs.count(); ++i) {
+        Target* target = is_enabled(bench, configs[i]);
+        if (!target) {
+            continue;
+        }
+
+        // During HWUI output this canvas may be nullptr.
+        SkCanvas* canvas = target->getCanvas();
+        const char* config = target->config.name.c_str();
+
+        if (FLAGS_pre_log || FLAGS_dryRun) {
+            SkDebugf("Running %s\t%s\n"
+                     , bench->getUniqueName()
+                     , config);
+            if (FLAGS_dryRun) {
+                continue;
+            }
+        }
+
+        TRACE_EVENT2("skia", "Benchmark", "name", TRACE_STR_COPY(bench->getUniqueName()),
+                                          "config", TRACE_STR_COPY(config));
+
+        target->setup();
+        bench->perCanvasPreDraw(canvas);
+
+        int maxFrameLag;
+        int loops = target->needsFrameTiming(&maxFrameLag)
+            ? setup_gpu_bench(target, bench, maxFrameLag)
+            : setup_cpu_bench(overhead, target, bench);
+
+        if (kFailedLoops == loops) {
+            // Can't be timed.  A warning note has already been printed.
+            cleanup_run(target);
+            continue;
+        }
+
+        if (!*warmedUp && FLAGS_ms < 1000) {
+            // Run the first bench for 1000ms to warm up the nanobench if FLAGS_ms < 1000.
+            // Otherwise, the first few benches' measurements will be inaccurate.
+            auto stop = now_ms() + 1000;
+            do {
+                time(loops, bench, target);
+            } while (now_ms() < stop);
+        }
+        *warmedUp = true;
+
+        SkTArray<double> samples, instructions, cacheMisses;
+        std::unique_ptr<sk_tools::HardwareCounters> counters;
+        if (FLAGS_hwCounters) {
+            counters.reset(new sk_tools::HardwareCounters);
+            if (!counters->isValid()) {
+                counters.reset();
+            }
+        }
+        auto sample = [&] {
+            samples.push_back(time(loops, bench, target, counters.get()) / loops);
+            if (counters) {
+                instructions.push_back((double)counters->instructions() / loops);
+                cacheMisses .push_back((double)counters->cacheMisses()  / loops);
+            }
+        };
+        if (FLAGS_ms) {
+            auto stop = now_ms() + FLAGS_ms;
+            do {
+                sample();
+            } while (now_ms() < stop);
+        } else {
+            for (int s = 0; s < FLAGS_samples; s++) {
+                sample();
+            }
+        }
+
+#if SK_SUPPORT_GPU
+        SkTArray<SkString> keys;
+        SkTArray<double> values;
+        // Non-rendering benches may report the stats of GPU contexts they make themselves.
+        bool gpuStatsDump = FLAGS_gpuStatsDump &&
+                            (Benchmark::kGPU_Backend == configs[i].backend ||
+                             Benchmark::kNonRendering_Backend == configs[i].backend);
+        if (gpuStatsDump) {
+            // TODO cache stats
+            bench->getGpuStats(canvas, &keys, &values);
+        }
+#endif
+
+        bench->perCanvasPostDraw(canvas);
+
+        if (Benchmark::kNonRendering_Backend != target->config.backend &&
+            !FLAGS_writePath.isEmpty() && FLAGS_writePath[0]) {
+            SkString pngFilename = SkOSPath::Join(FLAGS_writePath[0], config);
+            pngFilename = SkOSPath::Join(pngFilename.c_str(), bench->getUniqueName());
+            pngFilename.append(".png");
+            write_canvas_png(target, pngFilename);
+        }
+
+        Stats stats(samples);
+        log->config(config);
+        log->configOption("name", bench->getName());
+        options.replay(log);
+        target->fillOptions(log);
+        log->metric("min_ms",    stats.min);
+        log->metric("median_ms", stats.median);
+        log->metric("median_ci_low_ms",  stats.medianLow);
+        log->metric("median_ci_high_ms", stats.medianHigh);
+        log->metrics("samples",    samples);
+        SkTArray<bool> outliers(samples.count());
+        for (double s : samples) {
+            outliers.push_back(stats.isOutlier(s));
+        }
+        log->flags("outliers", outliers);
+        if (counters) {
+            log->metric("instructions_per_loop", Stats(instructions).median);
+            log->metric("cache_misses_per_loop", Stats(cacheMisses).median);
+        }
+#if SK_SUPPORT_GPU
+        if (gpuStatsDump) {
+            // dump to json, only SKPBench and mock context benches return valid keys / values
+            SkASSERT(keys.count() == values.count());
+            for (int i = 0; i < keys.count(); i++) {
+                log->metric(keys[i].c_str(), values[i]);
+            }
+        }
+#endif
+
+        ran++;
+
+        if (kAutoTuneLoops != FLAGS_loops) {
+            if (configs.count() == 1) {
+                config = ""; // Only print the config if we run the same bench on more than one.
+            }
+            SkDebugf("%4d/%-4dMB\t%s\t%s\n"
+                     , sk_tools::getCurrResidentSetSizeMB()
+                     , sk_tools::getMaxResidentSetSizeMB()
+                     , bench->getUniqueName()
+                     , config);
+        } else if (FLAGS_quiet) {
+            const char* mark = " ";
+            const double stddev_percent = 100 * sqrt(stats.var) / stats.mean;
+            if (stddev_percent >  5) mark = "?";
+            if (stddev_percent > 10) mark = "!";
+
+            SkDebugf("%10.2f %s\t%s\t%s\n",
+                     stats.median*1e3, mark, bench->getUniqueName(), config);
+        } else if (FLAGS_csv) {
+            const double stddev_percent = 100 * sqrt(stats.var) / stats.mean;
+            SkDebugf("%g,%g,%g,%g,%g,%s,%s\n"
+                     , stats.min
+                     , stats.median
+                     , stats.mean
+                     , stats.max
+                     , stddev_percent
+                     , config
+                     , bench->getUniqueName()
+                     );
+        } else {
+            const char* format = "%4d/%-4dMB\t%d\t%s\t%s\t%s\t%s\t%.0f%%\t%s\t%s\t%s\n";
+            const double stddev_percent = 100 * sqrt(stats.var) / stats.mean;
+            SkDebugf(format
+                    , sk_tools::getCurrResidentSetSizeMB()
+                    , sk_tools::getMaxResidentSetSizeMB()
+                    , loops
+                    , HUMANIZE(stats.min)
+                    , HUMANIZE(stats.median)
+                    , HUMANIZE(stats.mean)
+                    , HUMANIZE(stats.max)
+                    , stddev_percent
+                    , FLAGS_ms ? to_string(samples.count()).c_str() : stats.plot.c_str()
+                    , config
+                    , bench->getUniqueName()
+                    );
+        }
+
+#if SK_SUPPORT_GPU
+        if (FLAGS_gpuStats && Benchmark::kGPU_Backend == configs[i].backend) {
+            target->dumpStats();
+        }
+#endif
+
+        if (FLAGS_verbose) {
+            SkDebugf("Samples:  ");
+            for (int i = 0; i < samples.count(); i++) {
+                SkDebugf("%s  ", HUMANIZE(samples[i]));
+            }
+            SkDebugf("%s\n", bench->getUniqueName());
+        }
+        cleanup_run(target);
+    }
+    return ran;
+}
+
+static void flush_every(ResultsWriter* log, int* runs, int ran) {
+    for (int i = 0; i < ran; i++) {
+        if ((*runs)++ % FLAGS_flushEvery == 0) {
+            log->flush();
+        }
+    }
+}
+
+// Benches that only use the CPU can run alongside each other on separate cores.
+static bool runs_on_cpu(Benchmark* bench, const SkTArray<Config>& configs) {
+    for (const Config& config : configs) {
+        if (Benchmark::kRaster_Backend       != config.backend &&
+            Benchmark::kNonRendering_Backend != config.backend &&
+            bench->isSuitableFor(config.backend)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// One worker thread per core in --cores, each pinned to its core, pulling whole benches off a
+// shared queue.  Each bench logs into its own BufferedResultsWriter, which is copied into the
+// real log when the bench is done, so the JSON looks just like a serial run's.
+class ConcurrentBenchRunner {
+public:
+    ConcurrentBenchRunner(const SkCommandLineFlags::StringArray& cores, ResultsWriter* log)
+        : fLog(log) {
+        for (int i = 0; i < cores.count(); i++) {
+            int core = atoi(cores[i]);
+            fThreads.emplace_back([this, core] { this->work(core); });
+        }
+    }
+
+    // Finishes every bench added so far.
+    ~ConcurrentBenchRunner() {
+        {
+            std::lock_guard<std::mutex> lock(fMutex);
+            fDone = true;
+        }
+        fCond.notify_all();
+        for (std::thread& thread : fThreads) {
+            thread.join();
+        }
+    }
+
+    // Blocks while every worker already has a bench waiting, so that benches (and SKPs) are not
+    // all loaded up front.
+    void add(std::unique_ptr<Benchmark> bench, const SkTArray<Config>& configs,
+             std::shared_ptr<BufferedResultsWriter> options, double overhead) {
+        std::shared_ptr<Benchmark> shared(bench.release());
+        std::unique_lock<std::mutex> lock(fMutex);
+        fCond.wait(lock, [this] { return fJobs.size() < fThreads.size(); });
+        fJobs.push_back([shared, &configs, options, overhead](bool* warmedUp,
+                                                              BufferedResultsWriter* results) {
+            return run_bench(shared.get(), configs, *options, results, overhead, warmedUp);
+        });
+        fPending++;
+        fCond.notify_all();
+    }
+
+    // Waits for every bench added so far to finish and be logged.
+    void wait() {
+        std::unique_lock<std::mutex> lock(fMutex);
+        fCond.wait(lock, [this] { return fPending == 0; });
+    }
+
+private:
+    typedef std::function<int(bool* warmedUp, BufferedResultsWriter*)> Job;
+
+    void work(int core) {
+        if (!sk_tools::pinCurrentThreadToCore(core)) {
+            SkDebugf("WARNING: could not pin to core %d.\n", core);
+        }
+        bool warmedUp = false;
+        for (;;) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(fMutex);
+                fCond.wait(lock, [this] { return fDone || !fJobs.empty(); });
+                if (fJobs.empty()) {
+                    return;
+                }
+                job = std::move(fJobs.front());
+                fJobs.pop_front();
+            }
+            fCond.notify_all();
+
+            BufferedResultsWriter results;
+            int ran = job(&warmedUp, &results);
+            job = nullptr;  // Deletes the bench here, on its own core.
+
+            std::lock_guard<std::mutex> lock(fMutex);
+            results.replay(fLog);
+            flush_every(fLog, &fRuns, ran);
+            fPending--;
+            fCond.notify_all();
+        }
+    }
+
+    ResultsWriter*           fLog;
+    std::vector<std::thread> fThreads;
+    std::mutex               fMutex;
+    std::condition_variable  fCond;
+    std::deque<Job>          fJobs;
+    int                      fPending = 0;
+    int                      fRuns    = 0;
+    bool                     fDone    = false;
+};
+
 // Some runs (mostly, Valgrind) are so slow that the bot framework thinks we've hung.
 // This prints something every once in a while so that it knows we're still working.
 static void start_keepalive() {
@@ -1195,8 +1523,6 @@ int main(int argc, char** argv) {
     const double overhead = estimate_timer_overhead();
     SkDebugf("Timer overhead: %s\n", HUMANIZE(overhead));
 
-    SkTArray<double> samples;
-
     if (kAutoTuneLoops != FLAGS_loops) {
         SkDebugf("Fixed number of loops; times would only be misleading so we won't print them.\n");
     } else if (FLAGS_quiet) {
@@ -1229,7 +1555,22 @@ int main(int argc, char** argv) {
         gSkForceRasterPipelineBlitter = true;
     }
 
+    // Benches run on this thread are pinned to the first of --cores, if any.
+    if (!FLAGS_cores.isEmpty() && !FLAGS_concurrentBenches &&
+        !sk_tools::pinCurrentThreadToCore(atoi(FLAGS_cores[0]))) {
+        SkDebugf("WARNING: could not pin to core %s.\n", FLAGS_cores[0]);
+    }
+    std::unique_ptr<ConcurrentBenchRunner> concurrent;
+    if (FLAGS_concurrentBenches) {
+        if (FLAGS_cores.isEmpty()) {
+            SkDebugf("ERROR: --concurrentBenches needs --cores.\n");
+            return 1;
+        }
+        concurrent.reset(new ConcurrentBenchRunner(FLAGS_cores, log.get()));
+    }
+
     int runs = 0;
+    bool warmedUp = false;
     BenchmarkStream benchStream;
     while (Benchmark* b = benchStream.next()) {
         std::unique_ptr<Benchmark> bench(b);
@@ -1237,171 +1578,21 @@ int main(int argc, char** argv) {
             continue;
         }
 
-        if (!configs.empty()) {
-            log->bench(bench->getUniqueName(), bench->getSize().fX, bench->getSize().fY);
-            bench->delayedSetup();
-        }
-        for (int i = 0; i < configs.count(); ++i) {
-            Target* target = is_enabled(b, configs[i]);
-            if (!target) {
-                continue;
-            }
-
-            // During HWUI output this canvas may be nullptr.
-            SkCanvas* canvas = target->getCanvas();
-            const char* config = target->config.name.c_str();
-
-            if (FLAGS_pre_log || FLAGS_dryRun) {
-                SkDebugf("Running %s\t%s\n"
-                         , bench->getUniqueName()
-                         , config);
-                if (FLAGS_dryRun) {
-                    continue;
-                }
-            }
+        auto options = std::make_shared<BufferedResultsWriter>();
+        benchStream.fillCurrentOptions(options.get());
 
-            TRACE_EVENT2("skia", "Benchmark", "name", TRACE_STR_COPY(bench->getUniqueName()),
-                                              "config", TRACE_STR_COPY(config));
-
-            target->setup();
-            bench->perCanvasPreDraw(canvas);
-
-            int maxFrameLag;
-            int loops = target->needsFrameTiming(&maxFrameLag)
-                ? setup_gpu_bench(target, bench.get(), maxFrameLag)
-                : setup_cpu_bench(overhead, target, bench.get());
-
-            if (kFailedLoops == loops) {
-                // Can't be timed.  A warning note has already been printed.
-                cleanup_run(target);
-                continue;
-            }
-
-            if (runs == 0 && FLAGS_ms < 1000) {
-                // Run the first bench for 1000ms to warm up the nanobench if FLAGS_ms < 1000.
-                // Otherwise, the first few benches' measurements will be inaccurate.
-                auto stop = now_ms() + 1000;
-                do {
-                    time(loops, bench.get(), target);
-                } while (now_ms() < stop);
-            }
-
-            if (FLAGS_ms) {
-                samples.reset();
-                auto stop = now_ms() + FLAGS_ms;
-                do {
-                    samples.push_back(time(loops, bench.get(), target) / loops);
-                } while (now_ms() < stop);
-            } else {
-                samples.reset(FLAGS_samples);
-                for (int s = 0; s < FLAGS_samples; s++) {
-                    samples[s] = time(loops, bench.get(), target) / loops;
-                }
-            }
-
-#if SK_SUPPORT_GPU
-            SkTArray<SkString> keys;
-            SkTArray<double> values;
-            bool gpuStatsDump = FLAGS_gpuStatsDump && Benchmark::kGPU_Backend == configs[i].backend;
-            if (gpuStatsDump) {
-                // TODO cache stats
-                bench->getGpuStats(canvas, &keys, &values);
-            }
-#endif
-
-            bench->perCanvasPostDraw(canvas);
-
-            if (Benchmark::kNonRendering_Backend != target->config.backend &&
-                !FLAGS_writePath.isEmpty() && FLAGS_writePath[0]) {
-                SkString pngFilename = SkOSPath::Join(FLAGS_writePath[0], config);
-                pngFilename = SkOSPath::Join(pngFilename.c_str(), bench->getUniqueName());
-                pngFilename.append(".png");
-                write_canvas_png(target, pngFilename);
-            }
-
-            Stats stats(samples);
-            log->config(config);
-            log->configOption("name", bench->getName());
-            benchStream.fillCurrentOptions(log.get());
-            target->fillOptions(log.get());
-            log->metric("min_ms",    stats.min);
-            log->metrics("samples",    samples);
-#if SK_SUPPORT_GPU
-            if (gpuStatsDump) {
-                // dump to json, only SKPBench currently returns valid keys / values
-                SkASSERT(keys.count() == values.count());
-                for (int i = 0; i < keys.count(); i++) {
-                    log->metric(keys[i].c_str(), values[i]);
-                }
-            }
-#endif
-
-            if (runs++ % FLAGS_flushEvery == 0) {
-                log->flush();
-            }
-
-            if (kAutoTuneLoops != FLAGS_loops) {
-                if (configs.count() == 1) {
-                    config = ""; // Only print the config if we run the same bench on more than one.
-                }
-                SkDebugf("%4d/%-4dMB\t%s\t%s\n"
-                         , sk_tools::getCurrResidentSetSizeMB()
-                         , sk_tools::getMaxResidentSetSizeMB()
-                         , bench->getUniqueName()
-                         , config);
-            } else if (FLAGS_quiet) {
-                const char* mark = " ";
-                const double stddev_percent = 100 * sqrt(stats.var) / stats.mean;
-                if (stddev_percent >  5) mark = "?";
-                if (stddev_percent > 10) mark = "!";
-
-                SkDebugf("%10.2f %s\t%s\t%s\n",
-                         stats.median*1e3, mark, bench->getUniqueName(), config);
-            } else if (FLAGS_csv) {
-                const double stddev_percent = 100 * sqrt(stats.var) / stats.mean;
-                SkDebugf("%g,%g,%g,%g,%g,%s,%s\n"
-                         , stats.min
-                         , stats.median
-                         , stats.mean
-                         , stats.max
-                         , stddev_percent
-                         , config
-                         , bench->getUniqueName()
-                         );
-            } else {
-                const char* format = "%4d/%-4dMB\t%d\t%s\t%s\t%s\t%s\t%.0f%%\t%s\t%s\t%s\n";
-                const double stddev_percent = 100 * sqrt(stats.var) / stats.mean;
-                SkDebugf(format
-                        , sk_tools::getCurrResidentSetSizeMB()
-                        , sk_tools::getMaxResidentSetSizeMB()
-                        , loops
-                        , HUMANIZE(stats.min)
-                        , HUMANIZE(stats.median)
-                        , HUMANIZE(stats.mean)
-                        , HUMANIZE(stats.max)
-                        , stddev_percent
-                        , FLAGS_ms ? to_string(samples.count()).c_str() : stats.plot.c_str()
-                        , config
-                        , bench->getUniqueName()
-                        );
-            }
-
-#if SK_SUPPORT_GPU
-            if (FLAGS_gpuStats && Benchmark::kGPU_Backend == configs[i].backend) {
-                target->dumpStats();
-            }
-#endif
-
-            if (FLAGS_verbose) {
-                SkDebugf("Samples:  ");
-                for (int i = 0; i < samples.count(); i++) {
-                    SkDebugf("%s  ", HUMANIZE(samples[i]));
-                }
-                SkDebugf("%s\n", bench->getUniqueName());
-            }
-            cleanup_run(target);
+        if (concurrent && runs_on_cpu(bench.get(), configs)) {
+            concurrent->add(std::move(bench), configs, std::move(options), overhead);
+            continue;
+        }
+        if (concurrent) {
+            // Everything else has the machine to itself.
+            concurrent->wait();
         }
+        int ran = run_bench(bench.get(), configs, *options, log.get(), overhead, &warmedUp);
+        flush_every(log.get(), &runs, ran);
     }
+    concurrent.reset();
 
     SkGraphics::PurgeAllCaches();
 
@@ -154,6 +154,23 @@ SK_API void sk_canvas_draw_image_rect(sk_canvas_t*, const sk_image_t*,
 SK_API void sk_canvas_draw_picture(sk_canvas_t*, const sk_picture_t*,
                                    const sk_matrix_t*, const sk_paint_t*);
 
+/**
+    Replay a buffer of draw records onto the canvas, in order, as if each
+    had been made as its own sk_canvas_t call.  This crosses into Skia
+    once for the whole buffer, rather than once per draw.
+
+    @param sk_draw_record_t[] The commands to draw, in caller memory.
+    @param int count The number of records.
+    @param sk_paint_t*[] The paints the records refer to by index.
+    @param int paintCount The number of paints.
+
+    Replay stops at the first record with an unknown op, a paint index
+    out of range, or a missing object.  Returns the number of records
+    replayed, which is count if all of them were valid.
+*/
+SK_API int sk_canvas_draw_records(sk_canvas_t*, const sk_draw_record_t records[], int count,
+                                  const sk_paint_t* const paints[], int paintCount);
+
 SK_C_PLUS_PLUS_END_GUARD
 
 #endif
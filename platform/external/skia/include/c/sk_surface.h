@@ -49,6 +49,30 @@ SK_API sk_surface_t* sk_surface_new_raster_direct(const sk_imageinfo_t*,
                                                   void* pixels, size_t rowBytes,
                                                   const sk_surfaceprops_t* props);
 
+/**
+    Called when a surface made by sk_surface_new_raster_direct_release()
+    no longer needs its pixels.
+*/
+typedef void (*sk_surface_raster_release_proc)(void* pixels, void* context);
+
+/**
+    Like sk_surface_new_raster_direct(), but rather than having to
+    outlast the surface, the pixels are handed back to the caller with
+    releaseProc(pixels, context) once the surface and anything made from
+    it are done with them.  The pixels are never copied.
+
+    @param sk_surface_raster_release_proc releaseProc (may be NULL)
+                                          Called when the pixels are no
+                                          longer used.  If the surface
+                                          cannot be created, it is
+                                          called right away.
+*/
+SK_API sk_surface_t* sk_surface_new_raster_direct_release(const sk_imageinfo_t*,
+                                                          void* pixels, size_t rowBytes,
+                                                          sk_surface_raster_release_proc releaseProc,
+                                                          void* context,
+                                                          const sk_surfaceprops_t* props);
+
 /**
     Decrement the reference count. If the reference count is 1 before
     the decrement, then release both the memory holding the
@@ -263,6 +263,44 @@ typedef enum {
     LUMINOSITY_SK_XFERMODE_MODE,
 } sk_xfermode_mode_t;
 
+/**
+    The operations a sk_draw_record_t can hold, and the fields of the
+    record each one reads.  Each behaves just like the sk_canvas_t call
+    it is named after.
+*/
+typedef enum {
+    SAVE_SK_DRAW_OP,            // (no fields)
+    RESTORE_SK_DRAW_OP,         // (no fields)
+    TRANSLATE_SK_DRAW_OP,       // point = (dx, dy)
+    SCALE_SK_DRAW_OP,           // point = (sx, sy)
+    CLIP_RECT_SK_DRAW_OP,       // rect
+    DRAW_PAINT_SK_DRAW_OP,      // paint
+    DRAW_RECT_SK_DRAW_OP,       // rect, paint
+    DRAW_OVAL_SK_DRAW_OP,       // rect, paint
+    DRAW_CIRCLE_SK_DRAW_OP,     // point = center, radius, paint
+    DRAW_PATH_SK_DRAW_OP,       // object = sk_path_t*, paint
+    DRAW_IMAGE_SK_DRAW_OP,      // object = sk_image_t*, point = top/left, paint (may be -1)
+    DRAW_IMAGE_RECT_SK_DRAW_OP, // object = sk_image_t*, src, rect = dst, paint (may be -1)
+} sk_draw_op_t;
+
+/**
+    One command in a buffer of them, for sk_canvas_draw_records().  The
+    records, and the paints they refer to, stay in the caller's memory;
+    nothing is copied.
+
+    paint is an index into the array of paints passed alongside the
+    records, so a handful of paints can be shared by many records.
+*/
+typedef struct {
+    sk_draw_op_t    op;
+    int32_t         paint;
+    const void*     object;
+    sk_point_t      point;
+    float           radius;
+    sk_rect_t       rect;
+    sk_rect_t       src;
+} sk_draw_record_t;
+
 //////////////////////////////////////////////////////////////////////////////////////////
 
 SK_C_PLUS_PLUS_END_GUARD
@@ -42,6 +42,8 @@ public:
     // The backing canvas will become invalid (and this entry point will return
     // null) once 'detach' is called.
     // Note: ownership of the SkCanvas is not transfered via this call.
+    // The ops recorded through it are allocated from memory that belongs to this recording, and
+    // that is freed along with the SkDeferredDisplayList.
     SkCanvas* getCanvas();
 
     std::unique_ptr<SkDeferredDisplayList> detach();
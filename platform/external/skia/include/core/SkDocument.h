@@ -110,6 +110,19 @@ public:
          *  quality setting.
          */
         int fEncodingQuality = 101;
+
+        /**
+         *  The zlib compression level of page contents and images: 0 is no compression, 1 is
+         *  fastest, 9 is smallest.  The default, -1, is zlib's default level.
+         */
+        int fCompressionLevel = -1;
+
+        /**
+         *  If greater than 1, page contents and images are compressed in 128KB chunks, up to
+         *  this many at a time on SkExecutor::GetDefault().  The output is slightly larger, and
+         *  the same for any number of threads.
+         */
+        int fCompressionThreads = 1;
     };
 
     /**
@@ -366,6 +366,17 @@ public:
         fIsVolatile = isVolatile;
     }
 
+    /** Shares the storage of SkPath with every other interned SkPath that has the same verbs,
+        points, and conic weights, so that many copies of one shape, such as an icon loaded
+        repeatedly, are stored once. Interned storage is allocated to fit, with no room to grow.
+
+        Interning hashes the storage of SkPath; intern SkPath that are built once and kept.
+        Modifying SkPath afterwards makes it a private copy, leaving other interned SkPath
+        unchanged. Interned storage no longer used by any SkPath is freed as more SkPath are
+        interned, and by SkGraphics::PurgeAllCaches().
+    */
+    void intern();
+
     /** Test if line between SkPoint pair is degenerate.
         Line with no length or that moves a very short distance is degenerate; it is
         treated as a point.
@@ -1644,7 +1655,7 @@ private:
     size_t writeToMemoryAsRRect(void* buffer) const;
     size_t readAsRRect(const void*, size_t);
     size_t readFromMemory_LE3(const void*, size_t);
-    size_t readFromMemory_EQ4(const void*, size_t);
+    size_t readFromMemory_EQ4Or5(const void*, size_t);
 
     friend class Iter;
     friend class SkPathPriv;
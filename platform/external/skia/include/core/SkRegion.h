@@ -436,6 +436,9 @@ private:
     // (inside ComputeRunBounds).
     bool setRuns(RunType runs[], int count);
 
+    // Like setRuns(), but takes ownership of head, whose first count runs were written in place.
+    bool adoptRuns(RunHead* head, int count);
+
     int count_runtype_values(int* itop, int* ibot) const;
 
     bool isValid() const;
@@ -42,4 +42,11 @@ struct SkFontMgr_Android_CustomFonts {
 /** Create a font manager for Android. If 'custom' is NULL, use only system fonts. */
 SK_API sk_sp<SkFontMgr> SkFontMgr_New_Android(const SkFontMgr_Android_CustomFonts* custom);
 
+/** Like SkFontMgr_New_Android(custom), but keeps what it learns from scanning the font files in an
+ *  index file at 'indexPath', so that later font managers only have to scan the font files that
+ *  are new or changed. If 'indexPath' is NULL, no index is kept.
+ */
+SK_API sk_sp<SkFontMgr> SkFontMgr_New_Android(const SkFontMgr_Android_CustomFonts* custom,
+                                              const char* indexPath);
+
 #endif // SkFontMgr_android_DEFINED
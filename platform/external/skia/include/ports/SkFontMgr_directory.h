@@ -18,4 +18,10 @@ class SkFontMgr;
  */
 SK_API sk_sp<SkFontMgr> SkFontMgr_New_Custom_Directory(const char* dir);
 
+/** Like SkFontMgr_New_Custom_Directory(dir), but keeps what it learns from scanning the font files
+ *  in an index file at 'indexPath', so that later font managers only have to scan the font files
+ *  that are new or changed. If 'indexPath' is NULL, no index is kept.
+ */
+SK_API sk_sp<SkFontMgr> SkFontMgr_New_Custom_Directory(const char* dir, const char* indexPath);
+
 #endif // SkFontMgr_directory_DEFINED
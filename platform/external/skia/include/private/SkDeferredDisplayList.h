@@ -11,6 +11,7 @@
 #include "SkSurfaceCharacterization.h"
 
 #if SK_SUPPORT_GPU
+#include "GrOpArena.h"
 #include "GrOpList.h"
 #endif
 
@@ -72,6 +73,8 @@ private:
 #else
 
 #if SK_SUPPORT_GPU
+    // The ops in 'fOpLists' were allocated from this, by the recorder's context.
+    sk_sp<GrOpArena>             fOpArena;
     SkTArray<sk_sp<GrOpList>>    fOpLists;
 #endif
     sk_sp<LazyProxyData>         fLazyProxyData;
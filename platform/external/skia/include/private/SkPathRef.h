@@ -246,6 +246,26 @@ public:
      */
     static void Rewind(sk_sp<SkPathRef>* pathRef);
 
+    /**
+     * Returns a path ref with the same contents as pathRef that is shared by every path ref
+     * interned with those contents, so identical paths (icons, glyph outlines, ...) are only stored
+     * once per process. Interned path refs are allocated to fit, with no room to grow; editing a
+     * path that holds one makes a private copy, as for any shared path ref. Empty path refs are
+     * returned as is.
+     */
+    static sk_sp<SkPathRef> Intern(sk_sp<SkPathRef> pathRef);
+
+    /**
+     * Drops the interned path refs that are no longer used outside of the intern table, returning
+     * how many were dropped. This also happens as the table grows.
+     */
+    static int PurgeInterned();
+
+    /**
+     * Returns the number of interned path refs and, if bytes is not null, the memory they use.
+     */
+    static int CountInterned(size_t* bytes = nullptr);
+
     ~SkPathRef();
     int countPoints() const { return fPointCnt; }
     int countVerbs() const { return fVerbCnt; }
@@ -347,6 +367,20 @@ private:
 
     void copy(const SkPathRef& ref, int additionalReserveVerbs, int additionalReservePoints);
 
+    // Copies ref into a path ref whose allocation holds exactly its verbs and points.
+    static SkPathRef* CreateCompactCopy(const SkPathRef& ref);
+
+    // Hashes the verbs, points and conic weights, for the intern table.
+    uint32_t contentHash() const;
+
+    // Like operator==, but also requires the same oval/rrect information, so either path ref can
+    // stand in for the other.
+    bool sameContents(const SkPathRef& ref) const;
+
+    size_t approximateBytesUsed() const {
+        return sizeof(SkPathRef) + this->currSize() + fConicWeights.reserved() * sizeof(SkScalar);
+    }
+
     // Doesn't read fSegmentMask, but (re)computes it from the verbs array
     unsigned computeSegmentMask() const;
 
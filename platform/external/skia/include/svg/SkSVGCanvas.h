@@ -16,9 +16,12 @@ class SkXMLWriter;
 class SK_API SkSVGCanvas {
 public:
     /**
-     *  Returns a new canvas that will generate SVG commands from its draw calls, and send
-     *  them to the provided xmlwriter. Ownership of the xmlwriter is not transfered to the canvas,
-     *  but it must stay valid during the lifetime of the returned canvas.
+     *  Returns a new canvas that will generate SVG commands from its draw calls, and write
+     *  them to the provided stream as they are made. Ownership of the stream is not transfered
+     *  to the canvas, but it must stay valid during the lifetime of the returned canvas.
+     *
+     *  Paths and images drawn more than once are written once, in <defs>, and then referenced
+     *  with <use>.
      *
      *  The canvas may buffer some drawing calls, so the output is not guaranteed to be valid
      *  or complete until the canvas instance is deleted.
@@ -419,6 +419,73 @@ void sk_canvas_draw_picture(sk_canvas_t* ccanvas, const sk_picture_t* cpicture,
     AsCanvas(ccanvas)->drawPicture(AsPicture(cpicture), matrixPtr, AsPaint(cpaint));
 }
 
+int sk_canvas_draw_records(sk_canvas_t* ccanvas, const sk_draw_record_t records[], int count,
+                           const sk_paint_t* const paints[], int paintCount) {
+    SkCanvas* canvas = AsCanvas(ccanvas);
+    for (int i = 0; i < count; ++i) {
+        const sk_draw_record_t& rec = records[i];
+
+        const SkPaint* paint = nullptr;
+        if (rec.paint >= 0) {
+            if (rec.paint >= paintCount || !paints[rec.paint]) {
+                return i;
+            }
+            paint = AsPaint(paints[rec.paint]);
+        }
+        // Only the image draws may go without a paint.
+        const bool needsPaint = rec.op >= DRAW_PAINT_SK_DRAW_OP && rec.op <= DRAW_PATH_SK_DRAW_OP;
+        const bool needsObject = rec.op >= DRAW_PATH_SK_DRAW_OP &&
+                                 rec.op <= DRAW_IMAGE_RECT_SK_DRAW_OP;
+        if ((needsPaint && !paint) || (needsObject && !rec.object)) {
+            return i;
+        }
+
+        switch (rec.op) {
+            case SAVE_SK_DRAW_OP:
+                canvas->save();
+                break;
+            case RESTORE_SK_DRAW_OP:
+                canvas->restore();
+                break;
+            case TRANSLATE_SK_DRAW_OP:
+                canvas->translate(rec.point.x, rec.point.y);
+                break;
+            case SCALE_SK_DRAW_OP:
+                canvas->scale(rec.point.x, rec.point.y);
+                break;
+            case CLIP_RECT_SK_DRAW_OP:
+                canvas->clipRect(AsRect(rec.rect));
+                break;
+            case DRAW_PAINT_SK_DRAW_OP:
+                canvas->drawPaint(*paint);
+                break;
+            case DRAW_RECT_SK_DRAW_OP:
+                canvas->drawRect(AsRect(rec.rect), *paint);
+                break;
+            case DRAW_OVAL_SK_DRAW_OP:
+                canvas->drawOval(AsRect(rec.rect), *paint);
+                break;
+            case DRAW_CIRCLE_SK_DRAW_OP:
+                canvas->drawCircle(rec.point.x, rec.point.y, rec.radius, *paint);
+                break;
+            case DRAW_PATH_SK_DRAW_OP:
+                canvas->drawPath(AsPath(*static_cast<const sk_path_t*>(rec.object)), *paint);
+                break;
+            case DRAW_IMAGE_SK_DRAW_OP:
+                canvas->drawImage(AsImage(static_cast<const sk_image_t*>(rec.object)),
+                                  rec.point.x, rec.point.y, paint);
+                break;
+            case DRAW_IMAGE_RECT_SK_DRAW_OP:
+                canvas->drawImageRect(AsImage(static_cast<const sk_image_t*>(rec.object)),
+                                      AsRect(rec.src), AsRect(rec.rect), paint);
+                break;
+            default:
+                return i;
+        }
+    }
+    return count;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////
 
 sk_surface_t* sk_surface_new_raster(const sk_imageinfo_t* cinfo,
@@ -452,6 +519,27 @@ sk_surface_t* sk_surface_new_raster_direct(const sk_imageinfo_t* cinfo, void* pi
     return (sk_surface_t*)SkSurface::MakeRasterDirect(info, pixels, rowBytes, &surfProps).release();
 }
 
+sk_surface_t* sk_surface_new_raster_direct_release(const sk_imageinfo_t* cinfo, void* pixels,
+                                                   size_t rowBytes,
+                                                   sk_surface_raster_release_proc releaseProc,
+                                                   void* context,
+                                                   const sk_surfaceprops_t* props) {
+    SkImageInfo info;
+    SkPixelGeometry geo = kUnknown_SkPixelGeometry;
+    sk_sp<SkSurface> surface;
+    if (from_c_info(*cinfo, &info) &&
+        (!props || from_c_pixelgeometry(props->pixelGeometry, &geo))) {
+        SkSurfaceProps surfProps(0, geo);
+        surface = SkSurface::MakeRasterDirectReleaseProc(info, pixels, rowBytes, releaseProc,
+                                                         context, &surfProps);
+    }
+    // Either way, the caller gets their pixels back.
+    if (!surface && releaseProc) {
+        releaseProc(pixels, context);
+    }
+    return (sk_surface_t*)surface.release();
+}
+
 void sk_surface_unref(sk_surface_t* csurf) {
     SkSafeUnref((SkSurface*)csurf);
 }
@@ -64,8 +64,19 @@ std::unique_ptr<SkCodec> SkCodec::MakeFromStream(std::unique_ptr<SkStream> strea
 
     constexpr size_t bytesToRead = MinBufferedBytesNeeded();
 
-    char buffer[bytesToRead];
-    size_t bytesRead = stream->peek(buffer, bytesToRead);
+    char storage[bytesToRead];
+    const char* buffer = storage;
+    size_t bytesRead = 0;
+    if (stream->getMemoryBase() && stream->hasPosition() && stream->hasLength()) {
+        // Sniff the format where the bytes are, rather than copying them out.
+        const size_t position = stream->getPosition();
+        if (position < stream->getLength()) {
+            buffer = static_cast<const char*>(stream->getMemoryBase()) + position;
+            bytesRead = SkTMin(bytesToRead, stream->getLength() - position);
+        }
+    } else {
+        bytesRead = stream->peek(storage, bytesToRead);
+    }
 
     // It is also possible to have a complete image less than bytesToRead bytes
     // (e.g. a 1 x 1 wbmp), meaning peek() would return less than bytesToRead.
@@ -82,7 +93,7 @@ std::unique_ptr<SkCodec> SkCodec::MakeFromStream(std::unique_ptr<SkStream> strea
         // It is possible the stream does not support peeking, but does support
         // rewinding.
         // Attempt to read() and pass the actual amount read to the decoder.
-        bytesRead = stream->read(buffer, bytesToRead);
+        bytesRead = stream->read(storage, bytesToRead);
         if (!stream->rewind()) {
             SkCodecPrintf("Encoded image data could not peek or rewind to determine format!\n");
             *outResult = kCouldNotRewind;
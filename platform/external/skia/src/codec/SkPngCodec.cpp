@@ -135,6 +135,24 @@ static inline bool is_chunk(const png_byte* chunk, const char* tag) {
 
 static inline bool process_data(png_structp png_ptr, png_infop info_ptr,
         SkStream* stream, void* buffer, size_t bufferSize, size_t length) {
+    const void* memoryBase = stream->getMemoryBase();
+    if (memoryBase && stream->hasPosition() && stream->hasLength()) {
+        // Hand libpng the bytes where they are. Advance the stream before processing each piece,
+        // just like reading it would, in case processing stops early.
+        while (length > 0) {
+            const size_t position = stream->getPosition();
+            const size_t bytesToProcess = std::min(bufferSize, length);
+            const size_t bytesSkipped = stream->skip(bytesToProcess);
+            png_process_data(png_ptr, info_ptr,
+                             (png_bytep) memoryBase + position, bytesSkipped);
+            if (bytesSkipped < bytesToProcess) {
+                return false;
+            }
+            length -= bytesToProcess;
+        }
+        return true;
+    }
+
     while (length > 0) {
         const size_t bytesToProcess = std::min(bufferSize, length);
         const size_t bytesRead = stream->read(buffer, bytesToProcess);
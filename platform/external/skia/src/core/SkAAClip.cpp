@@ -696,6 +696,13 @@ bool SkAAClip::set(const SkAAClip& src) {
     return !this->isEmpty();
 }
 
+size_t SkAAClip::approximateBytesUsed() const {
+    if (!fRunHead) {
+        return 0;
+    }
+    return sizeof(RunHead) + fRunHead->fRowCount * sizeof(YOffset) + fRunHead->fDataSize;
+}
+
 bool SkAAClip::setEmpty() {
     this->freeRuns();
     fBounds.setEmpty();
@@ -946,12 +953,15 @@ bool SkAAClip::quickContains(int left, int top, int right, int bottom) const {
 
 class SkAAClip::Builder {
     SkIRect fBounds;
+    // All rows share fData, each starting at its fOffset and running up to the next row's. Rows
+    // are only ever appended to the end, so the current row is always the last one.
     struct Row {
         int fY;
         int fWidth;
-        SkTDArray<uint8_t>* fData;
+        int fOffset;
     };
     SkTDArray<Row>  fRows;
+    SkTDArray<uint8_t> fData;
     Row* fCurrRow;
     int fPrevY;
     int fWidth;
@@ -965,15 +975,6 @@ public:
         fMinY = bounds.fTop;
     }
 
-    ~Builder() {
-        Row* row = fRows.begin();
-        Row* stop = fRows.end();
-        while (row < stop) {
-            delete row->fData;
-            row += 1;
-        }
-    }
-
     const SkIRect& getBounds() const { return fBounds; }
 
     void addRun(int x, int y, U8CPU alpha, int count) {
@@ -991,24 +992,22 @@ public:
             row = this->flushRow(true);
             row->fY = y;
             row->fWidth = 0;
-            SkASSERT(row->fData);
-            SkASSERT(0 == row->fData->count());
+            SkASSERT(row->fOffset == fData.count());
             fCurrRow = row;
         }
 
+        SkASSERT(row == &fRows.top());
         SkASSERT(row->fWidth <= x);
         SkASSERT(row->fWidth < fBounds.width());
 
-        SkTDArray<uint8_t>& data = *row->fData;
-
         int gap = x - row->fWidth;
         if (gap) {
-            AppendRun(data, 0, gap);
+            AppendRun(fData, 0, gap);
             row->fWidth += gap;
             SkASSERT(row->fWidth < fBounds.width());
         }
 
-        AppendRun(data, alpha, count);
+        AppendRun(fData, alpha, count);
         row->fWidth += count;
         SkASSERT(row->fWidth <= fBounds.width());
     }
@@ -1080,12 +1079,7 @@ public:
         const Row* row = fRows.begin();
         const Row* stop = fRows.end();
 
-        size_t dataSize = 0;
-        while (row < stop) {
-            dataSize += row->fData->count();
-            row += 1;
-        }
-
+        size_t dataSize = fData.count();
         if (0 == dataSize) {
             return target->setEmpty();
         }
@@ -1098,26 +1092,21 @@ public:
         RunHead* head = RunHead::Alloc(fRows.count(), dataSize);
         YOffset* yoffset = head->yoffsets();
         uint8_t* data = head->data();
-        uint8_t* baseData = data;
+        memcpy(data, fData.begin(), dataSize);
 
-        row = fRows.begin();
         SkDEBUGCODE(int prevY = row->fY - 1;)
         while (row < stop) {
             SkASSERT(prevY < row->fY);  // must be monotonic
             SkDEBUGCODE(prevY = row->fY);
 
             yoffset->fY = row->fY - adjustY;
-            yoffset->fOffset = SkToU32(data - baseData);
+            yoffset->fOffset = SkToU32(row->fOffset);
             yoffset += 1;
 
-            size_t n = row->fData->count();
-            memcpy(data, row->fData->begin(), n);
 #ifdef SK_DEBUG
-            size_t bytesNeeded = compute_row_length(data, fBounds.width());
-            SkASSERT(bytesNeeded == n);
+            size_t bytesNeeded = compute_row_length(data + row->fOffset, fBounds.width());
+            SkASSERT(bytesNeeded == (size_t)this->rowLength(row - fRows.begin()));
 #endif
-            data += n;
-
             row += 1;
         }
 
@@ -1133,10 +1122,9 @@ public:
         for (y = 0; y < fRows.count(); ++y) {
             const Row& row = fRows[y];
             SkDebugf("Y:%3d W:%3d", row.fY, row.fWidth);
-            const SkTDArray<uint8_t>& data = *row.fData;
-            int count = data.count();
+            int count = this->rowLength(y);
             SkASSERT(!(count & 1));
-            const uint8_t* ptr = data.begin();
+            const uint8_t* ptr = fData.begin() + row.fOffset;
             for (int x = 0; x < count; x += 2) {
                 SkDebugf(" [%3d:%02X]", ptr[0], ptr[1]);
                 ptr += 2;
@@ -1155,8 +1143,8 @@ public:
             const Row& row = fRows[i];
             SkASSERT(prevY < row.fY);
             SkASSERT(fWidth == row.fWidth);
-            int count = row.fData->count();
-            const uint8_t* ptr = row.fData->begin();
+            int count = this->rowLength(i);
+            const uint8_t* ptr = fData.begin() + row.fOffset;
             SkASSERT(!(count & 1));
             int w = 0;
             for (int x = 0; x < count; x += 2) {
@@ -1178,10 +1166,16 @@ public:
     }
 
 private:
+    int rowLength(int index) const {
+        int end = index + 1 < fRows.count() ? fRows[index + 1].fOffset : fData.count();
+        return end - fRows[index].fOffset;
+    }
+
     void flushRowH(Row* row) {
+        SkASSERT(row == &fRows.top());
         // flush current row if needed
         if (row->fWidth < fWidth) {
-            AppendRun(*row->fData, 0, fWidth - row->fWidth);
+            AppendRun(fData, 0, fWidth - row->fWidth);
             row->fWidth = fWidth;
         }
     }
@@ -1198,26 +1192,24 @@ private:
             Row* curr = &fRows[count - 1];
             SkASSERT(prev->fWidth == fWidth);
             SkASSERT(curr->fWidth == fWidth);
-            if (*prev->fData == *curr->fData) {
+            int prevLength = curr->fOffset - prev->fOffset;
+            if (prevLength == this->rowLength(count - 1) &&
+                    !memcmp(fData.begin() + prev->fOffset, fData.begin() + curr->fOffset,
+                            prevLength)) {
                 prev->fY = curr->fY;
+                // drop the duplicate row's data, leaving the end of fData for the next row
+                fData.setCount(curr->fOffset);
                 if (readyForAnother) {
-                    curr->fData->rewind();
                     next = curr;
                 } else {
-                    delete curr->fData;
-                    fRows.removeShuffle(count - 1);
-                }
-            } else {
-                if (readyForAnother) {
-                    next = fRows.append();
-                    next->fData = new SkTDArray<uint8_t>;
+                    fRows.pop();
                 }
+                return next;
             }
-        } else {
-            if (readyForAnother) {
-                next = fRows.append();
-                next->fData = new SkTDArray<uint8_t>;
-            }
+        }
+        if (readyForAnother) {
+            next = fRows.append();
+            next->fOffset = fData.count();
         }
         return next;
     }
@@ -29,6 +29,9 @@ public:
     bool isEmpty() const { return nullptr == fRunHead; }
     const SkIRect& getBounds() const { return fBounds; }
 
+    // Returns the number of bytes allocated for the clip's runs, which may be shared by copies.
+    size_t approximateBytesUsed() const;
+
     // Returns true iff the clip is not empty, and is just a hard-edged rect (no partial alpha).
     // If true, getBounds() can be used in place of this clip.
     bool isRect() const;
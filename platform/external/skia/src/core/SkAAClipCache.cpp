@@ -0,0 +1,100 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkAAClipCache.h"
+
+#define CHECK_LOCAL(localCache, localName, globalName, ...) \
+    ((localCache) ? localCache->localName(__VA_ARGS__) : SkResourceCache::globalName(__VA_ARGS__))
+
+SkAAClipCache::Source::Source(const SkPath& path, const SkMatrix& matrix)
+    : fGenID(path.getGenerationID())
+    , fFillType(path.getFillType())
+    , fCacheable(!path.isVolatile()) {
+    this->setMatrix(matrix);
+}
+
+SkAAClipCache::Source::Source(const SkRRect& rrect, const SkMatrix& matrix)
+    : fGenID(0)
+    , fFillType(SkPath::kWinding_FillType)
+    , fRRect(rrect)
+    , fCacheable(true) {
+    this->setMatrix(matrix);
+}
+
+void SkAAClipCache::Source::setMatrix(const SkMatrix& matrix) {
+    if (matrix.hasPerspective()) {
+        fCacheable = false;
+    }
+    fMatrix[0] = matrix.getScaleX();
+    fMatrix[1] = matrix.getSkewX();
+    fMatrix[2] = matrix.getTranslateX();
+    fMatrix[3] = matrix.getSkewY();
+    fMatrix[4] = matrix.getScaleY();
+    fMatrix[5] = matrix.getTranslateY();
+}
+
+namespace {
+static unsigned gAAClipKeyNamespaceLabel;
+
+struct AAClipKey : public SkResourceCache::Key {
+public:
+    AAClipKey(uint32_t genID, int32_t fillType, const SkScalar matrix[6], const SkRRect& rrect,
+              const SkIRect& limit)
+        : fGenID(genID)
+        , fFillType(fillType)
+        , fRRect(rrect)
+        , fLimit(limit)
+    {
+        memcpy(fMatrix, matrix, sizeof(fMatrix));
+        this->init(&gAAClipKeyNamespaceLabel, 0,
+                   sizeof(fGenID) + sizeof(fFillType) + sizeof(fMatrix) + sizeof(fRRect) +
+                   sizeof(fLimit));
+    }
+
+    uint32_t fGenID;
+    int32_t  fFillType;
+    SkScalar fMatrix[6];
+    SkRRect  fRRect;
+    SkIRect  fLimit;
+};
+
+struct AAClipRec : public SkResourceCache::Rec {
+    AAClipRec(const AAClipKey& key, const SkAAClip& clip)
+        : fKey(key)
+        , fClip(clip) {}
+
+    AAClipKey fKey;
+    SkAAClip  fClip;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(*this) + fClip.approximateBytesUsed(); }
+    const char* getCategory() const override { return "aaclip"; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextClip) {
+        const AAClipRec& rec = static_cast<const AAClipRec&>(baseRec);
+        SkAAClip* result = (SkAAClip*)contextClip;
+
+        // The clip's runs are immutable and ref-counted, so this shares them.
+        *result = rec.fClip;
+        return true;
+    }
+};
+} // namespace
+
+bool SkAAClipCache::Find(const Source& source, const SkIRect& limit, SkAAClip* clip,
+                         SkResourceCache* localCache) {
+    SkASSERT(source.isCacheable());
+    AAClipKey key(source.fGenID, source.fFillType, source.fMatrix, source.fRRect, limit);
+    return CHECK_LOCAL(localCache, find, Find, key, AAClipRec::Visitor, clip);
+}
+
+void SkAAClipCache::Add(const Source& source, const SkIRect& limit, const SkAAClip& clip,
+                        SkResourceCache* localCache) {
+    SkASSERT(source.isCacheable());
+    AAClipKey key(source.fGenID, source.fFillType, source.fMatrix, source.fRRect, limit);
+    return CHECK_LOCAL(localCache, add, Add, new AAClipRec(key, clip));
+}
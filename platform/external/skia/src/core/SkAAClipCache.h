@@ -0,0 +1,61 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkAAClipCache_DEFINED
+#define SkAAClipCache_DEFINED
+
+#include "SkAAClip.h"
+#include "SkMatrix.h"
+#include "SkPath.h"
+#include "SkResourceCache.h"
+#include "SkRRect.h"
+
+/**
+ *  Caches the antialiased clips built by scan converting a clip path or rrect, so that clipping to
+ *  the same geometry again (e.g. inside each save/restore around the items of a list) shares the
+ *  clip that was already built instead of rasterizing it again.
+ *
+ *  A clip is identified by its geometry before it was transformed to device space, the matrix,
+ *  and the device rect it was limited to.
+ */
+class SkAAClipCache {
+public:
+    class Source {
+    public:
+        Source(const SkPath&, const SkMatrix&);
+        Source(const SkRRect&, const SkMatrix&);
+
+        /**
+         *  Returns false if the geometry can't be recognized when it is clipped to again (e.g. a
+         *  volatile path), or the matrix has perspective.
+         */
+        bool isCacheable() const { return fCacheable; }
+
+    private:
+        void setMatrix(const SkMatrix&);
+
+        uint32_t fGenID;
+        int32_t  fFillType;
+        SkScalar fMatrix[6];
+        SkRRect  fRRect;
+        bool     fCacheable;
+
+        friend class SkAAClipCache;
+    };
+
+    /**
+     *  On success, sets clip to share the cached clip for source, limited to limit, and returns
+     *  true. On failure, returns false.
+     */
+    static bool Find(const Source& source, const SkIRect& limit, SkAAClip* clip,
+                     SkResourceCache* localCache = nullptr);
+
+    static void Add(const Source& source, const SkIRect& limit, const SkAAClip& clip,
+                    SkResourceCache* localCache = nullptr);
+};
+
+#endif
@@ -9,6 +9,7 @@
 #include "SkBitmapCache.h"
 #include "SkBitmapController.h"
 #include "SkBitmapProvider.h"
+#include "SkBitmapScaler.h"
 #include "SkMatrix.h"
 #include "SkMipMap.h"
 #include "SkTemplates.h"
@@ -40,6 +41,7 @@ private:
     sk_sp<const SkMipMap>   fCurrMip;
 
     bool processHighRequest(const SkBitmapProvider&);
+    bool processScaledRequest(const SkBitmapProvider&, SkScalar invScaleX, SkScalar invScaleY);
     bool processMediumRequest(const SkBitmapProvider&);
 };
 
@@ -63,9 +65,15 @@ bool SkDefaultBitmapControllerState::processHighRequest(const SkBitmapProvider&
     invScaleX = SkScalarAbs(invScaleX);
     invScaleY = SkScalarAbs(invScaleY);
 
-    if (invScaleX >= 1 - SK_ScalarNearlyZero || invScaleY >= 1 - SK_ScalarNearlyZero) {
-        // we're down-scaling so abort HQ
-        return false;
+    const bool shrinkX = invScaleX >= 1 - SK_ScalarNearlyZero,
+               shrinkY = invScaleY >= 1 - SK_ScalarNearlyZero;
+    if (shrinkX || shrinkY) {
+        // We're down-scaling, which bicubic can't do without aliasing. If we're only scaling
+        // (and translating) and neither axis grows, we can resample the whole image to its drawn
+        // size instead, which is then no bigger than the image. Otherwise abort HQ.
+        return shrinkX && shrinkY &&
+               !(fInvMatrix.getType() & ~(SkMatrix::kScale_Mask | SkMatrix::kTranslate_Mask)) &&
+               this->processScaledRequest(provider, invScaleX, invScaleY);
     }
 
     // Confirmed that we can use HQ (w/ rasterpipeline)
@@ -74,6 +82,55 @@ bool SkDefaultBitmapControllerState::processHighRequest(const SkBitmapProvider&
     return true;
 }
 
+bool SkDefaultBitmapControllerState::processScaledRequest(const SkBitmapProvider& provider,
+                                                          SkScalar invScaleX,
+                                                          SkScalar invScaleY) {
+    const int dstW = SkScalarRoundToInt(provider.width() / invScaleX),
+              dstH = SkScalarRoundToInt(provider.height() / invScaleY);
+    if (dstW <= 0 || dstH <= 0 || (dstW == provider.width() && dstH == provider.height())) {
+        return false;
+    }
+
+    const SkBitmapCacheDesc desc = provider.makeCacheDesc(dstW, dstH);
+    if (!SkBitmapCache::Find(desc, &fResultBitmap)) {
+        SkBitmap orig;
+        SkPixmap src;
+        if (!provider.asBitmap(&orig) || !orig.peekPixels(&src)) {
+            return false;
+        }
+        const SkImageInfo info = src.info().makeWH(dstW, dstH);
+        if (!SkBitmapScaler::CanResize(info, src.info())) {
+            return false;
+        }
+
+        SkPixmap dst;
+        SkBitmapCache::RecPtr rec;
+        if (provider.isVolatile()) {
+            if (!fResultBitmap.tryAllocPixels(info) || !fResultBitmap.peekPixels(&dst)) {
+                return false;
+            }
+        } else {
+            rec = SkBitmapCache::Alloc(desc, info, &dst);
+            if (!rec) {
+                return false;
+            }
+        }
+        if (!SkBitmapScaler::Resize(dst, src, SkBitmapScaler::kLanczos3_ResizeMethod)) {
+            return false;
+        }
+        if (rec) {
+            SkBitmapCache::Add(std::move(rec), &fResultBitmap);
+            provider.notifyAddedToCache();
+        }
+    }
+
+    // The resampled image is drawn 1:1 (or nearly), so bilerp is all it needs.
+    fInvMatrix.postScale(SkIntToScalar(dstW) / provider.width(),
+                         SkIntToScalar(dstH) / provider.height());
+    fQuality = kLow_SkFilterQuality;
+    return true;
+}
+
 /*
  *  Modulo internal errors, this should always succeed *if* the matrix is downscaling
  *  (in this case, we have the inverse, so it succeeds if fInvMatrix is upscaling)
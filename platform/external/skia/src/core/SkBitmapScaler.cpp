@@ -0,0 +1,212 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkBitmapScaler.h"
+#include "SkColorSpace.h"
+#include "SkHalf.h"
+#include "SkNx.h"
+#include "SkTaskGroup.h"
+#include "SkTemplates.h"
+
+#include <cmath>
+
+// Rows of dst scaled by each task.
+static constexpr int kBandRows = 32;
+
+static float lanczos3(float x) {
+    x = SkScalarAbs(x);
+    if (x < 1e-6f) {
+        return 1;
+    }
+    if (x >= 3) {
+        return 0;
+    }
+    const float px = SK_ScalarPI * x;
+    return 3 * sinf(px) * sinf(px / 3) / (px * px);
+}
+
+static float mitchell(float x) {
+    constexpr float B = 1.0f / 3, C = 1.0f / 3;
+    x = SkScalarAbs(x);
+    if (x < 1) {
+        return ((12 - 9*B - 6*C) * x*x*x + (-18 + 12*B + 6*C) * x*x + (6 - 2*B)) / 6;
+    }
+    if (x < 2) {
+        return ((-B - 6*C) * x*x*x + (6*B + 30*C) * x*x + (-12*B - 48*C) * x + (8*B + 24*C)) / 6;
+    }
+    return 0;
+}
+
+namespace {
+
+// The weights of the source pixels that make up each pixel along one axis of dst. Every dst
+// pixel reads the same number of taps, starting from its own first source pixel; taps that fall
+// off the edge of src are folded onto the edge pixel.
+class ResizeWeights {
+public:
+    ResizeWeights(int srcSize, int dstSize, float (*filter)(float), float radius) {
+        const float scale = (float)dstSize / srcSize;
+        // When shrinking, stretch the filter over all the source pixels under each dst pixel.
+        const float filterScale = SkTMin(scale, 1.0f);
+        const float support = radius / filterScale;
+
+        fTaps = SkTMin((int)(2 * support) + 1, srcSize);
+        fStarts.reset(dstSize);
+        fWeights.reset(dstSize * fTaps);
+        sk_bzero(fWeights.get(), dstSize * fTaps * sizeof(float));
+
+        for (int i = 0; i < dstSize; ++i) {
+            const float center = (i + 0.5f) / scale - 0.5f;
+            const int first = (int)std::ceil(center - support),
+                      last  = (int)std::floor(center + support);
+            const int start = SkTMin(SkTPin(first, 0, srcSize - 1), srcSize - fTaps);
+            fStarts[i] = start;
+
+            float* weights = fWeights.get() + i * fTaps;
+            float sum = 0;
+            for (int j = first; j <= last; ++j) {
+                const float w = filter((j - center) * filterScale);
+                weights[SkTPin(j, 0, srcSize - 1) - start] += w;
+                sum += w;
+            }
+            if (sum != 0) {
+                for (int k = 0; k < fTaps; ++k) {
+                    weights[k] /= sum;
+                }
+            }
+        }
+    }
+
+    int taps() const { return fTaps; }
+    int start(int i) const { return fStarts[i]; }
+    const float* weights(int i) const { return fWeights.get() + i * fTaps; }
+
+private:
+    int                  fTaps;
+    SkAutoTMalloc<int>   fStarts;
+    SkAutoTMalloc<float> fWeights;
+};
+
+}  // namespace
+
+static void load_row(const SkPixmap& src, int y, Sk4f* row) {
+    if (kRGBA_F16_SkColorType == src.colorType()) {
+        const uint64_t* px = src.addr64(0, y);
+        for (int x = 0; x < src.width(); ++x) {
+            row[x] = SkHalfToFloat_finite_ftz(px[x]);
+        }
+    } else {
+        const uint32_t* px = src.addr32(0, y);
+        for (int x = 0; x < src.width(); ++x) {
+            row[x] = SkNx_cast<float>(Sk4b::Load(px + x));
+        }
+    }
+}
+
+// Filtering can overshoot, so clamp each pixel back into range (and under its alpha if premul)
+// before storing it. Alpha is the last channel in all the formats we handle.
+static void store_row(const SkPixmap& dst, int y, const Sk4f* row) {
+    const bool f16 = kRGBA_F16_SkColorType == dst.colorType();
+    const float max = f16 ? 1.0f : 255.0f;
+    const SkAlphaType alphaType = dst.alphaType();
+    for (int x = 0; x < dst.width(); ++x) {
+        Sk4f px = row[x];
+        const float alpha = kOpaque_SkAlphaType == alphaType ? max : SkTPin(px[3], 0.0f, max);
+        const float hi = kPremul_SkAlphaType == alphaType ? alpha : max;
+        px = Sk4f::Min(Sk4f::Max(px, Sk4f(0.0f)), Sk4f(hi));
+        px = Sk4f(px[0], px[1], px[2], alpha);
+        if (f16) {
+            SkFloatToHalf_finite_ftz(px).store(dst.writable_addr64(x, y));
+        } else {
+            SkNx_cast<uint8_t>(px + 0.5f).store(dst.writable_addr32(x, y));
+        }
+    }
+}
+
+// Scales the dst rows [top, bottom): each source row they read is filtered across into a band of
+// dst-wide rows, which is then filtered down into each dst row.
+static void resize_band(const SkPixmap& dst, const SkPixmap& src,
+                        const ResizeWeights& across, const ResizeWeights& down,
+                        int top, int bottom) {
+    const int dstW = dst.width();
+    const int srcTop = down.start(top),
+              srcBottom = down.start(bottom - 1) + down.taps();
+
+    SkAutoTMalloc<Sk4f> band((srcBottom - srcTop) * dstW);
+    SkAutoTMalloc<Sk4f> row(SkTMax(src.width(), dstW));
+    for (int y = srcTop; y < srcBottom; ++y) {
+        load_row(src, y, row.get());
+        Sk4f* out = band.get() + (y - srcTop) * dstW;
+        for (int x = 0; x < dstW; ++x) {
+            const Sk4f* in = row.get() + across.start(x);
+            const float* weights = across.weights(x);
+            Sk4f sum(0.0f);
+            for (int k = 0; k < across.taps(); ++k) {
+                sum = sum + in[k] * weights[k];
+            }
+            out[x] = sum;
+        }
+    }
+
+    for (int y = top; y < bottom; ++y) {
+        const Sk4f* in = band.get() + (down.start(y) - srcTop) * dstW;
+        const float* weights = down.weights(y);
+        for (int x = 0; x < dstW; ++x) {
+            row[x] = in[x] * weights[0];
+        }
+        for (int k = 1; k < down.taps(); ++k) {
+            in += dstW;
+            for (int x = 0; x < dstW; ++x) {
+                row[x] = row[x] + in[x] * weights[k];
+            }
+        }
+        store_row(dst, y, row.get());
+    }
+}
+
+bool SkBitmapScaler::CanResize(const SkImageInfo& dst, const SkImageInfo& src) {
+    switch (src.colorType()) {
+        case kRGBA_8888_SkColorType:
+        case kBGRA_8888_SkColorType:
+        case kRGBA_F16_SkColorType:
+            break;
+        default:
+            return false;
+    }
+    return !src.isEmpty() && !dst.isEmpty() &&
+           src.colorType() == dst.colorType() &&
+           src.alphaType() == dst.alphaType() &&
+           kUnknown_SkAlphaType != src.alphaType() &&
+           SkColorSpace::Equals(src.colorSpace(), dst.colorSpace());
+}
+
+bool SkBitmapScaler::Resize(const SkPixmap& dst, const SkPixmap& src, ResizeMethod method) {
+    if (!CanResize(dst.info(), src.info()) || !src.addr() || !dst.addr()) {
+        return false;
+    }
+
+    float (*filter)(float) = lanczos3;
+    float radius = 3;
+    if (kMitchell_ResizeMethod == method) {
+        filter = mitchell;
+        radius = 2;
+    }
+    const ResizeWeights across(src.width(), dst.width(), filter, radius),
+                        down(src.height(), dst.height(), filter, radius);
+
+    const int bands = (dst.height() + kBandRows - 1) / kBandRows;
+    auto resize = [&](int i) {
+        resize_band(dst, src, across, down,
+                    i * kBandRows, SkTMin((i + 1) * kBandRows, dst.height()));
+    };
+    if (bands > 1) {
+        SkTaskGroup().batch(bands, resize);
+    } else {
+        resize(0);
+    }
+    return true;
+}
@@ -0,0 +1,38 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkBitmapScaler_DEFINED
+#define SkBitmapScaler_DEFINED
+
+#include "SkPixmap.h"
+
+/**
+ *  Resamples pixels with a windowed filter, first across each row and then down each column.
+ *  The filter is stretched to cover every source pixel when shrinking, so unlike mipmaps or a
+ *  bicubic shader it neither aliases nor blurs more than it has to, whatever the scale.
+ */
+class SkBitmapScaler {
+public:
+    enum ResizeMethod {
+        kLanczos3_ResizeMethod,     // sharpest, but may ring a little around hard edges
+        kMitchell_ResizeMethod,     // bicubic with B = C = 1/3, softer and with no ringing
+    };
+
+    /**
+     *  Returns true if Resize() can scale src into dst: both must be RGBA or BGRA 8888, or
+     *  RGBA F16, with the same color type, alpha type and color space, and neither empty.
+     */
+    static bool CanResize(const SkImageInfo& dst, const SkImageInfo& src);
+
+    /**
+     *  Scales all of src to fit all of dst. Large images are split into bands of rows which are
+     *  scaled in parallel. Returns false, leaving dst alone, if !CanResize(dst, src).
+     */
+    static bool Resize(const SkPixmap& dst, const SkPixmap& src, ResizeMethod);
+};
+
+#endif
@@ -38,6 +38,24 @@ static void SkARGB32_Blit32(const SkPixmap& device, const SkMask& mask,
     } while (--height != 0);
 }
 
+// One pixel of SkBlitRow::Color32(), with exactly the math of SkOpts::blit_row_color32.
+// The short runs along antialiased edges aren't worth setting up the vectorized row for.
+static inline SkPMColor blit_pixel_color32(SkPMColor dst, SkPMColor color) {
+    unsigned invA = 255 - SkGetPackedA32(color);
+    invA += invA >> 7;
+
+    SkPMColor result = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        unsigned d = (dst >> shift) & 0xFF,
+                 c = (color >> shift) & 0xFF;
+        result |= (((d * invA + (c << 8) + 128) & 0xFFFF) >> 8) << shift;
+    }
+    return result;
+}
+
+// Runs shorter than this are blended a pixel at a time.
+static constexpr int kShortRun = 4;
+
 //////////////////////////////////////////////////////////////////////////////////////
 
 SkARGB32_Blitter::SkARGB32_Blitter(const SkPixmap& device, const SkPaint& paint)
@@ -91,12 +109,22 @@ void SkARGB32_Blitter::blitAntiH(int x, int y, const SkAlpha antialias[],
             return;
         }
         unsigned aa = antialias[0];
+        // Neighboring runs often have the same coverage; blit them as one.
+        while (runs[count] > 0 && antialias[count] == aa) {
+            count += runs[count];
+        }
         if (aa) {
             if ((opaqueMask & aa) == 255) {
                 sk_memset32(device, color, count);
             } else {
                 uint32_t sc = SkAlphaMulQ(color, SkAlpha255To256(aa));
-                SkBlitRow::Color32(device, device, count, sc);
+                if (count < kShortRun) {
+                    for (int i = 0; i < count; ++i) {
+                        device[i] = blit_pixel_color32(device[i], sc);
+                    }
+                } else {
+                    SkBlitRow::Color32(device, device, count, sc);
+                }
             }
         }
         runs += count;
@@ -280,6 +308,9 @@ void SkARGB32_Black_Blitter::blitAntiH(int x, int y, const SkAlpha antialias[],
             return;
         }
         unsigned aa = antialias[0];
+        while (runs[count] > 0 && antialias[count] == aa) {
+            count += runs[count];
+        }
         if (aa) {
             if (aa == 255) {
                 sk_memset32(device, black, count);
@@ -62,19 +62,40 @@ void SkClipStackDevice::onSetDeviceClipRestriction(SkIRect* clipRestriction) {
     }
 }
 
+// The reserved empty and wide-open IDs are shared by stacks that may hold different elements.
+static bool is_memoizable(uint32_t genID) {
+    return genID != SkClipStack::kInvalidGenID &&
+           genID != SkClipStack::kEmptyGenID &&
+           genID != SkClipStack::kWideOpenGenID;
+}
+
 bool SkClipStackDevice::onClipIsAA() const {
+    uint32_t genID = fClipStack.getTopmostGenID();
+    if (genID == fClipIsAAGenID) {
+        return fClipIsAA;
+    }
+
     SkClipStack::B2TIter        iter(fClipStack);
     const SkClipStack::Element* element;
 
+    fClipIsAA = false;
     while ((element = iter.next()) != nullptr) {
         if (element->isAA()) {
-            return true;
+            fClipIsAA = true;
+            break;
         }
     }
-    return false;
+    fClipIsAAGenID = is_memoizable(genID) ? genID : SkClipStack::kInvalidGenID;
+    return fClipIsAA;
 }
 
 void SkClipStackDevice::onAsRgnClip(SkRegion* rgn) const {
+    uint32_t genID = fClipStack.getTopmostGenID();
+    if (genID == fRgnClipGenID) {
+        *rgn = fRgnClip;
+        return;
+    }
+
     SkClipStack::BoundsType boundType;
     bool isIntersectionOfRects;
     SkRect bounds;
@@ -86,6 +107,10 @@ void SkClipStackDevice::onAsRgnClip(SkRegion* rgn) const {
         fClipStack.asPath(&path);
         rgn->setPath(path, SkRegion(SkIRect::MakeWH(this->width(), this->height())));
     }
+    if (is_memoizable(genID)) {
+        fRgnClip = *rgn;
+        fRgnClipGenID = genID;
+    }
 }
 
 SkBaseDevice::ClipType SkClipStackDevice::onGetClipType() const {
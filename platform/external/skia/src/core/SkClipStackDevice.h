@@ -42,6 +42,12 @@ private:
     intptr_t fStorage[kPreallocCount * sizeof(SkClipStack::Element) / sizeof(intptr_t)];
     SkClipStack fClipStack;
 
+    // These walk the whole stack, so their answers are remembered for the stack's topmost gen ID.
+    mutable uint32_t fClipIsAAGenID = SkClipStack::kInvalidGenID;
+    mutable bool     fClipIsAA = false;
+    mutable uint32_t fRgnClipGenID = SkClipStack::kInvalidGenID;
+    mutable SkRegion fRgnClip;
+
     typedef SkBaseDevice INHERITED;
 };
 
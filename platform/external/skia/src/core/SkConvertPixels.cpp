@@ -15,10 +15,34 @@
 #include "SkOpts.h"
 #include "SkPM4fPriv.h"
 #include "SkRasterPipeline.h"
+#include "SkTaskGroup.h"
 #include "SkUnPreMultiply.h"
 #include "SkUnPreMultiplyPriv.h"
 #include "../jumper/SkJumper.h"
 
+// Large conversions are split into tiles of whole rows, each small enough for its src and dst
+// to stay in cache, and the tiles are converted in parallel.
+static constexpr size_t kTileBytes = 256 * 1024;
+static constexpr int64_t kMinParallelPixels = 512 * 512;
+
+template <typename Fn>
+static void for_each_row_tile(const SkImageInfo& dstInfo, const SkImageInfo& srcInfo, Fn&& fn) {
+    const int width = dstInfo.width(),
+              height = dstInfo.height();
+    const size_t tileRowBytes = width * (size_t)(srcInfo.bytesPerPixel() +
+                                                 dstInfo.bytesPerPixel());
+    const int tileRows = SkTMax(1, SkToInt(kTileBytes / SkTMax<size_t>(tileRowBytes, 1)));
+    const int tiles = (height + tileRows - 1) / tileRows;
+    if (tiles < 2 || (int64_t)width * height < kMinParallelPixels) {
+        fn(0, height);
+        return;
+    }
+    SkTaskGroup().batch(tiles, [&](int i) {
+        const int y = i * tileRows;
+        fn(y, SkTMin(tileRows, height - y));
+    });
+}
+
 // Fast Path 1: The memcpy() case.
 static inline bool can_memcpy(const SkImageInfo& dstInfo, const SkImageInfo& srcInfo) {
     if (dstInfo.colorType() != srcInfo.colorType()) {
@@ -152,12 +176,16 @@ static inline void apply_color_xform(const SkImageInfo& dstInfo, void* dstPixels
             SkColorSpaceXform_Base::New(srcInfo.colorSpace(), dstInfo.colorSpace(), behavior);
     SkASSERT(xform);
 
-    for (int y = 0; y < dstInfo.height(); y++) {
-        SkAssertResult(xform->apply(dstFormat, dstPixels, srcFormat, srcPixels, dstInfo.width(),
-                       xformAlpha));
-        dstPixels = SkTAddOffset<void>(dstPixels, dstRB);
-        srcPixels = SkTAddOffset<const void>(srcPixels, srcRB);
-    }
+    for_each_row_tile(dstInfo, srcInfo, [&](int top, int rows) {
+        void* dstRow = SkTAddOffset<void>(dstPixels, top * dstRB);
+        const void* srcRow = SkTAddOffset<const void>(srcPixels, top * srcRB);
+        for (int y = 0; y < rows; y++) {
+            SkAssertResult(xform->apply(dstFormat, dstRow, srcFormat, srcRow, dstInfo.width(),
+                           xformAlpha));
+            dstRow = SkTAddOffset<void>(dstRow, dstRB);
+            srcRow = SkTAddOffset<const void>(srcRow, srcRB);
+        }
+    });
 }
 
 // Fast Path 4: Alpha 8 dsts.
@@ -342,7 +370,11 @@ static void convert_with_pipeline(const SkImageInfo& dstInfo, void* dstRow, size
             break;
     }
 
-    pipeline.run(0,0, srcInfo.width(), srcInfo.height());
+    // Compile the pipeline once, and run it over each tile.
+    auto run = pipeline.compile();
+    for_each_row_tile(dstInfo, srcInfo, [&](int top, int rows) {
+        run(0, top, srcInfo.width(), rows);
+    });
 }
 
 void SkConvertPixels(const SkImageInfo& dstInfo, void* dstPixels, size_t dstRB,
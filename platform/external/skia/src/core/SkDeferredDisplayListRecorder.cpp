@@ -9,6 +9,8 @@
 
 #if SK_SUPPORT_GPU
 #include "GrContextPriv.h"
+#include "GrDrawingManager.h"
+#include "GrOpArena.h"
 #include "GrProxyProvider.h"
 #include "GrTexture.h"
 
@@ -66,6 +68,8 @@ bool SkDeferredDisplayListRecorder::init() {
 
     fLazyProxyData = sk_sp<SkDeferredDisplayList::LazyProxyData>(
                                                     new SkDeferredDisplayList::LazyProxyData);
+    // The arena goes with the opLists when they are moved to the DDL.
+    fContext->contextPriv().drawingManager()->setOpArena(sk_make_sp<GrOpArena>());
 
     auto proxyProvider = fContext->contextPriv().proxyProvider();
 
@@ -7,14 +7,13 @@
 
 #include "SkAutoMalloc.h"
 #include "SkDistanceFieldGen.h"
+#include "SkNx.h"
 #include "SkPointPriv.h"
+#include "SkTaskGroup.h"
 #include "SkTemplates.h"
 
-struct DFData {
-    float   fAlpha;      // alpha value of source texel
-    float   fDistSq;     // distance squared to nearest (so far) edge texel
-    SkPoint fDistVector; // distance vector to nearest (so far) edge texel
-};
+// Stands in for the distance to an edge, along a column with no edge texels in it.
+static constexpr float kFarDistance = 100000.f;
 
 enum NeighborFlags {
     kLeft_NeighborFlag        = 0x01,
@@ -43,6 +42,21 @@ static bool found_edge(const unsigned char* imagePtr, int width, int neighborFla
     // search for an edge
     unsigned char currVal = *imagePtr;
     unsigned char currCheck = (currVal >> 7);
+
+    // away from the sides of the image, we can test all the neighbors at once
+    if (kAll_NeighborFlags == neighborFlags) {
+        unsigned anyBits = 0, allBits = 0xff;
+        for (int i = 0; i < kNum8ConnectedNeighbors; ++i) {
+            anyBits |= imagePtr[offsets[i]];
+            allBits &= imagePtr[offsets[i]];
+        }
+        if (currCheck) {
+            // any neighbor <128
+            return !(allBits & 0x80);
+        }
+        // any neighbor >=128, or any non-zero neighbor if we're non-zero too
+        return currVal ? anyBits != 0 : SkToBool(anyBits & 0x80);
+    }
     for (int i = 0; i < kNum8ConnectedNeighbors; ++i) {
         unsigned char neighborVal;
         if ((1 << i) & neighborFlags) {
@@ -65,20 +79,20 @@ static bool found_edge(const unsigned char* imagePtr, int width, int neighborFla
     return false;
 }
 
-static void init_glyph_data(DFData* data, unsigned char* edges, const unsigned char* image,
+static void init_glyph_data(float* alpha, unsigned char* edges, const unsigned char* image,
                             int dataWidth, int dataHeight,
                             int imageWidth, int imageHeight,
                             int pad) {
-    data += pad*dataWidth;
-    data += pad;
+    alpha += pad*dataWidth;
+    alpha += pad;
     edges += (pad*dataWidth + pad);
 
     for (int j = 0; j < imageHeight; ++j) {
         for (int i = 0; i < imageWidth; ++i) {
             if (255 == *image) {
-                data->fAlpha = 1.0f;
+                *alpha = 1.0f;
             } else {
-                data->fAlpha = (*image)*0.00392156862f;  // 1/255
+                *alpha = (*image)*0.00392156862f;  // 1/255
             }
             int checkMask = kAll_NeighborFlags;
             if (i == 0) {
@@ -96,11 +110,11 @@ static void init_glyph_data(DFData* data, unsigned char* edges, const unsigned c
             if (found_edge(image, imageWidth, checkMask)) {
                 *edges = 255;  // using 255 makes for convenient debug rendering
             }
-            ++data;
+            ++alpha;
             ++image;
             ++edges;
         }
-        data += 2*pad;
+        alpha += 2*pad;
         edges += 2*pad;
     }
 }
@@ -147,169 +161,139 @@ static float edge_distance(const SkPoint& direction, float alpha) {
     return distance;
 }
 
-static void init_distances(DFData* data, unsigned char* edges, int width, int height) {
-    // skip one pixel border
-    DFData* currData = data;
-    DFData* prevData = data - width;
-    DFData* nextData = data + width;
-
+// Finds where the edge runs through each edge texel, from its alpha and the gradient around it,
+// and starts off the column distances: zero on edge texels, far away everywhere else.
+// Returns false if there are no edge texels at all.
+static bool init_distances(SkPoint* edgePoints, float* columnDist, const float* alpha,
+                           const unsigned char* edges, int width, int height) {
+    bool foundEdge = false;
     for (int j = 0; j < height; ++j) {
         for (int i = 0; i < width; ++i) {
-            if (*edges) {
-                // we should not be in the one-pixel outside band
-                SkASSERT(i > 0 && i < width-1 && j > 0 && j < height-1);
-                // gradient will point from low to high
-                // +y is down in this case
-                // i.e., if you're outside, gradient points towards edge
-                // if you're inside, gradient points away from edge
-                SkPoint currGrad;
-                currGrad.fX = (prevData+1)->fAlpha - (prevData-1)->fAlpha
-                             + SK_ScalarSqrt2*(currData+1)->fAlpha
-                             - SK_ScalarSqrt2*(currData-1)->fAlpha
-                             + (nextData+1)->fAlpha - (nextData-1)->fAlpha;
-                currGrad.fY = (nextData-1)->fAlpha - (prevData-1)->fAlpha
-                             + SK_ScalarSqrt2*nextData->fAlpha
-                             - SK_ScalarSqrt2*prevData->fAlpha
-                             + (nextData+1)->fAlpha - (prevData+1)->fAlpha;
-                SkPointPriv::SetLengthFast(&currGrad, 1.0f);
-
-                // init squared distance to edge and distance vector
-                float dist = edge_distance(currGrad, currData->fAlpha);
-                currGrad.scale(dist, &currData->fDistVector);
-                currData->fDistSq = dist*dist;
-            } else {
-                // init distance to "far away"
-                currData->fDistSq = 2000000.f;
-                currData->fDistVector.fX = 1000.f;
-                currData->fDistVector.fY = 1000.f;
+            const int index = j*width + i;
+            if (!edges[index]) {
+                columnDist[index] = kFarDistance;
+                continue;
             }
-            ++currData;
-            ++prevData;
-            ++nextData;
-            ++edges;
+            // we should not be in the one-pixel outside band
+            SkASSERT(i > 0 && i < width-1 && j > 0 && j < height-1);
+            const float* prevAlpha = alpha + index - width;
+            const float* currAlpha = alpha + index;
+            const float* nextAlpha = alpha + index + width;
+            // gradient will point from low to high
+            // +y is down in this case
+            // i.e., if you're outside, gradient points towards edge
+            // if you're inside, gradient points away from edge
+            SkPoint currGrad;
+            currGrad.fX = prevAlpha[1] - prevAlpha[-1]
+                         + SK_ScalarSqrt2*currAlpha[1]
+                         - SK_ScalarSqrt2*currAlpha[-1]
+                         + nextAlpha[1] - nextAlpha[-1];
+            currGrad.fY = nextAlpha[-1] - prevAlpha[-1]
+                         + SK_ScalarSqrt2*nextAlpha[0]
+                         - SK_ScalarSqrt2*prevAlpha[0]
+                         + nextAlpha[1] - prevAlpha[1];
+            SkPointPriv::SetLengthFast(&currGrad, 1.0f);
+
+            // the edge lies this far along the gradient from the texel center
+            float dist = edge_distance(currGrad, *currAlpha);
+            edgePoints[index].set(i + currGrad.fX*dist, j + currGrad.fY*dist);
+            columnDist[index] = 0;
+            foundEdge = true;
         }
     }
+    return foundEdge;
 }
 
-// Danielsson's 8SSEDT
-
-// first stage forward pass
-// (forward in Y, forward in X)
-static void F1(DFData* curr, int width) {
-    // upper left
-    DFData* check = curr - width-1;
-    SkPoint distVec = check->fDistVector;
-    float distSq = check->fDistSq - 2.0f*(distVec.fX + distVec.fY - 1.0f);
-    if (distSq < curr->fDistSq) {
-        distVec.fX -= 1.0f;
-        distVec.fY -= 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
-
-    // up
-    check = curr - width;
-    distVec = check->fDistVector;
-    distSq = check->fDistSq - 2.0f*distVec.fY + 1.0f;
-    if (distSq < curr->fDistSq) {
-        distVec.fY -= 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
-
-    // upper right
-    check = curr - width+1;
-    distVec = check->fDistVector;
-    distSq = check->fDistSq + 2.0f*(distVec.fX - distVec.fY + 1.0f);
-    if (distSq < curr->fDistSq) {
-        distVec.fX += 1.0f;
-        distVec.fY -= 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
-
-    // left
-    check = curr - 1;
-    distVec = check->fDistVector;
-    distSq = check->fDistSq - 2.0f*distVec.fX + 1.0f;
-    if (distSq < curr->fDistSq) {
-        distVec.fX -= 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
-}
-
-// second stage forward pass
-// (forward in Y, backward in X)
-static void F2(DFData* curr, int width) {
-    // right
-    DFData* check = curr + 1;
-    SkPoint distVec = check->fDistVector;
-    float distSq = check->fDistSq + 2.0f*distVec.fX + 1.0f;
-    if (distSq < curr->fDistSq) {
-        distVec.fX += 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
+// Felzenszwalb and Huttenlocher's separable exact distance transform (2012), which finds the
+// nearest edge texel to every texel with one pass down the columns and one across the rows.
+
+// First pass: for every texel, the signed offset up its column to the nearest edge texel in that
+// column (so that edge texel is at row j - columnDist). Each sweep carries a whole row of columns
+// along at once.
+static void column_pass(float* columnDist, int width, int height) {
+    // forwards in y: the nearest edge texel at or above
+    for (int j = 1; j < height; ++j) {
+        float* curr = columnDist + j*width;
+        const float* prev = curr - width;
+        int i = 0;
+        for (; i + 4 <= width; i += 4) {
+            Sk4f d = Sk4f::Load(curr + i);
+            (d == 0).thenElse(d, Sk4f::Load(prev + i) + 1).store(curr + i);
+        }
+        for (; i < width; ++i) {
+            if (curr[i] != 0) {
+                curr[i] = prev[i] + 1;
+            }
+        }
     }
-}
-
-// first stage backward pass
-// (backward in Y, forward in X)
-static void B1(DFData* curr, int width) {
-    // left
-    DFData* check = curr - 1;
-    SkPoint distVec = check->fDistVector;
-    float distSq = check->fDistSq - 2.0f*distVec.fX + 1.0f;
-    if (distSq < curr->fDistSq) {
-        distVec.fX -= 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
+    // backwards in y: take the nearest edge texel below, if that's closer
+    for (int j = height - 2; j >= 0; --j) {
+        float* curr = columnDist + j*width;
+        const float* next = curr + width;
+        int i = 0;
+        for (; i + 4 <= width; i += 4) {
+            Sk4f d = Sk4f::Load(curr + i);
+            Sk4f below = Sk4f::Load(next + i) - 1;
+            (below.abs() < d.abs()).thenElse(below, d).store(curr + i);
+        }
+        for (; i < width; ++i) {
+            float below = next[i] - 1;
+            if (SkScalarAbs(below) < SkScalarAbs(curr[i])) {
+                curr[i] = below;
+            }
+        }
     }
 }
 
-// second stage backward pass
-// (backward in Y, backwards in X)
-static void B2(DFData* curr, int width) {
-    // right
-    DFData* check = curr + 1;
-    SkPoint distVec = check->fDistVector;
-    float distSq = check->fDistSq + 2.0f*distVec.fX + 1.0f;
-    if (distSq < curr->fDistSq) {
-        distVec.fX += 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
-
-    // bottom left
-    check = curr + width-1;
-    distVec = check->fDistVector;
-    distSq = check->fDistSq - 2.0f*(distVec.fX - distVec.fY - 1.0f);
-    if (distSq < curr->fDistSq) {
-        distVec.fX -= 1.0f;
-        distVec.fY += 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
+// Second pass: along each row, the lower envelope of the parabolas (i - q)^2 + columnDist(q)^2
+// rooted at each column q gives the nearest edge texel to every texel in the row. We record its
+// index in 'nearest', or 'noEdge' if there are no edge texels within 'maxDist' of a texel. Since
+// the distance field is clamped, we can skip the columns whose edge texels are all further than
+// that from this row, which is most of them inside and outside larger glyphs.
+static void row_pass(int* nearest, const float* columnDist, int width, int height,
+                     float maxDist, int noEdge, int* roots, float* bounds) {
+    for (int j = 0; j < height; ++j) {
+        const float* dist = columnDist + j*width;
+        int* rowNearest = nearest + j*width;
+
+        // build the lower envelope of the nearby parabolas
+        int k = -1;
+        for (int q = 0; q < width; ++q) {
+            if (SkScalarAbs(dist[q]) >= maxDist) {
+                continue;
+            }
+            const float fq = dist[q]*dist[q] + q*q;
+            float s = 0;
+            while (k >= 0) {
+                const int v = roots[k];
+                s = (fq - (dist[v]*dist[v] + v*v)) / (2*(q - v));
+                if (s > bounds[k]) {
+                    break;
+                }
+                --k;
+            }
+            ++k;
+            roots[k] = q;
+            bounds[k] = k ? s : -SK_ScalarInfinity;
+        }
 
-    // bottom
-    check = curr + width;
-    distVec = check->fDistVector;
-    distSq = check->fDistSq + 2.0f*distVec.fY + 1.0f;
-    if (distSq < curr->fDistSq) {
-        distVec.fY += 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
+        if (k < 0) {
+            for (int i = 0; i < width; ++i) {
+                rowNearest[i] = noEdge;
+            }
+            continue;
+        }
+        bounds[k + 1] = SK_ScalarInfinity;
 
-    // bottom right
-    check = curr + width+1;
-    distVec = check->fDistVector;
-    distSq = check->fDistSq + 2.0f*(distVec.fX + distVec.fY + 1.0f);
-    if (distSq < curr->fDistSq) {
-        distVec.fX += 1.0f;
-        distVec.fY += 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
+        // then read off the parabola on the envelope above each texel
+        int e = 0;
+        for (int i = 0; i < width; ++i) {
+            while (bounds[e + 1] < i) {
+                ++e;
+            }
+            const int q = roots[e];
+            rowNearest[i] = (j - (int)dist[q])*width + q;
+        }
     }
 }
 
@@ -332,8 +316,55 @@ static unsigned char pack_distance_field_val(float dist) {
     // (which represents zero).
     return (unsigned char)SkScalarRoundToInt(dist / (2 * distanceMagnitude) * 256.0f);
 }
+
+// Packs four distances at once, just as above.
+template <int distanceMagnitude>
+static Sk4b pack_distance_field_vals(const Sk4f& dist) {
+    Sk4f val = Sk4f::Min(Sk4f::Max(-dist, -distanceMagnitude),
+                         distanceMagnitude * 127.0f / 128.0f) + distanceMagnitude;
+    // val is never negative, so truncating after adding 0.5 rounds just as SkScalarRoundToInt
+    return SkNx_cast<uint8_t>(val / (2 * distanceMagnitude) * 256.0f + 0.5f);
+}
 #endif
 
+// The squared distance from texel (i, j) to where the edge runs through the edge texel at 'index'.
+static inline float distance_to_edge_sq(const SkPoint* edgePoints, int index, int i, int j) {
+    const SkPoint& edge = edgePoints[index];
+    return SkPointPriv::LengthSqd(SkPoint::Make(edge.fX - i, edge.fY - j));
+}
+
+// The nearest edge texel isn't always the one with the nearest subtexel edge point, so near the
+// edge we also try those nearest each neighbor, and remember the best for the neighbors still to
+// come. Further away the difference is lost when we clamp the distance. Returns the squared
+// distance to the nearest edge point.
+static float refine_nearest(int* nearest, const SkPoint* edgePoints, const int neighborOffsets[4],
+                            int index, int i, int j, float maxDistSq) {
+    int best = nearest[index];
+    float distSq = distance_to_edge_sq(edgePoints, best, i, j);
+    if (distSq >= maxDistSq) {
+        return distSq;
+    }
+    // compare all the candidates at once; it's rare that any is closer
+    const int* candidates = nearest + index;
+    const SkPoint& p0 = edgePoints[candidates[neighborOffsets[0]]];
+    const SkPoint& p1 = edgePoints[candidates[neighborOffsets[1]]];
+    const SkPoint& p2 = edgePoints[candidates[neighborOffsets[2]]];
+    const SkPoint& p3 = edgePoints[candidates[neighborOffsets[3]]];
+    Sk4f dx = Sk4f(p0.fX, p1.fX, p2.fX, p3.fX) - i,
+         dy = Sk4f(p0.fY, p1.fY, p2.fY, p3.fY) - j;
+    Sk4f candidateSq = dx*dx + dy*dy;
+    if ((candidateSq < distSq).anyTrue()) {
+        for (int n = 0; n < 4; ++n) {
+            if (candidateSq[n] < distSq) {
+                distSq = candidateSq[n];
+                best = candidates[neighborOffsets[n]];
+            }
+        }
+    }
+    nearest[index] = best;
+    return distSq;
+}
+
 // assumes a padded 8-bit image and distance field
 // width and height are the original width and height of the image
 static bool generate_distance_field_from_image(unsigned char* distanceField,
@@ -343,118 +374,117 @@ static bool generate_distance_field_from_image(unsigned char* distanceField,
     SkASSERT(copyPtr);
 
     // we expand our temp data by one more on each side to simplify
-    // the scanning code -- will always be treated as infinitely far away
+    // the gradient code -- will always be treated as infinitely far away
     int pad = SK_DistanceFieldPad + 1;
 
     // set params for distance field data
     int dataWidth = width + 2*pad;
     int dataHeight = height + 2*pad;
-
-    // create zeroed temp DFData+edge storage
-    SkAutoFree storage(sk_calloc_throw(dataWidth*dataHeight*(sizeof(DFData) + 1)));
-    DFData*        dataPtr = (DFData*)storage.get();
-    unsigned char* edgePtr = (unsigned char*)storage.get() + dataWidth*dataHeight*sizeof(DFData);
+    int dataCount = dataWidth*dataHeight;
+
+    // create temp storage: alpha, edge points, column distances, nearest edge texels,
+    // and the row pass' envelope, then the zeroed edge flags
+    size_t perTexel = sizeof(float) + sizeof(SkPoint) + sizeof(float) + sizeof(int);
+    size_t envelope = (dataWidth + 1)*(sizeof(int) + sizeof(float));
+    SkAutoMalloc storage(dataCount*(perTexel + 1) + sizeof(SkPoint) + envelope);
+    float*   alphaPtr      = (float*)storage.get();
+    SkPoint* edgePointPtr  = (SkPoint*)(alphaPtr + dataCount);
+    float*   columnDistPtr = (float*)(edgePointPtr + dataCount + 1);
+    int*     nearestPtr    = (int*)(columnDistPtr + dataCount);
+    int*     rootsPtr      = nearestPtr + dataCount;
+    float*   boundsPtr     = (float*)(rootsPtr + dataWidth + 1);
+    unsigned char* edgePtr = (unsigned char*)(boundsPtr + dataWidth + 1);
+    sk_bzero(alphaPtr, dataCount*sizeof(float));
+    sk_bzero(edgePtr, dataCount);
 
     // copy glyph into distance field storage
-    init_glyph_data(dataPtr, edgePtr, copyPtr,
+    init_glyph_data(alphaPtr, edgePtr, copyPtr,
                     dataWidth, dataHeight,
                     width+2, height+2, SK_DistanceFieldPad);
 
-    // create initial distance data, particularly at edges
-    init_distances(dataPtr, edgePtr, dataWidth, dataHeight);
-
-    // now perform Euclidean distance transform to propagate distances
-
-    // forwards in y
-    DFData* currData = dataPtr+dataWidth+1; // skip outer buffer
-    unsigned char* currEdge = edgePtr+dataWidth+1;
-    for (int j = 1; j < dataHeight-1; ++j) {
-        // forwards in x
-        for (int i = 1; i < dataWidth-1; ++i) {
-            // don't need to calculate distance for edge pixels
-            if (!*currEdge) {
-                F1(currData, dataWidth);
-            }
-            ++currData;
-            ++currEdge;
-        }
+    // texels with no edge texels nearby find a far away edge point here instead
+    const int noEdge = dataCount;
+    edgePointPtr[noEdge].set(kFarDistance, kFarDistance);
 
-        // backwards in x
-        --currData; // reset to end
-        --currEdge;
-        for (int i = 1; i < dataWidth-1; ++i) {
-            // don't need to calculate distance for edge pixels
-            if (!*currEdge) {
-                F2(currData, dataWidth);
-            }
-            --currData;
-            --currEdge;
+    // create initial distance data, particularly at edges
+    bool foundEdge = init_distances(edgePointPtr, columnDistPtr, alphaPtr, edgePtr,
+                                    dataWidth, dataHeight);
+
+    // now perform Euclidean distance transform to find the nearest edge texels, as far out as
+    // makes a difference to the clamped distance field (allowing for the subtexel edge points,
+    // which are within half a diagonal of their texels)
+    constexpr float kMaxDistance = SK_DistanceFieldMagnitude + 1.5f;
+    if (!foundEdge) {
+        for (int index = 0; index < dataCount; ++index) {
+            nearestPtr[index] = noEdge;
         }
-
-        currData += dataWidth+1;
-        currEdge += dataWidth+1;
+    } else {
+        column_pass(columnDistPtr, dataWidth, dataHeight);
+        row_pass(nearestPtr, columnDistPtr, dataWidth, dataHeight, kMaxDistance, noEdge,
+                 rootsPtr, boundsPtr);
     }
 
-    // backwards in y
-    currData = dataPtr+dataWidth*(dataHeight-2) - 1; // skip outer buffer
-    currEdge = edgePtr+dataWidth*(dataHeight-2) - 1;
+    // find the distance to the nearest edge point, refining the nearest edge texels forwards and
+    // then backwards so the better edge points spread both ways (reusing the column distances)
+    const float kMaxDistanceSq = kMaxDistance*kMaxDistance;
+    const int prevOffsets[4] = { -dataWidth-1, -dataWidth, -dataWidth+1, -1 };
+    const int nextOffsets[4] = { 1, dataWidth-1, dataWidth, dataWidth+1 };
+    float* distSqPtr = columnDistPtr;
     for (int j = 1; j < dataHeight-1; ++j) {
-        // forwards in x
         for (int i = 1; i < dataWidth-1; ++i) {
-            // don't need to calculate distance for edge pixels
-            if (!*currEdge) {
-                B1(currData, dataWidth);
+            const int index = j*dataWidth + i;
+            if (edgePtr[index]) {
+                distSqPtr[index] = distance_to_edge_sq(edgePointPtr, index, i, j);
+            } else {
+                distSqPtr[index] = refine_nearest(nearestPtr, edgePointPtr, prevOffsets,
+                                                  index, i, j, kMaxDistanceSq);
             }
-            ++currData;
-            ++currEdge;
         }
-
-        // backwards in x
-        --currData; // reset to end
-        --currEdge;
-        for (int i = 1; i < dataWidth-1; ++i) {
-            // don't need to calculate distance for edge pixels
-            if (!*currEdge) {
-                B2(currData, dataWidth);
+    }
+    for (int j = dataHeight-2; j > 0; --j) {
+        for (int i = dataWidth-2; i > 0; --i) {
+            const int index = j*dataWidth + i;
+            if (!edgePtr[index] && distSqPtr[index] < kMaxDistanceSq) {
+                distSqPtr[index] = refine_nearest(nearestPtr, edgePointPtr, nextOffsets,
+                                                  index, i, j, kMaxDistanceSq);
             }
-            --currData;
-            --currEdge;
         }
-
-        currData -= dataWidth-1;
-        currEdge -= dataWidth-1;
     }
 
     // copy results to final distance field data
-    currData = dataPtr + dataWidth+1;
-    currEdge = edgePtr + dataWidth+1;
     unsigned char *dfPtr = distanceField;
     for (int j = 1; j < dataHeight-1; ++j) {
-        for (int i = 1; i < dataWidth-1; ++i) {
 #if DUMP_EDGE
-            float alpha = currData->fAlpha;
+        for (int i = 1; i < dataWidth-1; ++i) {
+            const int index = j*dataWidth + i;
+            float alpha = alphaPtr[index];
             float edge = 0.0f;
-            if (*currEdge) {
+            if (edgePtr[index]) {
                 edge = 0.25f;
             }
             // blend with original image
             float result = alpha + (1.0f-alpha)*edge;
             unsigned char val = sk_float_round2int(255*result);
             *dfPtr++ = val;
+        }
 #else
-            float dist;
-            if (currData->fAlpha > 0.5f) {
-                dist = -SkScalarSqrt(currData->fDistSq);
-            } else {
-                dist = SkScalarSqrt(currData->fDistSq);
+        const float* distSq = distSqPtr + j*dataWidth + 1;
+        const float* alpha = alphaPtr + j*dataWidth + 1;
+        int i = 0;
+        for (; i + 4 <= dataWidth-2; i += 4) {
+            Sk4f dist = Sk4f::Min(Sk4f::Load(distSq + i), kMaxDistanceSq).sqrt();
+            dist = (Sk4f::Load(alpha + i) > 0.5f).thenElse(-dist, dist);
+            pack_distance_field_vals<SK_DistanceFieldMagnitude>(dist).store(dfPtr);
+            dfPtr += 4;
+        }
+        for (; i < dataWidth-2; ++i) {
+            float dist = SkScalarSqrt(SkTMin(distSq[i], kMaxDistanceSq));
+            if (alpha[i] > 0.5f) {
+                dist = -dist;
             }
             *dfPtr++ = pack_distance_field_val<SK_DistanceFieldMagnitude>(dist);
-#endif
-            ++currData;
-            ++currEdge;
         }
-        currData += 2;
-        currEdge += 2;
+#endif
     }
 
     return true;
@@ -478,7 +508,7 @@ bool SkGenerateDistanceFieldFromA8Image(unsigned char* distanceField,
     unsigned char* currDestPtr = copyPtr + width + 2;
     for (int i = 0; i < height; ++i) {
         *currDestPtr++ = 0;
-        memcpy(currDestPtr, currSrcScanLine, rowBytes);
+        memcpy(currDestPtr, currSrcScanLine, width);
         currSrcScanLine += rowBytes;
         currDestPtr += width;
         *currDestPtr++ = 0;
@@ -521,3 +551,29 @@ bool SkGenerateDistanceFieldFromBWImage(unsigned char* distanceField,
 
     return generate_distance_field_from_image(distanceField, copyPtr, width, height);
 }
+
+bool SkGenerateDistanceFields(const SkDistanceFieldRequest requests[], int count) {
+    SkAutoSTMalloc<64, bool> results(count);
+
+    auto generate = [&](int i) {
+        const SkDistanceFieldRequest& request = requests[i];
+        results[i] = request.fIsBW
+            ? SkGenerateDistanceFieldFromBWImage(request.fDistanceField, request.fImage,
+                                                 request.fWidth, request.fHeight,
+                                                 request.fRowBytes)
+            : SkGenerateDistanceFieldFromA8Image(request.fDistanceField, request.fImage,
+                                                 request.fWidth, request.fHeight,
+                                                 request.fRowBytes);
+    };
+    if (count > 1) {
+        SkTaskGroup().batch(count, generate);
+    } else if (count == 1) {
+        generate(0);
+    }
+
+    bool allSucceeded = true;
+    for (int i = 0; i < count; ++i) {
+        allSucceeded &= results[i];
+    }
+    return allSucceeded;
+}
@@ -51,6 +51,24 @@ bool SkGenerateDistanceFieldFromBWImage(unsigned char* distanceField,
                                         const unsigned char* image,
                                         int w, int h, size_t rowBytes);
 
+/** One mask to generate a distance field for with SkGenerateDistanceFields(). */
+struct SkDistanceFieldRequest {
+    unsigned char*       fDistanceField;  // allocated by the client with the padding above
+    const unsigned char* fImage;
+    int                  fWidth;
+    int                  fHeight;
+    size_t               fRowBytes;
+    bool                 fIsBW;           // 1-bit rather than 8-bit mask data
+};
+
+/** Generate distance fields for many masks at once, e.g. when filling a glyph atlas.
+ *  The fields are generated in parallel. Returns true if all of them were generated.
+ *
+ *  @param requests          The masks and the distance fields to generate from them.
+ *  @param count             Number of requests.
+ */
+bool SkGenerateDistanceFields(const SkDistanceFieldRequest requests[], int count);
+
 /** Given width and height of original image, return size (in bytes) of distance field
  *  @param w                 Width of the original image.
  *  @param h                 Height of the original image.
@@ -19,6 +19,7 @@
 #include "SkOpts.h"
 #include "SkPath.h"
 #include "SkPathEffect.h"
+#include "SkPathRef.h"
 #include "SkPixelRef.h"
 #include "SkRefCnt.h"
 #include "SkResourceCache.h"
@@ -60,6 +61,7 @@ void SkGraphics::PurgeAllCaches() {
     SkGraphics::PurgeFontCache();
     SkGraphics::PurgeResourceCache();
     SkImageFilter::PurgeCache();
+    SkPathRef::PurgeInterned();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
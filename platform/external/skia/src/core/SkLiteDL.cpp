@@ -29,6 +29,22 @@ static const SkRect* maybe_unset(const SkRect& r) {
     return r.left() == SK_ScalarInfinity ? nullptr : &r;
 }
 
+// Conservative bounds of drawing raw with paint, or kUnset if there's no telling.
+static SkRect fast_bounds(const SkRect& raw, const SkPaint& paint) {
+    if (!paint.canComputeFastBounds()) {
+        return kUnset;
+    }
+    SkRect storage;
+    const SkRect& bounds = paint.computeFastBounds(raw, &storage);
+    return bounds.isFinite() ? bounds : kUnset;
+}
+
+// Paths and matrices lazily cache things about themselves; compute them now instead of racing.
+static void make_threadsafe(SkPath* path, SkMatrix* matrix) {
+    if (path)   { path->updateBoundsCache(); (void)path->getGenerationID(); }
+    if (matrix) { (void)matrix->getType(); }
+}
+
 // copy_v(dst, src,n, src,n, ...) copies an arbitrary number of typed srcs into dst.
 static void copy_v(void* dst) {}
 
@@ -116,6 +132,7 @@ namespace {
             c->saveLayer({ maybe_unset(bounds), &paint, backdrop.get(), clipMask.get(),
                            clipMatrix.isIdentity() ? nullptr : &clipMatrix, flags });
         }
+        void makeThreadsafe() { make_threadsafe(nullptr, &clipMatrix); }
     };
 
     struct Concat final : Op {
@@ -123,6 +140,7 @@ namespace {
         Concat(const SkMatrix& matrix) : matrix(matrix) {}
         SkMatrix matrix;
         void draw(SkCanvas* c, const SkMatrix&) const { c->concat(matrix); }
+        void makeThreadsafe() { make_threadsafe(nullptr, &matrix); }
     };
     struct SetMatrix final : Op {
         static const auto kType = Type::SetMatrix;
@@ -131,6 +149,7 @@ namespace {
         void draw(SkCanvas* c, const SkMatrix& original) const {
             c->setMatrix(SkMatrix::Concat(original, matrix));
         }
+        void makeThreadsafe() { make_threadsafe(nullptr, &matrix); }
     };
     struct Translate final : Op {
         static const auto kType = Type::Translate;
@@ -148,6 +167,7 @@ namespace {
         SkClipOp op;
         bool     aa;
         void draw(SkCanvas* c, const SkMatrix&) const { c->clipPath(path, op, aa); }
+        void makeThreadsafe() { make_threadsafe(&path, nullptr); }
     };
     struct ClipRect final : Op {
         static const auto kType = Type::ClipRect;
@@ -185,6 +205,10 @@ namespace {
         SkPath  path;
         SkPaint paint;
         void draw(SkCanvas* c, const SkMatrix&) const { c->drawPath(path, paint); }
+        void makeThreadsafe() { make_threadsafe(&path, nullptr); }
+        SkRect bounds() const {
+            return path.isInverseFillType() ? kUnset : fast_bounds(path.getBounds(), paint);
+        }
     };
     struct DrawRect final : Op {
         static const auto kType = Type::DrawRect;
@@ -192,6 +216,7 @@ namespace {
         SkRect  rect;
         SkPaint paint;
         void draw(SkCanvas* c, const SkMatrix&) const { c->drawRect(rect, paint); }
+        SkRect bounds() const { return fast_bounds(rect.makeSorted(), paint); }
     };
     struct DrawRegion final : Op {
         static const auto kType = Type::DrawRegion;
@@ -199,6 +224,7 @@ namespace {
         SkRegion region;
         SkPaint  paint;
         void draw(SkCanvas* c, const SkMatrix&) const { c->drawRegion(region, paint); }
+        SkRect bounds() const { return fast_bounds(SkRect::Make(region.getBounds()), paint); }
     };
     struct DrawOval final : Op {
         static const auto kType = Type::DrawOval;
@@ -206,6 +232,7 @@ namespace {
         SkRect  oval;
         SkPaint paint;
         void draw(SkCanvas* c, const SkMatrix&) const { c->drawOval(oval, paint); }
+        SkRect bounds() const { return fast_bounds(oval.makeSorted(), paint); }
     };
     struct DrawArc final : Op {
         static const auto kType = Type::DrawArc;
@@ -220,6 +247,7 @@ namespace {
         SkPaint paint;
         void draw(SkCanvas* c, const SkMatrix&) const { c->drawArc(oval, startAngle, sweepAngle,
                                                                    useCenter, paint); }
+        SkRect bounds() const { return fast_bounds(oval.makeSorted(), paint); }
     };
     struct DrawRRect final : Op {
         static const auto kType = Type::DrawRRect;
@@ -227,6 +255,7 @@ namespace {
         SkRRect rrect;
         SkPaint paint;
         void draw(SkCanvas* c, const SkMatrix&) const { c->drawRRect(rrect, paint); }
+        SkRect bounds() const { return fast_bounds(rrect.getBounds(), paint); }
     };
     struct DrawDRRect final : Op {
         static const auto kType = Type::DrawDRRect;
@@ -235,6 +264,7 @@ namespace {
         SkRRect outer, inner;
         SkPaint paint;
         void draw(SkCanvas* c, const SkMatrix&) const { c->drawDRRect(outer, inner, paint); }
+        SkRect bounds() const { return fast_bounds(outer.getBounds(), paint); }
     };
 
     struct DrawAnnotation final : Op {
@@ -253,9 +283,21 @@ namespace {
         }
         sk_sp<SkDrawable> drawable;
         SkMatrix          matrix = SkMatrix::I();
+        sk_sp<SkPicture>  snapshot;
         void draw(SkCanvas* c, const SkMatrix&) const {
-            c->drawDrawable(drawable.get(), &matrix);
+            if (snapshot) {
+                c->drawPicture(snapshot.get(), &matrix, nullptr);
+            } else {
+                c->drawDrawable(drawable.get(), &matrix);
+            }
+        }
+        // A drawable may draw differently each time, and isn't safe to draw from several
+        // threads at once.  Like SkPicture does, freeze what it draws right now.
+        void makeThreadsafe() {
+            snapshot.reset(drawable->newPictureSnapshot());
+            make_threadsafe(nullptr, &matrix);
         }
+        void thaw() { snapshot.reset(); }
     };
     struct DrawPicture final : Op {
         static const auto kType = Type::DrawPicture;
@@ -271,6 +313,7 @@ namespace {
         void draw(SkCanvas* c, const SkMatrix&) const {
             c->drawPicture(picture.get(), &matrix, has_paint ? &paint : nullptr);
         }
+        void makeThreadsafe() { make_threadsafe(nullptr, &matrix); }
     };
 
     struct DrawImage final : Op {
@@ -283,6 +326,9 @@ namespace {
         SkScalar x,y;
         SkPaint paint;
         void draw(SkCanvas* c, const SkMatrix&) const { c->drawImage(image.get(), x,y, &paint); }
+        SkRect bounds() const {
+            return fast_bounds(SkRect::MakeXYWH(x,y, image->width(), image->height()), paint);
+        }
     };
     struct DrawImageNine final : Op {
         static const auto kType = Type::DrawImageNine;
@@ -298,6 +344,7 @@ namespace {
         void draw(SkCanvas* c, const SkMatrix&) const {
             c->drawImageNine(image.get(), center, dst, &paint);
         }
+        SkRect bounds() const { return fast_bounds(dst.makeSorted(), paint); }
     };
     struct DrawImageRect final : Op {
         static const auto kType = Type::DrawImageRect;
@@ -314,6 +361,7 @@ namespace {
         void draw(SkCanvas* c, const SkMatrix&) const {
             c->drawImageRect(image.get(), src, dst, &paint, constraint);
         }
+        SkRect bounds() const { return fast_bounds(dst.makeSorted(), paint); }
     };
     struct DrawImageLattice final : Op {
         static const auto kType = Type::DrawImageLattice;
@@ -338,6 +386,7 @@ namespace {
             c->drawImageLattice(image.get(), {xdivs, ydivs, flags, xs, ys, &src, colors}, dst,
                                 &paint);
         }
+        SkRect bounds() const { return fast_bounds(dst.makeSorted(), paint); }
     };
 
     struct DrawText final : Op {
@@ -392,6 +441,7 @@ namespace {
         void draw(SkCanvas* c, const SkMatrix&) const {
             c->drawTextOnPath(pod<void>(this), bytes, path, &matrix, paint);
         }
+        void makeThreadsafe() { make_threadsafe(&path, &matrix); }
     };
     struct DrawTextRSXform final : Op {
         static const auto kType = Type::DrawTextRSXform;
@@ -422,6 +472,7 @@ namespace {
         void draw(SkCanvas* c, const SkMatrix&) const {
             c->drawTextBlob(blob.get(), x,y, paint);
         }
+        SkRect bounds() const { return fast_bounds(blob->bounds().makeOffset(x,y), paint); }
     };
 
     struct DrawPatch final : Op {
@@ -502,6 +553,7 @@ namespace {
         void draw(SkCanvas* c, const SkMatrix&) const {
             c->private_draw_shadow_rec(fPath, fRec);
         }
+        void makeThreadsafe() { make_threadsafe(&fPath, nullptr); }
     };
 }
 
@@ -516,6 +568,9 @@ void* SkLiteDL::push(size_t pod, Args&&... args) {
         fBytes.realloc(fReserved);
     }
     SkASSERT(fUsed + skip <= fReserved);
+    if (!fBounds.isEmpty()) {
+        this->thaw();  // Any new op thaws a frozen display list.
+    }
     auto op = (T*)(fBytes.get() + fUsed);
     fUsed += skip;
     new (op) T{ std::forward<Args>(args)... };
@@ -696,15 +751,9 @@ void SkLiteDL::drawShadowRec(const SkPath& path, const SkDrawShadowRec& rec) {
     this->push<DrawShadowRec>(0, path, rec);
 }
 
-typedef void(*draw_fn)(const void*,  SkCanvas*, const SkMatrix&);
 typedef void(*void_fn)(const void*);
-
-// All ops implement draw().
-#define M(T) [](const void* op, SkCanvas* c, const SkMatrix& original) { \
-    ((const T*)op)->draw(c, original);                                         \
-},
-static const draw_fn draw_fns[] = { TYPES(M) };
-#undef M
+typedef void(*freeze_fn)(void*, SkRect*);
+typedef void(*thaw_fn)(void*);
 
 // Older libstdc++ has pre-standard std::has_trivial_destructor.
 #if defined(__GLIBCXX__) && (__GLIBCXX__ < 20130000)
@@ -719,9 +768,84 @@ static const draw_fn draw_fns[] = { TYPES(M) };
 static const void_fn dtor_fns[] = { TYPES(M) };
 #undef M
 
+// Ops with anything to precompute implement makeThreadsafe(), and draws we can cull bounds().
+template <typename T>
+static auto freeze_op(T* op, int) -> decltype(op->makeThreadsafe()) { op->makeThreadsafe(); }
+template <typename T>
+static void freeze_op(T*, ...) {}
+
+template <typename T>
+static auto op_bounds(const T* op, int) -> decltype(op->bounds()) { return op->bounds(); }
+template <typename T>
+static SkRect op_bounds(const T*, ...) { return kUnset; }
+
+#define M(T) [](void* op, SkRect* bounds) { \
+    freeze_op((T*)op, 0);                      \
+    *bounds = op_bounds((const T*)op, 0);      \
+},
+static const freeze_fn freeze_fns[] = { TYPES(M) };
+#undef M
+
+// Ops that froze more than a cache implement thaw() to go back to drawing live.
+template <typename T>
+static auto thaw_op(T* op, int) -> decltype(op->thaw()) { op->thaw(); }
+template <typename T>
+static void thaw_op(T*, ...) {}
+
+#define M(T) [](void* op) { thaw_op((T*)op, 0); },
+static const thaw_fn thaw_fns[] = { TYPES(M) };
+#undef M
+
 void SkLiteDL::draw(SkCanvas* canvas) const {
     SkAutoCanvasRestore acr(canvas, false);
-    this->map(draw_fns, canvas, canvas->getTotalMatrix());
+    const SkMatrix original = canvas->getTotalMatrix();
+
+    // Once frozen, we have bounds for each op, and skip any draw the canvas would reject anyway.
+    const SkRect* bounds = fBounds.isEmpty() ? nullptr : fBounds.begin();
+
+    auto end = fBytes.get() + fUsed;
+    for (const uint8_t* ptr = fBytes.get(); ptr < end; ) {
+        auto op = (const Op*)ptr;
+        ptr += op->skip;
+
+        if (bounds) {
+            const SkRect& opBounds = *bounds++;
+            if (opBounds.left() != SK_ScalarInfinity &&
+#ifdef SK_SUPPORT_LEGACY_DRAWFILTER
+                    !canvas->getDrawFilter() &&  // A draw filter may change the paint.
+#endif
+                    canvas->quickReject(opBounds)) {
+                continue;
+            }
+        }
+
+        // A switch over every type lets the compiler inline each op's draw().
+        switch ((Type)op->type) {
+        #define M(T) case Type::T: ((const T*)op)->draw(canvas, original); break;
+            TYPES(M)
+        #undef M
+        }
+    }
+}
+
+void SkLiteDL::makeThreadsafe() {
+    fBounds.rewind();
+    auto end = fBytes.get() + fUsed;
+    for (uint8_t* ptr = fBytes.get(); ptr < end; ) {
+        auto op = (Op*)ptr;
+        freeze_fns[op->type](op, fBounds.append());
+        ptr += op->skip;
+    }
+}
+
+void SkLiteDL::thaw() {
+    auto end = fBytes.get() + fUsed;
+    for (uint8_t* ptr = fBytes.get(); ptr < end; ) {
+        auto op = (Op*)ptr;
+        thaw_fns[op->type](op);
+        ptr += op->skip;
+    }
+    fBounds.rewind();
 }
 
 SkLiteDL::~SkLiteDL() {
@@ -733,4 +857,5 @@ void SkLiteDL::reset() {
 
     // Leave fBytes and fReserved alone.
     fUsed   = 0;
+    fBounds.rewind();
 }
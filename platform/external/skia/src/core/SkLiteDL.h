@@ -25,6 +25,12 @@ public:
     void reset();
     bool empty() const { return fUsed == 0; }
 
+    // Precomputes what draw() would otherwise compute lazily, so several threads may draw()
+    // this display list at once, and the bounds of each op, so draw() can skip those the canvas
+    // would reject.  Drawables are snapshotted as they draw now.  Recording more ops, or reset(),
+    // thaws the display list again.
+    void makeThreadsafe();
+
 #ifdef SK_SUPPORT_LEGACY_DRAWFILTER
     void setDrawFilter(SkDrawFilter*);
 #endif
@@ -88,9 +94,12 @@ private:
     template <typename Fn, typename... Args>
     void map(const Fn[], Args...) const;
 
+    void thaw();
+
     SkAutoTMalloc<uint8_t> fBytes;
     size_t                 fUsed = 0;
     size_t                 fReserved = 0;
+    SkTDArray<SkRect>      fBounds;    // One per op once frozen by makeThreadsafe(), else empty.
 };
 
 #endif//SkLiteDL_DEFINED
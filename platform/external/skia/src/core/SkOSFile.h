@@ -49,6 +49,17 @@ void*   sk_fdmmap(int fd, size_t* length);
  */
 void    sk_fmunmap(const void* addr, size_t length);
 
+enum SkFILE_Access {
+    kNormal_SkFILE_Access,
+    kSequential_SkFILE_Access,  // Read front to back, all of it and soon.
+    kRandom_SkFILE_Access       // Read here and there, often only in small part.
+};
+
+/** Tells the OS how a mapping from sk_fmmap or sk_fdmmap is going to be read, so that it can read
+ *  ahead of it, or not. This is only a hint, and may do nothing.
+ */
+void    sk_fmadvise(const void* addr, size_t length, SkFILE_Access);
+
 /** Returns true if the two point at the exact same filesystem object. */
 bool    sk_fidentical(FILE* a, FILE* b);
 
@@ -65,6 +76,11 @@ bool    sk_exists(const char *path, SkFILE_Flags = (SkFILE_Flags)0);
 // Returns true if a directory exists at this path.
 bool    sk_isdir(const char *path);
 
+/** Gets the size of the file at this path, and when it was last modified (in seconds).
+ *  Returns false if there is no such file.
+ */
+bool    sk_stat(const char path[], size_t* size, int64_t* modified);
+
 // Like pread, but may affect the file position marker.
 // Returns the number of bytes read or SIZE_MAX if failed.
 size_t sk_qread(FILE*, void* buffer, size_t count, size_t offset);
@@ -86,6 +86,7 @@ namespace SkOpts {
     void Init_sse41();
     void Init_sse42();
     void Init_avx();
+    void Init_hsw();
     void Init_crc32();
 
     static void init() {
@@ -107,6 +108,10 @@ namespace SkOpts {
             if (SkCpu::Supports(SkCpu::AVX  )) { Init_avx();   }
         #endif
 
+        #if SK_CPU_SSE_LEVEL < SK_CPU_SSE_LEVEL_AVX2
+            if (SkCpu::Supports(SkCpu::HSW  )) { Init_hsw();   }
+        #endif
+
     #elif defined(SK_CPU_ARM64)
         if (SkCpu::Supports(SkCpu::CRC32)) { Init_crc32(); }
 
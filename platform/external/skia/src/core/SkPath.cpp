@@ -369,6 +369,12 @@ void SkPath::rewind() {
     this->resetFields();
 }
 
+void SkPath::intern() {
+    SkDEBUGCODE(this->validate();)
+
+    fPathRef = SkPathRef::Intern(std::move(fPathRef));
+}
+
 bool SkPath::isLastContourClosed() const {
     int verbCount = fPathRef->countVerbs();
     if (0 == verbCount) {
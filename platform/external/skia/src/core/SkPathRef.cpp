@@ -8,10 +8,15 @@
 #include "SkBuffer.h"
 #include "SkNx.h"
 #include "SkOnce.h"
+#include "SkOpts.h"
 #include "SkPath.h"
 #include "SkPathRef.h"
 #include "SkPathPriv.h"
 #include "SkSafeMath.h"
+#include "SkTArray.h"
+#include "SkTHash.h"
+
+#include <vector>
 
 // Conic weights must be 0 < weight <= finite
 static bool validate_conic_weights(const SkScalar weights[], int count) {
@@ -474,6 +479,142 @@ void SkPathRef::copy(const SkPathRef& ref,
     SkDEBUGCODE(this->validate();)
 }
 
+SkPathRef* SkPathRef::CreateCompactCopy(const SkPathRef& ref) {
+    SkPathRef* copy = new SkPathRef;
+    // With exactly enough free space up front, copy() keeps this allocation rather than growing
+    // it to kMinSize.
+    const size_t size = ref.fVerbCnt * sizeof(uint8_t) + ref.fPointCnt * sizeof(SkPoint);
+    copy->fPoints = reinterpret_cast<SkPoint*>(sk_malloc_throw(size));
+    copy->fVerbs = SkTAddOffset<uint8_t>(copy->fPoints, size);
+    copy->fFreeSpace = size;
+    copy->copy(ref, 0, 0);
+    copy->fConicWeights.shrinkToFit();
+    SkASSERT(0 == copy->fFreeSpace);
+    return copy;
+}
+
+uint32_t SkPathRef::contentHash() const {
+    uint32_t hash = SkOpts::hash(this->verbsMemBegin(), fVerbCnt * sizeof(uint8_t));
+    hash = SkOpts::hash(fPoints, fPointCnt * sizeof(SkPoint), hash);
+    return SkOpts::hash(fConicWeights.begin(), fConicWeights.bytes(), hash);
+}
+
+bool SkPathRef::sameContents(const SkPathRef& ref) const {
+    if (fIsOval != ref.fIsOval || fIsRRect != ref.fIsRRect) {
+        return false;
+    }
+    if ((fIsOval || fIsRRect) && (fRRectOrOvalIsCCW != ref.fRRectOrOvalIsCCW ||
+                                  fRRectOrOvalStartIdx != ref.fRRectOrOvalStartIdx)) {
+        return false;
+    }
+    return *this == ref;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// Interned path refs by contentHash(). Nearly every hash holds a single path ref.
+using InternedRefs = std::vector<sk_sp<SkPathRef>>;
+using InternTable = SkTHashMap<uint32_t, InternedRefs>;
+
+// The table is purged of unused path refs whenever it grows past twice the size it had after the
+// last purge, and never below this size.
+constexpr int kMinInternedPurgeCount = 1024;
+
+}  // namespace
+
+SK_DECLARE_STATIC_MUTEX(gInternMutex);
+static InternTable* gInterned;         // guarded by gInternMutex
+static int gInternedCount;             // guarded by gInternMutex
+static int gInternedPurgeCount = kMinInternedPurgeCount;  // guarded by gInternMutex
+
+// Must be called holding gInternMutex.
+static int purge_interned() {
+    if (!gInterned) {
+        return 0;
+    }
+    int purged = 0;
+    SkTArray<uint32_t> emptyHashes;
+    gInterned->foreach([&](uint32_t hash, InternedRefs* refs) {
+        for (size_t i = refs->size(); i-- > 0;) {
+            // Only the table can hand out another ref to a unique path ref, and we hold its lock.
+            if ((*refs)[i]->unique()) {
+                (*refs)[i] = std::move(refs->back());
+                refs->pop_back();
+                ++purged;
+            }
+        }
+        if (refs->empty()) {
+            emptyHashes.push_back(hash);
+        }
+    });
+    for (uint32_t hash : emptyHashes) {
+        gInterned->remove(hash);
+    }
+    gInternedCount -= purged;
+    gInternedPurgeCount = SkTMax(2 * gInternedCount, kMinInternedPurgeCount);
+    return purged;
+}
+
+sk_sp<SkPathRef> SkPathRef::Intern(sk_sp<SkPathRef> pathRef) {
+    SkASSERT(pathRef);
+    if (0 == pathRef->fVerbCnt) {
+        return pathRef;
+    }
+    const uint32_t hash = pathRef->contentHash();
+
+    SkAutoMutexAcquire lock(gInternMutex);
+    if (!gInterned) {
+        gInterned = new InternTable;
+    }
+    if (gInternedCount >= gInternedPurgeCount) {
+        purge_interned();
+    }
+    InternedRefs* refs = gInterned->find(hash);
+    if (refs) {
+        for (const sk_sp<SkPathRef>& ref : *refs) {
+            if (ref == pathRef || ref->sameContents(*pathRef)) {
+                return ref;
+            }
+        }
+    } else {
+        refs = gInterned->set(hash, InternedRefs());
+    }
+
+    if (pathRef->fFreeSpace || pathRef->fConicWeights.reserved() > pathRef->countWeights()) {
+        pathRef.reset(CreateCompactCopy(*pathRef));
+    }
+    // Settle the lazily computed state now, while no one else can see this path ref.
+    if (pathRef->unique()) {
+        pathRef->getBounds();
+        pathRef->genID();
+    }
+    refs->push_back(pathRef);
+    ++gInternedCount;
+    return pathRef;
+}
+
+int SkPathRef::PurgeInterned() {
+    SkAutoMutexAcquire lock(gInternMutex);
+    return purge_interned();
+}
+
+int SkPathRef::CountInterned(size_t* bytes) {
+    SkAutoMutexAcquire lock(gInternMutex);
+    if (bytes) {
+        *bytes = 0;
+        if (gInterned) {
+            gInterned->foreach([bytes](uint32_t, InternedRefs* refs) {
+                for (const sk_sp<SkPathRef>& ref : *refs) {
+                    *bytes += ref->approximateBytesUsed();
+                }
+            });
+        }
+    }
+    return gInternedCount;
+}
+
 unsigned SkPathRef::computeSegmentMask() const {
     const uint8_t* verbs = this->verbsMemBegin();
     unsigned mask = 0;
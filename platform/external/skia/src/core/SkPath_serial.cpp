@@ -8,15 +8,18 @@
 #include <cmath>
 #include "SkBuffer.h"
 #include "SkData.h"
+#include "SkFloatBits.h"
 #include "SkMath.h"
 #include "SkPathPriv.h"
 #include "SkPathRef.h"
 #include "SkRRect.h"
 #include "SkSafeMath.h"
+#include "SkTemplates.h"
 
 enum SerializationOffsets {
     kType_SerializationShift = 28,       // requires 4 bits
     kDirection_SerializationShift = 26,  // requires 2 bits
+    kFracBits_SerializationShift = 16,   // requires 4 bits, kCompact only
     kFillType_SerializationShift = 8,    // requires 8 bits
     // low-8-bits are version
     kVersion_SerializationMask = 0xFF,
@@ -27,13 +30,15 @@ enum SerializationVersions {
     kPathPrivLastMoveToIndex_Version = 2,
     kPathPrivTypeEnumVersion = 3,
     kJustPublicData_Version = 4,    // introduced Feb/2018
+    kCompactPoints_Version = 5,     // kCompact serialization type
 
-    kCurrent_Version = kJustPublicData_Version
+    kCurrent_Version = kCompactPoints_Version
 };
 
 enum SerializationType {
     kGeneral = 0,
-    kRRect = 1
+    kRRect = 1,
+    kCompact = 2,   // kGeneral, with points in 16-bit fixed point
 };
 
 static unsigned extract_version(uint32_t packed) {
@@ -48,6 +53,43 @@ static SerializationType extract_serializationtype(uint32_t packed) {
     return static_cast<SerializationType>((packed >> kType_SerializationShift) & 0xF);
 }
 
+static int extract_fracbits(uint32_t packed) {
+    return (packed >> kFracBits_SerializationShift) & 0xF;
+}
+
+// Returns the number of fraction bits of a 16-bit fixed point that holds every coordinate of pts
+// exactly, or -1 if there is none. Integer and simple fractional coordinates, as in icons and
+// hinted outlines, usually fit.
+static int compact_frac_bits(const SkPoint pts[], int count) {
+    const SkScalar* coords = &pts[0].fX;
+    SkScalar maxAbs = 0;
+    for (int i = 0; i < 2 * count; ++i) {
+        const SkScalar abs = SkScalarAbs(coords[i]);
+        if (!(abs <= maxAbs)) {     // also catches NaN
+            maxAbs = abs;
+        }
+    }
+    // Use as many fraction bits as the largest coordinate allows: if any number of bits holds
+    // every coordinate exactly, so does that many.
+    int fracBits = 15;
+    while (fracBits >= 0 && !(maxAbs * (1 << fracBits) <= SK_MaxS16)) {
+        --fracBits;
+    }
+    if (fracBits < 0) {
+        return -1;
+    }
+    const SkScalar scale = SkIntToScalar(1 << fracBits),
+                   invScale = 1 / scale;
+    for (int i = 0; i < 2 * count; ++i) {
+        // Compare bits, so -0 (which would come back as 0) is not compacted.
+        const SkScalar decoded = (int16_t)(coords[i] * scale) * invScale;
+        if (SkFloat2Bits(decoded) != SkFloat2Bits(coords[i])) {
+            return -1;
+        }
+    }
+    return fracBits;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 size_t SkPath::writeToMemoryAsRRect(void* storage) const {
@@ -91,17 +133,26 @@ size_t SkPath::writeToMemory(void* storage) const {
         return bytes;
     }
 
-    int32_t packed = (fFillType << kFillType_SerializationShift) |
-                     (SerializationType::kGeneral << kType_SerializationShift) |
-                     kCurrent_Version;
-
     int32_t pts = fPathRef->countPoints();
     int32_t cnx = fPathRef->countWeights();
     int32_t vbs = fPathRef->countVerbs();
 
+    // Points that fit 16-bit fixed point are written in half the space.
+    const int fracBits = pts ? compact_frac_bits(fPathRef->points(), pts) : -1;
+    const bool compact = fracBits >= 0;
+
+    int32_t packed = (fFillType << kFillType_SerializationShift) |
+                     kCurrent_Version;
+    if (compact) {
+        packed |= (SerializationType::kCompact << kType_SerializationShift) |
+                  (fracBits << kFracBits_SerializationShift);
+    } else {
+        packed |= SerializationType::kGeneral << kType_SerializationShift;
+    }
+
     SkSafeMath safe;
     size_t size = 4 * sizeof(int32_t);
-    size = safe.add(size, safe.mul(pts, sizeof(SkPoint)));
+    size = safe.add(size, safe.mul(pts, compact ? sizeof(SkIPoint16) : sizeof(SkPoint)));
     size = safe.add(size, safe.mul(cnx, sizeof(SkScalar)));
     size = safe.add(size, safe.mul(vbs, sizeof(uint8_t)));
     size = safe.alignUp(size, 4);
@@ -117,7 +168,16 @@ size_t SkPath::writeToMemory(void* storage) const {
     buffer.write32(pts);
     buffer.write32(cnx);
     buffer.write32(vbs);
-    buffer.write(fPathRef->points(), pts * sizeof(SkPoint));
+    if (compact) {
+        SkIPoint16* fixed = static_cast<SkIPoint16*>(buffer.skip(pts * sizeof(SkIPoint16)));
+        const SkScalar scale = SkIntToScalar(1 << fracBits);
+        const SkPoint* points = fPathRef->points();
+        for (int i = 0; i < pts; ++i) {
+            fixed[i].set((int16_t)(points[i].fX * scale), (int16_t)(points[i].fY * scale));
+        }
+    } else {
+        buffer.write(fPathRef->points(), pts * sizeof(SkPoint));
+    }
     buffer.write(fPathRef->conicWeights(), cnx * sizeof(SkScalar));
     buffer.write(fPathRef->verbsMemBegin(), vbs * sizeof(uint8_t));
     buffer.padToAlign4();
@@ -146,8 +206,8 @@ size_t SkPath::readFromMemory(const void* storage, size_t length) {
     if (version <= kPathPrivTypeEnumVersion) {
         return this->readFromMemory_LE3(storage, length);
     }
-    if (version == kJustPublicData_Version) {
-        return this->readFromMemory_EQ4(storage, length);
+    if (version == kJustPublicData_Version || version == kCompactPoints_Version) {
+        return this->readFromMemory_EQ4Or5(storage, length);
     }
     return 0;
 }
@@ -190,20 +250,27 @@ size_t SkPath::readAsRRect(const void* storage, size_t length) {
     return buffer.pos();
 }
 
-size_t SkPath::readFromMemory_EQ4(const void* storage, size_t length) {
+size_t SkPath::readFromMemory_EQ4Or5(const void* storage, size_t length) {
     SkRBuffer buffer(storage, length);
     uint32_t packed;
     if (!buffer.readU32(&packed)) {
         return 0;
     }
 
-    SkASSERT(extract_version(packed) == 4);
+    const unsigned version = extract_version(packed);
+    SkASSERT(version == 4 || version == 5);
 
-    switch (extract_serializationtype(packed)) {
+    const SerializationType type = extract_serializationtype(packed);
+    switch (type) {
         case SerializationType::kRRect:
             return this->readAsRRect(storage, length);
         case SerializationType::kGeneral:
             break;  // fall through
+        case SerializationType::kCompact:
+            if (version < kCompactPoints_Version) {
+                return 0;
+            }
+            break;  // fall through
         default:
             return 0;
     }
@@ -213,7 +280,13 @@ size_t SkPath::readFromMemory_EQ4(const void* storage, size_t length) {
         return 0;
     }
 
-    const SkPoint* points = buffer.skipCount<SkPoint>(pts);
+    const SkPoint* points = nullptr;
+    const SkIPoint16* fixed = nullptr;
+    if (SerializationType::kCompact == type) {
+        fixed = buffer.skipCount<SkIPoint16>(pts);
+    } else {
+        points = buffer.skipCount<SkPoint>(pts);
+    }
     const SkScalar* conics = buffer.skipCount<SkScalar>(cnx);
     const uint8_t* verbs = buffer.skipCount<uint8_t>(vbs);
     buffer.skipToAlign4();
@@ -222,6 +295,16 @@ size_t SkPath::readFromMemory_EQ4(const void* storage, size_t length) {
     }
     SkASSERT(buffer.pos() <= length);
 
+    SkAutoSTMalloc<32, SkPoint> decoded;
+    if (fixed) {
+        const SkScalar invScale = 1 / SkIntToScalar(1 << extract_fracbits(packed));
+        decoded.reset(pts);
+        for (int i = 0; i < pts; ++i) {
+            decoded[i].set(fixed[i].fX * invScale, fixed[i].fY * invScale);
+        }
+        points = decoded.get();
+    }
+
 #define CHECK_POINTS_CONICS(p, c)       \
     do {                                \
         if (p && ((pts -= p) < 0)) {    \
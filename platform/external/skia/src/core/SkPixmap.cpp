@@ -6,6 +6,7 @@
  */
 
 #include "SkBitmap.h"
+#include "SkBitmapScaler.h"
 #include "SkCanvas.h"
 #include "SkColorData.h"
 #include "SkConvertPixels.h"
@@ -246,6 +247,14 @@ bool SkPixmap::scalePixels(const SkPixmap& actualDst, SkFilterQuality quality) c
         return src.readPixels(dst);
     }
 
+    // When shrinking either way, resample with a proper filter rather than a bicubic that
+    // only looks at the nearest 4x4 source pixels.
+    if (kHigh_SkFilterQuality == quality &&
+        (dst.width() < src.width() || dst.height() < src.height()) &&
+        SkBitmapScaler::Resize(dst, src, SkBitmapScaler::kLanczos3_ResizeMethod)) {
+        return true;
+    }
+
     // If src and dst are both unpremul, we'll fake them out to appear as if premul.
     bool clampAsIfUnpremul = false;
     if (src.alphaType() == kUnpremul_SkAlphaType &&
@@ -240,26 +240,76 @@ bool SkRasterClip::setPath(const SkPath& path, const SkRegion& clip, bool doAA)
     return this->updateCacheAndReturnNonEmpty();
 }
 
+bool SkRasterClip::setAAClip(const SkAAClip& clip) {
+    AUTO_RASTERCLIP_VALIDATE(*this);
+
+    fIsBW = false;
+    fAA = clip;
+    return this->updateCacheAndReturnNonEmpty();
+}
+
 bool SkRasterClip::op(const SkRRect& rrect, const SkMatrix& matrix, const SkIRect& devBounds,
                       SkRegion::Op op, bool doAA) {
-    SkIRect bounds(devBounds);
-    this->applyClipRestriction(op, &bounds);
+    if (rrect.isRect()) {
+        return this->op(rrect.getBounds(), matrix, devBounds, op, doAA);
+    }
+
+    // Intersecting a rect clip with an rrect that contains it, or misses it, needs no mask.
+    if (SkRegion::kIntersect_Op == op && this->isRect()) {
+        SkRRect devRRect;
+        if (rrect.transform(matrix, &devRRect)) {
+            const SkRect devClip = SkRect::Make(this->getBounds());
+            if (devRRect.contains(devClip)) {
+                return true;
+            }
+            if (!SkRect::Intersects(devRRect.getBounds(), devClip)) {
+                return this->setEmpty();
+            }
+        }
+    }
 
     SkPath path;
     path.addRRect(rrect);
 
-    return this->op(path, matrix, bounds, op, doAA);
+    return this->opPath(path, matrix, devBounds, op, doAA, SkAAClipCache::Source(rrect, matrix));
 }
 
 bool SkRasterClip::op(const SkPath& path, const SkMatrix& matrix, const SkIRect& devBounds,
                       SkRegion::Op op, bool doAA) {
+    return this->opPath(path, matrix, devBounds, op, doAA, SkAAClipCache::Source(path, matrix));
+}
+
+bool SkRasterClip::opPath(const SkPath& path, const SkMatrix& matrix, const SkIRect& devBounds,
+                          SkRegion::Op op, bool doAA, const SkAAClipCache::Source& source) {
     AUTO_RASTERCLIP_VALIDATE(*this);
     SkIRect bounds(devBounds);
     this->applyClipRestriction(op, &bounds);
 
-    // base is used to limit the size (and therefore memory allocation) of the
-    // region that results from scan converting devPath.
-    SkRegion base;
+    // limit is used to limit the size (and therefore memory allocation) of the
+    // clip that results from scan converting devPath. If we are intersect, we
+    // can do better (tighter) with our own bounds, than just using the device.
+    const SkIRect limit = SkRegion::kIntersect_Op == op ? this->getBounds() : bounds;
+
+    // If we are intersecting with a rect (which the scan converted path lies within), or
+    // replacing, the scan converted path becomes our clip. Otherwise, if we are complex, our
+    // region blitter may hork, so we do that case in two steps.
+    // FIXME: we should also be able to set the path directly when this->isBW(),
+    // but relaxing the test above triggers GM asserts in
+    // SkRgnBuilder::blitH(). We need to investigate what's going on.
+    const bool setDirectly = SkRegion::kReplace_Op == op ||
+                             (SkRegion::kIntersect_Op == op && this->isRect());
+
+    // Building AA clips is expensive, and the same clip is often set again and again.
+    const bool useCache = doAA && source.isCacheable() && !limit.isEmpty();
+    SkAAClip cached;
+    if (useCache && SkAAClipCache::Find(source, limit, &cached)) {
+        if (setDirectly) {
+            return this->setAAClip(cached);
+        }
+        SkRasterClip clip;
+        clip.setAAClip(cached);
+        return this->op(clip, op);
+    }
 
     SkPath devPath;
     if (matrix.isIdentity()) {
@@ -268,32 +318,24 @@ bool SkRasterClip::op(const SkPath& path, const SkMatrix& matrix, const SkIRect&
         path.transform(matrix, &devPath);
         devPath.setIsVolatile(true);
     }
-    if (SkRegion::kIntersect_Op == op) {
-        // since we are intersect, we can do better (tighter) with currRgn's
-        // bounds, than just using the device. However, if currRgn is complex,
-        // our region blitter may hork, so we do that case in two steps.
-        if (this->isRect()) {
-            // FIXME: we should also be able to do this when this->isBW(),
-            // but relaxing the test above triggers GM asserts in
-            // SkRgnBuilder::blitH(). We need to investigate what's going on.
-            return this->setPath(devPath, this->bwRgn(), doAA);
-        } else {
-            base.setRect(this->getBounds());
-            SkRasterClip clip;
-            clip.setPath(devPath, base, doAA);
-            return this->op(clip, op);
-        }
-    } else {
-        base.setRect(bounds);
 
-        if (SkRegion::kReplace_Op == op) {
-            return this->setPath(devPath, base, doAA);
-        } else {
-            SkRasterClip clip;
-            clip.setPath(devPath, base, doAA);
-            return this->op(clip, op);
+    SkRegion base;
+    base.setRect(limit);
+
+    if (setDirectly) {
+        bool nonEmpty = this->setPath(devPath, base, doAA);
+        if (useCache && this->isAA()) {
+            SkAAClipCache::Add(source, limit, fAA);
         }
+        return nonEmpty;
+    }
+
+    SkRasterClip clip;
+    clip.setPath(devPath, base, doAA);
+    if (useCache && clip.isAA()) {
+        SkAAClipCache::Add(source, limit, clip.aaRgn());
     }
+    return this->op(clip, op);
 }
 
 bool SkRasterClip::setPath(const SkPath& path, const SkIRect& clip, bool doAA) {
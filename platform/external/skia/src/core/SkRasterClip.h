@@ -10,6 +10,7 @@
 
 #include "SkRegion.h"
 #include "SkAAClip.h"
+#include "SkAAClipCache.h"
 
 class SkRRect;
 
@@ -164,6 +165,9 @@ private:
 
     bool setPath(const SkPath& path, const SkRegion& clip, bool doAA);
     bool setPath(const SkPath& path, const SkIRect& clip, bool doAA);
+    bool setAAClip(const SkAAClip&);
+    bool opPath(const SkPath&, const SkMatrix&, const SkIRect&, SkRegion::Op, bool doAA,
+                const SkAAClipCache::Source&);
     bool op(const SkRasterClip&, SkRegion::Op);
     bool setConservativeRect(const SkRect& r, const SkIRect& clipR, bool isInverse);
 
@@ -103,7 +103,8 @@ struct SkJumper_Engine;
     M(byte_tables) M(byte_tables_rgb)                              \
     M(rgb_to_hsl) M(hsl_to_rgb)                                    \
     M(clut_3D) M(clut_4D)                                          \
-    M(gauss_a_to_rgba)
+    M(gauss_a_to_rgba)                                             \
+    M(perlin_noise) M(improved_noise)
 
 class SkRasterPipeline {
 public:
@@ -225,6 +225,42 @@ static bool isRunCountEmpty(int count) {
     return count <= 2;
 }
 
+// Trims off any empty spans from the top and bottom of runs that hold more than a single rect,
+// returning the new start of the runs and updating count.
+// weird I should need this, perhaps op() could be smarter...
+static SkRegion::RunType* trim_empty_spans(SkRegion::RunType runs[], int* count) {
+    SkRegion::RunType* stop = runs + *count;
+    assert_sentinel(runs[0], false);    // top
+    assert_sentinel(runs[1], false);    // bottom
+    // runs[2] is uncomputed intervalCount
+
+    if (runs[3] == SkRegion::kRunTypeSentinel) {  // should be first left...
+        runs += 3;  // skip empty initial span
+        runs[0] = runs[-2]; // set new top to prev bottom
+        assert_sentinel(runs[1], false);    // bot: a sentinal would mean two in a row
+        assert_sentinel(runs[2], false);    // intervalcount
+        assert_sentinel(runs[3], false);    // left
+        assert_sentinel(runs[4], false);    // right
+    }
+
+    assert_sentinel(stop[-1], true);
+    assert_sentinel(stop[-2], true);
+
+    // now check for a trailing empty span
+    if (stop[-5] == SkRegion::kRunTypeSentinel) { // eek, stop[-4] was a bottom with no x-runs
+        stop[-4] = SkRegion::kRunTypeSentinel;    // kill empty last span
+        stop -= 3;
+        assert_sentinel(stop[-1], true);    // last y-sentinel
+        assert_sentinel(stop[-2], true);    // last x-sentinel
+        assert_sentinel(stop[-3], false);   // last right
+        assert_sentinel(stop[-4], false);   // last left
+        assert_sentinel(stop[-5], false);   // last interval-count
+        assert_sentinel(stop[-6], false);   // last bottom
+    }
+    *count = (int)(stop - runs);
+    return runs;
+}
+
 bool SkRegion::setRuns(RunType runs[], int count) {
     SkDEBUGCODE(this->validate();)
     SkASSERT(count > 0);
@@ -235,38 +271,8 @@ bool SkRegion::setRuns(RunType runs[], int count) {
         return this->setEmpty();
     }
 
-    // trim off any empty spans from the top and bottom
-    // weird I should need this, perhaps op() could be smarter...
     if (count > kRectRegionRuns) {
-        RunType* stop = runs + count;
-        assert_sentinel(runs[0], false);    // top
-        assert_sentinel(runs[1], false);    // bottom
-        // runs[2] is uncomputed intervalCount
-
-        if (runs[3] == SkRegion::kRunTypeSentinel) {  // should be first left...
-            runs += 3;  // skip empty initial span
-            runs[0] = runs[-2]; // set new top to prev bottom
-            assert_sentinel(runs[1], false);    // bot: a sentinal would mean two in a row
-            assert_sentinel(runs[2], false);    // intervalcount
-            assert_sentinel(runs[3], false);    // left
-            assert_sentinel(runs[4], false);    // right
-        }
-
-        assert_sentinel(stop[-1], true);
-        assert_sentinel(stop[-2], true);
-
-        // now check for a trailing empty span
-        if (stop[-5] == SkRegion::kRunTypeSentinel) { // eek, stop[-4] was a bottom with no x-runs
-            stop[-4] = SkRegion::kRunTypeSentinel;    // kill empty last span
-            stop -= 3;
-            assert_sentinel(stop[-1], true);    // last y-sentinel
-            assert_sentinel(stop[-2], true);    // last x-sentinel
-            assert_sentinel(stop[-3], false);   // last right
-            assert_sentinel(stop[-4], false);   // last left
-            assert_sentinel(stop[-5], false);   // last interval-count
-            assert_sentinel(stop[-6], false);   // last bottom
-        }
-        count = (int)(stop - runs);
+        runs = trim_empty_spans(runs, &count);
     }
 
     SkASSERT(count >= kRectRegionRuns);
@@ -299,6 +305,54 @@ bool SkRegion::setRuns(RunType runs[], int count) {
     return true;
 }
 
+bool SkRegion::adoptRuns(RunHead* head, int count) {
+    SkASSERT(head && 1 == head->fRefCnt);
+    SkASSERT(count > 0 && count <= head->fRunCount);
+
+    RunType* runs = head->writable_runs();
+    if (isRunCountEmpty(count)) {
+        assert_sentinel(runs[count-1], true);
+        sk_free(head);
+        return this->setEmpty();
+    }
+
+    if (count > kRectRegionRuns) {
+        RunType* trimmed = trim_empty_spans(runs, &count);
+        if (trimmed != runs) {
+            memmove(runs, trimmed, count * sizeof(RunType));
+        }
+    }
+
+    SkASSERT(count >= kRectRegionRuns);
+
+    SkIRect bounds;
+    if (SkRegion::RunsAreARect(runs, count, &bounds)) {
+        sk_free(head);
+        return this->setRect(bounds);
+    }
+
+    // head was sized for the worst case, so give back what the runs did not use.
+    if (count < head->fRunCount) {
+        head = (RunHead*)sk_realloc_throw(head, sizeof(RunHead) + count * sizeof(RunType));
+        head->fRunCount = count;
+    }
+    head->computeRunBounds(&bounds);
+
+    // Our computed bounds might be too large, so we have to check here.
+    if (bounds.isEmpty()) {
+        sk_free(head);
+        return this->setEmpty();
+    }
+
+    this->freeRuns();
+    fRunHead = head;
+    fBounds = bounds;
+
+    SkDEBUGCODE(this->validate();)
+
+    return true;
+}
+
 void SkRegion::BuildRectRuns(const SkIRect& bounds,
                              RunType runs[kRectRegionRuns]) {
     runs[0] = bounds.fTop;
@@ -711,6 +765,35 @@ static SkRegion::RunType* operate_on_span(const SkRegion::RunType a_runs[],
                                           const SkRegion::RunType b_runs[],
                                           SkRegion::RunType dst[],
                                           int min, int max) {
+    // Scanlines where one side has no intervals, or where both sides are the same, are common
+    // (e.g. every scanline of a region above or below a rect being op'ed into it). Their result
+    // is either nothing or one side's intervals verbatim, so copy those in bulk instead of
+    // merging them one edge at a time. The interval-count sits just before the intervals.
+    const int a_count = a_runs[-1];
+    const int b_count = b_runs[-1];
+    SkASSERT(a_runs[2 * a_count] == SkRegion::kRunTypeSentinel);
+    SkASSERT(b_runs[2 * b_count] == SkRegion::kRunTypeSentinel);
+    if (0 == a_count || 0 == b_count ||
+            (a_count == b_count &&
+             !memcmp(a_runs, b_runs, 2 * a_count * sizeof(SkRegion::RunType)))) {
+        const SkRegion::RunType* src = a_runs;
+        int count = a_count;
+        int inside = 3;
+        if (0 == b_count) {
+            inside = 1;
+        } else if (0 == a_count) {
+            src = b_runs;
+            count = b_count;
+            inside = 2;
+        }
+        if ((unsigned)(inside - min) <= (unsigned)(max - min)) {
+            memcpy(dst, src, 2 * count * sizeof(SkRegion::RunType));
+            dst += 2 * count;
+        }
+        *dst++ = SkRegion::kRunTypeSentinel;
+        return dst;
+    }
+
     spanRec rec;
     bool    firstInterval = true;
 
@@ -947,24 +1030,42 @@ static int count_to_intervals(int count) {
 }
 #endif
 
-/*  Given a number of intervals, what is the worst case representation of that
-    many intervals?
-
-    Worst case (from a storage perspective), is a vertical stack of single
-    intervals:  TOP + N * (BOTTOM INTERVALCOUNT LEFT RIGHT SENTINEL) + SENTINEL
+/*  Return the number of y-spans in runs (starting at TOP), and the most intervals found on any
+    single one of them.
  */
-static int intervals_to_count(int intervals) {
-    return 1 + intervals * 5 + 1;
-}
-
-/*  Given the intervalCounts of RunTypes in two regions, return the worst-case number
-    of RunTypes need to store the result after a region-op.
+static int count_yspans(const SkRegion::RunType runs[], int* maxIntervals) {
+    int yspans = 0;
+    int most = 0;
+    runs += 1;  // skip TOP
+    while (*runs < SkRegion::kRunTypeSentinel) {
+        const int intervals = runs[1];
+        most = SkMax32(most, intervals);
+        runs += 2 + intervals * 2 + 1;  // BOTTOM INTERVALCOUNT [LEFT RIGHT]... SENTINEL
+        yspans += 1;
+    }
+    *maxIntervals = most;
+    return yspans;
+}
+
+/*  Given the RunTypes of two regions, return the worst-case number of RunTypes needed to store
+    the result after a region-op.
+
+    Every y-span of the result ends on a distinct top or bottom of one of the inputs, so there are
+    at most (a_yspans + b_yspans + 1) of them, and each can have no more intervals than the two
+    input scanlines it is built from. This keeps the bound linear in the size of the inputs; a
+    bound from the total interval counts alone has to be their product.
  */
-static int compute_worst_case_count(int a_intervals, int b_intervals) {
-    // Our heuristic worst case is ai * (bi + 1) + bi * (ai + 1)
-    int intervals = 2 * a_intervals * b_intervals + a_intervals + b_intervals;
-    // convert back to number of RunType values
-    return intervals_to_count(intervals);
+static int compute_worst_case_count(const SkRegion::RunType a_runs[],
+                                    const SkRegion::RunType b_runs[]) {
+    int a_intervals, b_intervals;
+    const int a_yspans = count_yspans(a_runs, &a_intervals);
+    const int b_yspans = count_yspans(b_runs, &b_intervals);
+
+    // TOP + yspans * (BOTTOM INTERVALCOUNT [LEFT RIGHT]... SENTINEL) + SENTINEL
+    const int64_t yspans = (int64_t)a_yspans + b_yspans + 1;
+    const int64_t count = 2 + yspans * (3 + 2 * ((int64_t)a_intervals + b_intervals));
+    if (!sk_64_isS32(count)) { SK_ABORT("Invalid Size"); }
+    return (int)count;
 }
 
 static bool setEmptyCheck(SkRegion* result) {
@@ -1069,23 +1170,38 @@ bool SkRegion::Oper(const SkRegion& rgnaOrig, const SkRegion& rgnbOrig, Op op,
     const RunType* a_runs = rgna->getRuns(tmpA, &a_intervals);
     const RunType* b_runs = rgnb->getRuns(tmpB, &b_intervals);
 
-    int dstCount = compute_worst_case_count(a_intervals, b_intervals);
-    SkAutoSTMalloc<256, RunType> array(dstCount);
+    int dstCount = compute_worst_case_count(a_runs, b_runs);
+
+    // Small results are staged on the stack and copied into exactly sized runs by setRuns().
+    constexpr int kStackRuns = 256;
+    if (!result || dstCount <= kStackRuns) {
+        SkAutoSTMalloc<kStackRuns, RunType> array(dstCount);
 
 #ifdef SK_DEBUG
 //  Sometimes helpful to seed everything with a known value when debugging
 //  sk_memset32((uint32_t*)array.get(), 0x7FFFFFFF, dstCount);
 #endif
 
-    int count = operate(a_runs, b_runs, array.get(), op, nullptr == result);
-    SkASSERT(count <= dstCount);
+        int count = operate(a_runs, b_runs, array.get(), op, nullptr == result);
+        SkASSERT(count <= dstCount);
 
-    if (result) {
-        SkASSERT(count >= 0);
-        return result->setRuns(array.get(), count);
-    } else {
-        return (QUICK_EXIT_TRUE_COUNT == count) || !isRunCountEmpty(count);
+        if (result) {
+            SkASSERT(count >= 0);
+            return result->setRuns(array.get(), count);
+        } else {
+            return (QUICK_EXIT_TRUE_COUNT == count) || !isRunCountEmpty(count);
+        }
     }
+
+    // Larger results are built directly in the storage they will keep, rather than in a scratch
+    // buffer that would then be copied. The operands' runs stay alive until the result adopts
+    // its new runs, so this is also safe when result is one of them.
+    RunHead* head = RunHead::Alloc(dstCount);
+    SkASSERT(head);
+
+    int count = operate(a_runs, b_runs, head->writable_runs(), op, false);
+    SkASSERT(count >= 0 && count <= dstCount);
+    return result->adoptRuns(head, count);
 }
 
 bool SkRegion::op(const SkRegion& rgna, const SkRegion& rgnb, Op op) {
@@ -7,6 +7,33 @@
 
 #include "SkRemoteGlyphCache.h"
 
+#include "SkDraw.h"
+#include "SkGlyphCache.h"
+#include "SkNoDrawCanvas.h"
+#include "SkPicture.h"
+#include "SkReader32.h"
+#include "SkTextBlobRunIterator.h"
+#include "SkWriter32.h"
+
+static_assert(sizeof(SkPackedGlyphID) == sizeof(uint32_t), "SkPackedGlyphID is sent as 32 bits.");
+static_assert(SkAlign4(sizeof(SkScalerContextRec)) == sizeof(SkScalerContextRec),
+              "SkScalerContextRec is sent unpadded.");
+static_assert(SkAlign4(sizeof(SkPaint::FontMetrics)) == sizeof(SkPaint::FontMetrics),
+              "FontMetrics is sent unpadded.");
+
+static uint32_t packed_to_wire(SkPackedGlyphID id) {
+    uint32_t wire;
+    memcpy(&wire, &id, sizeof(wire));
+    return wire;
+}
+
+static SkPackedGlyphID wire_to_packed(uint32_t wire) {
+    SkPackedGlyphID id;
+    // SkPackedGlyphID is just its 32-bit fID, which has no public setter.
+    memcpy(static_cast<void*>(&id), &wire, sizeof(id));
+    return id;
+}
+
 struct WireTypeface {
     // std::thread::id thread_id;  // TODO:need to figure a good solution
     SkFontID        typeface_id;
@@ -56,10 +83,145 @@ sk_sp<SkData> SkRemoteGlyphCacheRenderer::encodeTypeface(SkTypeface* tf) {
     return SkData::MakeWithCopy(&wire, sizeof(wire));
 }
 
+static void write_glyph(SkGlyphCache* cache, SkPackedGlyphID id, bool wantPath,
+                        SkWriter32* reply) {
+    const SkGlyph& glyph = cache->getGlyphIDMetrics(id.code(), id.getSubXFixed(),
+                                                    id.getSubYFixed());
+    reply->write32(packed_to_wire(id));
+    reply->writeScalar(glyph.fAdvanceX);
+    reply->writeScalar(glyph.fAdvanceY);
+    reply->write32(glyph.fWidth | (glyph.fHeight << 16));
+    reply->write32((uint16_t)glyph.fLeft | ((uint16_t)glyph.fTop << 16));
+    reply->write32(glyph.fMaskFormat | ((uint8_t)glyph.fForceBW << 8));
+
+    const void* image = cache->findImage(glyph);
+    reply->writeBool(image != nullptr);
+    if (image != nullptr) {
+        reply->writePad(image, glyph.computeImageSize());
+    }
+
+    const SkPath* path = wantPath ? cache->findPath(glyph) : nullptr;
+    reply->writeBool(path != nullptr);
+    if (path != nullptr) {
+        reply->writePath(*path);
+    }
+}
+
+bool SkRemoteGlyphCacheRenderer::serveGlyphRequests(
+    const void* requests, size_t size, SkWriter32* reply)
+{
+    SkReader32 reader{requests, size};
+    if (!reader.isAvailable(sizeof(int32_t))) {
+        return false;
+    }
+    int strikeCount = reader.readInt();
+    reply->write32(strikeCount);
+
+    for (int i = 0; i < strikeCount; i++) {
+        if (!reader.isAvailable(sizeof(uint32_t) + sizeof(SkScalerContextRec)
+                                + 2 * sizeof(int32_t))) {
+            return false;
+        }
+        SkFontID typefaceId = reader.readU32();
+        SkScalerContextRec rec;
+        reader.read(&rec, sizeof(rec));
+        int glyphCount = reader.readInt();
+        int pathCount = reader.readInt();
+        if (glyphCount < 0 || pathCount < 0 ||
+            !reader.isAvailable(((size_t)glyphCount + pathCount) * sizeof(uint32_t))) {
+            return false;
+        }
+        const uint32_t* glyphs = (const uint32_t*)reader.skip(glyphCount * sizeof(uint32_t));
+        const uint32_t* paths = (const uint32_t*)reader.skip(pathCount * sizeof(uint32_t));
+
+        auto typefaceIter = fTypefaceMap.find(typefaceId);
+        if (typefaceIter == nullptr) {
+            return false;
+        }
+        SkTypeface* tf = typefaceIter->get();
+
+        // The rec carries the render process's id for its proxy. Use ours so that every render
+        // process lands on the same strike.
+        SkScalerContextRec localRec = rec;
+        localRec.fFontID = SkTypeface::UniqueID(tf);
+        SkScalerContextEffects effects;
+        SkAutoDescriptor ad;
+        auto desc = SkScalerContext::AutoDescriptorGivenRecAndEffects(localRec, effects, &ad);
+        SkAutoGlyphCache cache{tf, effects, desc};
+
+        reply->write32(typefaceId);
+        reply->write(&rec, sizeof(rec));
+        reply->write(&cache->getFontMetrics(), sizeof(SkPaint::FontMetrics));
+        reply->write32(glyphCount + pathCount);
+        for (int j = 0; j < glyphCount; j++) {
+            write_glyph(cache.get(), wire_to_packed(glyphs[j]), false, reply);
+        }
+        for (int j = 0; j < pathCount; j++) {
+            write_glyph(cache.get(), wire_to_packed(paths[j]), true, reply);
+        }
+    }
+    return true;
+}
+
 SkRemoteGlyphCacheGPU::SkRemoteGlyphCacheGPU(
     std::unique_ptr<SkRemoteScalerContext> remoteScalerContext)
     : fRemoteScalerContext{std::move(remoteScalerContext)} { }
 
+// Collects the glyphs a picture draws, using the same strike the raster device would pick.
+class GlyphRequestCanvas final : public SkNoDrawCanvas {
+public:
+    GlyphRequestCanvas(const SkIRect& bounds, SkRemoteGlyphCacheGPU* cache,
+                       const SkSurfaceProps& props, SkScalerContextFlags flags)
+        : SkNoDrawCanvas{bounds}
+        , fCache{cache}
+        , fProps{props}
+        , fFlags{flags} { }
+
+protected:
+    void onDrawText(const void* text, size_t byteLength, SkScalar, SkScalar,
+                    const SkPaint& paint) override {
+        this->request(text, byteLength, paint);
+    }
+    void onDrawPosText(const void* text, size_t byteLength, const SkPoint[],
+                       const SkPaint& paint) override {
+        this->request(text, byteLength, paint);
+    }
+    void onDrawPosTextH(const void* text, size_t byteLength, const SkScalar[], SkScalar,
+                        const SkPaint& paint) override {
+        this->request(text, byteLength, paint);
+    }
+    void onDrawTextBlob(const SkTextBlob* blob, SkScalar, SkScalar,
+                        const SkPaint& paint) override {
+        SkPaint runPaint{paint};
+        for (SkTextBlobRunIterator it{blob}; !it.done(); it.next()) {
+            it.applyFontToPaint(&runPaint);
+            this->request(it.glyphs(), it.glyphCount() * sizeof(SkGlyphID), runPaint);
+        }
+    }
+
+private:
+    void request(const void* text, size_t byteLength, const SkPaint& paint) {
+        const SkMatrix& matrix = this->getTotalMatrix();
+        if (paint.getTextEncoding() != SkPaint::kGlyphID_TextEncoding ||
+            paint.getTypeface() == nullptr ||
+            SkDraw::ShouldDrawTextAsPaths(paint, matrix)) {
+            return;
+        }
+        SkScalerContextRec rec;
+        SkScalerContextEffects effects;
+        SkScalerContext::MakeRecAndEffects(paint, &fProps, &matrix, fFlags, &rec, &effects);
+        if (effects.fPathEffect != nullptr || effects.fMaskFilter != nullptr) {
+            return;
+        }
+        fCache->requestGlyphs(paint.getTypeface(), rec, (const SkGlyphID*)text,
+                              SkToInt(byteLength / sizeof(SkGlyphID)));
+    }
+
+    SkRemoteGlyphCacheGPU* const fCache;
+    const SkSurfaceProps         fProps;
+    const SkScalerContextFlags   fFlags;
+};
+
 void SkRemoteGlyphCacheGPU::prepareDeserializeProcs(SkDeserialProcs* procs) {
     auto decode = [](const void* buf, size_t len, void* ctx) {
         return reinterpret_cast<SkRemoteGlyphCacheGPU*>(ctx)->decodeTypeface(buf, len);
@@ -84,11 +246,267 @@ sk_sp<SkTypeface> SkRemoteGlyphCacheGPU::decodeTypeface(const void* buf, size_t
             wire.typeface_id,
             wire.style,
             wire.is_fixed,
-            fRemoteScalerContext.get());
+            this);
 
         typeFace = fMapIdToTypeface.set(wire.typeface_id, newTypeface);
+        fProxies.set(SkTypeface::UniqueID(newTypeface.get()), newTypeface.get());
     }
     return *typeFace;
 }
 
+void SkRemoteGlyphCacheGPU::requestGlyphs(
+    SkTypeface* tf, const SkScalerContextRec& rec,
+    const SkGlyphID glyphs[], int count, bool needPaths)
+{
+    auto proxy = fProxies.find(SkTypeface::UniqueID(tf));
+    if (proxy == nullptr) {
+        return;
+    }
+
+    SkScalerContextRecDescriptor desc{rec};
+    auto strikeIter = fStrikes.find(desc);
+    if (strikeIter == nullptr) {
+        std::unique_ptr<Strike> strike{new Strike{sk_ref_sp(*proxy), rec}};
+        strikeIter = fStrikes.set(desc, std::move(strike));
+    }
+    Strike* strike = strikeIter->get();
+
+    for (int i = 0; i < count; i++) {
+        uint32_t id = packed_to_wire(SkPackedGlyphID{glyphs[i]});
+        if (needPaths) {
+            if (!strike->fRequestedPaths.contains(id)) {
+                strike->fRequestedPaths.add(id);
+                *strike->fPendingPaths.append() = id;
+                fPendingGlyphCount++;
+            }
+        } else if (!strike->fRequestedGlyphs.contains(id)) {
+            strike->fRequestedGlyphs.add(id);
+            *strike->fPendingGlyphs.append() = id;
+            fPendingGlyphCount++;
+        }
+    }
+}
+
+void SkRemoteGlyphCacheGPU::requestGlyphsForPicture(
+    const SkPicture* picture, const SkSurfaceProps& props, SkScalerContextFlags flags)
+{
+    GlyphRequestCanvas canvas{picture->cullRect().roundOut(), this, props, flags};
+    picture->playback(&canvas);
+}
+
+bool SkRemoteGlyphCacheGPU::writeGlyphRequests(SkWriter32* requests) {
+    if (fPendingGlyphCount == 0) {
+        return false;
+    }
+
+    int strikeCount = 0;
+    fStrikes.foreach([&strikeCount](const SkScalerContextRecDescriptor&,
+                                    std::unique_ptr<Strike>* strike) {
+        if (!(*strike)->fPendingGlyphs.isEmpty() || !(*strike)->fPendingPaths.isEmpty()) {
+            strikeCount++;
+        }
+    });
+
+    requests->write32(strikeCount);
+    fStrikes.foreach([requests](const SkScalerContextRecDescriptor&,
+                                std::unique_ptr<Strike>* strikePtr) {
+        Strike* strike = strikePtr->get();
+        if (strike->fPendingGlyphs.isEmpty() && strike->fPendingPaths.isEmpty()) {
+            return;
+        }
+        requests->write32(strike->fTypeface->fontID());
+        requests->write(&strike->fRec, sizeof(strike->fRec));
+        requests->write32(strike->fPendingGlyphs.count());
+        requests->write32(strike->fPendingPaths.count());
+        requests->write(strike->fPendingGlyphs.begin(), strike->fPendingGlyphs.bytes());
+        requests->write(strike->fPendingPaths.begin(), strike->fPendingPaths.bytes());
+        strike->fPendingGlyphs.rewind();
+        strike->fPendingPaths.rewind();
+    });
+    fPendingGlyphCount = 0;
+    return true;
+}
+
+void SkRemoteGlyphCacheGPU::resetRequestedGlyphs() {
+    fStrikes.reset();
+    fPendingGlyphCount = 0;
+}
+
+bool SkRemoteGlyphCacheGPU::readGlyphs(const void* reply, size_t size) {
+    SkReader32 reader{reply, size};
+    if (!reader.isAvailable(sizeof(int32_t))) {
+        return false;
+    }
+    int strikeCount = reader.readInt();
+    for (int i = 0; i < strikeCount; i++) {
+        if (!this->readStrike(&reader)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SkRemoteGlyphCacheGPU::readStrike(SkReader32* reader) {
+    if (!reader->isAvailable(sizeof(uint32_t) + sizeof(SkScalerContextRec)
+                             + sizeof(SkPaint::FontMetrics) + sizeof(int32_t))) {
+        return false;
+    }
+    SkFontID typefaceId = reader->readU32();
+    ReceivedStrike strike;
+    reader->read(&strike.fRec, sizeof(strike.fRec));
+    reader->read(&strike.fFontMetrics, sizeof(strike.fFontMetrics));
+    int glyphCount = reader->readInt();
+
+    auto typeface = fMapIdToTypeface.find(typefaceId);
+    if (typeface == nullptr || glyphCount < 0) {
+        return false;
+    }
+
+    for (int i = 0; i < glyphCount; i++) {
+        static constexpr size_t kGlyphHeaderSize = 7 * sizeof(uint32_t);
+        if (!reader->isAvailable(kGlyphHeaderSize)) {
+            return false;
+        }
+        uint32_t id = reader->readU32();
+        SkGlyph* glyph = strike.fGlyphs.set(id, SkGlyph{});
+        glyph->initWithGlyphID(wire_to_packed(id));
+        glyph->fAdvanceX = reader->readScalar();
+        glyph->fAdvanceY = reader->readScalar();
+        uint32_t size = reader->readU32();
+        glyph->fWidth = size & 0xFFFF;
+        glyph->fHeight = size >> 16;
+        uint32_t origin = reader->readU32();
+        glyph->fLeft = (int16_t)(origin & 0xFFFF);
+        glyph->fTop = (int16_t)(origin >> 16);
+        uint32_t format = reader->readU32();
+        glyph->fMaskFormat = format & 0xFF;
+        glyph->fForceBW = (int8_t)(format >> 8);
+        glyph->fRsbDelta = glyph->fLsbDelta = 0;
+
+        if (reader->readBool()) {
+            if (glyph->fWidth == 0 || glyph->fWidth >= kMaxGlyphWidth ||
+                glyph->fMaskFormat > SkMask::kLCD16_Format) {
+                return false;
+            }
+            size_t imageSize = glyph->computeImageSize();
+            if (!reader->isAvailable(imageSize)) {
+                return false;
+            }
+            // Points into the reply, which outlives this strike.
+            glyph->fImage = const_cast<void*>(reader->skip(imageSize));
+        }
+
+        if (!reader->isAvailable(sizeof(int32_t))) {
+            return false;
+        }
+        if (reader->readBool()) {
+            SkPath* path = strike.fPaths.set(id, SkPath{});
+            if (!reader->readPath(path)) {
+                return false;
+            }
+        }
+    }
+
+    // Pull every received glyph through the SkGlyphCache so later lookups stay in process.
+    // The proxy's scaler context comes back to this object, which answers from fReceived.
+    SkScalerContextEffects effects;
+    SkAutoDescriptor ad;
+    auto desc = SkScalerContext::AutoDescriptorGivenRecAndEffects(strike.fRec, effects, &ad);
+    fReceived = &strike;
+    {
+        SkAutoGlyphCache cache{typeface->get(), effects, desc};
+        strike.fGlyphs.foreach([&cache, &strike](uint32_t id, SkGlyph* received) {
+            SkPackedGlyphID packedID = wire_to_packed(id);
+            const SkGlyph& glyph = cache->getGlyphIDMetrics(
+                    packedID.code(), packedID.getSubXFixed(), packedID.getSubYFixed());
+            cache->findImage(glyph);
+            if (strike.fPaths.find(id) != nullptr) {
+                cache->findPath(glyph);
+            }
+        });
+    }
+    fReceived = nullptr;
+    return true;
+}
+
+const SkRemoteGlyphCacheGPU::ReceivedStrike* SkRemoteGlyphCacheGPU::received(
+    const SkScalerContextRec& rec) const
+{
+    if (fReceived != nullptr && 0 == memcmp(&fReceived->fRec, &rec, sizeof(rec))) {
+        return fReceived;
+    }
+    return nullptr;
+}
+
+void SkRemoteGlyphCacheGPU::generateFontMetrics(const SkTypefaceProxy& tf,
+                                                const SkScalerContextRec& rec,
+                                                SkPaint::FontMetrics* metrics) {
+    if (auto strike = this->received(rec)) {
+        *metrics = strike->fFontMetrics;
+        return;
+    }
+    fRemoteScalerContext->generateFontMetrics(tf, rec, metrics);
+}
+
+void SkRemoteGlyphCacheGPU::generateMetrics(const SkTypefaceProxy& tf,
+                                            const SkScalerContextRec& rec,
+                                            SkGlyph* glyph) {
+    if (auto strike = this->received(rec)) {
+        if (auto received = strike->fGlyphs.find(packed_to_wire(glyph->getPackedID()))) {
+            void* image = glyph->fImage;
+            auto pathData = glyph->fPathData;
+            *glyph = *received;
+            glyph->fImage = image;
+            glyph->fPathData = pathData;
+            return;
+        }
+    }
+    fRemoteScalerContext->generateMetrics(tf, rec, glyph);
+}
+
+void SkRemoteGlyphCacheGPU::generateImage(const SkTypefaceProxy& tf,
+                                          const SkScalerContextRec& rec,
+                                          const SkGlyph& glyph) {
+    if (auto strike = this->received(rec)) {
+        auto received = strike->fGlyphs.find(packed_to_wire(glyph.getPackedID()));
+        if (received != nullptr && received->fImage != nullptr) {
+            memcpy(glyph.fImage, received->fImage, glyph.computeImageSize());
+            return;
+        }
+    }
+    fRemoteScalerContext->generateImage(tf, rec, glyph);
+}
+
+void SkRemoteGlyphCacheGPU::generateMetricsAndImage(const SkTypefaceProxy& tf,
+                                                    const SkScalerContextRec& rec,
+                                                    SkArenaAlloc* alloc,
+                                                    SkGlyph* glyph) {
+    if (auto strike = this->received(rec)) {
+        if (auto received = strike->fGlyphs.find(packed_to_wire(glyph->getPackedID()))) {
+            auto pathData = glyph->fPathData;
+            *glyph = *received;
+            glyph->fImage = nullptr;
+            glyph->fPathData = pathData;
+            if (received->fImage != nullptr) {
+                glyph->allocImage(alloc);
+                memcpy(glyph->fImage, received->fImage, glyph->computeImageSize());
+            }
+            return;
+        }
+    }
+    fRemoteScalerContext->generateMetricsAndImage(tf, rec, alloc, glyph);
+}
+
+void SkRemoteGlyphCacheGPU::generatePath(const SkTypefaceProxy& tf,
+                                         const SkScalerContextRec& rec,
+                                         SkGlyphID glyph, SkPath* path) {
+    if (auto strike = this->received(rec)) {
+        if (auto received = strike->fPaths.find(packed_to_wire(SkPackedGlyphID{glyph}))) {
+            *path = *received;
+            return;
+        }
+    }
+    fRemoteScalerContext->generatePath(tf, rec, glyph, path);
+}
+
 
@@ -12,10 +12,15 @@
 #include "SkData.h"
 #include "SkDescriptor.h"
 #include "SkSerialProcs.h"
+#include "SkSurfaceProps.h"
 #include "SkTHash.h"
 #include "SkTypeface.h"
 #include "SkTypeface_remote.h"
 
+class SkPicture;
+class SkReader32;
+class SkWriter32;
+
 class SkScalerContextRecDescriptor {
 public:
     SkScalerContextRecDescriptor() {}
@@ -23,6 +28,7 @@ public:
         auto desc = reinterpret_cast<SkDescriptor*>(&fDescriptor);
         desc->init();
         desc->addEntry(kRec_SkDescriptorTag, sizeof(rec), &rec);
+        desc->computeChecksum();
         SkASSERT(sizeof(fDescriptor) == desc->getLength());
     }
 
@@ -58,6 +64,21 @@ private:
     } fDescriptor;
 };
 
+/*
+ * Glyph requests and replies are batched per frame so that a render process crosses to the glyph
+ * process once per frame instead of once per glyph. Both are flat SkWriter32 streams:
+ *
+ *   request: strikeCount, then per strike
+ *            typefaceID, SkScalerContextRec, glyphCount, pathCount,
+ *            glyphCount x SkPackedGlyphID, pathCount x SkPackedGlyphID
+ *   reply:   strikeCount, then per strike
+ *            typefaceID, SkScalerContextRec, FontMetrics, glyphCount, then per glyph
+ *            SkPackedGlyphID, advanceX, advanceY, width | height << 16, left | top << 16,
+ *            maskFormat | forceBW << 8, hasImage [, image bytes (padded to 4)],
+ *            hasPath [, path]
+ *
+ * The typefaceID is the renderer's SkFontID, as sent by prepareSerializeProcs().
+ */
 class SkRemoteGlyphCacheRenderer {
 public:
     void prepareSerializeProcs(SkSerialProcs* procs);
@@ -65,6 +86,14 @@ public:
     SkScalerContext* generateScalerContext(
         const SkScalerContextRecDescriptor& desc, SkFontID typefaceId);
 
+    /**
+     *  Answer a batch written by SkRemoteGlyphCacheGPU::writeGlyphRequests(). The glyphs are
+     *  rasterized through this process's SkGlyphCache, so strikes are shared by every render
+     *  process talking to this renderer. Returns false if the batch is malformed or names a
+     *  typeface this renderer never sent.
+     */
+    bool serveGlyphRequests(const void* requests, size_t size, SkWriter32* reply);
+
 private:
     sk_sp<SkData> encodeTypeface(SkTypeface* tf);
 
@@ -79,18 +108,103 @@ private:
     DescriptorToContextMap fScalerContextMap;
 };
 
-class SkRemoteGlyphCacheGPU {
+/*
+ * The render process side. Typeface proxies created by prepareDeserializeProcs() scale their
+ * glyphs through this object: glyphs delivered by readGlyphs() are answered locally, anything
+ * else falls back to the synchronous remoteScalerContext.
+ */
+class SkRemoteGlyphCacheGPU : public SkRemoteScalerContext {
 public:
     explicit SkRemoteGlyphCacheGPU(std::unique_ptr<SkRemoteScalerContext> remoteScalerContext);
 
     void prepareDeserializeProcs(SkDeserialProcs* procs);
 
+    /**
+     *  Queue glyphs for the next batch. The typeface must be a proxy made by this object, and
+     *  rec must describe a strike without effects. Glyphs already requested are skipped.
+     */
+    void requestGlyphs(SkTypeface* tf, const SkScalerContextRec& rec,
+                       const SkGlyphID glyphs[], int count, bool needPaths = false);
+
+    /**
+     *  Walk the text in picture and queue the glyphs needed to draw it on a device with the
+     *  given props and flags. Text drawn as paths or with effects is left to the fallback path.
+     */
+    void requestGlyphsForPicture(const SkPicture* picture, const SkSurfaceProps& props,
+                                 SkScalerContextFlags flags);
+
+    int pendingGlyphCount() const { return fPendingGlyphCount; }
+
+    /** Write and clear the queued requests. Returns false if nothing is queued. */
+    bool writeGlyphRequests(SkWriter32* requests);
+
+    /**
+     *  Read a reply from SkRemoteGlyphCacheRenderer::serveGlyphRequests() and install its
+     *  strikes and glyphs in this process's SkGlyphCache. Returns false on a malformed reply.
+     */
+    bool readGlyphs(const void* reply, size_t size);
+
+    /** Forget which glyphs were requested, e.g. after SkGraphics::PurgeFontCache(). */
+    void resetRequestedGlyphs();
+
+    void generateFontMetrics(const SkTypefaceProxy& tf,
+                             const SkScalerContextRec& rec,
+                             SkPaint::FontMetrics* metrics) override;
+    void generateMetrics(const SkTypefaceProxy& tf,
+                         const SkScalerContextRec& rec,
+                         SkGlyph* glyph) override;
+    void generateImage(const SkTypefaceProxy& tf,
+                       const SkScalerContextRec& rec,
+                       const SkGlyph& glyph) override;
+    void generateMetricsAndImage(const SkTypefaceProxy& tf,
+                                 const SkScalerContextRec& rec,
+                                 SkArenaAlloc* alloc,
+                                 SkGlyph* glyph) override;
+    void generatePath(const SkTypefaceProxy& tf,
+                      const SkScalerContextRec& rec,
+                      SkGlyphID glyph, SkPath* path) override;
+
 private:
     sk_sp<SkTypeface> decodeTypeface(const void* buf, size_t len);
 
+    struct Strike {
+        Strike(sk_sp<SkTypefaceProxy> typeface, const SkScalerContextRec& rec)
+            : fTypeface{std::move(typeface)}, fRec(rec) {}
+
+        sk_sp<SkTypefaceProxy>  fTypeface;
+        SkScalerContextRec      fRec;
+        SkTDArray<uint32_t>     fPendingGlyphs;
+        SkTDArray<uint32_t>     fPendingPaths;
+        SkTHashSet<uint32_t>    fRequestedGlyphs;
+        SkTHashSet<uint32_t>    fRequestedPaths;
+    };
+
+    // A strike read by readGlyphs(), alive only while it is copied into the SkGlyphCache.
+    struct ReceivedStrike {
+        SkScalerContextRec              fRec;
+        SkPaint::FontMetrics            fFontMetrics;
+        SkTHashMap<uint32_t, SkGlyph>   fGlyphs;
+        SkTHashMap<uint32_t, SkPath>    fPaths;
+    };
+
+    bool readStrike(SkReader32* reader);
+    const ReceivedStrike* received(const SkScalerContextRec& rec) const;
+
     std::unique_ptr<SkRemoteScalerContext> fRemoteScalerContext;
     // TODO: Figure out how to manage the entries for the following maps.
     SkTHashMap<SkFontID, sk_sp<SkTypefaceProxy>> fMapIdToTypeface;
+    // Proxies by their local unique ID, so requests can check they own a typeface.
+    SkTHashMap<SkFontID, SkTypefaceProxy*> fProxies;
+
+    using DescriptorToStrikeMap =
+    SkTHashMap<
+    SkScalerContextRecDescriptor,
+    std::unique_ptr<Strike>,
+    SkScalerContextRecDescriptor::Hash>;
+
+    DescriptorToStrikeMap  fStrikes;
+    int                    fPendingGlyphCount{0};
+    const ReceivedStrike*  fReceived{nullptr};
 };
 
 #endif  // SkRemoteGlyphCache_DEFINED
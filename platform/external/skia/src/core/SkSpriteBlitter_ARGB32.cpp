@@ -43,6 +43,12 @@ public:
         SkBlitRow::Proc32 proc = fProc32;
         U8CPU             alpha = fAlpha;
 
+        // When neither has any padding between rows, the rect is really just one long row.
+        if (dstRB == srcRB && dstRB == width * sizeof(uint32_t) && height <= SK_MaxS32 / width) {
+            width *= height;
+            height = 1;
+        }
+
         do {
             proc(dst, src, width, alpha);
             dst = (uint32_t* SK_RESTRICT)((char*)dst + dstRB);
@@ -817,7 +817,7 @@ std::unique_ptr<SkStreamAsset> SkDynamicMemoryWStream::detachAsStream() {
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
-static sk_sp<SkData> mmap_filename(const char path[]) {
+static sk_sp<SkData> mmap_filename(const char path[], SkFILE_Access access) {
     FILE* file = sk_fopen(path, kRead_SkFILE_Flag);
     if (nullptr == file) {
         return nullptr;
@@ -825,11 +825,19 @@ static sk_sp<SkData> mmap_filename(const char path[]) {
 
     auto data = SkData::MakeFromFILE(file);
     sk_fclose(file);
+    if (data && kNormal_SkFILE_Access != access) {
+        sk_fmadvise(data->data(), data->size(), access);
+    }
     return data;
 }
 
 std::unique_ptr<SkStreamAsset> SkStream::MakeFromFile(const char path[]) {
-    auto data(mmap_filename(path));
+    return SkStreamMakeFromFile(path, kNormal_SkFILE_Access);
+}
+
+// Declared in SkStreamPriv.h:
+std::unique_ptr<SkStreamAsset> SkStreamMakeFromFile(const char path[], SkFILE_Access access) {
+    auto data(mmap_filename(path, access));
     if (data) {
         return skstd::make_unique<SkMemoryStream>(std::move(data));
     }
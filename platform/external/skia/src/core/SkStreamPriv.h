@@ -8,10 +8,14 @@
 #ifndef SkStreamPriv_DEFINED
 #define SkStreamPriv_DEFINED
 
+#include "SkOSFile.h"
 #include "SkRefCnt.h"
 
+#include <memory>
+
 class SkData;
 class SkStream;
+class SkStreamAsset;
 class SkWStream;
 
 /**
@@ -33,4 +37,10 @@ sk_sp<SkData> SkCopyStreamToData(SkStream* stream);
  */
 bool SkStreamCopy(SkWStream* out, SkStream* input);
 
+/**
+ *  Like SkStream::MakeFromFile(), but if the file can be mapped, tells the OS how the stream is
+ *  going to be read so that it can read ahead of it (or not).
+ */
+std::unique_ptr<SkStreamAsset> SkStreamMakeFromFile(const char path[], SkFILE_Access);
+
 #endif  // SkStreamPriv_DEFINED
@@ -10,9 +10,11 @@
 #include "SkColorData.h"
 #include "SkColorSpaceXformer.h"
 #include "SkImageFilterPriv.h"
+#include "SkNx.h"
 #include "SkPoint3.h"
 #include "SkReadBuffer.h"
 #include "SkSpecialImage.h"
+#include "SkTemplates.h"
 #include "SkTypes.h"
 #include "SkWriteBuffer.h"
 
@@ -77,6 +79,20 @@ static inline void fast_normalize(SkPoint3* vector) {
     vector->fZ *= scale;
 }
 
+// Four SkPoint3s, one in each lane, for lighting four pixels at a time.
+struct Point3x4 {
+    Sk4f fX, fY, fZ;
+
+    Sk4f dot(const Point3x4& v) const { return fX * v.fX + fY * v.fY + fZ * v.fZ; }
+    Sk4f dot(const SkPoint3& v) const { return fX * v.fX + fY * v.fY + fZ * v.fZ; }
+    Point3x4 makeScale(const Sk4f& scale) const { return { fX * scale, fY * scale, fZ * scale }; }
+};
+
+static inline void fast_normalize(Point3x4* vector) {
+    Sk4f scale = (vector->dot(*vector) + SK_ScalarNearlyZero).rsqrt();
+    *vector = vector->makeScale(scale);
+}
+
 static SkPoint3 read_point3(SkReadBuffer& buffer) {
     SkPoint3 point;
     point.fX = buffer.readScalar();
@@ -120,6 +136,10 @@ public:
 
     virtual SkPoint3 surfaceToLight(int x, int y, int z, SkScalar surfaceScale) const = 0;
     virtual SkPoint3 lightColor(const SkPoint3& surfaceToLight) const = 0;
+    // The same, for the four pixels at x[0..3] on row y.
+    virtual Point3x4 surfaceToLight(const Sk4f& x, int y, const Sk4f& z,
+                                    SkScalar surfaceScale) const = 0;
+    virtual Point3x4 lightColor(const Point3x4& surfaceToLight) const = 0;
 
 protected:
     SkImageFilterLight(SkColor color) {
@@ -148,8 +168,22 @@ public:
 
     virtual SkPMColor light(const SkPoint3& normal, const SkPoint3& surfaceTolight,
                             const SkPoint3& lightColor) const= 0;
+    virtual void light(const Point3x4& normal, const Point3x4& surfaceTolight,
+                       const Point3x4& lightColor, SkPMColor dst[4]) const = 0;
 };
 
+// Rounds and clamps the channels of four pixels like the scalar light() calls, and packs them.
+static inline void pack_colors(const Sk4f& a, const Sk4f& r, const Sk4f& g, const Sk4f& b,
+                               SkPMColor dst[4]) {
+    auto channel = [](const Sk4f& c, int shift) {
+        Sk4f rounded = Sk4f::Min(Sk4f::Max((c + 0.5f).floor(), 0.0f), 255.0f);
+        return SkNx_cast<uint32_t>(SkNx_cast<uint8_t>(rounded)) << shift;
+    };
+    Sk4u pixels = channel(a, SK_A32_SHIFT) | channel(r, SK_R32_SHIFT) |
+                  channel(g, SK_G32_SHIFT) | channel(b, SK_B32_SHIFT);
+    pixels.store(dst);
+}
+
 class DiffuseLightingType : public BaseLightingType {
 public:
     DiffuseLightingType(SkScalar kd)
@@ -164,6 +198,12 @@ public:
                             SkClampMax(SkScalarRoundToInt(color.fY), 255),
                             SkClampMax(SkScalarRoundToInt(color.fZ), 255));
     }
+    void light(const Point3x4& normal, const Point3x4& surfaceTolight,
+               const Point3x4& lightColor, SkPMColor dst[4]) const override {
+        Sk4f colorScale = Sk4f::Max(Sk4f::Min(normal.dot(surfaceTolight) * fKD, 1.0f), 0.0f);
+        Point3x4 color = lightColor.makeScale(colorScale);
+        pack_colors(255.0f, color.fX, color.fY, color.fZ, dst);
+    }
 private:
     SkScalar fKD;
 };
@@ -189,6 +229,21 @@ public:
                             SkClampMax(SkScalarRoundToInt(color.fY), 255),
                             SkClampMax(SkScalarRoundToInt(color.fZ), 255));
     }
+    void light(const Point3x4& normal, const Point3x4& surfaceTolight,
+               const Point3x4& lightColor, SkPMColor dst[4]) const override {
+        Point3x4 halfDir = { surfaceTolight.fX, surfaceTolight.fY, surfaceTolight.fZ + 1.0f };
+        fast_normalize(&halfDir);
+        Sk4f cosines = normal.dot(halfDir);
+        // There's no Sk4f pow(), so only this part is done one pixel at a time.
+        SkScalar colorScale[4];
+        for (int i = 0; i < 4; ++i) {
+            colorScale[i] = SkScalarClampMax(fKS * SkScalarPow(cosines[i], fShininess),
+                                             SK_Scalar1);
+        }
+        Point3x4 color = lightColor.makeScale(Sk4f::Load(colorScale));
+        pack_colors(Sk4f::Max(Sk4f::Max(color.fX, color.fY), color.fZ),
+                    color.fX, color.fY, color.fZ, dst);
+    }
 private:
     SkScalar fKS;
     SkScalar fShininess;
@@ -260,6 +315,21 @@ static inline SkPoint3 bottomRightNormal(int m[9], SkScalar surfaceScale) {
 }
 
 
+// interiorNormal() for the four pixels starting at mid[0], with the alpha of their rows at up, mid
+// and down.
+static inline Point3x4 interiorNormals(const float* up, const float* mid, const float* down,
+                                       SkScalar surfaceScale) {
+    Sk4f upLeft = Sk4f::Load(up - 1), upRight = Sk4f::Load(up + 1),
+         left = Sk4f::Load(mid - 1), right = Sk4f::Load(mid + 1),
+         downLeft = Sk4f::Load(down - 1), downRight = Sk4f::Load(down + 1);
+    Sk4f x = ((upRight - upLeft) + (right - left) * 2 + (downRight - downLeft)) * gOneQuarter;
+    Sk4f y = ((downLeft - upLeft) + (Sk4f::Load(down) - Sk4f::Load(up)) * 2 +
+              (downRight - upRight)) * gOneQuarter;
+    Point3x4 normal = { -x * surfaceScale, -y * surfaceScale, 1.0f };
+    fast_normalize(&normal);
+    return normal;
+}
+
 class UncheckedPixelFetcher {
 public:
     static inline uint32_t Fetch(const SkBitmap& src, int x, int y, const SkIRect& bounds) {
@@ -317,29 +387,66 @@ static void lightBitmap(const BaseLightingType& lightingType,
                                      l->lightColor(surfaceToLight));
     }
 
+    // The rows in between are lit four pixels at a time, from the alpha of the rows above, at and
+    // below each one, fetched once into floats.
+    const int width = right - left;
+    SkAutoTMalloc<float> alphaStorage(3 * width);
+    float* rows[3] = { alphaStorage.get(), alphaStorage.get() + width,
+                       alphaStorage.get() + 2 * width };
+    auto fetchRow = [&](float* row, int rowY) {
+        for (int i = 0; i < width; ++i) {
+            row[i] = PixelFetcher::Fetch(src, left + i, rowY, srcBounds);
+        }
+    };
+    fetchRow(rows[1], y);
+    fetchRow(rows[2], y + 1);
     for (++y; y < bottom - 1; ++y) {
+        float* recycled = rows[0];
+        rows[0] = rows[1];
+        rows[1] = rows[2];
+        rows[2] = recycled;
+        fetchRow(rows[2], y + 1);
+        const float* up = rows[0];
+        const float* mid = rows[1];
+        const float* down = rows[2];
+
         int x = left;
         int m[9];
-        m[1] = PixelFetcher::Fetch(src, x,     y - 1, srcBounds);
-        m[2] = PixelFetcher::Fetch(src, x + 1, y - 1, srcBounds);
-        m[4] = PixelFetcher::Fetch(src, x,     y,     srcBounds);
-        m[5] = PixelFetcher::Fetch(src, x + 1, y,     srcBounds);
-        m[7] = PixelFetcher::Fetch(src, x,     y + 1, srcBounds);
-        m[8] = PixelFetcher::Fetch(src, x + 1, y + 1, srcBounds);
+        m[1] = up[0];
+        m[2] = up[1];
+        m[4] = mid[0];
+        m[5] = mid[1];
+        m[7] = down[0];
+        m[8] = down[1];
         SkPoint3 surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
         *dptr++ = lightingType.light(leftNormal(m, surfaceScale), surfaceToLight,
                                      l->lightColor(surfaceToLight));
-        for (++x; x < right - 1; ++x) {
-            shiftMatrixLeft(m);
-            m[2] = PixelFetcher::Fetch(src, x + 1, y - 1, srcBounds);
-            m[5] = PixelFetcher::Fetch(src, x + 1, y,     srcBounds);
-            m[8] = PixelFetcher::Fetch(src, x + 1, y + 1, srcBounds);
-            surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
+        int i = 1;
+        for (; i + 4 < width; i += 4) {
+            Point3x4 normal = interiorNormals(up + i, mid + i, down + i, surfaceScale);
+            Sk4f z = Sk4f::Load(mid + i);
+            Point3x4 surfaceToLights = l->surfaceToLight(Sk4f(0, 1, 2, 3) + (left + i), y, z,
+                                                         surfaceScale);
+            lightingType.light(normal, surfaceToLights, l->lightColor(surfaceToLights), dptr);
+            dptr += 4;
+        }
+        for (; i < width - 1; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                m[j]     = up[i + j - 1];
+                m[j + 3] = mid[i + j - 1];
+                m[j + 6] = down[i + j - 1];
+            }
+            surfaceToLight = l->surfaceToLight(left + i, y, m[4], surfaceScale);
             *dptr++ = lightingType.light(interiorNormal(m, surfaceScale), surfaceToLight,
                                          l->lightColor(surfaceToLight));
         }
-        shiftMatrixLeft(m);
-        surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
+        m[0] = up[i - 1];
+        m[1] = up[i];
+        m[3] = mid[i - 1];
+        m[4] = mid[i];
+        m[6] = down[i - 1];
+        m[7] = down[i];
+        surfaceToLight = l->surfaceToLight(left + i, y, m[4], surfaceScale);
         *dptr++ = lightingType.light(rightNormal(m, surfaceScale), surfaceToLight,
                                      l->lightColor(surfaceToLight));
     }
@@ -839,6 +946,13 @@ public:
         return fDirection;
     }
     SkPoint3 lightColor(const SkPoint3&) const override { return this->color(); }
+    Point3x4 surfaceToLight(const Sk4f& x, int y, const Sk4f& z,
+                            SkScalar surfaceScale) const override {
+        return { fDirection.fX, fDirection.fY, fDirection.fZ };
+    }
+    Point3x4 lightColor(const Point3x4&) const override {
+        return { this->color().fX, this->color().fY, this->color().fZ };
+    }
     LightType type() const override { return kDistant_LightType; }
     const SkPoint3& direction() const { return fDirection; }
     GrGLLight* createGLLight() const override {
@@ -900,6 +1014,17 @@ public:
         return direction;
     }
     SkPoint3 lightColor(const SkPoint3&) const override { return this->color(); }
+    Point3x4 surfaceToLight(const Sk4f& x, int y, const Sk4f& z,
+                            SkScalar surfaceScale) const override {
+        Point3x4 direction = { fLocation.fX - x,
+                               fLocation.fY - SkIntToScalar(y),
+                               fLocation.fZ - z * surfaceScale };
+        fast_normalize(&direction);
+        return direction;
+    }
+    Point3x4 lightColor(const Point3x4&) const override {
+        return { this->color().fX, this->color().fY, this->color().fZ };
+    }
     LightType type() const override { return kPoint_LightType; }
     const SkPoint3& location() const { return fLocation; }
     GrGLLight* createGLLight() const override {
@@ -1014,15 +1139,24 @@ public:
         return direction;
     }
     SkPoint3 lightColor(const SkPoint3& surfaceToLight) const override {
-        SkScalar cosAngle = -surfaceToLight.dot(fS);
-        SkScalar scale = 0;
-        if (cosAngle >= fCosOuterConeAngle) {
-            scale = SkScalarPow(cosAngle, fSpecularExponent);
-            if (cosAngle < fCosInnerConeAngle) {
-                scale *= (cosAngle - fCosOuterConeAngle) * fConeScale;
-            }
+        return this->color().makeScale(this->lightScale(-surfaceToLight.dot(fS)));
+    }
+    Point3x4 surfaceToLight(const Sk4f& x, int y, const Sk4f& z,
+                            SkScalar surfaceScale) const override {
+        Point3x4 direction = { fLocation.fX - x,
+                               fLocation.fY - SkIntToScalar(y),
+                               fLocation.fZ - z * surfaceScale };
+        fast_normalize(&direction);
+        return direction;
+    }
+    Point3x4 lightColor(const Point3x4& surfaceToLight) const override {
+        Sk4f cosAngles = -surfaceToLight.dot(fS);
+        SkScalar scale[4];
+        for (int i = 0; i < 4; ++i) {
+            scale[i] = this->lightScale(cosAngles[i]);
         }
-        return this->color().makeScale(scale);
+        Point3x4 color = { this->color().fX, this->color().fY, this->color().fZ };
+        return color.makeScale(Sk4f::Load(scale));
     }
     GrGLLight* createGLLight() const override {
 #if SK_SUPPORT_GPU
@@ -1097,6 +1231,17 @@ protected:
     }
 
 private:
+    SkScalar lightScale(SkScalar cosAngle) const {
+        SkScalar scale = 0;
+        if (cosAngle >= fCosOuterConeAngle) {
+            scale = SkScalarPow(cosAngle, fSpecularExponent);
+            if (cosAngle < fCosInnerConeAngle) {
+                scale *= (cosAngle - fCosOuterConeAngle) * fConeScale;
+            }
+        }
+        return scale;
+    }
+
     static const SkScalar kSpecularExponentMin;
     static const SkScalar kSpecularExponentMax;
 
@@ -31,13 +31,44 @@ void GrDrawOpAtlas::instantiate(GrOnFlushResourceProvider* onFlushResourceProvid
         // All the atlas pages are now instantiated at flush time in the activeNewPage method.
         SkASSERT(fProxies[i] && fProxies[i]->priv().isInstantiated());
     }
+
+    // Carry out the moves that the last compaction planned, before any op of this flush prepares.
+    // The atlas isn't changed between the end of a flush and the start of the next one.
+    if (fPlannedMoves.count()) {
+        GrDeferredTextureUploadWritePixelsFn writePixels =
+                [onFlushResourceProvider](GrTextureProxy* proxy, int left, int top, int width,
+                                          int height, GrColorType colorType, const void* buffer,
+                                          size_t rowBytes) {
+                    return onFlushResourceProvider->writePixels(proxy, left, top, width, height,
+                                                                colorType, buffer, rowBytes);
+                };
+        this->movePlannedPlots(writePixels);
+    }
+}
+
+void GrDrawOpAtlas::movePlannedPlots(GrDeferredTextureUploadWritePixelsFn& writePixels) {
+    bool movedAll = true;
+    for (const PlannedMove& move : fPlannedMoves) {
+        if (!this->movePlot(move.fFrom.get(), move.fTo.get(), writePixels)) {
+            fMoveWriteFailed = true;
+            movedAll = false;
+            break;
+        }
+    }
+    fPlannedMoves.reset();
+
+    if (movedAll && fDeactivateAfterMoves) {
+        this->deactivateLastPage();
+    }
+    fDeactivateAfterMoves = false;
 }
 
 std::unique_ptr<GrDrawOpAtlas> GrDrawOpAtlas::Make(GrProxyProvider* proxyProvider,
                                                    GrPixelConfig config, int width,
                                                    int height, int numPlotsX, int numPlotsY,
                                                    AllowMultitexturing allowMultitexturing,
-                                                   GrDrawOpAtlas::EvictionFunc func, void* data) {
+                                                   GrDrawOpAtlas::EvictionFunc func, void* data,
+                                                   GrDrawOpAtlas::MoveFunc moveFunc) {
     std::unique_ptr<GrDrawOpAtlas> atlas(new GrDrawOpAtlas(proxyProvider, config, width, height,
                                                            numPlotsX, numPlotsY,
                                                            allowMultitexturing));
@@ -45,7 +76,7 @@ std::unique_ptr<GrDrawOpAtlas> GrDrawOpAtlas::Make(GrProxyProvider* proxyProvide
         return nullptr;
     }
 
-    atlas->registerEvictionCallback(func, data);
+    atlas->registerEvictionCallback(func, data, moveFunc);
     return atlas;
 }
 
@@ -59,6 +90,8 @@ GrDrawOpAtlas::Plot::Plot(int pageIndex, int plotIndex, uint64_t genID, int offX
         : fLastUpload(GrDeferredUploadToken::AlreadyFlushedToken())
         , fLastUse(GrDeferredUploadToken::AlreadyFlushedToken())
         , fFlushesSinceLastUse(0)
+        , fUsage(0)
+        , fRectCount(0)
         , fPageIndex(pageIndex)
         , fPlotIndex(plotIndex)
         , fGenID(genID)
@@ -125,6 +158,7 @@ bool GrDrawOpAtlas::Plot::addSubImage(int width, int height, const void* image,
     }
 
     fDirtyRect.join(loc->fX, loc->fY, loc->fX + width, loc->fY + height);
+    ++fRectCount;
 
     loc->fX += fOffset.fX;
     loc->fY += fOffset.fY;
@@ -133,7 +167,7 @@ bool GrDrawOpAtlas::Plot::addSubImage(int width, int height, const void* image,
     return true;
 }
 
-void GrDrawOpAtlas::Plot::uploadToTexture(GrDeferredTextureUploadWritePixelsFn& writePixels,
+bool GrDrawOpAtlas::Plot::uploadToTexture(GrDeferredTextureUploadWritePixelsFn& writePixels,
                                           GrTextureProxy* proxy) {
     // We should only be issuing uploads if we are in fact dirty
     SkASSERT(fDirty && fData && proxy && proxy->priv().peekTexture());
@@ -151,16 +185,38 @@ void GrDrawOpAtlas::Plot::uploadToTexture(GrDeferredTextureUploadWritePixelsFn&
     dataPtr += fBytesPerPixel * fDirtyRect.fLeft;
     // TODO: Make GrDrawOpAtlas store a GrColorType rather than GrPixelConfig.
     auto colorType = GrPixelConfigToColorType(fConfig);
-    writePixels(proxy, fOffset.fX + fDirtyRect.fLeft, fOffset.fY + fDirtyRect.fTop,
-                fDirtyRect.width(), fDirtyRect.height(), colorType, dataPtr, rowBytes);
+    if (!writePixels(proxy, fOffset.fX + fDirtyRect.fLeft, fOffset.fY + fDirtyRect.fTop,
+                     fDirtyRect.width(), fDirtyRect.height(), colorType, dataPtr, rowBytes)) {
+        return false;
+    }
     fDirtyRect.setEmpty();
     SkDEBUGCODE(fDirty = false;)
+    return true;
+}
+
+float GrDrawOpAtlas::Plot::percentFull() const {
+    return fRects ? fRects->percentFull() : 0;
+}
+
+void GrDrawOpAtlas::Plot::moveFrom(Plot* that) {
+    SkASSERT(!fRectCount && fWidth == that->fWidth && fHeight == that->fHeight);
+    SkASSERT(fBytesPerPixel == that->fBytesPerPixel);
+    // Our data was just cleared, so it can become that plot's.
+    SkTSwap(fData, that->fData);
+    SkTSwap(fRects, that->fRects);
+    fRectCount = that->fRectCount;
+    fUsage = that->fUsage;
+    fLastUse = that->fLastUse;
+    fFlushesSinceLastUse = that->fFlushesSinceLastUse;
+    that->resetRects();
 }
 
 void GrDrawOpAtlas::Plot::resetRects() {
     if (fRects) {
         fRects->reset();
     }
+    fRectCount = 0;
+    fUsage = 0;
 
     fGenID++;
     fID = CreateId(fPageIndex, fPlotIndex, fGenID);
@@ -186,6 +242,8 @@ GrDrawOpAtlas::GrDrawOpAtlas(GrProxyProvider* proxyProvider,
         , fTextureHeight(height)
         , fAtlasGeneration(kInvalidAtlasGeneration + 1)
         , fPrevFlushToken(GrDeferredUploadToken::AlreadyFlushedToken())
+        , fDeactivateAfterMoves(false)
+        , fMoveWriteFailed(false)
         , fAllowMultitexturing(allowMultitexturing)
         , fNumActivePages(0) {
     fPlotWidth = fTextureWidth / numPlotsX;
@@ -206,6 +264,57 @@ inline void GrDrawOpAtlas::processEviction(AtlasID id) {
     ++fAtlasGeneration;
 }
 
+bool GrDrawOpAtlas::canMovePlots() const {
+    if (fMoveWriteFailed) {
+        return false;
+    }
+    for (int i = 0; i < fEvictionCallbacks.count(); i++) {
+        if (!fEvictionCallbacks[i].fMoveFunc) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool GrDrawOpAtlas::movePlot(Plot* from, Plot* to,
+                             GrDeferredTextureUploadWritePixelsFn& writePixels) {
+    SkASSERT(this->canMovePlots());
+    // Write the contents to their new place first, so that a failed write leaves both plots as
+    // they were.
+    if (from->fData) {
+        auto colorType = GrPixelConfigToColorType(fPixelConfig);
+        if (!writePixels(fProxies[to->fPageIndex].get(), to->fOffset.fX, to->fOffset.fY,
+                         to->fWidth, to->fHeight, colorType, from->fData,
+                         from->fBytesPerPixel * from->fWidth)) {
+            return false;
+        }
+    }
+
+    AtlasID fromID = from->id();
+    this->processEvictionAndResetRects(to);
+    to->moveFrom(from);
+
+    SkIPoint16 delta = SkIPoint16::Make(to->fOffset.fX - from->fOffset.fX,
+                                        to->fOffset.fY - from->fOffset.fY);
+    for (int i = 0; i < fEvictionCallbacks.count(); i++) {
+        (*fEvictionCallbacks[i].fMoveFunc)(fromID, to->id(), delta, fEvictionCallbacks[i].fData);
+    }
+    ++fAtlasGeneration;
+
+    this->makeMRU(to, to->fPageIndex);
+    return true;
+}
+
+void GrDrawOpAtlas::getPlotStats(SkTArray<PlotStats>* stats) const {
+    for (uint32_t pageIdx = 0; pageIdx < fNumActivePages; ++pageIdx) {
+        for (uint32_t plotIdx = 0; plotIdx < fNumPlots; ++plotIdx) {
+            const Plot* plot = fPages[pageIdx].fPlotArray[plotIdx].get();
+            stats->push_back({pageIdx, plotIdx, plot->rectCount(), plot->percentFull(),
+                              plot->usage()});
+        }
+    }
+}
+
 inline bool GrDrawOpAtlas::updatePlot(GrDeferredUploadTarget* target, AtlasID* id, Plot* plot) {
     int pageIdx = GetPageIndexFromID(plot->id());
     this->makeMRU(plot, pageIdx);
@@ -263,24 +372,31 @@ bool GrDrawOpAtlas::addToAtlas(GrResourceProvider* resourceProvider,
         }
     }
 
-    // If the above fails, then see if the least recently used plot per page has already been
-    // flushed to the gpu if we're at max page allocation, or if the plot has aged out otherwise.
-    // We wait until we've grown to the full number of pages to begin evicting already flushed
-    // plots so that we can maximize the opportunity for reuse.
-    // As before we prioritize this upload to the first pages, not the most recently used.
-    for (unsigned int pageIdx = 0; pageIdx < fNumActivePages; ++pageIdx) {
-        Plot* plot = fPages[pageIdx].fPlotList.tail();
-        SkASSERT(plot);
-        if (fNumActivePages == this->maxPages() &&
-            plot->lastUseToken() < target->tokenTracker()->nextTokenToFlush()) {
+    // If the above fails, then see if a plot has already been flushed to the gpu if we're at max
+    // page allocation. We wait until we've grown to the full number of pages to begin evicting
+    // already flushed plots so that we can maximize the opportunity for reuse.
+    // Of those plots, evict the one used in the fewest of the recent flushes, as it's the least
+    // likely to be needed again soon. Ties go to the least recently used, and as before we
+    // prioritize this upload to the first pages.
+    if (fNumActivePages == this->maxPages()) {
+        Plot* plot = nullptr;
+        for (unsigned int pageIdx = 0; pageIdx < fNumActivePages; ++pageIdx) {
+            PlotList::Iter plotIter;
+            plotIter.init(fPages[pageIdx].fPlotList, PlotList::Iter::kTail_IterStart);
+            while (Plot* candidate = plotIter.get()) {
+                if (candidate->lastUseToken() < target->tokenTracker()->nextTokenToFlush() &&
+                    (!plot || candidate->usage() < plot->usage())) {
+                    plot = candidate;
+                }
+                plotIter.prev();
+            }
+        }
+        if (plot) {
             this->processEvictionAndResetRects(plot);
-            SkASSERT(GrBytesPerPixel(fProxies[pageIdx]->config()) == plot->bpp());
+            SkASSERT(GrBytesPerPixel(fProxies[plot->fPageIndex]->config()) == plot->bpp());
             SkDEBUGCODE(bool verify = )plot->addSubImage(width, height, image, loc);
             SkASSERT(verify);
-            if (!this->updatePlot(target, id, plot)) {
-                return false;
-            }
-            return true;
+            return this->updatePlot(target, id, plot);
         }
     }
 
@@ -351,11 +467,6 @@ bool GrDrawOpAtlas::addToAtlas(GrResourceProvider* resourceProvider,
 }
 
 void GrDrawOpAtlas::compact(GrDeferredUploadToken startTokenForNextFlush) {
-    if (fNumActivePages <= 1) {
-        fPrevFlushToken = startTokenForNextFlush;
-        return;
-    }
-
     // For all plots, reset number of flushes since used if used this frame.
     PlotList::Iter plotIter;
     bool atlasUsedThisFlush = false;
@@ -372,11 +483,30 @@ void GrDrawOpAtlas::compact(GrDeferredUploadToken startTokenForNextFlush) {
         }
     }
 
+    // Age the usage of all plots, which picks the plots to evict when the atlas is full. As with
+    // the flush counts, only flushes that used the atlas count.
+    if (atlasUsedThisFlush) {
+        for (uint32_t pageIndex = 0; pageIndex < fNumActivePages; ++pageIndex) {
+            plotIter.init(fPages[pageIndex].fPlotList, PlotList::Iter::kHead_IterStart);
+            while (Plot* plot = plotIter.get()) {
+                plot->updateUsage(
+                        plot->lastUseToken().inInterval(fPrevFlushToken, startTokenForNextFlush));
+                plotIter.next();
+            }
+        }
+    }
+
+    if (fNumActivePages <= 1) {
+        fPrevFlushToken = startTokenForNextFlush;
+        return;
+    }
+
     // We only try to compact if the atlas was used in the recently completed flush.
     // This is to handle the case where a lot of text or path rendering has occurred but then just
     // a blinking cursor is drawn.
     // TODO: consider if we should also do this if it's been a long time since the last atlas use
-    if (atlasUsedThisFlush) {
+    // Nor do we if the moves planned last time haven't been carried out yet.
+    if (atlasUsedThisFlush && !fPlannedMoves.count()) {
         SkTArray<Plot*> availablePlots;
         uint32_t lastPageIndex = fNumActivePages - 1;
 
@@ -455,20 +585,26 @@ void GrDrawOpAtlas::compact(GrDeferredUploadToken startTokenForNextFlush) {
 #endif
 
         // If recently used plots in the last page are using less than a quarter of the page, try
-        // to evict them if there's available space in earlier pages. Since we prioritize uploading
-        // to the first pages, this will eventually clear out usage of this page unless we have a
-        // large need.
+        // to move them to available space in earlier pages, or to evict them if our clients can't
+        // handle moves. Since we prioritize uploading to the first pages, this will eventually
+        // clear out usage of this page unless we have a large need.
         if (availablePlots.count() && usedPlots && usedPlots <= fNumPlots / 4) {
+            bool canMove = this->canMovePlots();
             plotIter.init(fPages[lastPageIndex].fPlotList, PlotList::Iter::kHead_IterStart);
             while (Plot* plot = plotIter.get()) {
                 // If this plot was used recently
                 if (plot->flushesSinceLastUsed() <= kRecentlyUsedCount) {
-                    // See if there's room in an earlier page and if so evict.
+                    // See if there's room in an earlier page and if so move or evict.
                     // We need to be somewhat harsh here so that a handful of plots that are
                     // consistently in use don't end up locking the page in memory.
                     if (availablePlots.count() > 0) {
-                        this->processEvictionAndResetRects(plot);
-                        this->processEvictionAndResetRects(availablePlots.back());
+                        if (canMove) {
+                            fPlannedMoves.push_back({sk_ref_sp(plot),
+                                                     sk_ref_sp(availablePlots.back())});
+                        } else {
+                            this->processEvictionAndResetRects(plot);
+                            this->processEvictionAndResetRects(availablePlots.back());
+                        }
                         availablePlots.pop_back();
                         --usedPlots;
                     }
@@ -480,8 +616,11 @@ void GrDrawOpAtlas::compact(GrDeferredUploadToken startTokenForNextFlush) {
             }
         }
 
-        // If none of the plots in the last page have been used recently, delete it.
-        if (!usedPlots) {
+        // If none of the plots in the last page have been used recently, delete it. If some are to
+        // be moved, that waits until they have been.
+        if (!usedPlots && fPlannedMoves.count()) {
+            fDeactivateAfterMoves = true;
+        } else if (!usedPlots) {
 #ifdef DUMP_ATLAS_DATA
             if (gDumpAtlasData) {
                 SkDebugf("delete %d\n", fNumPages-1);
@@ -9,6 +9,7 @@
 #define GrDrawOpAtlas_DEFINED
 
 #include "SkPoint.h"
+#include "SkTArray.h"
 #include "SkTDArray.h"
 #include "SkTInternalLList.h"
 
@@ -45,6 +46,10 @@ struct GrDrawOpAtlasConfig {
  * determined by using the GrDrawUploadToken system: After a flush each subarea of the page
  * is checked to see whether it was used in that flush; if it is not, a counter is incremented.
  * Once that counter reaches a threshold that subarea is considered to be no longer in use.
+ * When the clients support it (see MoveFunc), the data still in use in the last page is moved to
+ * the free subareas of the lower pages, rather than evicted, so that it needn't be regenerated.
+ * The moves are carried out at the start of the next flush, by writing the data directly to its
+ * new place, and the last page is kept when such a write fails.
  *
  * Garbage collection is initiated by the GrDrawOpAtlas's client via the compact() method. One
  * solution is to make the client a subclass of GrOnFlushCallbackObject, register it with the
@@ -74,6 +79,16 @@ public:
      */
     typedef void (*EvictionFunc)(GrDrawOpAtlas::AtlasID, void*);
 
+    /**
+     * A function pointer for use as a callback when compaction moves the contents of a plot to
+     * another plot, rather than evicting them. Everything that had the first AtlasID now has the
+     * second one, and is offset by the given delta within its (possibly different) texture.
+     * Compaction only moves plots when all of the registered listeners provide this callback,
+     * and the moves are only carried out once the data has been written to its new place.
+     */
+    typedef void (*MoveFunc)(GrDrawOpAtlas::AtlasID from, GrDrawOpAtlas::AtlasID to,
+                             SkIPoint16 delta, void*);
+
     /**
      * Returns a GrDrawOpAtlas. This function can be called anywhere, but the returned atlas
      * should only be used inside of GrMeshDrawOp::onPrepareDraws.
@@ -89,13 +104,16 @@ public:
      *                          evict data
      *  @param data             User supplied data which will be passed into func whenever an
      *                          eviction occurs
+     *  @param moveFunc         An optional function which will be called whenever compaction
+     *                          moves data, rather than evicting it
      *  @return                 An initialized GrDrawOpAtlas, or nullptr if creation fails
      */
     static std::unique_ptr<GrDrawOpAtlas> Make(GrProxyProvider*, GrPixelConfig,
                                                int width, int height,
                                                int numPlotsX, int numPlotsY,
                                                AllowMultitexturing allowMultitexturing,
-                                               GrDrawOpAtlas::EvictionFunc func, void* data);
+                                               GrDrawOpAtlas::EvictionFunc func, void* data,
+                                               GrDrawOpAtlas::MoveFunc moveFunc = nullptr);
 
     /**
      * Adds a width x height subimage to the atlas. Upon success it returns an ID and the subimage's
@@ -139,14 +157,26 @@ public:
         plot->setLastUseToken(token);
     }
 
-    inline void registerEvictionCallback(EvictionFunc func, void* userData) {
+    inline void registerEvictionCallback(EvictionFunc func, void* userData,
+                                         MoveFunc moveFunc = nullptr) {
         EvictionData* data = fEvictionCallbacks.append();
         data->fFunc = func;
+        data->fMoveFunc = moveFunc;
         data->fData = userData;
     }
 
     uint32_t numActivePages() { return fNumActivePages; }
 
+    /** How full an active plot is, and how often it has been used, for tests and tools. */
+    struct PlotStats {
+        uint32_t fPageIndex;
+        uint32_t fPlotIndex;
+        int      fRectCount;
+        float    fPercentFull;
+        uint8_t  fUsage;  // One bit for each of the last eight flushes that used the atlas.
+    };
+    void getPlotStats(SkTArray<PlotStats>*) const;
+
     /**
      * A class which can be handed back to GrDrawOpAtlas for updating last use tokens in bulk.  The
      * current max number of plots per page the GrDrawOpAtlas can handle is 32. If in the future
@@ -219,6 +249,14 @@ public:
 
     void compact(GrDeferredUploadToken startTokenForNextFlush);
 
+    /**
+     * Carries out the moves planned by the last compact(). Each plot is written to its new place
+     * with a direct write before either plot changes. If a write fails, that plot and the rest
+     * stay where they are, and later compactions evict rather than move. instantiate() calls this
+     * with the flush's direct writes.
+     */
+    void movePlannedPlots(GrDeferredTextureUploadWritePixelsFn&);
+
     static constexpr auto kGlyphMaxDim = 256;
     static bool GlyphTooLargeForAtlas(int width, int height) {
         return width > kGlyphMaxDim || height > kGlyphMaxDim;
@@ -278,13 +316,33 @@ private:
         void setLastUploadToken(GrDeferredUploadToken token) { fLastUpload = token; }
         void setLastUseToken(GrDeferredUploadToken token) { fLastUse = token; }
 
-        void uploadToTexture(GrDeferredTextureUploadWritePixelsFn&, GrTextureProxy*);
+        // The dirty rect stays dirty if the write fails.
+        bool uploadToTexture(GrDeferredTextureUploadWritePixelsFn&, GrTextureProxy*);
         void resetRects();
 
         int flushesSinceLastUsed() { return fFlushesSinceLastUse; }
         void resetFlushesSinceLastUsed() { fFlushesSinceLastUse = 0; }
         void incFlushesSinceLastUsed() { fFlushesSinceLastUse++; }
 
+        /**
+         * The usage is an aging counter: every flush that uses the atlas shifts it down, and sets
+         * the top bit if this plot was used in it. So plots used in more of the recent flushes
+         * have higher usage, with the most recent flushes weighing the most.
+         */
+        uint8_t usage() const { return fUsage; }
+        void updateUsage(bool usedThisFlush) {
+            fUsage = (fUsage >> 1) | (usedThisFlush ? 0x80 : 0);
+        }
+
+        int rectCount() const { return fRectCount; }
+        float percentFull() const;
+
+        /**
+         * Takes the contents of 'that' plot, which must be the same size, and resets it. This plot
+         * must have just been reset, and the contents already written to its place in the texture.
+         */
+        void moveFrom(Plot* that);
+
     private:
         Plot(int pageIndex, int plotIndex, uint64_t genID, int offX, int offY, int width, int height,
              GrPixelConfig config);
@@ -312,6 +370,8 @@ private:
         GrDeferredUploadToken fLastUse;
         // the number of flushes since this plot has been last used
         int                   fFlushesSinceLastUse;
+        uint8_t               fUsage;
+        int                   fRectCount;
 
         struct {
             const uint32_t fPageIndex : 16;
@@ -366,6 +426,8 @@ private:
     void deactivateLastPage();
 
     void processEviction(AtlasID);
+    bool canMovePlots() const;
+    bool movePlot(Plot* from, Plot* to, GrDeferredTextureUploadWritePixelsFn&);
     inline void processEvictionAndResetRects(Plot* plot) {
         this->processEviction(plot->id());
         plot->resetRects();
@@ -384,11 +446,23 @@ private:
 
     struct EvictionData {
         EvictionFunc fFunc;
+        MoveFunc fMoveFunc;
         void* fData;
     };
 
     SkTDArray<EvictionData> fEvictionCallbacks;
 
+    // The moves planned by compaction, which are carried out at the start of the next flush.
+    struct PlannedMove {
+        sk_sp<Plot> fFrom;
+        sk_sp<Plot> fTo;
+    };
+    SkTArray<PlannedMove> fPlannedMoves;
+    // Whether to deactivate the last page once the planned moves have emptied it.
+    bool fDeactivateAfterMoves;
+    // Set when a direct write of a moved plot failed, after which compaction only evicts.
+    bool fMoveWriteFailed;
+
     struct Page {
         // allocated array of Plots
         std::unique_ptr<sk_sp<Plot>[]> fPlotArray;
@@ -360,6 +360,7 @@ void GrDrawingManager::moveOpListsToDDL(SkDeferredDisplayList* ddl) {
     }
 
     ddl->fOpLists = std::move(fOpLists);
+    ddl->fOpArena = std::move(fOpArena);
 #endif
 }
 
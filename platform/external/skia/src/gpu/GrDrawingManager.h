@@ -8,6 +8,7 @@
 #ifndef GrDrawingManager_DEFINED
 #define GrDrawingManager_DEFINED
 
+#include "GrOpArena.h"
 #include "GrPathRenderer.h"
 #include "GrPathRendererChain.h"
 #include "GrRenderTargetOpList.h"
@@ -82,6 +83,11 @@ public:
     void moveOpListsToDDL(SkDeferredDisplayList* ddl);
     void copyOpListsFromDDL(const SkDeferredDisplayList*, GrRenderTargetProxy* newDest);
 
+    // A context that records a DDL allocates its ops from an arena that goes with the DDL's
+    // opLists. GrRenderTargetContext installs it around each call that makes ops.
+    void setOpArena(sk_sp<GrOpArena> arena) { fOpArena = std::move(arena); }
+    GrOpArena* opArena() const { return fOpArena.get(); }
+
 private:
     GrDrawingManager(GrContext*, const GrPathRendererChain::Options&,
                      const GrAtlasTextContext::Options&, GrSingleOwner*,
@@ -120,6 +126,7 @@ private:
 
     bool                              fAbandoned;
     SkTArray<sk_sp<GrOpList>>         fOpLists;
+    sk_sp<GrOpArena>                  fOpArena;
     // These are the IDs of the opLists currently being flushed (in internalFlush)
     SkSTArray<8, uint32_t, true>      fFlushingOpListIDs;
     // These are the new opLists generated by the onFlush CBs
@@ -403,6 +403,12 @@ bool GrGpu::writePixels(GrSurface* surface, GrSurfaceOrigin origin, int left, in
         SkIRect rect = SkIRect::MakeXYWH(left, top, width, height);
         this->didWriteToSurface(surface, origin, &rect, mipLevelCount);
         fStats.incTextureUploads();
+        size_t bytes = 0;
+        for (int currentMipLevel = 0; currentMipLevel < mipLevelCount; currentMipLevel++) {
+            bytes += (size_t)SkTMax(width >> currentMipLevel, 1) *
+                     SkTMax(height >> currentMipLevel, 1) * GrColorTypeBytesPerPixel(srcColorType);
+        }
+        fStats.incTextureUploadBytes(bytes);
         return true;
     }
     return false;
@@ -399,6 +399,7 @@ public:
             fShaderCompilations = 0;
             fTextureCreates = 0;
             fTextureUploads = 0;
+            fTextureUploadBytes = 0;
             fTransfersToTexture = 0;
             fStencilAttachmentCreates = 0;
             fNumDraws = 0;
@@ -413,6 +414,8 @@ public:
         void incTextureCreates() { fTextureCreates++; }
         int textureUploads() const { return fTextureUploads; }
         void incTextureUploads() { fTextureUploads++; }
+        size_t textureUploadBytes() const { return fTextureUploadBytes; }
+        void incTextureUploadBytes(size_t bytes) { fTextureUploadBytes += bytes; }
         int transfersToTexture() const { return fTransfersToTexture; }
         void incTransfersToTexture() { fTransfersToTexture++; }
         void incStencilAttachmentCreates() { fStencilAttachmentCreates++; }
@@ -427,6 +430,7 @@ public:
         int fShaderCompilations;
         int fTextureCreates;
         int fTextureUploads;
+        size_t fTextureUploadBytes;
         int fTransfersToTexture;
         int fStencilAttachmentCreates;
         int fNumDraws;
@@ -438,6 +442,7 @@ public:
         void incShaderCompilations() {}
         void incTextureCreates() {}
         void incTextureUploads() {}
+        void incTextureUploadBytes(size_t) {}
         void incTransfersToTexture() {}
         void incStencilAttachmentCreates() {}
         void incNumDraws() {}
@@ -9,8 +9,11 @@
 
 #include "GrContextPriv.h"
 #include "GrDrawingManager.h"
+#include "GrGpu.h"
 #include "GrProxyProvider.h"
 #include "GrSurfaceProxy.h"
+#include "GrSurfaceProxyPriv.h"
+#include "GrTextureProxy.h"
 
 sk_sp<GrRenderTargetContext> GrOnFlushResourceProvider::makeRenderTargetContext(
                                                         const GrSurfaceDesc& desc,
@@ -111,6 +114,25 @@ sk_sp<const GrBuffer> GrOnFlushResourceProvider::findOrMakeStaticBuffer(GrBuffer
     return buffer;
 }
 
+bool GrOnFlushResourceProvider::writePixels(GrTextureProxy* proxy, int left, int top, int width,
+                                            int height, GrColorType srcColorType,
+                                            const void* buffer, size_t rowBytes) {
+    GrSurface* dstSurface = proxy->priv().peekSurface();
+    SkASSERT(dstSurface);
+    GrGpu* gpu = fDrawingMgr->getContext()->contextPriv().getGpu();
+    // Only direct writes are supported. Unlike the flush's uploads, this doesn't draw through a
+    // temporary texture when the backend needs that.
+    GrGpu::DrawPreference drawPreference = GrGpu::kNoDraw_DrawPreference;
+    GrGpu::WritePixelTempDrawInfo tempInfo;
+    if (!gpu->getWritePixelsInfo(dstSurface, proxy->origin(), width, height, srcColorType,
+                                 GrSRGBConversion::kNone, &drawPreference, &tempInfo) ||
+        GrGpu::kNoDraw_DrawPreference != drawPreference) {
+        return false;
+    }
+    return gpu->writePixels(dstSurface, proxy->origin(), left, top, width, height, srcColorType,
+                            buffer, rowBytes);
+}
+
 const GrCaps* GrOnFlushResourceProvider::caps() const {
     return fDrawingMgr->getContext()->caps();
 }
@@ -85,6 +85,10 @@ public:
     sk_sp<const GrBuffer> findOrMakeStaticBuffer(GrBufferType, size_t, const void* data,
                                                  const GrUniqueKey&);
 
+    // Writes to an instantiated texture proxy right away, so ahead of the flush's uploads and ops.
+    bool writePixels(GrTextureProxy*, int left, int top, int width, int height, GrColorType,
+                     const void* buffer, size_t rowBytes);
+
     const GrCaps* caps() const;
 
 private:
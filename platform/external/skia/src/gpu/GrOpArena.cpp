@@ -0,0 +1,58 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrOpArena.h"
+#include "SkMalloc.h"
+
+static thread_local GrOpArena* gCurrentArena = nullptr;
+
+GrOpArena::GrOpArena(size_t minBlockSize)
+        : fMinBlockSize(GrSizeAlignUp(minBlockSize, kAlignment))
+        , fSize(0)
+        , fTail(nullptr)
+        , fCurr(nullptr)
+        , fEnd(nullptr) {
+}
+
+GrOpArena::~GrOpArena() {
+    SkASSERT(gCurrentArena != this);
+    Block* block = fTail;
+    while (block) {
+        Block* prev = block->fPrev;
+        sk_free(block);
+        block = prev;
+    }
+}
+
+GrOpArena* GrOpArena::Current() {
+    return gCurrentArena;
+}
+
+GrOpArena* GrOpArena::SetCurrent(GrOpArena* arena) {
+    GrOpArena* previous = gCurrentArena;
+    gCurrentArena = arena;
+    return previous;
+}
+
+void* GrOpArena::allocate(size_t size) {
+    SkASSERT(gCurrentArena == this);
+    size = GrSizeAlignUp(size, kAlignment);
+    if ((size_t)(fEnd - fCurr) < size) {
+        // The rest of the current block is abandoned.
+        size_t blockSize = SkTMax<size_t>(kBlockSize + size, fMinBlockSize);
+        Block* block = static_cast<Block*>(sk_malloc_throw(blockSize));
+        block->fPrev = fTail;
+        fTail = block;
+        fCurr = reinterpret_cast<char*>(block) + kBlockSize;
+        fEnd = reinterpret_cast<char*>(block) + blockSize;
+        fSize += blockSize;
+    }
+    void* ptr = fCurr;
+    fCurr += size;
+    this->ref();
+    return ptr;
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrOpArena_DEFINED
+#define GrOpArena_DEFINED
+
+#include "GrTypes.h"
+#include "SkRefCnt.h"
+
+/**
+ * Bump allocates GrOps for one recorder, so that several threads can record at once without
+ * sharing the global op pool or contending in malloc. The recording context's GrDrawingManager owns
+ * the arena, and GrRenderTargetContext installs it on the calling thread with AutoInstall around
+ * each call that makes ops. GrOp's operator new then allocates from it. Nothing stays installed
+ * between calls, so only the recorder's own ops land in the arena.
+ *
+ * Allocation only happens on the thread that the arena is current on, but an op may be deleted on
+ * any thread. Deleting an op doesn't free its memory: every op holds a ref on its arena, and the
+ * arena's blocks are freed as a whole once the last of its ops, and its owner, are gone. This lets
+ * the ops of a finished SkDeferredDisplayList be handed to another thread without any copying.
+ */
+class GrOpArena : public SkNVRefCnt<GrOpArena> {
+public:
+    explicit GrOpArena(size_t minBlockSize = kDefaultMinBlockSize);
+    ~GrOpArena();
+
+    /** Returns the arena installed on the calling thread, or null. */
+    static GrOpArena* Current();
+
+    /** Installs 'arena' (which may be null) on the calling thread, and returns the previous one. */
+    static GrOpArena* SetCurrent(GrOpArena* arena);
+
+    /**
+     * Allocates 'size' bytes, for an operator new, from the calling thread's arena or, if it has
+     * none, with 'poolAllocate'. The memory must be freed with Release().
+     */
+    template <typename PoolAllocateFn>
+    static void* Allocate(size_t size, PoolAllocateFn&& poolAllocate) {
+        // The memory is prefixed with the arena it came from, null for the pool.
+        GrOpArena* arena = Current();
+        void* mem = arena ? arena->allocate(size + kPrefixSize)
+                          : poolAllocate(size + kPrefixSize);
+        *static_cast<GrOpArena**>(mem) = arena;
+        return static_cast<char*>(mem) + kPrefixSize;
+    }
+
+    /**
+     * Frees memory from Allocate(). 'poolRelease' is called with what 'poolAllocate' returned, if
+     * that is where it came from. This may be called on any thread.
+     */
+    template <typename PoolReleaseFn>
+    static void Release(void* p, PoolReleaseFn&& poolRelease) {
+        void* mem = static_cast<char*>(p) - kPrefixSize;
+        if (GrOpArena* arena = *static_cast<GrOpArena**>(mem)) {
+            arena->unref();
+        } else {
+            poolRelease(mem);
+        }
+    }
+
+    /** Returns the total size of the blocks that the arena has allocated from the system. */
+    size_t size() const { return fSize; }
+
+    /**
+     * Installs an arena on the calling thread for the lifetime of the object, and then restores
+     * the previous one.
+     */
+    class AutoInstall {
+    public:
+        explicit AutoInstall(GrOpArena* arena) : fPrevious(SetCurrent(arena)) {}
+        ~AutoInstall() { SetCurrent(fPrevious); }
+
+    private:
+        GrOpArena* fPrevious;
+    };
+
+    static constexpr size_t kDefaultMinBlockSize = 16384;
+
+private:
+    struct Block {
+        Block* fPrev;
+    };
+
+    enum {
+        // The same alignment as GrMemoryPool.
+        kAlignment  = 8,
+        kPrefixSize = GR_CT_ALIGN_UP(sizeof(GrOpArena*), kAlignment),
+        kBlockSize  = GR_CT_ALIGN_UP(sizeof(Block), kAlignment),
+    };
+
+    // Allocates from the current block, and refs the arena on behalf of the allocation.
+    void* allocate(size_t size);
+
+    size_t fMinBlockSize;
+    size_t fSize;
+    Block* fTail;
+    char*  fCurr;
+    char*  fEnd;
+};
+
+#endif
@@ -0,0 +1,160 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrOpBoundsIndex.h"
+#include "GrRect.h"
+
+void GrOpBoundsIndex::reset(const SkRect& targetBounds) {
+    fTargetBounds = targetBounds;
+    fCellWidth = SkTMax(targetBounds.width() / kGridSize, SK_Scalar1);
+    fCellHeight = SkTMax(targetBounds.height() / kGridSize, SK_Scalar1);
+    fPieces.rewind();
+    fFirstPiece.rewind();
+    for (SkTDArray<int>& cell : fCells) {
+        cell.rewind();
+    }
+    fLargePieces.rewind();
+    for (SkTDArray<int>& ops : fClasses) {
+        ops.rewind();
+    }
+}
+
+void GrOpBoundsIndex::cellRange(const SkRect& bounds, SkIRect* cells) const {
+    if (!bounds.isFinite()) {
+        // These can't overlap anything, but keep them where every query looks.
+        cells->set(0, 0, kGridSize, kGridSize);
+        return;
+    }
+    // Ops may draw outside the target, so pin before converting to ints. Those parts of the
+    // bounds share the edge cells.
+    auto toCell = [](SkScalar coord, SkScalar origin, SkScalar cellSize) {
+        return (int)SkTPin((coord - origin) / cellSize, 0.f, (SkScalar)(kGridSize - 1));
+    };
+    cells->fLeft = toCell(bounds.fLeft, fTargetBounds.fLeft, fCellWidth);
+    cells->fTop = toCell(bounds.fTop, fTargetBounds.fTop, fCellHeight);
+    cells->fRight = toCell(bounds.fRight, fTargetBounds.fLeft, fCellWidth) + 1;
+    cells->fBottom = toCell(bounds.fBottom, fTargetBounds.fTop, fCellHeight) + 1;
+}
+
+void GrOpBoundsIndex::insertPiece(SkTDArray<int>* list, int piece) const {
+    // Pieces are almost always added for the most recent op, so this rarely moves anything.
+    int opIndex = fPieces[piece].fOpIndex;
+    int i = list->count();
+    while (i > 0 && fPieces[(*list)[i - 1]].fOpIndex > opIndex) {
+        --i;
+    }
+    *list->insert(i) = piece;
+}
+
+void GrOpBoundsIndex::addPiece(int opIndex, const SkRect& bounds) {
+    int piece = fPieces.count();
+    *fPieces.append() = {bounds, opIndex, fFirstPiece[opIndex]};
+    fFirstPiece[opIndex] = piece;
+
+    SkIRect cells;
+    this->cellRange(bounds, &cells);
+    if (cells.width() * cells.height() > kMaxCellsPerPiece) {
+        this->insertPiece(&fLargePieces, piece);
+        return;
+    }
+    for (int y = cells.fTop; y < cells.fBottom; ++y) {
+        for (int x = cells.fLeft; x < cells.fRight; ++x) {
+            this->insertPiece(&this->cell(x, y), piece);
+        }
+    }
+}
+
+void GrOpBoundsIndex::append(const SkRect& bounds, uint32_t classID) {
+    int opIndex = fFirstPiece.count();
+    *fFirstPiece.append() = -1;
+    this->addPiece(opIndex, bounds);
+
+    if (classID >= (uint32_t)fClasses.count()) {
+        fClasses.push_back_n(classID + 1 - fClasses.count());
+    }
+    *fClasses[classID].append() = opIndex;
+}
+
+void GrOpBoundsIndex::addBounds(int opIndex, const SkRect& bounds) {
+    this->addPiece(opIndex, bounds);
+}
+
+void GrOpBoundsIndex::moveBounds(int srcIndex, int dstIndex) {
+    for (int piece = fFirstPiece[srcIndex]; piece >= 0; piece = fPieces[piece].fNext) {
+        this->addPiece(dstIndex, fPieces[piece].fBounds);
+    }
+}
+
+int GrOpBoundsIndex::lastOverlappingIn(const SkTDArray<int>& list, const SkRect& bounds,
+                                       int floor) const {
+    for (int i = list.count() - 1; i >= 0; --i) {
+        const Piece& piece = fPieces[list[i]];
+        if (piece.fOpIndex <= floor) {
+            break;
+        }
+        if (GrRectsOverlap(piece.fBounds, bounds)) {
+            return piece.fOpIndex;
+        }
+    }
+    return floor;
+}
+
+int GrOpBoundsIndex::lastOverlapping(const SkRect& bounds) const {
+    int last = this->lastOverlappingIn(fLargePieces, bounds, -1);
+    SkIRect cells;
+    this->cellRange(bounds, &cells);
+    for (int y = cells.fTop; y < cells.fBottom; ++y) {
+        for (int x = cells.fLeft; x < cells.fRight; ++x) {
+            last = this->lastOverlappingIn(this->cell(x, y), bounds, last);
+        }
+    }
+    return last;
+}
+
+int GrOpBoundsIndex::firstOverlappingIn(const SkTDArray<int>& list, int opIndex,
+                                        const SkRect& bounds, int ceiling) const {
+    // Binary search for the first piece of an op after opIndex, then scan forward.
+    int lo = 0, hi = list.count();
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (fPieces[list[mid]].fOpIndex <= opIndex) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    for (int i = lo; i < list.count(); ++i) {
+        const Piece& piece = fPieces[list[i]];
+        if (piece.fOpIndex >= ceiling) {
+            break;
+        }
+        if (GrRectsOverlap(piece.fBounds, bounds)) {
+            return piece.fOpIndex;
+        }
+    }
+    return ceiling;
+}
+
+int GrOpBoundsIndex::firstOverlappingAfter(int opIndex, const SkRect& bounds, int ceiling) const {
+    int first = this->firstOverlappingIn(fLargePieces, opIndex, bounds, ceiling);
+    SkIRect cells;
+    this->cellRange(bounds, &cells);
+    for (int y = cells.fTop; y < cells.fBottom; ++y) {
+        for (int x = cells.fLeft; x < cells.fRight; ++x) {
+            first = this->firstOverlappingIn(this->cell(x, y), opIndex, bounds, first);
+        }
+    }
+    return first;
+}
+
+int GrOpBoundsIndex::firstOverlappingAfter(int opIndex) const {
+    int first = this->count();
+    for (int piece = fFirstPiece[opIndex]; piece >= 0; piece = fPieces[piece].fNext) {
+        first = this->firstOverlappingAfter(opIndex, fPieces[piece].fBounds, first);
+    }
+    return first;
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrOpBoundsIndex_DEFINED
+#define GrOpBoundsIndex_DEFINED
+
+#include "SkRect.h"
+#include "SkTArray.h"
+#include "SkTDArray.h"
+
+/**
+ * Indexes the ops recorded by an opList, by where they draw on a uniform grid over the target and
+ * by their GrOp::ClassID. GrRenderTargetOpList uses it to find combine candidates, and the ops
+ * that block reordering, without walking over every recorded op.
+ *
+ * Ops are identified by their position in the opList. An op that other ops were combined into
+ * keeps the bounds of each of them, rather than their union, so that a few combined draws far
+ * apart don't block everything recorded in between. Every list of ops that the index keeps (per
+ * cell and per class) is sorted by position, so the most recent or the next op can be found by
+ * scanning from one end.
+ */
+class GrOpBoundsIndex {
+public:
+    GrOpBoundsIndex() : fCellWidth(0), fCellHeight(0) {}
+
+    /** Clears the index and sets up the grid to cover 'targetBounds'. */
+    void reset(const SkRect& targetBounds);
+
+    int count() const { return fFirstPiece.count(); }
+
+    /** Adds the op at position count(). */
+    void append(const SkRect& bounds, uint32_t classID);
+
+    /** Records that the op at 'opIndex' now also draws within 'bounds'. */
+    void addBounds(int opIndex, const SkRect& bounds);
+
+    /** Records that the op at 'srcIndex' was combined forward, into the one at 'dstIndex'. */
+    void moveBounds(int srcIndex, int dstIndex);
+
+    /** Returns the position of the most recent op that overlaps 'bounds', or -1 if none does. */
+    int lastOverlapping(const SkRect& bounds) const;
+
+    /**
+     * Returns the position of the first op after 'opIndex' that overlaps where 'opIndex' draws, or
+     * count() if none does.
+     */
+    int firstOverlappingAfter(int opIndex) const;
+
+    /** Returns the sorted positions of the ops with the given class, or null if there are none. */
+    const SkTDArray<int>* opsOfClass(uint32_t classID) const {
+        return classID < (uint32_t)fClasses.count() ? &fClasses[classID] : nullptr;
+    }
+
+private:
+    // A grid this size keeps the lists short for typical targets without making the ops that
+    // cover most of the target expensive to add.
+    static constexpr int kGridSize = 16;
+    // Bounds covering more cells than this go into fLargePieces instead.
+    static constexpr int kMaxCellsPerPiece = kGridSize * kGridSize / 4;
+
+    // One of the rects an op draws within.
+    struct Piece {
+        SkRect fBounds;
+        int    fOpIndex;
+        int    fNext;    // The op's next piece, or -1.
+    };
+
+    void addPiece(int opIndex, const SkRect& bounds);
+    void cellRange(const SkRect& bounds, SkIRect* cells) const;
+    SkTDArray<int>& cell(int x, int y) { return fCells[y * kGridSize + x]; }
+    const SkTDArray<int>& cell(int x, int y) const { return fCells[y * kGridSize + x]; }
+
+    // Inserts a piece into a list of pieces sorted by op position.
+    void insertPiece(SkTDArray<int>* list, int piece) const;
+    // Scans a list of pieces for the most recent op overlapping 'bounds' that comes after 'floor'.
+    int lastOverlappingIn(const SkTDArray<int>&, const SkRect& bounds, int floor) const;
+    // Scans a list of pieces for the first op overlapping 'bounds' between 'opIndex' and 'ceiling'.
+    int firstOverlappingIn(const SkTDArray<int>&, int opIndex, const SkRect& bounds,
+                           int ceiling) const;
+    int firstOverlappingAfter(int opIndex, const SkRect& bounds, int ceiling) const;
+
+    SkRect                   fTargetBounds;
+    SkScalar                 fCellWidth;
+    SkScalar                 fCellHeight;
+    SkTDArray<Piece>         fPieces;
+    SkTDArray<int>           fFirstPiece;
+    SkTDArray<int>           fCells[kGridSize * kGridSize];
+    SkTDArray<int>           fLargePieces;
+    SkTArray<SkTDArray<int>> fClasses;
+};
+
+#endif
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrRectanizer_maxrects.h"
+#include "SkPoint.h"
+
+// These run for every free rect on every add, so skip SkIRect's checks for empty and overflowing
+// rects. Free rects are never empty, and never stick out of the plot.
+static inline bool overlaps(const SkIRect& a, const SkIRect& b) {
+    return a.fLeft < b.fRight && b.fLeft < a.fRight && a.fTop < b.fBottom && b.fTop < a.fBottom;
+}
+
+static inline bool contains(const SkIRect& outer, const SkIRect& inner) {
+    return outer.fLeft <= inner.fLeft && outer.fTop <= inner.fTop &&
+           outer.fRight >= inner.fRight && outer.fBottom >= inner.fBottom;
+}
+
+bool GrRectanizerMaxRects::addRect(int width, int height, SkIPoint16* loc) {
+    if ((unsigned)width > (unsigned)this->width() ||
+        (unsigned)height > (unsigned)this->height()) {
+        return false;
+    }
+
+    // Find the free rect that the new one fits best, by the side with the least space over, then
+    // by the other side. Ties go to the topmost, then leftmost, to keep the packing tight.
+    int bestIndex = -1;
+    int bestShortSide = SK_MaxS32;
+    int bestLongSide = SK_MaxS32;
+    for (int i = 0; i < fFreeRects.count(); ++i) {
+        const SkIRect& free = fFreeRects[i];
+        int leftoverX = free.fRight - free.fLeft - width;
+        int leftoverY = free.fBottom - free.fTop - height;
+        if (leftoverX < 0 || leftoverY < 0) {
+            continue;
+        }
+        int shortSide = SkTMin(leftoverX, leftoverY);
+        int longSide = SkTMax(leftoverX, leftoverY);
+        if (this->isBetterFit(free, shortSide, longSide, bestIndex, bestShortSide,
+                              bestLongSide)) {
+            bestIndex = i;
+            bestShortSide = shortSide;
+            bestLongSide = longSide;
+        }
+    }
+
+    if (-1 == bestIndex) {
+        loc->fX = 0;
+        loc->fY = 0;
+        return false;
+    }
+
+    SkIRect used = SkIRect::MakeXYWH(fFreeRects[bestIndex].fLeft, fFreeRects[bestIndex].fTop,
+                                     width, height);
+    this->splitFreeRects(used);
+
+    loc->fX = used.fLeft;
+    loc->fY = used.fTop;
+    fAreaSoFar += width*height;
+    return true;
+}
+
+bool GrRectanizerMaxRects::isBetterFit(const SkIRect& free, int shortSide, int longSide,
+                                       int bestIndex, int bestShortSide, int bestLongSide) const {
+    if (shortSide != bestShortSide) {
+        return shortSide < bestShortSide;
+    }
+    if (longSide != bestLongSide) {
+        return longSide < bestLongSide;
+    }
+    const SkIRect& best = fFreeRects[bestIndex];
+    return free.fTop < best.fTop || (free.fTop == best.fTop && free.fLeft < best.fLeft);
+}
+
+void GrRectanizerMaxRects::splitFreeRects(const SkIRect& used) {
+    // Replace each free rect that overlaps 'used' with the pieces of it that are left around
+    // 'used'. The pieces go into a separate list, as only they need to be checked for containment.
+    fNewRects.rewind();
+    for (int i = 0; i < fFreeRects.count(); ++i) {
+        SkIRect free = fFreeRects[i];
+        if (!overlaps(free, used)) {
+            continue;
+        }
+
+        if (used.fLeft > free.fLeft) {
+            fNewRects.append()->set(free.fLeft, free.fTop, used.fLeft, free.fBottom);
+        }
+        if (used.fRight < free.fRight) {
+            fNewRects.append()->set(used.fRight, free.fTop, free.fRight, free.fBottom);
+        }
+        if (used.fTop > free.fTop) {
+            fNewRects.append()->set(free.fLeft, free.fTop, free.fRight, used.fTop);
+        }
+        if (used.fBottom < free.fBottom) {
+            fNewRects.append()->set(free.fLeft, used.fBottom, free.fRight, free.fBottom);
+        }
+        fFreeRects.removeShuffle(i);
+        --i;
+    }
+
+    // The remaining free rects are all maximal, so don't contain each other, and a piece can't
+    // contain any of them either, as it lies inside the rect it was split from. So only the
+    // pieces can be redundant. There are few of them, so drop those that another piece contains
+    // first (of equal pieces, the first one checked), and then those that a remaining rect does.
+    for (int i = 0; i < fNewRects.count(); ++i) {
+        for (int j = 0; j < fNewRects.count(); ++j) {
+            if (j != i && contains(fNewRects[j], fNewRects[i])) {
+                fNewRects.removeShuffle(i);
+                --i;
+                break;
+            }
+        }
+    }
+    int oldCount = fFreeRects.count();
+    for (const SkIRect& piece : fNewRects) {
+        bool contained = false;
+        for (int j = 0; j < oldCount && !contained; ++j) {
+            contained = contains(fFreeRects[j], piece);
+        }
+        if (!contained) {
+            *fFreeRects.append() = piece;
+        }
+    }
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrRectanizer_maxrects_DEFINED
+#define GrRectanizer_maxrects_DEFINED
+
+#include "GrRectanizer.h"
+#include "SkRect.h"
+#include "SkTDArray.h"
+
+// Pack rectangles by tracking every maximal free rectangle, and place each new rect in the free
+// rectangle that leaves the shortest side over ("best short side fit"). This packs mixed sizes
+// more tightly than the skyline, which can never use the space under its silhouette, at the cost
+// of a longer list to search.
+// Based, in part, on Jukka Jylanki's work at http://clb.demon.fi
+class GrRectanizerMaxRects : public GrRectanizer {
+public:
+    GrRectanizerMaxRects(int w, int h) : INHERITED(w, h) {
+        this->reset();
+    }
+
+    ~GrRectanizerMaxRects() override { }
+
+    void reset() override {
+        fAreaSoFar = 0;
+        fFreeRects.rewind();
+        fFreeRects.append()->set(0, 0, this->width(), this->height());
+    }
+
+    bool addRect(int w, int h, SkIPoint16* loc) override;
+
+    float percentFull() const override {
+        return fAreaSoFar / ((float)this->width() * this->height());
+    }
+
+    int freeRectCount() const { return fFreeRects.count(); }
+
+private:
+    bool isBetterFit(const SkIRect&, int shortSide, int longSide,
+                     int bestIndex, int bestShortSide, int bestLongSide) const;
+    // Replaces every free rect that overlaps 'used' with the (up to four) maximal rects around
+    // it, dropping those that are contained in others.
+    void splitFreeRects(const SkIRect& used);
+
+    SkTDArray<SkIRect>  fFreeRects;
+    SkTDArray<SkIRect>  fNewRects;    // Scratch space for splitFreeRects().
+    int32_t             fAreaSoFar;
+
+    typedef GrRectanizer INHERITED;
+};
+
+#endif
@@ -95,6 +95,11 @@ private:
 #define RETURN_FALSE_IF_ABANDONED  if (this->drawingManager()->wasAbandoned()) { return false; }
 #define RETURN_FALSE_IF_ABANDONED_PRIV  if (fRenderTargetContext->drawingManager()->wasAbandoned()) { return false; }
 #define RETURN_NULL_IF_ABANDONED   if (this->drawingManager()->wasAbandoned()) { return nullptr; }
+// Ops made on a context that records a DDL are allocated from the DDL's arena.
+#define AUTO_OP_ARENA \
+    GrOpArena::AutoInstall autoOpArena(this->drawingManager()->opArena());
+#define AUTO_OP_ARENA_PRIV \
+    GrOpArena::AutoInstall autoOpArena(fRenderTargetContext->drawingManager()->opArena());
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -225,6 +230,7 @@ void GrRenderTargetContext::drawText(const GrClip& clip, const SkPaint& skPaint,
     RETURN_IF_ABANDONED
     SkDEBUGCODE(this->validate();)
     GR_CREATE_TRACE_MARKER_CONTEXT("GrRenderTargetContext", "drawText", fContext);
+    AUTO_OP_ARENA
 
     GrAtlasTextContext* atlasTextContext = this->drawingManager()->getAtlasTextContext();
     atlasTextContext->drawText(fContext, fTextTarget.get(), clip, skPaint, viewMatrix,
@@ -240,6 +246,7 @@ void GrRenderTargetContext::drawPosText(const GrClip& clip, const SkPaint& paint
     RETURN_IF_ABANDONED
     SkDEBUGCODE(this->validate();)
     GR_CREATE_TRACE_MARKER_CONTEXT("GrRenderTargetContext", "drawPosText", fContext);
+    AUTO_OP_ARENA
 
     GrAtlasTextContext* atlasTextContext = this->drawingManager()->getAtlasTextContext();
     atlasTextContext->drawPosText(fContext, fTextTarget.get(), clip, paint, viewMatrix,
@@ -255,6 +262,7 @@ void GrRenderTargetContext::drawTextBlob(const GrClip& clip, const SkPaint& pain
     RETURN_IF_ABANDONED
     SkDEBUGCODE(this->validate();)
     GR_CREATE_TRACE_MARKER_CONTEXT("GrRenderTargetContext", "drawTextBlob", fContext);
+    AUTO_OP_ARENA
 
     GrAtlasTextContext* atlasTextContext = this->drawingManager()->getAtlasTextContext();
     atlasTextContext->drawTextBlob(fContext, fTextTarget.get(), clip, paint, viewMatrix,
@@ -266,6 +274,7 @@ void GrRenderTargetContext::discard() {
     RETURN_IF_ABANDONED
     SkDEBUGCODE(this->validate();)
     GR_CREATE_TRACE_MARKER_CONTEXT("GrRenderTargetContext", "discard", fContext);
+    AUTO_OP_ARENA
 
     AutoCheckFlush acf(this->drawingManager());
 
@@ -279,6 +288,7 @@ void GrRenderTargetContext::clear(const SkIRect* rect,
     RETURN_IF_ABANDONED
     SkDEBUGCODE(this->validate();)
     GR_CREATE_TRACE_MARKER_CONTEXT("GrRenderTargetContext", "clear", fContext);
+    AUTO_OP_ARENA
 
     AutoCheckFlush acf(this->drawingManager());
     this->internalClear(rect ? GrFixedClip(*rect) : GrFixedClip::Disabled(), color,
@@ -291,6 +301,7 @@ void GrRenderTargetContextPriv::absClear(const SkIRect* clearRect, const GrColor
     SkDEBUGCODE(fRenderTargetContext->validate();)
     GR_CREATE_TRACE_MARKER_CONTEXT("GrRenderTargetContextPriv", "absClear",
                                    fRenderTargetContext->fContext);
+    AUTO_OP_ARENA_PRIV
 
     AutoCheckFlush acf(fRenderTargetContext->drawingManager());
 
@@ -328,6 +339,7 @@ void GrRenderTargetContextPriv::clear(const GrFixedClip& clip,
     SkDEBUGCODE(fRenderTargetContext->validate();)
     GR_CREATE_TRACE_MARKER_CONTEXT("GrRenderTargetContextPriv", "clear",
                                    fRenderTargetContext->fContext);
+    AUTO_OP_ARENA_PRIV
 
     AutoCheckFlush acf(fRenderTargetContext->drawingManager());
     fRenderTargetContext->internalClear(clip, color, canClearFullscreen);
@@ -362,6 +374,7 @@ void GrRenderTargetContext::drawPaint(const GrClip& clip,
     RETURN_IF_ABANDONED
     SkDEBUGCODE(this->validate();)
     GR_CREATE_TRACE_MARKER_CONTEXT("GrRenderTargetContext", "drawPaint", fContext);
+    AUTO_OP_ARENA
 
     // set rect to be big enough to fill the space, but not super-huge, so we
     // don't overflow fixed-point implementations
@@ -496,6 +509,7 @@ void GrRenderTargetContext::drawRect(const GrClip& clip,
     RETURN_IF_ABANDONED
     SkDEBUGCODE(this->validate();)
     GR_CREATE_TRACE_MARKER_CONTEXT("GrRenderTargetContext", "drawRect", fContext);
+    AUTO_OP_ARENA
 
     // Path effects should've been devolved to a path in SkGpuDevice
     SkASSERT(!style->pathEffect());
@@ -600,6 +614,7 @@ void GrRenderTargetContextPriv::clearStencilClip(const GrFixedClip& clip, bool i
     SkDEBUGCODE(fRenderTargetContext->validate();)
     GR_CREATE_TRACE_MARKER_CONTEXT("GrRenderTargetContextPriv", "clearStencilClip",
                                    fRenderTargetContext->fContext);
+    AUTO_OP_ARENA_PRIV
 
     AutoCheckFlush acf(fRenderTargetContext->drawingManager());
 
@@ -621,6 +636,7 @@ void GrRenderTargetContextPriv::stencilPath(const GrHardClip& clip,
     SkDEBUGCODE(fRenderTargetContext->validate();)
     GR_CREATE_TRACE_MARKER_CONTEXT("GrRenderTargetContextPriv", "stencilPath",
                                    fRenderTargetContext->fContext);
+    AUTO_OP_ARENA_PRIV
 
     SkASSERT(aaType != GrAAType::kCoverage);
 
@@ -665,6 +681,7 @@ void GrRenderTargetContextPriv::stencilRect(const GrHardClip& clip,
     SkDEBUGCODE(fRenderTargetContext->validate();)
     GR_CREATE_TRACE_MARKER_CONTEXT("GrRenderTargetContextPriv", "stencilRect",
                                    fRenderTargetContext->fContext);
+    AUTO_OP_ARENA_PRIV
 
     SkASSERT(GrAAType::kCoverage != aaType);
     AutoCheckFlush acf(fRenderTargetContext->drawingManager());
@@ -688,6 +705,7 @@ bool GrRenderTargetContextPriv::drawAndStencilRect(const GrHardClip& clip,
     SkDEBUGCODE(fRenderTargetContext->validate();)
     GR_CREATE_TRACE_MARKER_CONTEXT("GrRenderTargetContextPriv", "drawAndStencilRect",
                                    fRenderTargetContext->fContext);
+    AUTO_OP_ARENA_PRIV
 
     AutoCheckFlush acf(fRenderTargetContext->drawingManager());
 
@@ -713,6 +731,7 @@ void GrRenderTargetContext::fillRectToRect(const GrClip& clip,
     RETURN_IF_ABANDONED
     SkDEBUGCODE(this->validate();)
             GR_CREATE_TRACE_MARKER_CONTEXT("GrRenderTargetContext", "fillRectToRect", fContext);
+    AUTO_OP_ARENA
 
     SkRect croppedRect = rectToDraw;
     SkRect croppedLocalRect = localRect;
@@ -775,6 +794,7 @@ void GrRenderTargetContext::drawTextureAffine(const GrClip& clip, sk_sp<GrTextur
     RETURN_IF_ABANDONED
     SkDEBUGCODE(this->validate();)
     GR_CREATE_TRACE_MARKER_CONTEXT("GrRenderTargetContext", "drawTextureAffine", fContext);
+    AUTO_OP_ARENA
     SkASSERT(!viewMatrix.hasPerspective());
     if (filter != GrSamplerState::Filter::kNearest && !must_filter(srcRect, dstRect, viewMatrix)) {
         filter = GrSamplerState::Filter::kNearest;
@@ -802,6 +822,7 @@ void GrRenderTargetContext::fillRectWithLocalMatrix(const GrClip& clip,
     RETURN_IF_ABANDONED
     SkDEBUGCODE(this->validate();)
     GR_CREATE_TRACE_MARKER_CONTEXT("GrRenderTargetContext", "fillRectWithLocalMatrix", fContext);
+    AUTO_OP_ARENA
 
     SkRect croppedRect = rectToDraw;
     if (!crop_filled_rect(this->width(), this->height(), clip, viewMatrix, &croppedRect)) {
@@ -849,6 +870,7 @@ void GrRenderTargetContext::drawVertices(const GrClip& clip,
     RETURN_IF_ABANDONED
     SkDEBUGCODE(this->validate();)
     GR_CREATE_TRACE_MARKER_CONTEXT("GrRenderTargetContext", "drawVertices", fContext);
+    AUTO_OP_ARENA
 
     AutoCheckFlush acf(this->drawingManager());
 
@@ -874,6 +896,7 @@ void GrRenderTargetContext::drawAtlas(const GrClip& clip,
     RETURN_IF_ABANDONED
     SkDEBUGCODE(this->validate();)
     GR_CREATE_TRACE_MARKER_CONTEXT("GrRenderTargetContext", "drawAtlas", fContext);
+    AUTO_OP_ARENA
 
     AutoCheckFlush acf(this->drawingManager());
 
@@ -895,6 +918,7 @@ void GrRenderTargetContext::drawRRect(const GrClip& origClip,
     RETURN_IF_ABANDONED
     SkDEBUGCODE(this->validate();)
     GR_CREATE_TRACE_MARKER_CONTEXT("GrRenderTargetContext", "drawRRect", fContext);
+    AUTO_OP_ARENA
     if (rrect.isEmpty()) {
        return;
     }
@@ -954,6 +978,7 @@ bool GrRenderTargetContext::drawFastShadow(const GrClip& clip,
     }
     SkDEBUGCODE(this->validate();)
     GR_CREATE_TRACE_MARKER_CONTEXT("GrRenderTargetContext", "drawFastShadow", fContext);
+    AUTO_OP_ARENA
 
     // check z plane
     bool tiltZPlane = SkToBool(!SkScalarNearlyZero(rec.fZPlaneParams.fX) ||
@@ -1235,6 +1260,7 @@ void GrRenderTargetContext::drawDRRect(const GrClip& clip,
     RETURN_IF_ABANDONED
     SkDEBUGCODE(this->validate();)
     GR_CREATE_TRACE_MARKER_CONTEXT("GrRenderTargetContext", "drawDRRect", fContext);
+    AUTO_OP_ARENA
 
     SkASSERT(!outer.isEmpty());
     SkASSERT(!inner.isEmpty());
@@ -1266,6 +1292,7 @@ void GrRenderTargetContext::drawRegion(const GrClip& clip,
     RETURN_IF_ABANDONED
     SkDEBUGCODE(this->validate();)
     GR_CREATE_TRACE_MARKER_CONTEXT("GrRenderTargetContext", "drawRegion", fContext);
+    AUTO_OP_ARENA
 
     if (GrAA::kYes == aa) {
         // GrRegionOp performs no antialiasing but is much faster, so here we check the matrix
@@ -1299,6 +1326,7 @@ void GrRenderTargetContext::drawOval(const GrClip& clip,
     RETURN_IF_ABANDONED
     SkDEBUGCODE(this->validate();)
     GR_CREATE_TRACE_MARKER_CONTEXT("GrRenderTargetContext", "drawOval", fContext);
+    AUTO_OP_ARENA
 
     if (oval.isEmpty() && !style.pathEffect()) {
         return;
@@ -1334,6 +1362,7 @@ void GrRenderTargetContext::drawArc(const GrClip& clip,
     RETURN_IF_ABANDONED
     SkDEBUGCODE(this->validate();)
             GR_CREATE_TRACE_MARKER_CONTEXT("GrRenderTargetContext", "drawArc", fContext);
+    AUTO_OP_ARENA
 
     AutoCheckFlush acf(this->drawingManager());
 
@@ -1370,6 +1399,7 @@ void GrRenderTargetContext::drawImageLattice(const GrClip& clip,
     RETURN_IF_ABANDONED
     SkDEBUGCODE(this->validate();)
     GR_CREATE_TRACE_MARKER_CONTEXT("GrRenderTargetContext", "drawImageLattice", fContext);
+    AUTO_OP_ARENA
 
     AutoCheckFlush acf(this->drawingManager());
 
@@ -1397,6 +1427,7 @@ bool GrRenderTargetContext::waitOnSemaphores(int numSemaphores,
     RETURN_FALSE_IF_ABANDONED
     SkDEBUGCODE(this->validate();)
     GR_CREATE_TRACE_MARKER_CONTEXT("GrRenderTargetContext", "waitOnSemaphores", fContext);
+    AUTO_OP_ARENA
 
     AutoCheckFlush acf(this->drawingManager());
 
@@ -1418,6 +1449,7 @@ bool GrRenderTargetContext::waitOnSemaphores(int numSemaphores,
 }
 
 void GrRenderTargetContext::insertEventMarker(const SkString& str) {
+    AUTO_OP_ARENA
     std::unique_ptr<GrOp> op(GrDebugMarkerOp::Make(fRenderTargetProxy.get(), str));
     this->getRTOpList()->addOp(std::move(op), *this->caps());
 }
@@ -1479,6 +1511,7 @@ void GrRenderTargetContext::drawPath(const GrClip& clip,
     RETURN_IF_ABANDONED
     SkDEBUGCODE(this->validate();)
             GR_CREATE_TRACE_MARKER_CONTEXT("GrRenderTargetContextPriv", "drawPath", fContext);
+    AUTO_OP_ARENA
 
     GrShape shape(path, style);
     if (shape.isEmpty()) {
@@ -1542,6 +1575,7 @@ bool GrRenderTargetContextPriv::drawAndStencilPath(const GrHardClip& clip,
     SkDEBUGCODE(fRenderTargetContext->validate();)
     GR_CREATE_TRACE_MARKER_CONTEXT("GrRenderTargetContextPriv", "drawAndStencilPath",
                                    fRenderTargetContext->fContext);
+    AUTO_OP_ARENA_PRIV
 
     if (path.isEmpty() && path.isInverseFillType()) {
         this->drawAndStencilRect(clip, ss, op, invert, GrAA::kNo, SkMatrix::I(),
@@ -1616,6 +1650,7 @@ void GrRenderTargetContext::drawShapeUsingPathRenderer(const GrClip& clip,
     ASSERT_SINGLE_OWNER
     RETURN_IF_ABANDONED
     GR_CREATE_TRACE_MARKER_CONTEXT("GrRenderTargetContext", "internalDrawPath", fContext);
+    AUTO_OP_ARENA
 
     SkIRect clipConservativeBounds;
     clip.getConservativeBounds(this->width(), this->height(), &clipConservativeBounds, nullptr);
@@ -1722,6 +1757,7 @@ uint32_t GrRenderTargetContext::addDrawOp(const GrClip& clip, std::unique_ptr<Gr
     }
     SkDEBUGCODE(this->validate();)
     GR_CREATE_TRACE_MARKER_CONTEXT("GrRenderTargetContext", "addDrawOp", fContext);
+    AUTO_OP_ARENA
 
     // Setup clip
     SkRect bounds;
@@ -10,17 +10,21 @@
 #include "GrCaps.h"
 #include "GrGpu.h"
 #include "GrGpuCommandBuffer.h"
+#include "GrOpBoundsIndex.h"
 #include "GrRect.h"
 #include "GrRenderTargetContext.h"
 #include "GrResourceAllocator.h"
 #include "ops/GrClearOp.h"
 #include "ops/GrCopySurfaceOp.h"
 #include "SkTraceEvent.h"
+#include <algorithm>
 
 
 ////////////////////////////////////////////////////////////////////////////////
 
-// Experimentally we have found that most combining occurs within the first 10 comparisons.
+// Experimentally we have found that most combining occurs within the first 10 comparisons. Short
+// opLists are searched linearly. Once an opList holds more ops than this it indexes them, and then
+// the limits apply to the ops of the same class that could be combined with, however far apart.
 static const int kMaxOpLookback = 10;
 static const int kMaxOpLookahead = 10;
 
@@ -183,6 +187,7 @@ bool GrRenderTargetOpList::onExecute(GrOpFlushState* flushState) {
 void GrRenderTargetOpList::endFlush() {
     fLastClipStackGenID = SK_InvalidUniqueID;
     fRecordedOps.reset();
+    fOpIndex.reset();
     fClipAllocator.reset();
     INHERITED::endFlush();
 }
@@ -205,6 +210,7 @@ void GrRenderTargetOpList::fullClear(const GrCaps& caps, GrColor color) {
     // buffer we will need a more elaborate tracking system (skbug.com/7002).
     if (this->isEmpty() || !fTarget.get()->asRenderTargetProxy()->needsStencil()) {
         fRecordedOps.reset();
+        fOpIndex.reset();
         fDeferredProxies.reset();
         fColorLoadOp = GrLoadOp::kClear;
         fLoadClearColor = color;
@@ -342,7 +348,11 @@ void GrRenderTargetOpList::recordOp(std::unique_ptr<GrOp> op,
     GrOP_INFO("\tOutcome:\n");
     int maxCandidates = SkTMin(kMaxOpLookback, fRecordedOps.count());
     // If we don't have a valid destination render target then we cannot reorder.
-    if (maxCandidates) {
+    if (fOpIndex) {
+        if (this->combineWithIndexedOp(op.get(), clip, dstProxy, caps)) {
+            return;
+        }
+    } else if (maxCandidates) {
         int i = 0;
         while (true) {
             const RecordedOp& candidate = fRecordedOps.fromBack(i);
@@ -377,6 +387,45 @@ void GrRenderTargetOpList::recordOp(std::unique_ptr<GrOp> op,
     }
     fRecordedOps.emplace_back(std::move(op), clip, dstProxy);
     fRecordedOps.back().fOp->wasRecorded(this);
+
+    if (fOpIndex) {
+        fOpIndex->append(fRecordedOps.back().fOp->bounds(), fRecordedOps.back().fOp->classID());
+    } else if (fRecordedOps.count() > kMaxOpLookback) {
+        fOpIndex.reset(new GrOpBoundsIndex);
+        fOpIndex->reset(SkRect::MakeIWH(fTarget.get()->width(), fTarget.get()->height()));
+        for (const RecordedOp& recordedOp : fRecordedOps) {
+            fOpIndex->append(recordedOp.fOp->bounds(), recordedOp.fOp->classID());
+        }
+    }
+}
+
+bool GrRenderTargetOpList::combineWithIndexedOp(GrOp* op, const GrAppliedClip* clip,
+                                                const DstProxy* dstProxy, const GrCaps& caps) {
+    // Only ops recorded at or after the last one that overlaps can be combined with, since the
+    // combined op draws at the candidate's position.
+    const SkRect bounds = op->bounds();
+    int blocker = fOpIndex->lastOverlapping(bounds);
+    if (const SkTDArray<int>* candidates = fOpIndex->opsOfClass(op->classID())) {
+        int end = SkTMax(candidates->count() - kMaxOpLookback, 0);
+        for (int i = candidates->count() - 1; i >= end && (*candidates)[i] >= blocker; --i) {
+            int candidateIdx = (*candidates)[i];
+            const RecordedOp& candidate = fRecordedOps[candidateIdx];
+            if (this->combineIfPossible(candidate, op, clip, dstProxy, caps)) {
+                GrOP_INFO("\t\tBackward: Combining with (%s, opID: %u)\n", candidate.fOp->name(),
+                          candidate.fOp->uniqueID());
+                GrOP_INFO("\t\t\tBackward: Combined op info:\n");
+                GrOP_INFO(SkTabString(candidate.fOp->dumpInfo(), 4).c_str());
+                GR_AUDIT_TRAIL_OPS_RESULT_COMBINED(fAuditTrail, candidate.fOp.get(), op);
+                fOpIndex->addBounds(candidateIdx, bounds);
+                return true;
+            }
+        }
+    }
+    if (blocker >= 0) {
+        GrOP_INFO("\t\tBackward: Intersects with (%s, opID: %u)\n",
+                  fRecordedOps[blocker].fOp->name(), fRecordedOps[blocker].fOp->uniqueID());
+    }
+    return false;
 }
 
 void GrRenderTargetOpList::forwardCombine(const GrCaps& caps) {
@@ -384,6 +433,11 @@ void GrRenderTargetOpList::forwardCombine(const GrCaps& caps) {
 
     GrOP_INFO("opList: %d ForwardCombine %d ops:\n", this->uniqueID(), fRecordedOps.count());
 
+    if (fOpIndex) {
+        this->forwardCombineIndexed(caps);
+        return;
+    }
+
     for (int i = 0; i < fRecordedOps.count() - 1; ++i) {
         GrOp* op = fRecordedOps[i].fOp.get();
 
@@ -418,3 +472,29 @@ void GrRenderTargetOpList::forwardCombine(const GrCaps& caps) {
     }
 }
 
+void GrRenderTargetOpList::forwardCombineIndexed(const GrCaps& caps) {
+    SkASSERT(fOpIndex && fOpIndex->count() == fRecordedOps.count());
+
+    for (int i = 0; i < fRecordedOps.count() - 1; ++i) {
+        GrOp* op = fRecordedOps[i].fOp.get();
+        const SkTDArray<int>* candidates = fOpIndex->opsOfClass(op->classID());
+        SkASSERT(candidates);
+        // Ops are only moved forward, so everything after i is still in place.
+        int blocker = fOpIndex->firstOverlappingAfter(i);
+        const int* first = std::upper_bound(candidates->begin(), candidates->end(), i);
+        const int* last = SkTMin(first + kMaxOpLookahead, candidates->end());
+        for (const int* j = first; j < last && *j <= blocker; ++j) {
+            const RecordedOp& candidate = fRecordedOps[*j];
+            if (this->combineIfPossible(fRecordedOps[i], candidate.fOp.get(),
+                                        candidate.fAppliedClip, &candidate.fDstProxy, caps)) {
+                GrOP_INFO("\t\t%d: (%s opID: %u) -> Combining with (%s, opID: %u)\n",
+                          i, op->name(), op->uniqueID(),
+                          candidate.fOp->name(), candidate.fOp->uniqueID());
+                GR_AUDIT_TRAIL_OPS_RESULT_COMBINED(fAuditTrail, op, candidate.fOp.get());
+                fRecordedOps[*j].fOp = std::move(fRecordedOps[i].fOp);
+                fOpIndex->moveBounds(i, *j);
+                break;
+            }
+        }
+    }
+}
@@ -25,6 +25,7 @@
 class GrAuditTrail;
 class GrClearOp;
 class GrCaps;
+class GrOpBoundsIndex;
 class GrRenderTargetProxy;
 
 class GrRenderTargetOpList final : public GrOpList {
@@ -152,6 +153,10 @@ private:
 
     void forwardCombine(const GrCaps&);
 
+    // These are used in place of the linear searches once there are enough ops to index.
+    bool combineWithIndexedOp(GrOp*, const GrAppliedClip*, const DstProxy*, const GrCaps&);
+    void forwardCombineIndexed(const GrCaps&);
+
     // If this returns true then b has been merged into a's op.
     bool combineIfPossible(const RecordedOp& a, GrOp* b, const GrAppliedClip* bClip,
                            const DstProxy* bDstTexture, const GrCaps&);
@@ -162,6 +167,7 @@ private:
 
     // For ops/opList we have mean: 5 stdDev: 28
     SkSTArray<5, RecordedOp, true> fRecordedOps;
+    std::unique_ptr<GrOpBoundsIndex> fOpIndex;
 
     // MDB TODO: 4096 for the first allocation of the clip space will be huge overkill.
     // Gather statistics to determine the correct size.
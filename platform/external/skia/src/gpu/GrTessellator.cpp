@@ -93,7 +93,8 @@
 
 namespace {
 
-const int kArenaChunkSize = 16 * 1024;
+const size_t kArenaChunkSize = 16 * 1024;
+const size_t kMinArenaChunkSize = 1024;
 #ifndef GR_TESSELLATOR_LEGACY_INVERSION_HANDLING
 const float kCosMiterAngle = 0.97f; // Corresponds to an angle of ~14 degrees.
 #endif
@@ -2261,19 +2262,26 @@ Poly* path_to_polys(const SkPath& path, SkScalar tolerance, const SkRect& clipBo
                              antialias, outerMesh, alloc);
 }
 
-int get_contour_count(const SkPath& path, SkScalar tolerance) {
+int get_contour_count(const SkPath& path, SkScalar tolerance, int* maxPts) {
     int contourCnt;
-    int maxPts = GrPathUtils::worstCasePointCount(path, &contourCnt, tolerance);
-    if (maxPts <= 0) {
+    *maxPts = GrPathUtils::worstCasePointCount(path, &contourCnt, tolerance);
+    if (*maxPts <= 0) {
         return 0;
     }
-    if (maxPts > ((int)SK_MaxU16 + 1)) {
-        SkDebugf("Path not rendered, too many verts (%d)\n", maxPts);
+    if (*maxPts > ((int)SK_MaxU16 + 1)) {
+        SkDebugf("Path not rendered, too many verts (%d)\n", *maxPts);
         return 0;
     }
     return contourCnt;
 }
 
+// Every point becomes a vertex and most get an edge, so size the arena's blocks from the point
+// count. Small paths, the common case, then don't pay for a full-size block.
+size_t arena_chunk_size(int maxPts) {
+    size_t size = (size_t)maxPts * (sizeof(Vertex) + sizeof(Edge));
+    return SkTPin<size_t>(size, kMinArenaChunkSize, kArenaChunkSize);
+}
+
 int count_points(Poly* polys, SkPath::FillType fillType) {
     int count = 0;
     for (Poly* poly = polys; poly; poly = poly->fNext) {
@@ -2317,12 +2325,13 @@ namespace GrTessellator {
 int PathToTriangles(const SkPath& path, SkScalar tolerance, const SkRect& clipBounds,
                     VertexAllocator* vertexAllocator, bool antialias, const GrColor& color,
                     bool canTweakAlphaForCoverage, bool* isLinear) {
-    int contourCnt = get_contour_count(path, tolerance);
+    int maxPts;
+    int contourCnt = get_contour_count(path, tolerance, &maxPts);
     if (contourCnt <= 0) {
         *isLinear = true;
         return 0;
     }
-    SkArenaAlloc alloc(kArenaChunkSize);
+    SkArenaAlloc alloc(arena_chunk_size(maxPts));
     VertexList outerMesh;
     Poly* polys = path_to_polys(path, tolerance, clipBounds, contourCnt, alloc, antialias,
                                 isLinear, &outerMesh);
@@ -2357,12 +2366,13 @@ int PathToTriangles(const SkPath& path, SkScalar tolerance, const SkRect& clipBo
 
 int PathToVertices(const SkPath& path, SkScalar tolerance, const SkRect& clipBounds,
                    GrTessellator::WindingVertex** verts) {
-    int contourCnt = get_contour_count(path, tolerance);
+    int maxPts;
+    int contourCnt = get_contour_count(path, tolerance, &maxPts);
     if (contourCnt <= 0) {
         *verts = nullptr;
         return 0;
     }
-    SkArenaAlloc alloc(kArenaChunkSize);
+    SkArenaAlloc alloc(arena_chunk_size(maxPts));
     bool isLinear;
     Poly* polys = path_to_polys(path, tolerance, clipBounds, contourCnt, alloc, false, &isLinear,
                                 nullptr);
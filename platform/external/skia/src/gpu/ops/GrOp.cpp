@@ -8,6 +8,7 @@
 #include "GrOp.h"
 
 #include "GrMemoryPool.h"
+#include "GrOpArena.h"
 #include "SkSpinlock.h"
 
 // TODO I noticed a small benefit to using a larger exclusive pool for ops. Its very small, but
@@ -46,12 +47,18 @@ int32_t GrOp::gCurrOpClassID = GrOp::kIllegalOpID;
 
 int32_t GrOp::gCurrOpUniqueID = GrOp::kIllegalOpID;
 
+// Threads that record into their own GrOpArena, like SkDeferredDisplayListRecorders do, don't use
+// the global pool at all.
 void* GrOp::operator new(size_t size) {
-    return MemoryPoolAccessor().pool()->allocate(size);
+    return GrOpArena::Allocate(size, [](size_t poolSize) {
+        return MemoryPoolAccessor().pool()->allocate(poolSize);
+    });
 }
 
 void GrOp::operator delete(void* target) {
-    return MemoryPoolAccessor().pool()->release(target);
+    GrOpArena::Release(target, [](void* poolMem) {
+        MemoryPoolAccessor().pool()->release(poolMem);
+    });
 }
 
 GrOp::GrOp(uint32_t classID)
@@ -9,6 +9,7 @@
 
 #include "GrAuditTrail.h"
 #include "GrClip.h"
+#include "GrContextPriv.h"
 #include "GrDefaultGeoProcFactory.h"
 #include "GrDrawOpTest.h"
 #include "GrMesh.h"
@@ -17,7 +18,12 @@
 #include "GrResourceCache.h"
 #include "GrResourceProvider.h"
 #include "GrTessellator.h"
+#include "SkAutoMalloc.h"
 #include "SkGeometry.h"
+#include "SkMakeUnique.h"
+#include "SkSemaphore.h"
+#include "SkTaskGroup.h"
+#include "SkTraceEvent.h"
 
 #include "GrSimpleMeshDrawOpHelper.h"
 #include "ops/GrMeshDrawOp.h"
@@ -131,6 +137,118 @@ private:
     void* fVertices;
 };
 
+// Non-AA vertices are cached in model space, keyed by the shape and, for inverse fills, the clip.
+void make_cache_key(const GrShape& shape, const SkIRect& devClipBounds, GrUniqueKey* key) {
+    static const GrUniqueKey::Domain kDomain = GrUniqueKey::GenerateDomain();
+    static constexpr int kClipBoundsCnt = sizeof(devClipBounds) / sizeof(uint32_t);
+    int shapeKeyDataCnt = shape.unstyledKeySize();
+    SkASSERT(shapeKeyDataCnt >= 0);
+    GrUniqueKey::Builder builder(key, kDomain, shapeKeyDataCnt + kClipBoundsCnt, "Path");
+    shape.writeUnstyledKey(&builder[0]);
+    // For inverse fills, the tessellation is dependent on clip bounds.
+    if (shape.inverseFilled()) {
+        memcpy(&builder[shapeKeyDataCnt], &devClipBounds, sizeof(devClipBounds));
+    } else {
+        memset(&builder[shapeKeyDataCnt], 0, sizeof(devClipBounds));
+    }
+    builder.finish();
+}
+
+SkScalar non_aa_tolerance(const GrShape& shape, const SkMatrix& viewMatrix) {
+    return GrPathUtils::scaleToleranceToSrc(GrPathUtils::kDefaultTolerance, viewMatrix,
+                                            shape.bounds());
+}
+
+// The layout GrTessellator writes: positions, plus color and coverage when antialiasing.
+size_t vertex_stride(bool antialias, bool canTweakAlphaForCoverage) {
+    if (!antialias) {
+        return sizeof(SkPoint);
+    }
+    return canTweakAlphaForCoverage ? sizeof(GrDefaultGeoProcFactory::PositionColorAttr)
+                                    : sizeof(GrDefaultGeoProcFactory::PositionColorCoverageAttr);
+}
+
+class CPUVertexAllocator : public GrTessellator::VertexAllocator {
+public:
+    CPUVertexAllocator(size_t stride, SkAutoMalloc* storage)
+        : VertexAllocator(stride)
+        , fStorage(storage) {}
+    void* lock(int vertexCount) override { return fStorage->reset(vertexCount * stride()); }
+    void unlock(int actualCount) override {}
+private:
+    SkAutoMalloc* fStorage;
+};
+
+/**
+ * A path tessellated into CPU memory by a task on the context's SkTaskGroup. The op starts the
+ * task once its color and coverage are final, so tessellation runs in parallel with the rest of
+ * recording, and only waits for it in onPrepareDraws, where the vertices are copied into a
+ * vertex buffer. The destructor also waits, in case the op is deleted without being flushed.
+ */
+class DeferredTessellation : public SkNoncopyable {
+public:
+    DeferredTessellation(const SkPath& path, SkScalar tolerance, const SkRect& clipBounds,
+                         bool antialias, GrColor color, bool canTweakAlphaForCoverage)
+        : fPath(path)
+        , fTolerance(tolerance)
+        , fClipBounds(clipBounds)
+        , fStride(vertex_stride(antialias, canTweakAlphaForCoverage))
+        , fAntialias(antialias)
+        , fColor(color)
+        , fCanTweakAlphaForCoverage(canTweakAlphaForCoverage) {}
+
+    ~DeferredTessellation() { this->wait(); }
+
+    // Called on the worker thread.
+    void run() {
+        CPUVertexAllocator allocator(fStride, &fVertices);
+        fCount = GrTessellator::PathToTriangles(fPath, fTolerance, fClipBounds, &allocator,
+                                                fAntialias, fColor, fCanTweakAlphaForCoverage,
+                                                &fIsLinear);
+        fReady.signal();
+    }
+
+    // Waits for the tessellation, then copies it into 'allocator'. Returns the vertex count.
+    int copyTo(GrTessellator::VertexAllocator* allocator, bool* isLinear) {
+        this->wait();
+        *isLinear = fIsLinear;
+        if (0 == fCount) {
+            return 0;
+        }
+        SkASSERT(allocator->stride() == fStride);
+        void* verts = allocator->lock(fCount);
+        if (!verts) {
+            SkDebugf("Could not allocate vertices\n");
+            return 0;
+        }
+        memcpy(verts, fVertices.get(), fCount * fStride);
+        allocator->unlock(fCount);
+        return fCount;
+    }
+
+private:
+    void wait() {
+        if (!fWaited) {
+            fReady.wait();
+            fWaited = true;
+        }
+    }
+
+    const SkPath   fPath;
+    const SkScalar fTolerance;
+    const SkRect   fClipBounds;
+    const size_t   fStride;
+    const bool     fAntialias;
+    const GrColor  fColor;
+    const bool     fCanTweakAlphaForCoverage;
+
+    SkAutoMalloc   fVertices;
+    int            fCount = 0;
+    bool           fIsLinear = true;
+    SkSemaphore    fReady;
+    bool           fWaited = false;
+};
+
 }  // namespace
 
 GrTessellatingPathRenderer::GrTessellatingPathRenderer() {
@@ -174,9 +292,11 @@ public:
                                           const SkMatrix& viewMatrix,
                                           SkIRect devClipBounds,
                                           GrAAType aaType,
-                                          const GrUserStencilSettings* stencilSettings) {
+                                          const GrUserStencilSettings* stencilSettings,
+                                          SkTaskGroup* taskGroup = nullptr) {
         return Helper::FactoryHelper<TessellatingPathOp>(std::move(paint), shape, viewMatrix,
-                                                         devClipBounds, aaType, stencilSettings);
+                                                         devClipBounds, aaType, stencilSettings,
+                                                         taskGroup);
     }
 
     const char* name() const override { return "TessellatingPathOp"; }
@@ -199,14 +319,16 @@ public:
                        const SkMatrix& viewMatrix,
                        const SkIRect& devClipBounds,
                        GrAAType aaType,
-                       const GrUserStencilSettings* stencilSettings)
+                       const GrUserStencilSettings* stencilSettings,
+                       SkTaskGroup* taskGroup)
             : INHERITED(ClassID())
             , fHelper(helperArgs, aaType, stencilSettings)
             , fColor(color)
             , fShape(shape)
             , fViewMatrix(viewMatrix)
             , fDevClipBounds(devClipBounds)
-            , fAntiAlias(GrAAType::kCoverage == aaType) {
+            , fAntiAlias(GrAAType::kCoverage == aaType)
+            , fTaskGroup(taskGroup) {
         SkRect devBounds;
         viewMatrix.mapRect(&devBounds, shape.bounds());
         if (shape.inverseFilled()) {
@@ -224,7 +346,26 @@ public:
         GrProcessorAnalysisCoverage coverage = fAntiAlias
                                                        ? GrProcessorAnalysisCoverage::kSingleChannel
                                                        : GrProcessorAnalysisCoverage::kNone;
-        return fHelper.xpRequiresDstTexture(caps, clip, dstIsClamped, coverage, &fColor);
+        RequiresDstTexture result =
+                fHelper.xpRequiresDstTexture(caps, clip, dstIsClamped, coverage, &fColor);
+        // The vertex colors are final now, so the path can be tessellated ahead of the flush.
+        if (fTaskGroup) {
+            SkPath path;
+            SkScalar tol;
+            SkRect clipBounds;
+            if (this->getTessellationArgs(&path, &tol, &clipBounds)) {
+                fDeferred = skstd::make_unique<DeferredTessellation>(
+                        path, tol, clipBounds, fAntiAlias, fColor,
+                        fHelper.compatibleWithAlphaAsCoverage());
+                DeferredTessellation* deferred = fDeferred.get();
+                fTaskGroup->add([deferred] {
+                    TRACE_EVENT0("skia", "Threaded Tessellation");
+                    deferred->run();
+                });
+            }
+            fTaskGroup = nullptr;
+        }
+        return result;
     }
 
 private:
@@ -235,46 +376,62 @@ private:
         return path;
     }
 
+    // The path, tolerance and clip bounds to tessellate with: in model space without AA, so that
+    // the vertices can be cached, and in device space with AA. Returns false if there is nothing
+    // to draw.
+    bool getTessellationArgs(SkPath* path, SkScalar* tol, SkRect* clipBounds) const {
+        *path = this->getPath();
+        *clipBounds = SkRect::Make(fDevClipBounds);
+        if (fAntiAlias) {
+            if (path->isEmpty()) {
+                return false;
+            }
+            path->transform(fViewMatrix);
+            *tol = GrPathUtils::kDefaultTolerance;
+            return true;
+        }
+        SkMatrix vmi;
+        if (!fViewMatrix.invert(&vmi)) {
+            return false;
+        }
+        vmi.mapRect(clipBounds);
+        *tol = non_aa_tolerance(fShape, fViewMatrix);
+        return true;
+    }
+
+    int tessellate(GrTessellator::VertexAllocator* allocator, bool* isLinear) {
+        if (fDeferred) {
+            return fDeferred->copyTo(allocator, isLinear);
+        }
+        SkPath path;
+        SkScalar tol;
+        SkRect clipBounds;
+        if (!this->getTessellationArgs(&path, &tol, &clipBounds)) {
+            return 0;
+        }
+        return GrTessellator::PathToTriangles(path, tol, clipBounds, allocator, fAntiAlias,
+                                              fColor, fHelper.compatibleWithAlphaAsCoverage(),
+                                              isLinear);
+    }
+
     void draw(Target* target, const GrGeometryProcessor* gp) {
         SkASSERT(!fAntiAlias);
         GrResourceProvider* rp = target->resourceProvider();
-        bool inverseFill = fShape.inverseFilled();
         // construct a cache key from the path's genID and the view matrix
-        static const GrUniqueKey::Domain kDomain = GrUniqueKey::GenerateDomain();
         GrUniqueKey key;
-        static constexpr int kClipBoundsCnt = sizeof(fDevClipBounds) / sizeof(uint32_t);
-        int shapeKeyDataCnt = fShape.unstyledKeySize();
-        SkASSERT(shapeKeyDataCnt >= 0);
-        GrUniqueKey::Builder builder(&key, kDomain, shapeKeyDataCnt + kClipBoundsCnt, "Path");
-        fShape.writeUnstyledKey(&builder[0]);
-        // For inverse fills, the tessellation is dependent on clip bounds.
-        if (inverseFill) {
-            memcpy(&builder[shapeKeyDataCnt], &fDevClipBounds, sizeof(fDevClipBounds));
-        } else {
-            memset(&builder[shapeKeyDataCnt], 0, sizeof(fDevClipBounds));
-        }
-        builder.finish();
+        make_cache_key(fShape, fDevClipBounds, &key);
         sk_sp<GrBuffer> cachedVertexBuffer(rp->findByUniqueKey<GrBuffer>(key));
         int actualCount;
-        SkScalar tol = GrPathUtils::kDefaultTolerance;
-        tol = GrPathUtils::scaleToleranceToSrc(tol, fViewMatrix, fShape.bounds());
+        SkScalar tol = non_aa_tolerance(fShape, fViewMatrix);
         if (cache_match(cachedVertexBuffer.get(), tol, &actualCount)) {
             this->drawVertices(target, gp, cachedVertexBuffer.get(), 0, actualCount);
             return;
         }
 
-        SkRect clipBounds = SkRect::Make(fDevClipBounds);
-
-        SkMatrix vmi;
-        if (!fViewMatrix.invert(&vmi)) {
-            return;
-        }
-        vmi.mapRect(&clipBounds);
         bool isLinear;
         bool canMapVB = GrCaps::kNone_MapFlags != target->caps().mapBufferFlags();
         StaticVertexAllocator allocator(gp->getVertexStride(), rp, canMapVB);
-        int count = GrTessellator::PathToTriangles(getPath(), tol, clipBounds, &allocator,
-                                                   false, GrColor(), false, &isLinear);
+        int count = this->tessellate(&allocator, &isLinear);
         if (count == 0) {
             return;
         }
@@ -289,18 +446,9 @@ private:
 
     void drawAA(Target* target, const GrGeometryProcessor* gp) {
         SkASSERT(fAntiAlias);
-        SkPath path = getPath();
-        if (path.isEmpty()) {
-            return;
-        }
-        SkRect clipBounds = SkRect::Make(fDevClipBounds);
-        path.transform(fViewMatrix);
-        SkScalar tol = GrPathUtils::kDefaultTolerance;
         bool isLinear;
         DynamicVertexAllocator allocator(gp->getVertexStride(), target);
-        int count =
-                GrTessellator::PathToTriangles(path, tol, clipBounds, &allocator, true, fColor,
-                                               fHelper.compatibleWithAlphaAsCoverage(), &isLinear);
+        int count = this->tessellate(&allocator, &isLinear);
         if (count == 0) {
             return;
         }
@@ -361,6 +509,8 @@ private:
     SkMatrix                fViewMatrix;
     SkIRect                 fDevClipBounds;
     bool                    fAntiAlias;
+    SkTaskGroup*            fTaskGroup;
+    std::unique_ptr<DeferredTessellation> fDeferred;
 
     typedef GrMeshDrawOp INHERITED;
 };
@@ -374,12 +524,26 @@ bool GrTessellatingPathRenderer::onDrawPath(const DrawPathArgs& args) {
     args.fClip->getConservativeBounds(args.fRenderTargetContext->width(),
                                       args.fRenderTargetContext->height(),
                                       &clipBoundsI);
+    // With an executor, tessellate on another thread, unless the vertices are already cached.
+    SkTaskGroup* taskGroup = args.fContext->contextPriv().getTaskGroup();
+    GrResourceProvider* rp = args.fContext->contextPriv().resourceProvider();
+    if (taskGroup && GrAAType::kCoverage != args.fAAType && rp) {
+        GrUniqueKey key;
+        make_cache_key(*args.fShape, clipBoundsI, &key);
+        sk_sp<GrBuffer> cachedVertexBuffer(rp->findByUniqueKey<GrBuffer>(key));
+        int actualCount;
+        if (cache_match(cachedVertexBuffer.get(), non_aa_tolerance(*args.fShape, *args.fViewMatrix),
+                        &actualCount)) {
+            taskGroup = nullptr;
+        }
+    }
     std::unique_ptr<GrDrawOp> op = TessellatingPathOp::Make(std::move(args.fPaint),
                                                             *args.fShape,
                                                             *args.fViewMatrix,
                                                             clipBoundsI,
                                                             args.fAAType,
-                                                            args.fUserStencilSettings);
+                                                            args.fUserStencilSettings,
+                                                            taskGroup);
     args.fRenderTargetContext->addDrawOp(*args.fClip, std::move(op));
     return true;
 }
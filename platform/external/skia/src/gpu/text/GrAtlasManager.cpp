@@ -214,7 +214,8 @@ bool GrAtlasManager::initAtlas(GrMaskFormat format) {
         fAtlases[index] = GrDrawOpAtlas::Make(fProxyProvider, config, width, height,
                                               numPlotsX, numPlotsY, fAllowMultitexturing,
                                               &GrGlyphCache::HandleEviction,
-                                              fGlyphCache);
+                                              fGlyphCache,
+                                              GrGlyphCache::MoveHandlerForFormat(format));
         if (!fAtlases[index]) {
             return false;
         }
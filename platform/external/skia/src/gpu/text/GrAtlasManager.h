@@ -111,6 +111,13 @@ public:
         return this->getAtlas(format)->atlasGeneration();
     }
 
+    // Appends how full the plots of the atlas that matches this format are, if it has been made.
+    void getPlotStats(GrMaskFormat format, SkTArray<GrDrawOpAtlas::PlotStats>* stats) const {
+        if (const GrDrawOpAtlas* atlas = fAtlases[MaskFormatToAtlasIndex(format)].get()) {
+            atlas->getPlotStats(stats);
+        }
+    }
+
     // GrOnFlushCallbackObject overrides
 
     void preFlush(GrOnFlushResourceProvider* onFlushResourceProvider, const uint32_t*, int,
@@ -54,6 +54,30 @@ void GrGlyphCache::HandleEviction(GrDrawOpAtlas::AtlasID id, void* ptr) {
     }
 }
 
+template <GrMaskFormat kFormat>
+void GrGlyphCache::HandleMove(GrDrawOpAtlas::AtlasID from, GrDrawOpAtlas::AtlasID to,
+                              SkIPoint16 delta, void* ptr) {
+    GrGlyphCache* glyphCache = reinterpret_cast<GrGlyphCache*>(ptr);
+
+    StrikeHash::Iter iter(&glyphCache->fCache);
+    for (; !iter.done(); ++iter) {
+        (*iter).moveID(kFormat, from, to, delta);
+    }
+}
+
+GrDrawOpAtlas::MoveFunc GrGlyphCache::MoveHandlerForFormat(GrMaskFormat format) {
+    switch (format) {
+        case kA8_GrMaskFormat:
+            return &HandleMove<kA8_GrMaskFormat>;
+        case kA565_GrMaskFormat:
+            return &HandleMove<kA565_GrMaskFormat>;
+        case kARGB_GrMaskFormat:
+            return &HandleMove<kARGB_GrMaskFormat>;
+    }
+    SK_ABORT("Invalid GrMaskFormat");
+    return nullptr;
+}
+
 static inline GrMaskFormat get_packed_glyph_mask_format(const SkGlyph& glyph) {
     SkMask::Format format = static_cast<SkMask::Format>(glyph.fMaskFormat);
     switch (format) {
@@ -292,6 +316,19 @@ void GrTextStrike::removeID(GrDrawOpAtlas::AtlasID id) {
     }
 }
 
+void GrTextStrike::moveID(GrMaskFormat format, GrDrawOpAtlas::AtlasID from,
+                          GrDrawOpAtlas::AtlasID to, SkIPoint16 delta) {
+    SkTDynamicHash<GrGlyph, GrGlyph::PackedID>::Iter iter(&fCache);
+    while (!iter.done()) {
+        if (from == (*iter).fID && format == (*iter).fMaskFormat) {
+            (*iter).fID = to;
+            (*iter).fAtlasLocation.fX += delta.fX;
+            (*iter).fAtlasLocation.fY += delta.fY;
+        }
+        ++iter;
+    }
+}
+
 bool GrTextStrike::addGlyphToAtlas(GrResourceProvider* resourceProvider,
                                    GrDeferredUploadTarget* target,
                                    GrGlyphCache* glyphCache,
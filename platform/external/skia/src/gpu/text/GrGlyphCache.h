@@ -73,6 +73,10 @@ public:
     // remove any references to this plot
     void removeID(GrDrawOpAtlas::AtlasID);
 
+    // update the references to this plot of the given format's atlas, which has been moved
+    void moveID(GrMaskFormat, GrDrawOpAtlas::AtlasID from, GrDrawOpAtlas::AtlasID to,
+                SkIPoint16 delta);
+
     // If a TextStrike is abandoned by the cache, then the caller must get a new strike
     bool isAbandoned() const { return fIsAbandoned; }
 
@@ -131,7 +135,15 @@ public:
 
     static void HandleEviction(GrDrawOpAtlas::AtlasID, void*);
 
+    // Unlike evicting, moving changes where glyphs are, so the handler has to know which atlas,
+    // and so which mask format, the AtlasIDs are from.
+    static GrDrawOpAtlas::MoveFunc MoveHandlerForFormat(GrMaskFormat);
+
 private:
+    template <GrMaskFormat kFormat>
+    static void HandleMove(GrDrawOpAtlas::AtlasID from, GrDrawOpAtlas::AtlasID to,
+                           SkIPoint16 delta, void*);
+
     sk_sp<GrTextStrike> generateStrike(const SkGlyphCache* cache) {
         // 'fCache' get the construction ref
         sk_sp<GrTextStrike> strike = sk_ref_sp(new GrTextStrike(cache->getDescriptor()));
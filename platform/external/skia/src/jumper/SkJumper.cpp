@@ -269,6 +269,7 @@ extern "C" {
     NOPE(rgb_to_hsl) NOPE(hsl_to_rgb)
     NOPE(clut_3D) NOPE(clut_4D)
     NOPE(gauss_a_to_rgba)
+    NOPE(perlin_noise) NOPE(improved_noise)
 
     #undef LOWP
     #undef TODO
@@ -122,4 +122,18 @@ struct SkJumper_ColorLookupTableCtx {
     int limits[4];
 };
 
+// Used by perlin_noise and improved_noise. See SkPerlinNoiseShader.
+struct SkJumper_PerlinNoiseCtx {
+    const uint8_t* lattice;       // perlin_noise's lattice selector, 256 entries.
+    const float*   gradients;     // perlin_noise's gradients, (x,y) for 4 channels * 256 entries.
+    const uint8_t* permutations;  // improved_noise's permutations, 512 entries.
+    float baseFrequencyX, baseFrequencyY;
+    float offsetX, offsetY;       // From device space to the noise's (integer) coordinates.
+    float z;                      // improved_noise's seed.
+    int   numOctaves;
+    int   fractalNoise;           // perlin_noise's type: fractal noise or turbulence.
+    int   stitching;
+    int   stitchWidth, stitchHeight;
+};
+
 #endif//SkJumper_DEFINED
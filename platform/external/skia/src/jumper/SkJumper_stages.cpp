@@ -2253,6 +2253,132 @@ STAGE(gauss_a_to_rgba, Ctx::None) {
     b = a;
 }
 
+// Perlin noise, as defined for SVG's feTurbulence, for all four channels at once.
+// This is taken from the SVG spec: http://www.w3.org/TR/SVG11/filters.html#feTurbulenceElement
+STAGE(perlin_noise, const SkJumper_PerlinNoiseCtx* ctx) {
+    // (r,g) are pixel centers. The noise is sampled at whole points of its own space.
+    F x = floor_(r + ctx->offsetX) * ctx->baseFrequencyX,
+      y = floor_(g + ctx->offsetY) * ctx->baseFrequencyY;
+
+    const int kPerlinNoise = 4096;
+    int stitchWidth  = ctx->stitchWidth,
+        stitchHeight = ctx->stitchHeight;
+
+    F sum[4] = { 0, 0, 0, 0 };
+    float ratio = 1.0f;
+    for (int octave = 0; octave < ctx->numOctaves; ++octave) {
+        F px = x + (float)kPerlinNoise,
+          py = y + (float)kPerlinNoise;
+        F x0f = floor_(px),
+          y0f = floor_(py);
+        F fx = px - x0f,
+          fy = py - y0f;
+
+        U32 x0 = trunc_(x0f), x1 = x0 + 1,
+            y0 = trunc_(y0f), y1 = y0 + 1;
+        if (ctx->stitching) {
+            // Wrap the lattice around the stitch tile, so that tiling lines are not visible.
+            U32 wrapX = (uint32_t)(stitchWidth  + kPerlinNoise),
+                wrapY = (uint32_t)(stitchHeight + kPerlinNoise);
+            x0 = if_then_else(x0 >= wrapX, x0 - (uint32_t)stitchWidth , x0);
+            x1 = if_then_else(x1 >= wrapX, x1 - (uint32_t)stitchWidth , x1);
+            y0 = if_then_else(y0 >= wrapY, y0 - (uint32_t)stitchHeight, y0);
+            y1 = if_then_else(y1 >= wrapY, y1 - (uint32_t)stitchHeight, y1);
+        }
+
+        // The lattice points are the same for every channel. Only their gradients differ.
+        U32 i = expand(gather(ctx->lattice, x0 & 255)),
+            j = expand(gather(ctx->lattice, x1 & 255));
+        U32 b00 = 2 * ((i + y0) & 255),
+            b10 = 2 * ((j + y0) & 255),
+            b01 = 2 * ((i + y1) & 255),
+            b11 = 2 * ((j + y1) & 255);
+        F sx = fx * fx * (3 - 2 * fx),
+          sy = fy * fy * (3 - 2 * fy);
+
+        for (int channel = 0; channel < 4; ++channel) {
+            const float* gradients = ctx->gradients + 512 * channel;
+            auto dot = [=](U32 b, F u, F v) {
+                return gather(gradients, b) * u + gather(gradients, b + 1) * v;
+            };
+            F n = lerp(lerp(dot(b00, fx, fy    ), dot(b10, fx - 1, fy    ), sx),
+                       lerp(dot(b01, fx, fy - 1), dot(b11, fx - 1, fy - 1), sx), sy);
+            sum[channel] += (ctx->fractalNoise ? n : abs_(n)) * (1.0f / ratio);
+        }
+
+        x *= 2;
+        y *= 2;
+        ratio *= 2;
+        stitchWidth  *= 2;
+        stitchHeight *= 2;
+    }
+
+    if (ctx->fractalNoise) {
+        for (F& v : sum) {
+            v = (v + 1) * 0.5f;
+        }
+    }
+    r = min(max(0, sum[0]), 1);
+    g = min(max(0, sum[1]), 1);
+    b = min(max(0, sum[2]), 1);
+    a = min(max(0, sum[3]), 1);
+}
+
+// Improved Perlin noise, based on the Java implementation at http://mrl.nyu.edu/~perlin/noise/,
+// for all four channels at once. Each channel is a 2D slice of 3D noise at a different z.
+SI F improved_noise_grad(U32 hash, F x, F y, float z) {
+    U32 h = hash & 15;
+    F u = if_then_else(h < 8, x, y),
+      v = if_then_else(h < 4, y, if_then_else((h == 12) | (h == 14), x, F(z)));
+    return if_then_else((h & 1) == 0, u, -u) + if_then_else((h & 2) == 0, v, -v);
+}
+
+STAGE(improved_noise, const SkJumper_PerlinNoiseCtx* ctx) {
+    F x0 = floor_(r + ctx->offsetX) * ctx->baseFrequencyX,
+      y0 = floor_(g + ctx->offsetY) * ctx->baseFrequencyY;
+    auto perm = [=](U32 ix) { return expand(gather(ctx->permutations, ix)); };
+    auto fade = [](F t) { return t * t * t * (t * (t * 6 - 15) + 10); };
+
+    F result[4];
+    for (int channel = 0; channel < 4; ++channel) {
+        // z is the same for every pixel, so only x and y need vectors.
+        float z = channel * 1000.0f + ctx->z;
+        uint32_t Z = (uint32_t)(int)floorf(z) & 255;
+        float pz = z - floorf(z),
+              w  = pz * pz * pz * (pz * (pz * 6 - 15) + 10);
+
+        F x = x0, y = y0, sum = 0;
+        float ratio = 1.0f;
+        for (int octave = 0; octave < ctx->numOctaves; ++octave) {
+            F fx = floor_(x), fy = floor_(y);
+            U32 X = trunc_(fx) & 255, Y = trunc_(fy) & 255;
+            F px = x - fx, py = y - fy;
+            F u = fade(px), v = fade(py);
+
+            U32 A  = perm(X    ) + Y, AA = perm(A    ) + Z, AB = perm(A + 1) + Z,
+                B  = perm(X + 1) + Y, BA = perm(B    ) + Z, BB = perm(B + 1) + Z;
+            F n = lerp(lerp(lerp(improved_noise_grad(perm(AA    ), px    , py    , pz    ),
+                                 improved_noise_grad(perm(BA    ), px - 1, py    , pz    ), u),
+                            lerp(improved_noise_grad(perm(AB    ), px    , py - 1, pz    ),
+                                 improved_noise_grad(perm(BB    ), px - 1, py - 1, pz    ), u), v),
+                       lerp(lerp(improved_noise_grad(perm(AA + 1), px    , py    , pz - 1),
+                                 improved_noise_grad(perm(BA + 1), px - 1, py    , pz - 1), u),
+                            lerp(improved_noise_grad(perm(AB + 1), px    , py - 1, pz - 1),
+                                 improved_noise_grad(perm(BB + 1), px - 1, py - 1, pz - 1), u), v),
+                       F(w));
+            sum += n * (1.0f / ratio);
+            x *= 2;
+            y *= 2;
+            ratio *= 2;
+        }
+        result[channel] = min(max(0, (sum + 1) * 0.5f), 1);
+    }
+    r = result[0];
+    g = result[1];
+    b = result[2];
+    a = result[3];
+}
+
 // A specialized fused image shader for clamp-x, clamp-y, non-sRGB sampling.
 STAGE(bilerp_clamp_8888, SkJumper_GatherCtx* ctx) {
     // (cx,cy) are the center of our sample.
@@ -30,6 +30,25 @@ void blit_row_color32(SkPMColor* dst, const SkPMColor* src, int count, SkPMColor
     invA += invA >> 7;
     SkASSERT(invA < 256);  // We've should have already handled alpha == 0 externally.
 
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    // The same math as the Sk4px loop below, 8 pixels at a time.
+    {
+        const __m256i zero = _mm256_setzero_si256(),
+                      colorHighAndRound = _mm256_add_epi16(
+                              _mm256_unpacklo_epi8(zero, _mm256_set1_epi32(color)),
+                              _mm256_set1_epi16(128)),
+                      invA_16x = _mm256_set1_epi16(invA);
+        for (; count >= 8; count -= 8, src += 8, dst += 8) {
+            __m256i px = _mm256_loadu_si256((const __m256i*)src),
+                    lo = _mm256_mullo_epi16(_mm256_unpacklo_epi8(px, zero), invA_16x),
+                    hi = _mm256_mullo_epi16(_mm256_unpackhi_epi8(px, zero), invA_16x);
+            lo = _mm256_srli_epi16(_mm256_add_epi16(lo, colorHighAndRound), 8);
+            hi = _mm256_srli_epi16(_mm256_add_epi16(hi, colorHighAndRound), 8);
+            _mm256_storeu_si256((__m256i*)dst, _mm256_packus_epi16(lo, hi));
+        }
+    }
+#endif
+
     Sk16h colorHighAndRound = Sk4px::DupPMColor(color).widenHi() + Sk16h(128);
     Sk16b invA_16x(invA);
 
@@ -38,6 +57,27 @@ void blit_row_color32(SkPMColor* dst, const SkPMColor* src, int count, SkPMColor
     });
 }
 
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+
+// The same math as SkPMSrcOver_SSE2(), for 8 pixels at a time.
+static inline __m256i SkPMSrcOver_AVX2(const __m256i& src, const __m256i& dst) {
+    const __m256i mask = _mm256_set1_epi32(0xFF00FF);
+
+    // scale = 256 - SkGetPackedA32(src), in both 16-bit halves of each pixel.
+    __m256i scale = _mm256_srli_epi32(_mm256_slli_epi32(src, 24 - SK_A32_SHIFT), 24);
+    scale = _mm256_sub_epi32(_mm256_set1_epi32(256), scale);
+    scale = _mm256_or_si256(_mm256_slli_epi32(scale, 16), scale);
+
+    // SkAlphaMulQ(dst, scale), as in SkAlphaMulQ_SSE2().
+    __m256i rb = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_and_si256(mask, dst), scale), 8);
+    __m256i ag = _mm256_mullo_epi16(_mm256_srli_epi16(dst, 8), scale);
+    ag = _mm256_andnot_si256(mask, ag);
+
+    return _mm256_add_epi32(src, _mm256_or_si256(rb, ag));
+}
+
+#endif
+
 #if defined(SK_ARM_HAS_NEON)
 
 // Return a uint8x8_t value, r, computed as r[i] = SkMulDiv255Round(x[i], y[i]), where r[i], x[i],
@@ -82,7 +122,46 @@ void blit_row_s32a_opaque(SkPMColor* dst, const SkPMColor* src, int len, U8CPU a
     SkASSERT(alpha == 0xFF);
     sk_msan_assert_initialized(src, src+len);
 
-#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE41
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    const auto alphaMask = _mm256_set1_epi32(0xFF000000);
+
+    // Like the SSE4.1 loop below, but 16 pixels are only two registers, so we go on to blend
+    // runs of 8 too.
+    while (len >= 8) {
+        const int n = len >= 16 ? 16 : 8;
+
+        auto s0 = _mm256_loadu_si256((const __m256i*)(src) + 0),
+             s1 = n == 16 ? _mm256_loadu_si256((const __m256i*)(src) + 1) : s0;
+
+        if (_mm256_testz_si256(_mm256_or_si256(s0, s1), alphaMask)) {
+            // All n source pixels are transparent.  Nothing to do.
+            src += n;
+            dst += n;
+            len -= n;
+            continue;
+        }
+
+        auto d0 = (__m256i*)(dst) + 0,
+             d1 = (__m256i*)(dst) + 1;
+
+        if (_mm256_testc_si256(_mm256_and_si256(s0, s1), alphaMask)) {
+            // All n source pixels are opaque.  SrcOver becomes Src.
+            _mm256_storeu_si256(d0, s0);
+            if (n == 16) {
+                _mm256_storeu_si256(d1, s1);
+            }
+        } else {
+            _mm256_storeu_si256(d0, SkPMSrcOver_AVX2(s0, _mm256_loadu_si256(d0)));
+            if (n == 16) {
+                _mm256_storeu_si256(d1, SkPMSrcOver_AVX2(s1, _mm256_loadu_si256(d1)));
+            }
+        }
+        src += n;
+        dst += n;
+        len -= n;
+    }
+
+#elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE41
     while (len >= 16) {
         // Load 16 source pixels.
         auto s0 = _mm_loadu_si128((const __m128i*)(src) + 0),
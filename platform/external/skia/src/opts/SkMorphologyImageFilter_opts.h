@@ -9,6 +9,8 @@
 #define SkMorphologyImageFilter_opts_DEFINED
 
 #include "SkColor.h"
+#include "SkNx.h"
+#include "SkTemplates.h"
 
 namespace SK_OPTS_NS {
 
@@ -17,8 +19,8 @@ enum class MorphDirection { kX, kY };
 
 #if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
 template<MorphType type, MorphDirection direction>
-static void morph(const SkPMColor* src, SkPMColor* dst,
-                  int radius, int width, int height, int srcStride, int dstStride) {
+static void morph_direct(const SkPMColor* src, SkPMColor* dst,
+                         int radius, int width, int height, int srcStride, int dstStride) {
     const int srcStrideX = direction == MorphDirection::kX ? 1 : srcStride;
     const int dstStrideX = direction == MorphDirection::kX ? 1 : dstStride;
     const int srcStrideY = direction == MorphDirection::kX ? srcStride : 1;
@@ -50,8 +52,8 @@ static void morph(const SkPMColor* src, SkPMColor* dst,
 
 #elif defined(SK_ARM_HAS_NEON)
 template<MorphType type, MorphDirection direction>
-static void morph(const SkPMColor* src, SkPMColor* dst,
-                  int radius, int width, int height, int srcStride, int dstStride) {
+static void morph_direct(const SkPMColor* src, SkPMColor* dst,
+                         int radius, int width, int height, int srcStride, int dstStride) {
     const int srcStrideX = direction == MorphDirection::kX ? 1 : srcStride;
     const int dstStrideX = direction == MorphDirection::kX ? 1 : dstStride;
     const int srcStrideY = direction == MorphDirection::kX ? srcStride : 1;
@@ -82,8 +84,8 @@ static void morph(const SkPMColor* src, SkPMColor* dst,
 
 #else
 template<MorphType type, MorphDirection direction>
-static void morph(const SkPMColor* src, SkPMColor* dst,
-                  int radius, int width, int height, int srcStride, int dstStride) {
+static void morph_direct(const SkPMColor* src, SkPMColor* dst,
+                         int radius, int width, int height, int srcStride, int dstStride) {
     const int srcStrideX = direction == MorphDirection::kX ? 1 : srcStride;
     const int dstStrideX = direction == MorphDirection::kX ? 1 : dstStride;
     const int srcStrideY = direction == MorphDirection::kX ? srcStride : 1;
@@ -128,6 +130,98 @@ static void morph(const SkPMColor* src, SkPMColor* dst,
 
 #endif
 
+// Van Herk / Gil-Werman: pad the line with the identity and cut it into blocks as long as the
+// window. Every window then covers the tail of one block and the head of the next, so each output
+// is the extreme of a running suffix and a running prefix, no matter how large the radius is.
+// Four lines are filtered at once, one pixel of each in an Sk16b.
+template<MorphType type, MorphDirection direction>
+static void morph_van_herk(const SkPMColor* src, SkPMColor* dst,
+                           int radius, int width, int height, int srcStride, int dstStride) {
+    const int srcStrideX = direction == MorphDirection::kX ? 1 : srcStride;
+    const int dstStrideX = direction == MorphDirection::kX ? 1 : dstStride;
+    const int srcStrideY = direction == MorphDirection::kX ? srcStride : 1;
+    const int dstStrideY = direction == MorphDirection::kX ? dstStride : 1;
+    radius = SkMin32(radius, width - 1);
+    const int window = 2 * radius + 1;
+    const int padded = width + 2 * radius;
+    const Sk16b identity(type == kDilate ? 0 : 255);
+    auto extreme = [](const Sk16b& a, const Sk16b& b) {
+        return type == kDilate ? Sk16b::Max(a, b) : Sk16b::Min(a, b);
+    };
+    SkAutoTMalloc<uint32_t> suffix(4 * padded);
+
+    for (int y = 0; y < height; y += 4) {
+        const int lines = SkMin32(4, height - y);
+        // Columns are next to each other in memory, rows have to be gathered and scattered.
+        const bool contiguous = direction == MorphDirection::kY && lines == 4;
+        auto load = [&](int i) {
+            int x = i - radius;
+            if (x < 0 || x >= width) {
+                return identity;
+            }
+            const SkPMColor* p = src + x * srcStrideX;
+            if (contiguous) {
+                return Sk16b::Load(p);
+            }
+            uint32_t pixels[4];
+            for (int k = 0; k < 4; ++k) {
+                pixels[k] = p[SkMin32(k, lines - 1) * srcStrideY];
+            }
+            return Sk16b::Load(pixels);
+        };
+
+        Sk16b run = identity;
+        int toBlockStart = (padded - 1) % window;
+        for (int i = padded - 1; i >= 0; --i) {
+            run = extreme(run, load(i));
+            run.store(&suffix[4 * i]);
+            if (toBlockStart-- == 0) {
+                run = identity;
+                toBlockStart = window - 1;
+            }
+        }
+
+        run = identity;
+        int toBlockEnd = window;
+        SkPMColor* dptr = dst;
+        for (int i = 0; i < padded; ++i) {
+            if (toBlockEnd-- == 0) {
+                run = identity;
+                toBlockEnd = window - 1;
+            }
+            run = extreme(run, load(i));
+            if (i >= 2 * radius) {
+                Sk16b result = extreme(Sk16b::Load(&suffix[4 * (i - 2 * radius)]), run);
+                if (contiguous) {
+                    result.store(dptr);
+                } else {
+                    uint32_t pixels[4];
+                    result.store(pixels);
+                    for (int k = 0; k < lines; ++k) {
+                        dptr[k * dstStrideY] = pixels[k];
+                    }
+                }
+                dptr += dstStrideX;
+            }
+        }
+        src += 4 * srcStrideY;
+        dst += 4 * dstStrideY;
+    }
+}
+
+// Below this radius, taking the extreme of the whole window directly is cheaper.
+static constexpr int kMinVanHerkRadius = 4;
+
+template<MorphType type, MorphDirection direction>
+static void morph(const SkPMColor* src, SkPMColor* dst,
+                  int radius, int width, int height, int srcStride, int dstStride) {
+    if (radius >= kMinVanHerkRadius) {
+        morph_van_herk<type, direction>(src, dst, radius, width, height, srcStride, dstStride);
+    } else {
+        morph_direct<type, direction>(src, dst, radius, width, height, srcStride, dstStride);
+    }
+}
+
 static auto dilate_x = &morph<kDilate, MorphDirection::kX>,
             dilate_y = &morph<kDilate, MorphDirection::kY>,
              erode_x = &morph<kErode,  MorphDirection::kX>,
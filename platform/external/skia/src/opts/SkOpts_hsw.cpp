@@ -0,0 +1,25 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkSafe_math.h"   // Keep this first.
+#include "SkOpts.h"
+
+#if defined(_INC_MATH) && !defined(INC_MATH_IS_SAFE_NOW)
+    #error We have included ucrt\math.h without protecting it against ODR violation.
+#endif
+
+#define SK_OPTS_NS hsw
+#include "SkBlitMask_opts.h"
+#include "SkBlitRow_opts.h"
+
+namespace SkOpts {
+    void Init_hsw() {
+        blit_mask_d32_a8     = SK_OPTS_NS::blit_mask_d32_a8;
+        blit_row_color32     = SK_OPTS_NS::blit_row_color32;
+        blit_row_s32a_opaque = SK_OPTS_NS::blit_row_s32a_opaque;
+    }
+}
@@ -10,6 +10,8 @@
 #include "SkDeflate.h"
 #include "SkMakeUnique.h"
 #include "SkMalloc.h"
+#include "SkTaskGroup.h"
+#include "SkTemplates.h"
 #include "SkTraceEvent.h"
 
 #include "zlib.h"
@@ -54,32 +56,167 @@ static void do_deflate(int flush,
                  : returnValue == Z_OK);
 }
 
+static void init_zstream(z_stream* zStream, int compressionLevel, int windowBits) {
+    zStream->next_in = nullptr;
+    zStream->zalloc = &skia_alloc_func;
+    zStream->zfree = &skia_free_func;
+    zStream->opaque = nullptr;
+    SkDEBUGCODE(int r =) deflateInit2(zStream, compressionLevel, Z_DEFLATED, windowBits,
+                                      8, Z_DEFAULT_STRATEGY);
+    SkASSERT(Z_OK == r);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Threaded compression works pigz-style: each chunk of input is deflated on its own into a raw
+// deflate stream, primed with the window of input before it, and ended on a byte boundary with a
+// sync flush. The compressed chunks concatenate into one deflate stream, which we wrap in the
+// zlib or gzip header and trailer ourselves, combining the chunks' checksums.
+static constexpr size_t kParallelChunkSize = 128 * 1024;
+static constexpr size_t kDictionarySize = 32 * 1024;  // deflate's largest window
+
+namespace {
+struct CompressedChunk {
+    SkDynamicMemoryWStream fData;
+    uLong fCheck;
+};
+}  // namespace
+
+static void compress_chunk(CompressedChunk* chunk, int compressionLevel, bool gzip, bool last,
+                           const unsigned char* dictionary, size_t dictionarySize,
+                           const unsigned char* input, size_t inputSize) {
+    z_stream zStream;
+    init_zstream(&zStream, compressionLevel, -15);  // raw deflate, no header or trailer
+    if (dictionarySize) {
+        SkDEBUGCODE(int r =) deflateSetDictionary(&zStream, dictionary, SkToUInt(dictionarySize));
+        SkASSERT(Z_OK == r);
+    }
+    do_deflate(last ? Z_FINISH : Z_SYNC_FLUSH, &zStream, &chunk->fData,
+               const_cast<unsigned char*>(input), inputSize);
+    (void)deflateEnd(&zStream);
+    chunk->fCheck = gzip ? crc32(0, input, SkToUInt(inputSize))
+                         : adler32(1, input, SkToUInt(inputSize));
+}
+
+static void write_be32(SkWStream* out, uint32_t v) {
+    const uint8_t bytes[] = { (uint8_t)(v >> 24), (uint8_t)(v >> 16), (uint8_t)(v >> 8),
+                              (uint8_t)v };
+    out->write(bytes, sizeof(bytes));
+}
+
+static void write_le32(SkWStream* out, uint32_t v) {
+    const uint8_t bytes[] = { (uint8_t)v, (uint8_t)(v >> 8), (uint8_t)(v >> 16),
+                              (uint8_t)(v >> 24) };
+    out->write(bytes, sizeof(bytes));
+}
+
+// The header zlib's deflate() would write for this level.
+static void write_header(SkWStream* out, int compressionLevel, bool gzip) {
+    if (compressionLevel < 0) {
+        compressionLevel = 6;
+    }
+    if (gzip) {
+        const uint8_t extraFlags = 9 == compressionLevel ? 2 : compressionLevel < 2 ? 4 : 0;
+        const uint8_t header[] = { 0x1F, 0x8B, Z_DEFLATED, 0, 0, 0, 0, 0, extraFlags,
+                                   0xFF };  // unknown OS
+        out->write(header, sizeof(header));
+    } else {
+        const unsigned levelFlags = compressionLevel < 2 ? 0 :
+                                    compressionLevel < 6 ? 1 :
+                                    compressionLevel == 6 ? 2 : 3;
+        unsigned header = (0x78 << 8) | (levelFlags << 6);  // 32K window
+        header += 31 - header % 31;
+        const uint8_t bytes[] = { (uint8_t)(header >> 8), (uint8_t)header };
+        out->write(bytes, sizeof(bytes));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 // Hide all zlib impl details.
 struct SkDeflateWStream::Impl {
     SkWStream* fOut;
     unsigned char fInBuffer[SKDEFLATEWSTREAM_INPUT_BUFFER_SIZE];
     size_t fInBufferIndex;
     z_stream fZStream;
+
+    // Only used with threads.
+    int fCompressionLevel;
+    bool fGzip;
+    int fThreads;
+    // The kDictionarySize bytes of input before fPending, then room for fThreads chunks.
+    SkAutoTMalloc<unsigned char> fPending;
+    size_t fDictionarySize;     // how much of the dictionary is input so far
+    size_t fPendingSize;
+    size_t fTotalIn;
+    uLong fCheck;
+
+    unsigned char* pending() { return fPending.get() + kDictionarySize; }
+    size_t pendingCapacity() const { return fThreads * kParallelChunkSize; }
+
+    // Compresses and writes all the pending input.
+    void flushChunks(bool last);
 };
 
+void SkDeflateWStream::Impl::flushChunks(bool last) {
+    const int count = SkTMax(1, SkToInt((fPendingSize + kParallelChunkSize - 1) /
+                                        kParallelChunkSize));
+    SkAutoTArray<CompressedChunk> chunks(count);
+    auto compress = [&](int i) {
+        const size_t start = i * kParallelChunkSize;
+        const size_t dictionarySize = SkTMin(kDictionarySize, fDictionarySize + start);
+        compress_chunk(&chunks[i], fCompressionLevel, fGzip, last && i == count - 1,
+                       this->pending() + start - dictionarySize, dictionarySize,
+                       this->pending() + start,
+                       SkTMin(kParallelChunkSize, fPendingSize - start));
+    };
+    if (count > 1) {
+        SkTaskGroup().batch(count, compress);
+    } else {
+        compress(0);
+    }
+
+    for (int i = 0; i < count; ++i) {
+        const size_t size = SkTMin(kParallelChunkSize, fPendingSize - i * kParallelChunkSize);
+        fCheck = fGzip ? crc32_combine(fCheck, chunks[i].fCheck, SkToS32(size))
+                       : adler32_combine(fCheck, chunks[i].fCheck, SkToS32(size));
+        chunks[i].fData.writeToAndReset(fOut);
+    }
+
+    // Keep the end of the input as the next chunk's dictionary.
+    const size_t keep = SkTMin(kDictionarySize, fDictionarySize + fPendingSize);
+    memmove(this->pending() - keep, this->pending() + fPendingSize - keep, keep);
+    fDictionarySize = keep;
+    fTotalIn += fPendingSize;
+    fPendingSize = 0;
+}
+
 SkDeflateWStream::SkDeflateWStream(SkWStream* out,
                                    int compressionLevel,
-                                   bool gzip)
+                                   bool gzip,
+                                   int threads)
     : fImpl(skstd::make_unique<SkDeflateWStream::Impl>()) {
     fImpl->fOut = out;
     fImpl->fInBufferIndex = 0;
+    fImpl->fThreads = 0;
+    fImpl->fZStream.total_in = 0;
     if (!fImpl->fOut) {
         return;
     }
-    fImpl->fZStream.next_in = nullptr;
-    fImpl->fZStream.zalloc = &skia_alloc_func;
-    fImpl->fZStream.zfree = &skia_free_func;
-    fImpl->fZStream.opaque = nullptr;
     SkASSERT(compressionLevel <= 9 && compressionLevel >= -1);
-    SkDEBUGCODE(int r =) deflateInit2(&fImpl->fZStream, compressionLevel,
-                                      Z_DEFLATED, gzip ? 0x1F : 0x0F,
-                                      8, Z_DEFAULT_STRATEGY);
-    SkASSERT(Z_OK == r);
+    if (threads > 1) {
+        fImpl->fCompressionLevel = compressionLevel;
+        fImpl->fGzip = gzip;
+        fImpl->fThreads = threads;
+        fImpl->fPending.reset(kDictionarySize + fImpl->pendingCapacity());
+        fImpl->fDictionarySize = 0;
+        fImpl->fPendingSize = 0;
+        fImpl->fTotalIn = 0;
+        fImpl->fCheck = gzip ? crc32(0, nullptr, 0) : adler32(0, nullptr, 0);
+        write_header(out, compressionLevel, gzip);
+        return;
+    }
+    init_zstream(&fImpl->fZStream, compressionLevel, gzip ? 0x1F : 0x0F);
 }
 
 SkDeflateWStream::~SkDeflateWStream() { this->finalize(); }
@@ -89,6 +226,18 @@ void SkDeflateWStream::finalize() {
     if (!fImpl->fOut) {
         return;
     }
+    if (fImpl->fThreads) {
+        fImpl->flushChunks(true);
+        if (fImpl->fGzip) {
+            write_le32(fImpl->fOut, SkToU32(fImpl->fCheck));
+            write_le32(fImpl->fOut, (uint32_t)fImpl->fTotalIn);
+        } else {
+            write_be32(fImpl->fOut, SkToU32(fImpl->fCheck));
+        }
+        fImpl->fPending.reset(0);
+        fImpl->fOut = nullptr;
+        return;
+    }
     do_deflate(Z_FINISH, &fImpl->fZStream, fImpl->fOut, fImpl->fInBuffer,
                fImpl->fInBufferIndex);
     (void)deflateEnd(&fImpl->fZStream);
@@ -101,6 +250,21 @@ bool SkDeflateWStream::write(const void* void_buffer, size_t len) {
         return false;
     }
     const char* buffer = (const char*)void_buffer;
+    if (fImpl->fThreads) {
+        while (len > 0) {
+            // Wait for more input before flushing, so that the final chunk is always the one
+            // finalize() ends, whatever the number of threads.
+            if (fImpl->pendingCapacity() == fImpl->fPendingSize) {
+                fImpl->flushChunks(false);
+            }
+            size_t tocopy = SkTMin(len, fImpl->pendingCapacity() - fImpl->fPendingSize);
+            memcpy(fImpl->pending() + fImpl->fPendingSize, buffer, tocopy);
+            len -= tocopy;
+            buffer += tocopy;
+            fImpl->fPendingSize += tocopy;
+        }
+        return true;
+    }
     while (len > 0) {
         size_t tocopy =
                 SkTMin(len, sizeof(fImpl->fInBuffer) - fImpl->fInBufferIndex);
@@ -121,5 +285,8 @@ bool SkDeflateWStream::write(const void* void_buffer, size_t len) {
 }
 
 size_t SkDeflateWStream::bytesWritten() const {
+    if (fImpl->fThreads) {
+        return fImpl->fTotalIn + fImpl->fPendingSize;
+    }
     return fImpl->fZStream.total_in + fImpl->fInBufferIndex;
 }
@@ -29,10 +29,17 @@ public:
         a wrapper, documented in RFC 1952, around a deflate stream."
         gzip adds a header with a magic number to the beginning of the
         stream, alowing a client to identify a gzip file.
+
+        @param threads if greater than 1, the input is cut into 128KB
+        chunks that are compressed in parallel, up to this many at a
+        time, each primed with the 32KB of input before it.  The
+        output is a little larger and decompresses the same; it does
+        not depend on the number of threads.
      */
     SkDeflateWStream(SkWStream*,
                      int compressionLevel = -1,
-                     bool gzip = false);
+                     bool gzip = false,
+                     int threads = 1);
 
     /** The destructor calls finalize(). */
     ~SkDeflateWStream() override;
@@ -279,7 +279,9 @@ static void emit_image_xobject(SkWStream* stream,
                                const SkImage* image,
                                bool alpha,
                                const sk_sp<SkPDFObject>& smask,
-                               const SkPDFObjNumMap& objNumMap) {
+                               const SkPDFObjNumMap& objNumMap,
+                               int compressionLevel,
+                               int compressionThreads) {
     SkBitmap bitmap;
     if (!SkPDFUtils::ToBitmap(image, &bitmap)) {
         // no pixels or wrong size: fill with zeros.
@@ -288,7 +290,7 @@ static void emit_image_xobject(SkWStream* stream,
 
     // Write to a temporary buffer to get the compressed length.
     SkDynamicMemoryWStream buffer;
-    SkDeflateWStream deflateWStream(&buffer);
+    SkDeflateWStream deflateWStream(&buffer, compressionLevel, false, compressionThreads);
     if (alpha) {
         bitmap_alpha_to_a8(bitmap, &deflateWStream);
     } else {
@@ -326,16 +328,22 @@ namespace {
 // This SkPDFObject only outputs the alpha layer of the given bitmap.
 class PDFAlphaBitmap final : public SkPDFObject {
 public:
-    PDFAlphaBitmap(sk_sp<SkImage> image) : fImage(std::move(image)) { SkASSERT(fImage); }
+    PDFAlphaBitmap(sk_sp<SkImage> image, int compressionLevel, int compressionThreads)
+        : fImage(std::move(image))
+        , fCompressionLevel(compressionLevel)
+        , fCompressionThreads(compressionThreads) { SkASSERT(fImage); }
     void emitObject(SkWStream*  stream,
                     const SkPDFObjNumMap& objNumMap) const override {
         SkASSERT(fImage);
-        emit_image_xobject(stream, fImage.get(), true, nullptr, objNumMap);
+        emit_image_xobject(stream, fImage.get(), true, nullptr, objNumMap,
+                           fCompressionLevel, fCompressionThreads);
     }
     void drop() override { fImage = nullptr; }
 
 private:
     sk_sp<SkImage> fImage;
+    int fCompressionLevel;
+    int fCompressionThreads;
 };
 
 }  // namespace
@@ -348,18 +356,25 @@ public:
     void emitObject(SkWStream* stream,
                     const SkPDFObjNumMap& objNumMap) const override {
         SkASSERT(fImage);
-        emit_image_xobject(stream, fImage.get(), false, fSMask, objNumMap);
+        emit_image_xobject(stream, fImage.get(), false, fSMask, objNumMap,
+                           fCompressionLevel, fCompressionThreads);
     }
     void addResources(SkPDFObjNumMap* catalog) const override {
         catalog->addObjectRecursively(fSMask.get());
     }
     void drop() override { fImage = nullptr; fSMask = nullptr; }
-    PDFDefaultBitmap(sk_sp<SkImage> image, sk_sp<SkPDFObject> smask)
-        : fImage(std::move(image)), fSMask(std::move(smask)) { SkASSERT(fImage); }
+    PDFDefaultBitmap(sk_sp<SkImage> image, sk_sp<SkPDFObject> smask,
+                     int compressionLevel, int compressionThreads)
+        : fImage(std::move(image))
+        , fSMask(std::move(smask))
+        , fCompressionLevel(compressionLevel)
+        , fCompressionThreads(compressionThreads) { SkASSERT(fImage); }
 
 private:
     sk_sp<SkImage> fImage;
     sk_sp<SkPDFObject> fSMask;
+    int fCompressionLevel;
+    int fCompressionThreads;
 };
 }  // namespace
 
@@ -407,7 +422,8 @@ void PDFJpegBitmap::emitObject(SkWStream* stream,
 
 ////////////////////////////////////////////////////////////////////////////////
 
-sk_sp<SkPDFObject> SkPDFCreateBitmapObject(sk_sp<SkImage> image, int encodingQuality) {
+sk_sp<SkPDFObject> SkPDFCreateBitmapObject(sk_sp<SkImage> image, int encodingQuality,
+                                           int compressionLevel, int compressionThreads) {
     SkASSERT(image);
     SkASSERT(encodingQuality >= 0);
     sk_sp<SkData> data = image->refEncodedData();
@@ -437,10 +453,11 @@ sk_sp<SkPDFObject> SkPDFCreateBitmapObject(sk_sp<SkImage> image, int encodingQua
 
     sk_sp<SkPDFObject> smask;
     if (!isOpaque) {
-        smask = sk_make_sp<PDFAlphaBitmap>(image);
+        smask = sk_make_sp<PDFAlphaBitmap>(image, compressionLevel, compressionThreads);
     }
     #ifdef SK_PDF_IMAGE_STATS
     gRegularImageObjects.fetch_add(1);
     #endif
-    return sk_make_sp<PDFDefaultBitmap>(std::move(image), std::move(smask));
+    return sk_make_sp<PDFDefaultBitmap>(std::move(image), std::move(smask),
+                                        compressionLevel, compressionThreads);
 }
@@ -18,7 +18,12 @@ class SkPDFObject;
  * the image, and its emitObject() does not cache any data.
  *
  *  quality > 100 means lossless
+ *
+ *  Losslessly encoded images are compressed with SkDeflateWStream's
+ *  compressionLevel and threads.
  */
-sk_sp<SkPDFObject> SkPDFCreateBitmapObject(sk_sp<SkImage>, int encodingQuality = 101);
+sk_sp<SkPDFObject> SkPDFCreateBitmapObject(sk_sp<SkImage>, int encodingQuality = 101,
+                                           int compressionLevel = -1,
+                                           int compressionThreads = 1);
 
 #endif  // SkPDFBitmap_DEFINED
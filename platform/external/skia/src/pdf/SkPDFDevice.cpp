@@ -2512,7 +2512,9 @@ void SkPDFDevice::internalDrawImageRect(SkKeyedImage imageSubset,
     if (!pdfimage) {
         SkASSERT(imageSubset);
         pdfimage = SkPDFCreateBitmapObject(imageSubset.release(),
-                                           fDocument->metadata().fEncodingQuality);
+                                           fDocument->metadata().fEncodingQuality,
+                                           fDocument->metadata().fCompressionLevel,
+                                           fDocument->metadata().fCompressionThreads);
         if (!pdfimage) {
             return;
         }
@@ -11,8 +11,10 @@
 #include "SkMakeUnique.h"
 #include "SkPDFCanon.h"
 #include "SkPDFDevice.h"
+#include "SkPDFFont.h"
 #include "SkPDFUtils.h"
 #include "SkStream.h"
+#include "SkTaskGroup.h"
 
 SkPDFObjectSerializer::SkPDFObjectSerializer() : fBaseOffset(0), fNextToBeSerialized(0) {}
 
@@ -227,7 +229,9 @@ void SkPDFDocument::onEndPage() {
     if (annotations->size() > 0) {
         page->insertObject("Annots", std::move(annotations));
     }
-    auto contentObject = sk_make_sp<SkPDFStream>(fPageDevice->content());
+    auto contentObject = sk_make_sp<SkPDFStream>(fPageDevice->content(),
+                                                 fMetadata.fCompressionLevel,
+                                                 fMetadata.fCompressionThreads);
     this->serialize(contentObject);
     page->insertObjRef("Contents", std::move(contentObject));
     fPageDevice->appendDestinations(fDests.get(), page.get());
@@ -412,9 +416,17 @@ void SkPDFDocument::onClose(SkWStream* stream) {
         docCatalog->insertObjRef("Dests", std::move(fDests));
     }
 
-    // Build font subsetting info before calling addObjectRecursively().
+    // Build font subsetting info before calling addObjectRecursively(). The fonts are embedded
+    // in parallel; their metrics are looked up first, as that is all they need from the canon.
     SkPDFCanon* canon = &fCanon;
-    fFonts.foreach([canon](SkPDFFont* p){ p->getFontSubset(canon); });
+    SkTDArray<SkPDFFont*> fonts;
+    fFonts.foreach([canon, &fonts](SkPDFFont* p) {
+        SkPDFFont::GetMetrics(p->typeface(), canon);
+        fonts.push(p);
+    });
+    SkTaskGroup().batch(fonts.count(), [canon, &fonts](int i) {
+        fonts[i]->getFontSubset(canon);
+    });
     fObjectSerializer.addObjectRecursively(docCatalog);
     fObjectSerializer.serializeObjects(this->getStream());
     fObjectSerializer.serializeFooter(this->getStream(), docCatalog, fID);
@@ -432,6 +444,8 @@ sk_sp<SkDocument> SkPDFMakeDocument(SkWStream* stream,
     if (meta.fEncodingQuality < 0) {
         meta.fEncodingQuality = 0;
     }
+    meta.fCompressionLevel = SkTPin(meta.fCompressionLevel, -1, 9);
+    meta.fCompressionThreads = SkTMax(meta.fCompressionThreads, 1);
     return stream ? sk_make_sp<SkPDFDocument>(stream, meta) : nullptr;
 }
 
@@ -12,6 +12,7 @@
 #include "SkPDFConvertType1FontStream.h"
 #include "SkPDFDevice.h"
 #include "SkPDFFont.h"
+#include "SkPDFFontSubsetCache.h"
 #include "SkPDFMakeCIDGlyphWidthsArray.h"
 #include "SkPDFMakeToUnicodeCmap.h"
 #include "SkPDFUtils.h"
@@ -377,21 +378,33 @@ static sk_sp<SkPDFStream> get_subset_font_stream(
 }
 #endif  // SK_PDF_USE_SFNTLY
 
-void SkPDFType0Font::getFontSubset(SkPDFCanon* canon) {
-    const SkAdvancedTypefaceMetrics* metricsPtr =
-        SkPDFFont::GetMetrics(this->typeface(), canon);
-    SkASSERT(metricsPtr);
-    if (!metricsPtr) { return; }
-    const SkAdvancedTypefaceMetrics& metrics = *metricsPtr;
-    SkASSERT(can_embed(metrics));
-    SkAdvancedTypefaceMetrics::FontType type = this->getType();
-    SkTypeface* face = this->typeface();
-    SkASSERT(face);
+// An object serialized once, to be written as is into any number of documents. It can't refer
+// to other objects.
+class SkPDFSerializedObject final : public SkPDFObject {
+public:
+    explicit SkPDFSerializedObject(sk_sp<SkData> data) : fData(std::move(data)) {}
+    void emitObject(SkWStream* stream, const SkPDFObjNumMap&) const override {
+        stream->write(fData->data(), fData->size());
+    }
 
-    auto descriptor = sk_make_sp<SkPDFDict>("FontDescriptor");
-    uint16_t emSize = SkToU16(this->typeface()->getUnitsPerEm());
-    add_common_font_descriptor_entries(descriptor.get(), metrics, emSize , 0);
+private:
+    sk_sp<SkData> fData;
+};
+
+static sk_sp<SkData> serialize(const SkPDFObject& object) {
+    SkDynamicMemoryWStream stream;
+    object.emitObject(&stream, SkPDFObjNumMap());
+    return stream.detachAsData();
+}
 
+// Makes the parts of the Type0 font that depend on which glyphs are used.
+static void make_type0_subset(SkTypeface* face,
+                              const SkAdvancedTypefaceMetrics& metrics,
+                              SkAdvancedTypefaceMetrics::FontType type,
+                              const SkBitSet& glyphUsage,
+                              SkGlyphID firstGlyphID,
+                              SkGlyphID lastGlyphID,
+                              SkPDFFontSubsetCache::Subset* subset) {
     int ttcIndex;
     std::unique_ptr<SkStreamAsset> fontAsset(face->openStream(&ttcIndex));
     size_t fontSize = fontAsset ? fontAsset->getLength() : 0;
@@ -406,10 +419,10 @@ void SkPDFType0Font::getFontSubset(SkPDFCanon* canon) {
                 if (!SkToBool(metrics.fFlags &
                               SkAdvancedTypefaceMetrics::kNotSubsettable_FontFlag)) {
                     sk_sp<SkPDFStream> subsetStream = get_subset_font_stream(
-                            std::move(fontAsset), this->glyphUsage(),
+                            std::move(fontAsset), glyphUsage,
                             metrics.fFontName.c_str(), ttcIndex);
                     if (subsetStream) {
-                        descriptor->insertObjRef("FontFile2", std::move(subsetStream));
+                        subset->fFontFile = serialize(*subsetStream);
                         break;
                     }
                     // If subsetting fails, fall back to original font data.
@@ -421,13 +434,13 @@ void SkPDFType0Font::getFontSubset(SkPDFCanon* canon) {
                 #endif  // SK_PDF_USE_SFNTLY
                 auto fontStream = sk_make_sp<SkPDFSharedStream>(std::move(fontAsset));
                 fontStream->dict()->insertInt("Length1", fontSize);
-                descriptor->insertObjRef("FontFile2", std::move(fontStream));
+                subset->fFontFile = serialize(*fontStream);
                 break;
             }
             case SkAdvancedTypefaceMetrics::kType1CID_Font: {
                 auto fontStream = sk_make_sp<SkPDFSharedStream>(std::move(fontAsset));
                 fontStream->dict()->insertName("Subtype", "CIDFontType0C");
-                descriptor->insertObjRef("FontFile3", std::move(fontStream));
+                subset->fFontFile = serialize(*fontStream);
                 break;
             }
             default:
@@ -435,6 +448,61 @@ void SkPDFType0Font::getFontSubset(SkPDFCanon* canon) {
         }
     }
 
+    int16_t defaultWidth = 0;
+    {
+        int emSize;
+        SkAutoGlyphCache glyphCache = SkPDFFont::MakeVectorCache(face, &emSize);
+        sk_sp<SkPDFArray> widths = SkPDFMakeCIDGlyphWidthsArray(
+                glyphCache.get(), &glyphUsage, SkToS16(emSize), &defaultWidth);
+        if (widths && widths->size() > 0) {
+            subset->fWidths = serialize(*widths);
+        }
+        subset->fDefaultWidth = scaleFromFontUnits(defaultWidth, SkToS16(emSize));
+    }
+
+    if (metrics.fGlyphToUnicode.count() > 0) {
+        subset->fToUnicode = serialize(*SkPDFMakeToUnicodeCmap(metrics.fGlyphToUnicode,
+                                                               &glyphUsage,
+                                                               true,
+                                                               firstGlyphID,
+                                                               lastGlyphID));
+    }
+}
+
+void SkPDFType0Font::getFontSubset(SkPDFCanon* canon) {
+    const SkAdvancedTypefaceMetrics* metricsPtr =
+        SkPDFFont::GetMetrics(this->typeface(), canon);
+    SkASSERT(metricsPtr);
+    if (!metricsPtr) { return; }
+    const SkAdvancedTypefaceMetrics& metrics = *metricsPtr;
+    SkASSERT(can_embed(metrics));
+    SkAdvancedTypefaceMetrics::FontType type = this->getType();
+    SkTypeface* face = this->typeface();
+    SkASSERT(face);
+    SkASSERT(this->multiByteGlyphs());
+
+    // Subsetting the font, and working out its widths and cmap, is most of the work here. Other
+    // documents may well have done it already for the same glyphs.
+    SkTDArray<SkGlyphID> glyphs;
+    this->glyphUsage().exportTo(&glyphs);
+    SkPDFFontSubsetCache::Subset subset;
+    if (!SkPDFFontSubsetCache::Find(face->uniqueID(), this->firstGlyphID(), this->lastGlyphID(),
+                                    glyphs, &subset)) {
+        make_type0_subset(face, metrics, type, this->glyphUsage(),
+                          this->firstGlyphID(), this->lastGlyphID(), &subset);
+        SkPDFFontSubsetCache::Add(face->uniqueID(), this->firstGlyphID(), this->lastGlyphID(),
+                                  glyphs, subset);
+    }
+
+    auto descriptor = sk_make_sp<SkPDFDict>("FontDescriptor");
+    uint16_t emSize = SkToU16(this->typeface()->getUnitsPerEm());
+    add_common_font_descriptor_entries(descriptor.get(), metrics, emSize , 0);
+    if (subset.fFontFile) {
+        descriptor->insertObjRef(
+                SkAdvancedTypefaceMetrics::kType1CID_Font == type ? "FontFile3" : "FontFile2",
+                sk_make_sp<SkPDFSerializedObject>(std::move(subset.fFontFile)));
+    }
+
     auto newCIDFont = sk_make_sp<SkPDFDict>("Font");
     newCIDFont->insertObjRef("FontDescriptor", std::move(descriptor));
     newCIDFont->insertName("BaseFont", metrics.fFontName);
@@ -456,18 +524,11 @@ void SkPDFType0Font::getFontSubset(SkPDFCanon* canon) {
     sysInfo->insertInt("Supplement", 0);
     newCIDFont->insertObject("CIDSystemInfo", std::move(sysInfo));
 
-    int16_t defaultWidth = 0;
-    {
-        int emSize;
-        SkAutoGlyphCache glyphCache = SkPDFFont::MakeVectorCache(face, &emSize);
-        sk_sp<SkPDFArray> widths = SkPDFMakeCIDGlyphWidthsArray(
-                glyphCache.get(), &this->glyphUsage(), SkToS16(emSize), &defaultWidth);
-        if (widths && widths->size() > 0) {
-            newCIDFont->insertObject("W", std::move(widths));
-        }
-        newCIDFont->insertScalar(
-                "DW", scaleFromFontUnits(defaultWidth, SkToS16(emSize)));
+    if (subset.fWidths) {
+        newCIDFont->insertObject("W",
+                                 sk_make_sp<SkPDFSerializedObject>(std::move(subset.fWidths)));
     }
+    newCIDFont->insertScalar("DW", subset.fDefaultWidth);
 
     ////////////////////////////////////////////////////////////////////////////
 
@@ -478,13 +539,9 @@ void SkPDFType0Font::getFontSubset(SkPDFCanon* canon) {
     descendantFonts->appendObjRef(std::move(newCIDFont));
     this->insertObject("DescendantFonts", std::move(descendantFonts));
 
-    if (metrics.fGlyphToUnicode.count() > 0) {
+    if (subset.fToUnicode) {
         this->insertObjRef("ToUnicode",
-                           SkPDFMakeToUnicodeCmap(metrics.fGlyphToUnicode,
-                                                  &this->glyphUsage(),
-                                                  multiByteGlyphs(),
-                                                  firstGlyphID(),
-                                                  lastGlyphID()));
+                           sk_make_sp<SkPDFSerializedObject>(std::move(subset.fToUnicode)));
     }
     SkDEBUGCODE(fPopulated = true);
     return;
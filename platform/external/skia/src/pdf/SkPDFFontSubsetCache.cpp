@@ -0,0 +1,103 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkOpts.h"
+#include "SkPDFFontSubsetCache.h"
+#include "SkResourceCache.h"
+
+#define CHECK_LOCAL(localCache, localName, globalName, ...) \
+    ((localCache) ? localCache->localName(__VA_ARGS__) : SkResourceCache::globalName(__VA_ARGS__))
+
+namespace {
+static unsigned gPDFFontSubsetKeyNamespaceLabel;
+
+// Subsets bigger than this fraction of the cache's byte limit aren't cached.
+static constexpr size_t kMaxCacheFraction = 16;
+
+// The glyphs are only hashed into the key; each entry keeps its glyphs to check against.
+struct FontSubsetKey : public SkResourceCache::Key {
+    FontSubsetKey(SkFontID fontID, SkGlyphID first, SkGlyphID last,
+                  const SkTDArray<SkGlyphID>& glyphs)
+        : fFontID(fontID)
+        , fGlyphRange(((uint32_t)first << 16) | last)
+        , fGlyphCount(glyphs.count())
+        , fGlyphHash(SkOpts::hash(glyphs.begin(), glyphs.bytes()))
+    {
+        this->init(&gPDFFontSubsetKeyNamespaceLabel, 0,
+                   sizeof(fFontID) + sizeof(fGlyphRange) + sizeof(fGlyphCount) +
+                   sizeof(fGlyphHash));
+    }
+
+    SkFontID fFontID;
+    uint32_t fGlyphRange;
+    uint32_t fGlyphCount;
+    uint32_t fGlyphHash;
+};
+
+struct FontSubsetRec : public SkResourceCache::Rec {
+    FontSubsetRec(const FontSubsetKey& key, const SkTDArray<SkGlyphID>& glyphs,
+                  const SkPDFFontSubsetCache::Subset& subset)
+        : fKey(key)
+        , fGlyphs(glyphs)
+        , fSubset(subset)
+    {}
+
+    FontSubsetKey                  fKey;
+    SkTDArray<SkGlyphID>           fGlyphs;
+    SkPDFFontSubsetCache::Subset   fSubset;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override {
+        size_t bytes = sizeof(*this) + fGlyphs.bytes();
+        for (const sk_sp<SkData>& data : { fSubset.fFontFile, fSubset.fWidths,
+                                           fSubset.fToUnicode }) {
+            bytes += data ? data->size() : 0;
+        }
+        return bytes;
+    }
+    const char* getCategory() const override { return "pdf-font-subset"; }
+
+    struct Context {
+        const SkTDArray<SkGlyphID>*   fGlyphs;
+        SkPDFFontSubsetCache::Subset* fResult;
+    };
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const FontSubsetRec& rec = static_cast<const FontSubsetRec&>(baseRec);
+        Context* context = static_cast<Context*>(contextData);
+        if (rec.fGlyphs.bytes() != context->fGlyphs->bytes() ||
+            0 != memcmp(rec.fGlyphs.begin(), context->fGlyphs->begin(), rec.fGlyphs.bytes())) {
+            return false;
+        }
+        *context->fResult = rec.fSubset;
+        return true;
+    }
+};
+} // namespace
+
+bool SkPDFFontSubsetCache::Find(SkFontID fontID, SkGlyphID first, SkGlyphID last,
+                                const SkTDArray<SkGlyphID>& glyphs, Subset* subset,
+                                SkResourceCache* localCache) {
+    FontSubsetKey key(fontID, first, last, glyphs);
+    FontSubsetRec::Context context = { &glyphs, subset };
+    return CHECK_LOCAL(localCache, find, Find, key, FontSubsetRec::Visitor, &context);
+}
+
+void SkPDFFontSubsetCache::Add(SkFontID fontID, SkGlyphID first, SkGlyphID last,
+                               const SkTDArray<SkGlyphID>& glyphs, const Subset& subset,
+                               SkResourceCache* localCache) {
+    FontSubsetKey key(fontID, first, last, glyphs);
+    std::unique_ptr<FontSubsetRec> rec(new FontSubsetRec(key, glyphs, subset));
+    // A whole font program can be megabytes, e.g. for CJK fonts. Don't let one evict most of what
+    // the cache's other users, like bitmaps and mipmaps, keep in it.
+    size_t limit = localCache ? localCache->getTotalByteLimit()
+                              : SkResourceCache::GetTotalByteLimit();
+    if (limit && rec->bytesUsed() > limit / kMaxCacheFraction) {
+        return;
+    }
+    return CHECK_LOCAL(localCache, add, Add, rec.release());
+}
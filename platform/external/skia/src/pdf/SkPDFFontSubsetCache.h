@@ -0,0 +1,46 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkPDFFontSubsetCache_DEFINED
+#define SkPDFFontSubsetCache_DEFINED
+
+#include "SkData.h"
+#include "SkTDArray.h"
+#include "SkTypeface.h"
+
+class SkResourceCache;
+
+/**
+ *  A process-wide cache of the parts of an embedded Type0 font that depend on which of its
+ *  glyphs a document uses, so that documents using the same glyphs of the same typeface can
+ *  share them rather than subsetting the font again. Each part is kept serialized, as it would
+ *  be written into a document. Entries live in SkResourceCache, which bounds their total size.
+ *  Subsets bigger than a sixteenth of the cache's limit aren't kept.
+ */
+class SkPDFFontSubsetCache {
+public:
+    struct Subset {
+        sk_sp<SkData> fFontFile;     // The font program stream, or nullptr if not embedded.
+        sk_sp<SkData> fWidths;       // The W array, or nullptr if empty.
+        sk_sp<SkData> fToUnicode;    // The ToUnicode cmap stream, or nullptr if none.
+        SkScalar      fDefaultWidth = 0;
+    };
+
+    /**
+     *  Finds the subset of the typeface's glyphs [first, last] which uses exactly these glyphs.
+     *  Returns false if there is none.
+     */
+    static bool Find(SkFontID, SkGlyphID first, SkGlyphID last,
+                     const SkTDArray<SkGlyphID>& glyphs, Subset*,
+                     SkResourceCache* localCache = nullptr);
+
+    static void Add(SkFontID, SkGlyphID first, SkGlyphID last,
+                    const SkTDArray<SkGlyphID>& glyphs, const Subset&,
+                    SkResourceCache* localCache = nullptr);
+};
+
+#endif
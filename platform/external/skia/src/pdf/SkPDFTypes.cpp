@@ -514,6 +514,11 @@ SkPDFStream::SkPDFStream(std::unique_ptr<SkStreamAsset> stream) {
     this->setData(std::move(stream));
 }
 
+SkPDFStream::SkPDFStream(std::unique_ptr<SkStreamAsset> stream, int compressionLevel,
+                         int compressionThreads) {
+    this->setData(std::move(stream), compressionLevel, compressionThreads);
+}
+
 SkPDFStream::SkPDFStream() {}
 
 SkPDFStream::~SkPDFStream() {}
@@ -541,7 +546,8 @@ void SkPDFStream::emitObject(SkWStream* stream,
     stream->writeText("\nendstream");
 }
 
-void SkPDFStream::setData(std::unique_ptr<SkStreamAsset> stream) {
+void SkPDFStream::setData(std::unique_ptr<SkStreamAsset> stream, int compressionLevel,
+                          int compressionThreads) {
     SkASSERT(!fCompressedData);  // Only call this function once.
     SkASSERT(stream);
     // Code assumes that the stream starts at the beginning.
@@ -554,7 +560,8 @@ void SkPDFStream::setData(std::unique_ptr<SkStreamAsset> stream) {
 
     SkASSERT(stream->hasLength());
     SkDynamicMemoryWStream compressedData;
-    SkDeflateWStream deflateWStream(&compressedData);
+    SkDeflateWStream deflateWStream(&compressedData, compressionLevel, false,
+                                    compressionThreads);
     if (stream->getLength() > 0) {
         SkStreamCopy(&deflateWStream, stream.get());
     }
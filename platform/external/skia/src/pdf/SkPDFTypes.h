@@ -325,6 +325,9 @@ public:
      *  @param stream The data part of the stream. */
     explicit SkPDFStream(sk_sp<SkData> data);
     explicit SkPDFStream(std::unique_ptr<SkStreamAsset> stream);
+    /** As above, compressing with the given SkDeflateWStream level and threads. */
+    SkPDFStream(std::unique_ptr<SkStreamAsset> stream, int compressionLevel,
+                int compressionThreads);
     ~SkPDFStream() override;
 
     SkPDFDict* dict() { return &fDict; }
@@ -341,7 +344,8 @@ protected:
     SkPDFStream();
 
     /** Only call this function once. */
-    void setData(std::unique_ptr<SkStreamAsset> stream);
+    void setData(std::unique_ptr<SkStreamAsset> stream, int compressionLevel = -1,
+                 int compressionThreads = 1);
 
 private:
     std::unique_ptr<SkStreamAsset> fCompressedData;
@@ -1804,6 +1804,39 @@ bool SkTypeface_FreeType::Scanner::scanFont(
     return true;
 }
 
+bool SkTypeface_FreeType::Scanner::scanCoverage(SkStreamAsset* stream, int ttcIndex,
+                                                SkTDArray<SkUnichar>* ranges) const {
+    SkAutoMutexAcquire libraryLock(fLibraryMutex);
+
+    FT_StreamRec streamRec;
+    FT_Face face = this->openFace(stream, ttcIndex, &streamRec);
+    if (nullptr == face) {
+        return false;
+    }
+
+    ranges->rewind();
+    // Use the same charmap that ref_ft_face() would.
+    if (!face->charmap) {
+        FT_Select_Charmap(face, FT_ENCODING_MS_SYMBOL);
+    }
+    if (face->charmap) {
+        FT_UInt glyph;
+        FT_ULong character = FT_Get_First_Char(face, &glyph);
+        while (glyph != 0) {
+            if (ranges->count() && (FT_ULong)ranges->top() + 1 == character) {
+                ranges->top() = character;
+            } else {
+                *ranges->append() = character;
+                *ranges->append() = character;
+            }
+            character = FT_Get_Next_Char(face, character, &glyph);
+        }
+    }
+
+    FT_Done_Face(face);
+    return true;
+}
+
 /*static*/ void SkTypeface_FreeType::Scanner::computeAxisValues(
     AxisDefinitions axisDefinitions,
     const SkFontArguments::VariationPosition position,
@@ -12,6 +12,7 @@
 #include "SkGlyph.h"
 #include "SkMutex.h"
 #include "SkScalerContext.h"
+#include "SkTDArray.h"
 #include "SkTypeface.h"
 #include "SkTypes.h"
 
@@ -71,6 +72,11 @@ public:
         bool scanFont(SkStreamAsset* stream, int ttcIndex,
                       SkString* name, SkFontStyle* style, bool* isFixedPitch,
                       AxisDefinitions* axes) const;
+        /** Gets the runs of characters that the face has glyphs for, as pairs of the first
+         *  and last character of each run, in order.
+         */
+        bool scanCoverage(SkStreamAsset* stream, int ttcIndex,
+                          SkTDArray<SkUnichar>* ranges) const;
         static void computeAxisValues(
             AxisDefinitions axisDefinitions,
             const SkFontArguments::VariationPosition position,
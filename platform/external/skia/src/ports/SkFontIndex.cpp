@@ -0,0 +1,271 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkBuffer.h"
+#include "SkFontIndex.h"
+#include "SkOSFile.h"
+#include "SkOpts.h"
+#include "SkStream.h"
+#include "SkStreamPriv.h"
+#include "SkTDArray.h"
+
+#include <stdio.h>
+
+// The index file is a header, followed by a body of entries, one for each font file:
+//
+//   header: magic, version, hash of the body, size of the body
+//   body:   number of entries, then for each:
+//             size of the rest of the entry, path,
+//             size and modification time of the font file, number of faces, then for each face:
+//               whether it could be scanned, family name, weight, width, slant, fixed pitch,
+//               axes (tag, minimum, default, maximum), coverage
+//
+// Everything is 32 bits (or two of them) and 4 byte aligned, so that coverage can be used where
+// it is mapped. The index is only ever read on the machine that wrote it.
+static constexpr uint32_t kMagic = SkSetFourByteTag('s', 'k', 'f', 'i');
+static constexpr uint32_t kVersion = 1;
+static constexpr size_t kHeaderSize = 4 * sizeof(uint32_t);
+
+static void write_string(SkWStream* stream, const SkString& string) {
+    static const char kPadding[4] = { 0, 0, 0, 0 };
+    stream->write32(SkToU32(string.size()));
+    stream->write(string.c_str(), string.size());
+    stream->write(kPadding, SkAlign4(string.size()) - string.size());
+}
+
+static bool read_string(SkRBuffer* buffer, SkString* string) {
+    uint32_t length;
+    if (!buffer->readU32(&length)) {
+        return false;
+    }
+    const void* chars = buffer->skip(length);
+    if (!chars || !buffer->skipToAlign4()) {
+        return false;
+    }
+    string->set(static_cast<const char*>(chars), length);
+    return true;
+}
+
+SkFontIndex::SkFontIndex(const Scanner& scanner, const char* indexPath)
+    : fScanner(scanner)
+    , fIndexPath(indexPath)
+    , fScannedAny(false)
+{
+    if (!indexPath) {
+        return;
+    }
+    fData = SkData::MakeFromFileName(indexPath);
+    if (!fData) {
+        return;
+    }
+
+    // Anything wrong with the index, and we start over with an empty one.
+    SkRBuffer buffer(fData->data(), fData->size());
+    uint32_t magic, version, hash, bodySize, entryCount;
+    if (!buffer.readU32(&magic) || kMagic != magic ||
+        !buffer.readU32(&version) || kVersion != version ||
+        !buffer.readU32(&hash) ||
+        !buffer.readU32(&bodySize) || bodySize != buffer.available() ||
+        hash != SkOpts::hash(fData->bytes() + kHeaderSize, bodySize) ||
+        !buffer.readU32(&entryCount))
+    {
+        fData = nullptr;
+        return;
+    }
+    for (uint32_t i = 0; i < entryCount; ++i) {
+        uint32_t entrySize;
+        if (!buffer.readU32(&entrySize)) {
+            break;
+        }
+        const size_t start = buffer.pos();
+        SkString path;
+        if (!read_string(&buffer, &path) || !buffer.skip(entrySize - (buffer.pos() - start))) {
+            break;
+        }
+        const size_t offset = start + sizeof(uint32_t) + SkAlign4(path.size());
+        fEntries.set(path, { offset, start + entrySize - offset });
+    }
+    if (!buffer.isValid() || !buffer.eof()) {
+        fEntries.reset();
+        fData = nullptr;
+    }
+}
+
+bool SkFontIndex::readFile(const Entry& entry, File* file) const {
+    SkRBuffer buffer(fData->bytes() + entry.fOffset, entry.fLength);
+    uint64_t size;
+    int64_t modified;
+    uint32_t faceCount;
+    if (!buffer.read(&size, sizeof(size)) || size != file->fSize ||
+        !buffer.read(&modified, sizeof(modified)) || modified != file->fModified ||
+        !buffer.readU32(&faceCount))
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < faceCount; ++i) {
+        Face& face = file->fFaces.push_back();
+        uint32_t scanned, weight, width, slant, isFixedPitch, axisCount, coverageCount;
+        if (!buffer.readU32(&scanned) ||
+            !read_string(&buffer, &face.fFamilyName) ||
+            !buffer.readU32(&weight) ||
+            !buffer.readU32(&width) ||
+            !buffer.readU32(&slant) || slant > SkFontStyle::kOblique_Slant ||
+            !buffer.readU32(&isFixedPitch) ||
+            !buffer.readU32(&axisCount))
+        {
+            return false;
+        }
+        face.fStyle = SkFontStyle(weight, width, static_cast<SkFontStyle::Slant>(slant));
+        face.fIsFixedPitch = SkToBool(isFixedPitch);
+        const Scanner::AxisDefinition* axes =
+                buffer.skipCount<Scanner::AxisDefinition>(axisCount);
+        if (!axes || !buffer.readU32(&coverageCount)) {
+            return false;
+        }
+        face.fAxes.push_back_n(axisCount, axes);
+        const SkUnichar* coverage = buffer.skipCount<SkUnichar>(coverageCount);
+        if (!coverage || (coverageCount & 1)) {
+            return false;
+        }
+        // Keep the coverage where it is mapped.
+        face.fCoverage = SkData::MakeSubset(fData.get(),
+                                            reinterpret_cast<const char*>(coverage) -
+                                                    static_cast<const char*>(fData->data()),
+                                            coverageCount * sizeof(SkUnichar));
+        file->fScanned.push_back(SkToBool(scanned));
+    }
+    return buffer.eof();
+}
+
+void SkFontIndex::scanFile(const char path[], File* file) const {
+    // Scanning only reads a few tables, so don't read ahead over the rest of the file.
+    std::unique_ptr<SkStreamAsset> stream = SkStreamMakeFromFile(path, kRandom_SkFILE_Access);
+    int faceCount;
+    if (!stream || !fScanner.recognizedFont(stream.get(), &faceCount)) {
+        return;
+    }
+    // Going through every character is only worth it if the index keeps the result.
+    const bool scanCoverage = !fIndexPath.isEmpty();
+    SkTDArray<SkUnichar> coverage;
+    for (int i = 0; i < faceCount; ++i) {
+        Face& face = file->fFaces.push_back();
+        bool scanned = fScanner.scanFont(stream.get(), i, &face.fFamilyName, &face.fStyle,
+                                         &face.fIsFixedPitch, &face.fAxes);
+        if (scanCoverage) {
+            scanned = scanned && fScanner.scanCoverage(stream.get(), i, &coverage);
+            face.fCoverage = scanned ? SkData::MakeWithCopy(coverage.begin(), coverage.bytes())
+                                     : SkData::MakeEmpty();
+        }
+        file->fScanned.push_back(scanned);
+    }
+}
+
+const SkFontIndex::File* SkFontIndex::findFile(const char path[]) {
+    SkString key(path);
+    if (std::unique_ptr<File>* file = fFiles.find(key)) {
+        return file->get();
+    }
+
+    std::unique_ptr<File> file(new File);
+    if (!sk_stat(path, &file->fSize, &file->fModified)) {
+        return nullptr;
+    }
+    const Entry* entry = fEntries.find(key);
+    if (!entry || !this->readFile(*entry, file.get())) {
+        file->fFaces.reset();
+        file->fScanned.reset();
+        this->scanFile(path, file.get());
+        fScannedAny = true;
+    }
+    return fFiles.set(key, std::move(file))->get();
+}
+
+int SkFontIndex::countFaces(const char path[]) {
+    const File* file = this->findFile(path);
+    return file ? file->fFaces.count() : 0;
+}
+
+const SkFontIndex::Face* SkFontIndex::findFace(const char path[], int ttcIndex) {
+    const File* file = this->findFile(path);
+    if (!file || ttcIndex < 0 || file->fFaces.count() <= ttcIndex || !file->fScanned[ttcIndex]) {
+        return nullptr;
+    }
+    return &file->fFaces[ttcIndex];
+}
+
+void SkFontIndex::save() {
+    // Keep what was looked up since the index was read. If that's all of it, and none of it had to
+    // be scanned again, there is nothing to write.
+    if (fIndexPath.isEmpty() || (!fScannedAny && fFiles.count() == fEntries.count())) {
+        return;
+    }
+
+    SkDynamicMemoryWStream body;
+    body.write32(fFiles.count());
+    fFiles.foreach([&body](const SkString& path, std::unique_ptr<File>* file) {
+        SkDynamicMemoryWStream entry;
+        write_string(&entry, path);
+        uint64_t size = (*file)->fSize;
+        entry.write(&size, sizeof(size));
+        entry.write(&(*file)->fModified, sizeof((*file)->fModified));
+        entry.write32((*file)->fFaces.count());
+        for (int i = 0; i < (*file)->fFaces.count(); ++i) {
+            const Face& face = (*file)->fFaces[i];
+            entry.write32((*file)->fScanned[i]);
+            write_string(&entry, face.fFamilyName);
+            entry.write32(face.fStyle.weight());
+            entry.write32(face.fStyle.width());
+            entry.write32(face.fStyle.slant());
+            entry.write32(face.fIsFixedPitch);
+            entry.write32(face.fAxes.count());
+            entry.write(face.fAxes.begin(), face.fAxes.count() * sizeof(face.fAxes[0]));
+            entry.write32(SkToU32(face.fCoverage->size() / sizeof(SkUnichar)));
+            entry.write(face.fCoverage->data(), face.fCoverage->size());
+        }
+        body.write32(SkToU32(entry.bytesWritten()));
+        entry.writeToAndReset(&body);
+    });
+    sk_sp<SkData> bodyData = body.detachAsData();
+
+    // Write it next to the index and move it over, so that nobody reads a partly written index.
+    SkString tempPath(fIndexPath);
+    tempPath.append(".tmp");
+    {
+        SkFILEWStream out(tempPath.c_str());
+        if (!out.isValid()) {
+            return;
+        }
+        out.write32(kMagic);
+        out.write32(kVersion);
+        out.write32(SkOpts::hash(bodyData->data(), bodyData->size()));
+        out.write32(SkToU32(bodyData->size()));
+        out.write(bodyData->data(), bodyData->size());
+    }
+    if (0 != rename(tempPath.c_str(), fIndexPath.c_str())) {
+        // Windows won't rename over an existing file.
+        remove(fIndexPath.c_str());
+        if (0 != rename(tempPath.c_str(), fIndexPath.c_str())) {
+            remove(tempPath.c_str());
+        }
+    }
+}
+
+bool SkFontIndex::Covers(const SkData& coverage, SkUnichar character) {
+    const SkUnichar* ranges = static_cast<const SkUnichar*>(coverage.data());
+    const int count = SkToInt(coverage.size() / (2 * sizeof(SkUnichar)));
+    // Find the first run that ends at or after the character.
+    int lo = 0, hi = count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (ranges[2 * mid + 1] < character) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo < count && ranges[2 * lo] <= character;
+}
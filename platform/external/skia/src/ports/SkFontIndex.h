@@ -0,0 +1,87 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkFontIndex_DEFINED
+#define SkFontIndex_DEFINED
+
+#include "SkData.h"
+#include "SkFontHost_FreeType_common.h"
+#include "SkFontStyle.h"
+#include "SkString.h"
+#include "SkTArray.h"
+#include "SkTHash.h"
+
+#include <memory>
+
+/**
+ *  What FreeType finds when it scans font files, kept in an index file between runs so that a
+ *  font manager only has to scan the font files that are new or changed since the last one.
+ *
+ *  The index file is mapped in one go when the SkFontIndex is made. Each font file in it is only
+ *  checked (by its size and modification time) when it is looked up, and only the font files
+ *  that fail the check are scanned again.
+ */
+class SkFontIndex : SkNoncopyable {
+public:
+    using Scanner = SkTypeface_FreeType::Scanner;
+
+    struct Face {
+        SkString                 fFamilyName;
+        SkFontStyle              fStyle;
+        bool                     fIsFixedPitch;
+        Scanner::AxisDefinitions fAxes;
+        // Pairs of the first and last character of each run of characters that the face has
+        // glyphs for, or null if the index isn't kept. See Covers().
+        sk_sp<SkData>            fCoverage;
+    };
+
+    /** If 'indexPath' is null, every font file is scanned, and nothing is kept. */
+    SkFontIndex(const Scanner&, const char* indexPath);
+
+    /** Returns the number of faces in the font file, or 0 if it isn't a font file. */
+    int countFaces(const char path[]);
+
+    /**
+     *  Returns what was found in the face at 'ttcIndex' of the font file, or null if it couldn't
+     *  be scanned. The face lives as long as the index.
+     */
+    const Face* findFace(const char path[], int ttcIndex);
+
+    /** Writes the index file, if it has one and the fonts looked up since it was read changed. */
+    void save();
+
+    /** Returns true if a face's coverage includes the character. */
+    static bool Covers(const SkData& coverage, SkUnichar);
+
+private:
+    struct File {
+        size_t                   fSize;
+        int64_t                  fModified;
+        SkTArray<Face>           fFaces;
+        // Which faces could be scanned, in step with fFaces.
+        SkTArray<bool, true>     fScanned;
+    };
+
+    // Where a font file's entry is in fData.
+    struct Entry {
+        size_t fOffset;
+        size_t fLength;
+    };
+
+    const File* findFile(const char path[]);
+    bool readFile(const Entry&, File*) const;
+    void scanFile(const char path[], File*) const;
+
+    const Scanner&                              fScanner;
+    const SkString                              fIndexPath;
+    sk_sp<SkData>                               fData;
+    SkTHashMap<SkString, Entry>                 fEntries;
+    SkTHashMap<SkString, std::unique_ptr<File>> fFiles;
+    bool                                        fScannedAny;
+};
+
+#endif
@@ -11,6 +11,7 @@
 #include "SkFixed.h"
 #include "SkFontDescriptor.h"
 #include "SkFontHost_FreeType_common.h"
+#include "SkFontIndex.h"
 #include "SkFontMgr.h"
 #include "SkFontMgr_android.h"
 #include "SkFontMgr_android_parser.h"
@@ -62,13 +63,15 @@ public:
                              bool isFixedPitch,
                              const SkString& familyName,
                              const SkTArray<SkLanguage, true>& lang,
-                             FontVariant variantStyle)
+                             FontVariant variantStyle,
+                             sk_sp<SkData> coverage)
         : INHERITED(style, isFixedPitch, familyName)
         , fPathName(pathName)
         , fIndex(index)
         , fAxes(axes, axesCount)
         , fLang(lang)
         , fVariantStyle(variantStyle)
+        , fCoverage(std::move(coverage))
         , fFile(cacheFontFiles ? sk_fopen(fPathName.c_str(), kRead_SkFILE_Flag) : nullptr) {
         if (cacheFontFiles) {
             SkASSERT(fFile);
@@ -104,6 +107,8 @@ public:
     const SkSTArray<4, SkFixed, true> fAxes;
     const SkSTArray<4, SkLanguage, true> fLang;
     const FontVariant fVariantStyle;
+    // The characters the font has glyphs for, as found by SkFontIndex. See SkFontIndex::Covers().
+    const sk_sp<SkData> fCoverage;
     SkAutoTCallVProc<FILE, sk_fclose> fFile;
 
     typedef SkTypeface_Android INHERITED;
@@ -145,7 +150,7 @@ class SkFontStyleSet_Android : public SkFontStyleSet {
     typedef SkTypeface_FreeType::Scanner Scanner;
 
 public:
-    explicit SkFontStyleSet_Android(const FontFamily& family, const Scanner& scanner,
+    explicit SkFontStyleSet_Android(const FontFamily& family, SkFontIndex* index,
                                     const bool cacheFontFiles) {
         const SkString* cannonicalFamilyName = nullptr;
         if (family.fNames.count() > 0) {
@@ -158,26 +163,19 @@ public:
             SkString pathName(family.fBasePath);
             pathName.append(fontFile.fFileName);
 
-            std::unique_ptr<SkStreamAsset> stream = SkStream::MakeFromFile(pathName.c_str());
-            if (!stream) {
-                SkDEBUGF(("Requested font file %s does not exist or cannot be opened.\n",
-                          pathName.c_str()));
-                continue;
-            }
-
             const int ttcIndex = fontFile.fIndex;
-            SkString familyName;
-            SkFontStyle style;
-            bool isFixedWidth;
-            Scanner::AxisDefinitions axisDefinitions;
-            if (!scanner.scanFont(stream.get(), ttcIndex,
-                                  &familyName, &style, &isFixedWidth, &axisDefinitions))
-            {
-                SkDEBUGF(("Requested font file %s exists, but is not a valid font.\n",
+            const SkFontIndex::Face* face = index->findFace(pathName.c_str(), ttcIndex);
+            if (!face) {
+                SkDEBUGF(("Requested font file %s does not exist or is not a valid font.\n",
                           pathName.c_str()));
                 continue;
             }
 
+            SkString familyName = face->fFamilyName;
+            SkFontStyle style = face->fStyle;
+            bool isFixedWidth = face->fIsFixedPitch;
+            const Scanner::AxisDefinitions& axisDefinitions = face->fAxes;
+
             int weight = fontFile.fWeight != 0 ? fontFile.fWeight : style.weight();
             SkFontStyle::Slant slant = style.slant();
             switch (fontFile.fStyle) {
@@ -210,7 +208,8 @@ public:
 
             fStyles.push_back().reset(new SkTypeface_AndroidSystem(
                     pathName, cacheFontFiles, ttcIndex, axisValues.get(), axisDefinitions.count(),
-                    style, isFixedWidth, familyName, family.fLanguages, variant));
+                    style, isFixedWidth, familyName, family.fLanguages, variant,
+                    face->fCoverage));
         }
     }
 
@@ -260,7 +259,7 @@ struct NameToFamily {
 
 class SkFontMgr_Android : public SkFontMgr {
 public:
-    SkFontMgr_Android(const SkFontMgr_Android_CustomFonts* custom) {
+    SkFontMgr_Android(const SkFontMgr_Android_CustomFonts* custom, const char* indexPath) {
         SkTDArray<FontFamily*> families;
         if (custom && SkFontMgr_Android_CustomFonts::kPreferSystem != custom->fSystemFontUse) {
             SkString base(custom->fBasePath);
@@ -277,7 +276,9 @@ public:
             SkFontMgr_Android_Parser::GetCustomFontFamilies(
                 families, base, custom->fFontsXml, custom->fFallbackFontsXml);
         }
-        this->buildNameToFamilyMap(families, custom ? custom->fIsolated : false);
+        SkFontIndex index(fScanner, indexPath);
+        this->buildNameToFamilyMap(families, &index, custom ? custom->fIsolated : false);
+        index.save();
         this->findDefaultStyleSet();
         families.deleteAll();
     }
@@ -363,6 +364,11 @@ protected:
                 continue;
             }
 
+            // Faces that were scanned for coverage can be ruled out without opening them.
+            if (face->fCoverage && !SkFontIndex::Covers(*face->fCoverage, character)) {
+                continue;
+            }
+
             SkPaint paint;
             paint.setTypeface(face);
             paint.setTextEncoding(SkPaint::kUTF32_TextEncoding);
@@ -494,7 +500,8 @@ private:
     SkTArray<NameToFamily, true> fNameToFamilyMap;
     SkTArray<NameToFamily, true> fFallbackNameToFamilyMap;
 
-    void buildNameToFamilyMap(SkTDArray<FontFamily*> families, const bool isolated) {
+    void buildNameToFamilyMap(SkTDArray<FontFamily*> families, SkFontIndex* index,
+                              const bool isolated) {
         for (int i = 0; i < families.count(); i++) {
             FontFamily& family = *families[i];
 
@@ -509,7 +516,7 @@ private:
             }
 
             sk_sp<SkFontStyleSet_Android> newSet =
-                sk_make_sp<SkFontStyleSet_Android>(family, fScanner, isolated);
+                sk_make_sp<SkFontStyleSet_Android>(family, index, isolated);
             if (0 == newSet->count()) {
                 continue;
             }
@@ -547,6 +554,11 @@ static char const * const gSystemFontUseStrings[] = {
 #endif
 
 sk_sp<SkFontMgr> SkFontMgr_New_Android(const SkFontMgr_Android_CustomFonts* custom) {
+    return SkFontMgr_New_Android(custom, nullptr);
+}
+
+sk_sp<SkFontMgr> SkFontMgr_New_Android(const SkFontMgr_Android_CustomFonts* custom,
+                                       const char* indexPath) {
     if (custom) {
         SkASSERT(0 <= custom->fSystemFontUse);
         SkASSERT(custom->fSystemFontUse < SK_ARRAY_COUNT(gSystemFontUseStrings));
@@ -556,5 +568,5 @@ sk_sp<SkFontMgr> SkFontMgr_New_Android(const SkFontMgr_Android_CustomFonts* cust
                   custom->fFontsXml,
                   custom->fFallbackFontsXml));
     }
-    return sk_make_sp<SkFontMgr_Android>(custom);
+    return sk_make_sp<SkFontMgr_Android>(custom, indexPath);
 }
@@ -10,8 +10,12 @@
 #include "SkFontMgr.h"
 #include "SkFontMgr_android.h"
 
+#ifndef SK_FONT_INDEX_PATH
+#    define SK_FONT_INDEX_PATH nullptr
+#endif
+
 sk_sp<SkFontMgr> SkFontMgr::Factory() {
-    return SkFontMgr_New_Android(nullptr);
+    return SkFontMgr_New_Android(nullptr, SK_FONT_INDEX_PATH);
 }
 
 #endif//defined(SK_BUILD_FOR_ANDROID)
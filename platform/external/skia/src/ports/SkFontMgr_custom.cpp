@@ -14,6 +14,7 @@
 #include "SkMakeUnique.h"
 #include "SkRefCnt.h"
 #include "SkStream.h"
+#include "SkStreamPriv.h"
 #include "SkString.h"
 #include "SkTArray.h"
 #include "SkTemplates.h"
@@ -76,7 +77,8 @@ SkTypeface_File::SkTypeface_File(const SkFontStyle& style, bool isFixedPitch, bo
 
 SkStreamAsset* SkTypeface_File::onOpenStream(int* ttcIndex) const {
     *ttcIndex = this->getIndex();
-    return SkStream::MakeFromFile(fPath.c_str()).release();
+    // FreeType reads the tables and glyphs it needs, wherever they are in the file.
+    return SkStreamMakeFromFile(fPath.c_str(), kRandom_SkFILE_Access).release();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
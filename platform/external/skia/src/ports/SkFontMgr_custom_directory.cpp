@@ -5,23 +5,26 @@
  * found in the LICENSE file.
  */
 
+#include "SkFontIndex.h"
 #include "SkFontMgr_custom.h"
 #include "SkFontMgr_directory.h"
 #include "SkOSFile.h"
 #include "SkOSPath.h"
-#include "SkStream.h"
 
 class DirectorySystemFontLoader : public SkFontMgr_Custom::SystemFontLoader {
 public:
-    DirectorySystemFontLoader(const char* dir) : fBaseDirectory(dir) { }
+    DirectorySystemFontLoader(const char* dir, const char* indexPath)
+        : fBaseDirectory(dir), fIndexPath(indexPath) { }
 
     void loadSystemFonts(const SkTypeface_FreeType::Scanner& scanner,
                          SkFontMgr_Custom::Families* families) const override
     {
-        load_directory_fonts(scanner, fBaseDirectory, ".ttf", families);
-        load_directory_fonts(scanner, fBaseDirectory, ".ttc", families);
-        load_directory_fonts(scanner, fBaseDirectory, ".otf", families);
-        load_directory_fonts(scanner, fBaseDirectory, ".pfb", families);
+        SkFontIndex index(scanner, fIndexPath.isEmpty() ? nullptr : fIndexPath.c_str());
+        load_directory_fonts(&index, fBaseDirectory, ".ttf", families);
+        load_directory_fonts(&index, fBaseDirectory, ".ttc", families);
+        load_directory_fonts(&index, fBaseDirectory, ".otf", families);
+        load_directory_fonts(&index, fBaseDirectory, ".pfb", families);
+        index.save();
 
         if (families->empty()) {
             SkFontStyleSet_Custom* family = new SkFontStyleSet_Custom(SkString());
@@ -42,7 +45,7 @@ private:
         return nullptr;
     }
 
-    static void load_directory_fonts(const SkTypeface_FreeType::Scanner& scanner,
+    static void load_directory_fonts(SkFontIndex* index,
                                      const SkString& directory, const char* suffix,
                                      SkFontMgr_Custom::Families* families)
     {
@@ -51,36 +54,28 @@ private:
 
         while (iter.next(&name, false)) {
             SkString filename(SkOSPath::Join(directory.c_str(), name.c_str()));
-            std::unique_ptr<SkStreamAsset> stream = SkStream::MakeFromFile(filename.c_str());
-            if (!stream) {
-                SkDebugf("---- failed to open <%s>\n", filename.c_str());
-                continue;
-            }
-
-            int numFaces;
-            if (!scanner.recognizedFont(stream.get(), &numFaces)) {
+            int numFaces = index->countFaces(filename.c_str());
+            if (0 == numFaces) {
                 SkDebugf("---- failed to open <%s> as a font\n", filename.c_str());
                 continue;
             }
 
             for (int faceIndex = 0; faceIndex < numFaces; ++faceIndex) {
-                bool isFixedPitch;
-                SkString realname;
-                SkFontStyle style = SkFontStyle(); // avoid uninitialized warning
-                if (!scanner.scanFont(stream.get(), faceIndex,
-                                      &realname, &style, &isFixedPitch, nullptr))
-                {
+                const SkFontIndex::Face* face = index->findFace(filename.c_str(), faceIndex);
+                if (!face) {
                     SkDebugf("---- failed to open <%s> <%d> as a font\n",
                              filename.c_str(), faceIndex);
                     continue;
                 }
 
+                const SkString& realname = face->fFamilyName;
                 SkFontStyleSet_Custom* addTo = find_family(*families, realname.c_str());
                 if (nullptr == addTo) {
                     addTo = new SkFontStyleSet_Custom(realname);
                     families->push_back().reset(addTo);
                 }
-                addTo->appendTypeface(sk_make_sp<SkTypeface_File>(style, isFixedPitch, true,
+                addTo->appendTypeface(sk_make_sp<SkTypeface_File>(face->fStyle,
+                                                                  face->fIsFixedPitch, true,
                                                                   realname, filename.c_str(),
                                                                   faceIndex));
             }
@@ -92,13 +87,18 @@ private:
                 continue;
             }
             SkString dirname(SkOSPath::Join(directory.c_str(), name.c_str()));
-            load_directory_fonts(scanner, dirname, suffix, families);
+            load_directory_fonts(index, dirname, suffix, families);
         }
     }
 
     SkString fBaseDirectory;
+    SkString fIndexPath;
 };
 
 SK_API sk_sp<SkFontMgr> SkFontMgr_New_Custom_Directory(const char* dir) {
-    return sk_make_sp<SkFontMgr_Custom>(DirectorySystemFontLoader(dir));
+    return SkFontMgr_New_Custom_Directory(dir, nullptr);
+}
+
+SK_API sk_sp<SkFontMgr> SkFontMgr_New_Custom_Directory(const char* dir, const char* indexPath) {
+    return sk_make_sp<SkFontMgr_Custom>(DirectorySystemFontLoader(dir, indexPath));
 }
@@ -12,6 +12,10 @@
 #    define SK_FONT_FILE_PREFIX "/usr/share/fonts/"
 #endif
 
+#ifndef SK_FONT_INDEX_PATH
+#    define SK_FONT_INDEX_PATH nullptr
+#endif
+
 sk_sp<SkFontMgr> SkFontMgr::Factory() {
-    return SkFontMgr_New_Custom_Directory(SK_FONT_FILE_PREFIX);
+    return SkFontMgr_New_Custom_Directory(SK_FONT_FILE_PREFIX, SK_FONT_INDEX_PATH);
 }
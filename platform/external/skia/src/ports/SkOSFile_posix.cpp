@@ -73,6 +73,22 @@ void sk_fmunmap(const void* addr, size_t length) {
     munmap(const_cast<void*>(addr), length);
 }
 
+void sk_fmadvise(const void* addr, size_t length, SkFILE_Access access) {
+    void* start = const_cast<void*>(addr);
+    switch (access) {
+        case kNormal_SkFILE_Access:
+            madvise(start, length, MADV_NORMAL);
+            break;
+        case kSequential_SkFILE_Access:
+            madvise(start, length, MADV_SEQUENTIAL);
+            madvise(start, length, MADV_WILLNEED);
+            break;
+        case kRandom_SkFILE_Access:
+            madvise(start, length, MADV_RANDOM);
+            break;
+    }
+}
+
 void* sk_fdmmap(int fd, size_t* size) {
     struct stat status;
     if (0 != fstat(fd, &status)) {
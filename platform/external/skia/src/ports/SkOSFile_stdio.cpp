@@ -6,6 +6,7 @@
  */
 
 #include "SkOSFile.h"
+#include "SkTFitsIn.h"
 #include "SkTypes.h"
 
 #include <errno.h>
@@ -167,6 +168,16 @@ bool sk_isdir(const char *path) {
     return SkToBool(status.st_mode & S_IFDIR);
 }
 
+bool sk_stat(const char path[], size_t* size, int64_t* modified) {
+    struct stat status;
+    if (0 != stat(path, &status) || !SkTFitsIn<size_t>(status.st_size)) {
+        return false;
+    }
+    *size = static_cast<size_t>(status.st_size);
+    *modified = status.st_mtime;
+    return true;
+}
+
 bool sk_mkdir(const char* path) {
     if (sk_isdir(path)) {
         return true;
@@ -81,6 +81,10 @@ void sk_fmunmap(const void* addr, size_t) {
     UnmapViewOfFile(addr);
 }
 
+void sk_fmadvise(const void*, size_t, SkFILE_Access) {
+    // Windows only takes access hints when the file is opened, and not for mapped views.
+}
+
 void* sk_fdmmap(int fileno, size_t* length) {
     HANDLE file = (HANDLE)_get_osfhandle(fileno);
     if (INVALID_HANDLE_VALUE == file) {
@@ -8,14 +8,14 @@
 #include "SkPerlinNoiseShader.h"
 
 #include "SkArenaAlloc.h"
-#include "SkDither.h"
 #include "SkColorFilter.h"
 #include "SkMakeUnique.h"
+#include "SkRasterPipeline.h"
 #include "SkReadBuffer.h"
 #include "SkShader.h"
 #include "SkString.h"
-#include "SkUnPreMultiply.h"
 #include "SkWriteBuffer.h"
+#include "../jumper/SkJumper.h"
 
 #if SK_SUPPORT_GPU
 #include "GrContext.h"
@@ -337,27 +337,6 @@ public:
                       SkScalar baseFrequencyY, int numOctaves, SkScalar seed,
                       const SkISize* tileSize);
 
-    class PerlinNoiseShaderContext : public Context {
-    public:
-        PerlinNoiseShaderContext(const SkPerlinNoiseShaderImpl& shader, const ContextRec&);
-
-        void shadeSpan(int x, int y, SkPMColor[], int count) override;
-
-    private:
-        SkPMColor shade(const SkPoint& point, StitchData& stitchData) const;
-        SkScalar calculateTurbulenceValueForPoint(
-                                                  int channel,
-                                                  StitchData& stitchData, const SkPoint& point) const;
-        SkScalar calculateImprovedNoiseValueForPoint(int channel, const SkPoint& point) const;
-        SkScalar noise2D(int channel,
-                         const StitchData& stitchData, const SkPoint& noiseVector) const;
-
-        SkMatrix     fMatrix;
-        PaintingData fPaintingData;
-
-        typedef Context INHERITED;
-    };
-
 #if SK_SUPPORT_GPU
     std::unique_ptr<GrFragmentProcessor> asFragmentProcessor(const GrFPArgs&) const override;
 #endif
@@ -367,7 +346,8 @@ public:
 
 protected:
     void flatten(SkWriteBuffer&) const override;
-    Context* onMakeContext(const ContextRec&, SkArenaAlloc*) const override;
+    bool onAppendStages(const StageRec&) const override;
+    bool onIsRasterPipelineOnly(const SkMatrix&) const override { return true; }
 
 private:
     const SkPerlinNoiseShaderImpl::Type fType;
@@ -383,27 +363,6 @@ private:
     typedef SkShaderBase INHERITED;
 };
 
-namespace {
-
-// noiseValue is the color component's value (or color)
-// limitValue is the maximum perlin noise array index value allowed
-// newValue is the current noise dimension (either width or height)
-inline int checkNoise(int noiseValue, int limitValue, int newValue) {
-    // If the noise value would bring us out of bounds of the current noise array while we are
-    // stiching noise tiles together, wrap the noise around the current dimension of the noise to
-    // stay within the array bounds in a continuous fashion (so that tiling lines are not visible)
-    if (noiseValue >= limitValue) {
-        noiseValue -= newValue;
-    }
-    return noiseValue;
-}
-
-inline SkScalar smoothCurve(SkScalar t) {
-    return t * t * (3 - 2 * t);
-}
-
-} // end namespace
-
 SkPerlinNoiseShaderImpl::SkPerlinNoiseShaderImpl(SkPerlinNoiseShaderImpl::Type type,
                                                  SkScalar baseFrequencyX,
                                                  SkScalar baseFrequencyY,
@@ -458,229 +417,43 @@ void SkPerlinNoiseShaderImpl::flatten(SkWriteBuffer& buffer) const {
     buffer.writeInt(fTileSize.fHeight);
 }
 
-SkScalar SkPerlinNoiseShaderImpl::PerlinNoiseShaderContext::noise2D(
-        int channel, const StitchData& stitchData, const SkPoint& noiseVector) const {
-    struct Noise {
-        int noisePositionIntegerValue;
-        int nextNoisePositionIntegerValue;
-        SkScalar noisePositionFractionValue;
-        Noise(SkScalar component)
-        {
-            SkScalar position = component + kPerlinNoise;
-            noisePositionIntegerValue = SkScalarFloorToInt(position);
-            noisePositionFractionValue = position - SkIntToScalar(noisePositionIntegerValue);
-            nextNoisePositionIntegerValue = noisePositionIntegerValue + 1;
-        }
-    };
-    Noise noiseX(noiseVector.x());
-    Noise noiseY(noiseVector.y());
-    SkScalar u, v;
-    const SkPerlinNoiseShaderImpl& perlinNoiseShader = static_cast<const SkPerlinNoiseShaderImpl&>(fShader);
-    // If stitching, adjust lattice points accordingly.
-    if (perlinNoiseShader.fStitchTiles) {
-        noiseX.noisePositionIntegerValue =
-            checkNoise(noiseX.noisePositionIntegerValue, stitchData.fWrapX, stitchData.fWidth);
-        noiseY.noisePositionIntegerValue =
-            checkNoise(noiseY.noisePositionIntegerValue, stitchData.fWrapY, stitchData.fHeight);
-        noiseX.nextNoisePositionIntegerValue =
-            checkNoise(noiseX.nextNoisePositionIntegerValue, stitchData.fWrapX, stitchData.fWidth);
-        noiseY.nextNoisePositionIntegerValue =
-            checkNoise(noiseY.nextNoisePositionIntegerValue, stitchData.fWrapY, stitchData.fHeight);
-    }
-    noiseX.noisePositionIntegerValue &= kBlockMask;
-    noiseY.noisePositionIntegerValue &= kBlockMask;
-    noiseX.nextNoisePositionIntegerValue &= kBlockMask;
-    noiseY.nextNoisePositionIntegerValue &= kBlockMask;
-    int i = fPaintingData.fLatticeSelector[noiseX.noisePositionIntegerValue];
-    int j = fPaintingData.fLatticeSelector[noiseX.nextNoisePositionIntegerValue];
-    int b00 = (i + noiseY.noisePositionIntegerValue) & kBlockMask;
-    int b10 = (j + noiseY.noisePositionIntegerValue) & kBlockMask;
-    int b01 = (i + noiseY.nextNoisePositionIntegerValue) & kBlockMask;
-    int b11 = (j + noiseY.nextNoisePositionIntegerValue) & kBlockMask;
-    SkScalar sx = smoothCurve(noiseX.noisePositionFractionValue);
-    SkScalar sy = smoothCurve(noiseY.noisePositionFractionValue);
-
-    if (sx < 0 || sy < 0 || sx > 1 || sy > 1) {
-        return 0;  // Check for pathological inputs.
-    }
-
-    // This is taken 1:1 from SVG spec: http://www.w3.org/TR/SVG11/filters.html#feTurbulenceElement
-    SkPoint fractionValue = SkPoint::Make(noiseX.noisePositionFractionValue,
-                                          noiseY.noisePositionFractionValue); // Offset (0,0)
-    u = fPaintingData.fGradient[channel][b00].dot(fractionValue);
-    fractionValue.fX -= SK_Scalar1; // Offset (-1,0)
-    v = fPaintingData.fGradient[channel][b10].dot(fractionValue);
-    SkScalar a = SkScalarInterp(u, v, sx);
-    fractionValue.fY -= SK_Scalar1; // Offset (-1,-1)
-    v = fPaintingData.fGradient[channel][b11].dot(fractionValue);
-    fractionValue.fX = noiseX.noisePositionFractionValue; // Offset (0,-1)
-    u = fPaintingData.fGradient[channel][b01].dot(fractionValue);
-    SkScalar b = SkScalarInterp(u, v, sx);
-    return SkScalarInterp(a, b, sy);
-}
-
-SkScalar SkPerlinNoiseShaderImpl::PerlinNoiseShaderContext::calculateTurbulenceValueForPoint(
-        int channel, StitchData& stitchData, const SkPoint& point) const {
-    const SkPerlinNoiseShaderImpl& perlinNoiseShader = static_cast<const SkPerlinNoiseShaderImpl&>(fShader);
-    if (perlinNoiseShader.fStitchTiles) {
-        // Set up TurbulenceInitial stitch values.
-        stitchData = fPaintingData.fStitchDataInit;
-    }
-    SkScalar turbulenceFunctionResult = 0;
-    SkPoint noiseVector(SkPoint::Make(point.x() * fPaintingData.fBaseFrequency.fX,
-                                      point.y() * fPaintingData.fBaseFrequency.fY));
-    SkScalar ratio = SK_Scalar1;
-    for (int octave = 0; octave < perlinNoiseShader.fNumOctaves; ++octave) {
-        SkScalar noise = noise2D(channel, stitchData, noiseVector);
-        SkScalar numer = (perlinNoiseShader.fType == kFractalNoise_Type) ?
-                            noise : SkScalarAbs(noise);
-        turbulenceFunctionResult += numer / ratio;
-        noiseVector.fX *= 2;
-        noiseVector.fY *= 2;
-        ratio *= 2;
-        if (perlinNoiseShader.fStitchTiles) {
-            // Update stitch values
-            stitchData.fWidth  *= 2;
-            stitchData.fWrapX   = stitchData.fWidth + kPerlinNoise;
-            stitchData.fHeight *= 2;
-            stitchData.fWrapY   = stitchData.fHeight + kPerlinNoise;
-        }
-    }
-
-    // The value of turbulenceFunctionResult comes from ((turbulenceFunctionResult) + 1) / 2
-    // by fractalNoise and (turbulenceFunctionResult) by turbulence.
-    if (perlinNoiseShader.fType == kFractalNoise_Type) {
-        turbulenceFunctionResult = SkScalarHalf(turbulenceFunctionResult + 1);
-    }
-
-    if (channel == 3) { // Scale alpha by paint value
-        turbulenceFunctionResult *= SkIntToScalar(getPaintAlpha()) / 255;
-    }
-
-    // Clamp result
-    return SkScalarPin(turbulenceFunctionResult, 0, SK_Scalar1);
-}
-
-////////////////////////////////////////////////////////////////////////////////////////////////////
-// Improved Perlin Noise based on Java implementation found at http://mrl.nyu.edu/~perlin/noise/
-static SkScalar fade(SkScalar t) {
-    return t * t * t * (t * (t * 6 - 15) + 10);
-}
-
-static SkScalar lerp(SkScalar t, SkScalar a, SkScalar b) {
-    return a + t * (b - a);
-}
-
-static SkScalar grad(int hash, SkScalar x, SkScalar y, SkScalar z) {
-    int h = hash & 15;
-    SkScalar u = h < 8 ? x : y;
-    SkScalar v = h < 4 ? y : h == 12 || h == 14 ? x : z;
-    return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
-}
-
-SkScalar SkPerlinNoiseShaderImpl::PerlinNoiseShaderContext::calculateImprovedNoiseValueForPoint(
-        int channel, const SkPoint& point) const {
-    const SkPerlinNoiseShaderImpl& perlinNoiseShader = static_cast<const SkPerlinNoiseShaderImpl&>(fShader);
-    SkScalar x = point.fX * perlinNoiseShader.fBaseFrequencyX;
-    SkScalar y = point.fY * perlinNoiseShader.fBaseFrequencyY;
-    // z offset between different channels, chosen arbitrarily
-    static const SkScalar CHANNEL_DELTA = 1000.0f;
-    SkScalar z = channel * CHANNEL_DELTA + perlinNoiseShader.fSeed;
-    SkScalar result = 0;
-    SkScalar ratio = SK_Scalar1;
-    for (int i = 0; i < perlinNoiseShader.fNumOctaves; i++) {
-        int X = SkScalarFloorToInt(x) & 255;
-        int Y = SkScalarFloorToInt(y) & 255;
-        int Z = SkScalarFloorToInt(z) & 255;
-        SkScalar px = x - SkScalarFloorToScalar(x);
-        SkScalar py = y - SkScalarFloorToScalar(y);
-        SkScalar pz = z - SkScalarFloorToScalar(z);
-        SkScalar u = fade(px);
-        SkScalar v = fade(py);
-        SkScalar w = fade(pz);
-        uint8_t* permutations = improved_noise_permutations;
-        int A  = permutations[X] + Y;
-        int AA = permutations[A] + Z;
-        int AB = permutations[A + 1] + Z;
-        int B  = permutations[X + 1] + Y;
-        int BA = permutations[B] + Z;
-        int BB = permutations[B + 1] + Z;
-        result += lerp(w, lerp(v, lerp(u, grad(permutations[AA    ], px    , py    , pz    ),
-                                          grad(permutations[BA    ], px - 1, py    , pz    )),
-                                  lerp(u, grad(permutations[AB    ], px    , py - 1, pz    ),
-                                          grad(permutations[BB    ], px - 1, py - 1, pz    ))),
-                          lerp(v, lerp(u, grad(permutations[AA + 1], px    , py    , pz - 1),
-                                          grad(permutations[BA + 1], px - 1, py    , pz - 1)),
-                                  lerp(u, grad(permutations[AB + 1], px    , py - 1, pz - 1),
-                                          grad(permutations[BB + 1], px - 1, py - 1, pz - 1)))) /
-                   ratio;
-        x *= 2;
-        y *= 2;
-        ratio *= 2;
-    }
-    result = SkScalarClampMax((result + 1.0f) / 2.0f, 1.0f);
-    return result;
-}
-////////////////////////////////////////////////////////////////////////////////////////////////////
-
-SkPMColor SkPerlinNoiseShaderImpl::PerlinNoiseShaderContext::shade(
-        const SkPoint& point, StitchData& stitchData) const {
-    const SkPerlinNoiseShaderImpl& perlinNoiseShader = static_cast<const SkPerlinNoiseShaderImpl&>(fShader);
-    SkPoint newPoint;
-    fMatrix.mapPoints(&newPoint, &point, 1);
-    newPoint.fX = SkScalarRoundToScalar(newPoint.fX);
-    newPoint.fY = SkScalarRoundToScalar(newPoint.fY);
-
-    U8CPU rgba[4];
-    for (int channel = 3; channel >= 0; --channel) {
-        SkScalar value;
-        if (perlinNoiseShader.fType == kImprovedNoise_Type) {
-            value = calculateImprovedNoiseValueForPoint(channel, newPoint);
-        }
-        else {
-            value = calculateTurbulenceValueForPoint(channel, stitchData, newPoint);
-        }
-        rgba[channel] = SkScalarFloorToInt(255 * value);
-    }
-    return SkPreMultiplyARGB(rgba[3], rgba[0], rgba[1], rgba[2]);
-}
-
-SkShaderBase::Context* SkPerlinNoiseShaderImpl::onMakeContext(const ContextRec& rec,
-                                                           SkArenaAlloc* alloc) const {
-    return alloc->make<PerlinNoiseShaderContext>(*this, rec);
-}
-
-static inline SkMatrix total_matrix(const SkShaderBase::ContextRec& rec,
-                                    const SkShaderBase& shader) {
-    SkMatrix matrix = SkMatrix::Concat(*rec.fMatrix, shader.getLocalMatrix());
-    if (rec.fLocalMatrix) {
-        matrix.preConcat(*rec.fLocalMatrix);
+bool SkPerlinNoiseShaderImpl::onAppendStages(const StageRec& rec) const {
+    SkMatrix matrix = SkMatrix::Concat(rec.fCTM, this->getLocalMatrix());
+    if (rec.fLocalM) {
+        matrix.preConcat(*rec.fLocalM);
     }
 
-    return matrix;
-}
-
-SkPerlinNoiseShaderImpl::PerlinNoiseShaderContext::PerlinNoiseShaderContext(
-        const SkPerlinNoiseShaderImpl& shader, const ContextRec& rec)
-    : INHERITED(shader, rec)
-    , fMatrix(total_matrix(rec, shader)) // used for temp storage, adjusted below
-    , fPaintingData(shader.fTileSize, shader.fSeed, shader.fBaseFrequencyX,
-                    shader.fBaseFrequencyY, fMatrix)
-{
-    // This (1,1) translation is due to WebKit's 1 based coordinates for the noise
-    // (as opposed to 0 based, usually). The same adjustment is in the setData() function.
-    fMatrix.setTranslate(-fMatrix.getTranslateX() + SK_Scalar1,
-                         -fMatrix.getTranslateY() + SK_Scalar1);
-}
-
-void SkPerlinNoiseShaderImpl::PerlinNoiseShaderContext::shadeSpan(
-        int x, int y, SkPMColor result[], int count) {
-    SkPoint point = SkPoint::Make(SkIntToScalar(x), SkIntToScalar(y));
-    StitchData stitchData;
-    for (int i = 0; i < count; ++i) {
-        result[i] = shade(point, stitchData);
-        point.fX += SK_Scalar1;
+    auto ctx = rec.fAlloc->make<SkJumper_PerlinNoiseCtx>();
+    // The noise follows the matrix's scale through the base frequency, and its translation with a
+    // (1,1) offset, due to WebKit's 1 based coordinates for the noise (as opposed to 0 based,
+    // usually). The same adjustment is in the setData() function.
+    ctx->offsetX = SK_Scalar1 - matrix.getTranslateX();
+    ctx->offsetY = SK_Scalar1 - matrix.getTranslateY();
+    ctx->numOctaves = fNumOctaves;
+
+    SkRasterPipeline* p = rec.fPipeline;
+    p->append_seed_shader();
+    if (kImprovedNoise_Type == fType) {
+        ctx->permutations = improved_noise_permutations;
+        ctx->baseFrequencyX = fBaseFrequencyX;
+        ctx->baseFrequencyY = fBaseFrequencyY;
+        ctx->z = fSeed;
+        p->append(SkRasterPipeline::improved_noise, ctx);
+    } else {
+        auto paintingData = rec.fAlloc->make<PaintingData>(fTileSize, fSeed, fBaseFrequencyX,
+                                                           fBaseFrequencyY, matrix);
+        ctx->lattice = paintingData->fLatticeSelector;
+        ctx->gradients = &paintingData->fGradient[0][0].fX;
+        ctx->baseFrequencyX = paintingData->fBaseFrequency.fX;
+        ctx->baseFrequencyY = paintingData->fBaseFrequency.fY;
+        ctx->fractalNoise = kFractalNoise_Type == fType;
+        ctx->stitching = fStitchTiles;
+        ctx->stitchWidth = paintingData->fStitchDataInit.fWidth;
+        ctx->stitchHeight = paintingData->fStitchDataInit.fHeight;
+        p->append(SkRasterPipeline::perlin_noise, ctx);
     }
+    p->append(SkRasterPipeline::premul);
+    return true;
 }
 
 /////////////////////////////////////////////////////////////////////
@@ -13,6 +13,7 @@
 #include "SkSLHCodeGenerator.h"
 #include "SkSLIRGenerator.h"
 #include "SkSLMetalCodeGenerator.h"
+#include "SkSLParser.h"
 #include "SkSLSPIRVCodeGenerator.h"
 #include "ir/SkSLEnum.h"
 #include "ir/SkSLExpression.h"
@@ -56,6 +57,58 @@ static const char* SKSL_FP_INCLUDE =
 
 namespace SkSL {
 
+namespace {
+
+/**
+ * The builtin modules are the same text for every Compiler, so each one is lexed and parsed only
+ * once per process. Every Compiler still converts the shared declarations into its own IR.
+ */
+struct BuiltinModule {
+    BuiltinModule(const char* text, SymbolTable& types, ErrorReporter& errors)
+    : fArena(strlen(text)) {
+        Parser parser(text, strlen(text), types, errors, &fArena);
+        fDeclarations = parser.file();
+    }
+
+    ASTArena fArena;
+    std::vector<std::unique_ptr<ASTDeclaration>> fDeclarations;
+};
+
+} // namespace
+
+// The modules are parsed by whichever Compiler needs them first, and intentionally never freed.
+static const BuiltinModule& sksl_module(SymbolTable& types, ErrorReporter& errors) {
+    static const BuiltinModule* module = new BuiltinModule(SKSL_INCLUDE, types, errors);
+    return *module;
+}
+
+static const BuiltinModule& program_module(Program::Kind kind, SymbolTable& types,
+                                           ErrorReporter& errors) {
+    switch (kind) {
+        case Program::kVertex_Kind: {
+            static const BuiltinModule* module = new BuiltinModule(SKSL_VERT_INCLUDE, types,
+                                                                   errors);
+            return *module;
+        }
+        case Program::kFragment_Kind: {
+            static const BuiltinModule* module = new BuiltinModule(SKSL_FRAG_INCLUDE, types,
+                                                                   errors);
+            return *module;
+        }
+        case Program::kGeometry_Kind: {
+            static const BuiltinModule* module = new BuiltinModule(SKSL_GEOM_INCLUDE, types,
+                                                                   errors);
+            return *module;
+        }
+        case Program::kFragmentProcessor_Kind: {
+            static const BuiltinModule* module = new BuiltinModule(SKSL_FP_INCLUDE, types,
+                                                                   errors);
+            return *module;
+        }
+    }
+    ABORT("unsupported program kind");
+}
+
 Compiler::Compiler(Flags flags)
 : fFlags(flags)
 , fErrorCount(0) {
@@ -200,8 +253,8 @@ Compiler::Compiler(Flags flags)
     fIRGenerator->fSymbolTable->add(skArgsName, std::unique_ptr<Symbol>(skArgs));
 
     std::vector<std::unique_ptr<ProgramElement>> ignored;
-    fIRGenerator->convertProgram(Program::kFragment_Kind, SKSL_INCLUDE, strlen(SKSL_INCLUDE),
-                                 *fTypes, &ignored);
+    fIRGenerator->convertProgram(Program::kFragment_Kind,
+                                 sksl_module(*fTypes, *this).fDeclarations, *fTypes, &ignored);
     fIRGenerator->fSymbolTable->markAllFunctionsBuiltin();
     if (fErrorCount) {
         printf("Unexpected errors: %s\n", fErrorText.c_str());
@@ -1163,24 +1216,8 @@ std::unique_ptr<Program> Compiler::convertProgram(Program::Kind kind, String tex
     fErrorCount = 0;
     fIRGenerator->start(&settings);
     std::vector<std::unique_ptr<ProgramElement>> elements;
-    switch (kind) {
-        case Program::kVertex_Kind:
-            fIRGenerator->convertProgram(kind, SKSL_VERT_INCLUDE, strlen(SKSL_VERT_INCLUDE),
-                                         *fTypes, &elements);
-            break;
-        case Program::kFragment_Kind:
-            fIRGenerator->convertProgram(kind, SKSL_FRAG_INCLUDE, strlen(SKSL_FRAG_INCLUDE),
-                                         *fTypes, &elements);
-            break;
-        case Program::kGeometry_Kind:
-            fIRGenerator->convertProgram(kind, SKSL_GEOM_INCLUDE, strlen(SKSL_GEOM_INCLUDE),
-                                         *fTypes, &elements);
-            break;
-        case Program::kFragmentProcessor_Kind:
-            fIRGenerator->convertProgram(kind, SKSL_FP_INCLUDE, strlen(SKSL_FP_INCLUDE), *fTypes,
-                                         &elements);
-            break;
-    }
+    fIRGenerator->convertProgram(kind, program_module(kind, *fTypes, *this).fDeclarations,
+                                 *fTypes, &elements);
     fIRGenerator->fSymbolTable->markAllFunctionsBuiltin();
     for (auto& element : elements) {
         if (element->fKind == ProgramElement::kEnum_Kind) {
@@ -1271,8 +1308,10 @@ bool Compiler::toGLSL(const Program& program, String* out) {
 }
 
 bool Compiler::toMetal(const Program& program, OutputStream& out) {
+    fSource = program.fSource.get();
     MetalCodeGenerator cg(&fContext, &program, this, &out);
     bool result = cg.generateCode();
+    fSource = nullptr;
     this->writeErrorCount();
     return result;
 }
@@ -255,7 +255,8 @@ void HCodeGenerator::writeFields() {
 
 String HCodeGenerator::GetHeader(const Program& program, ErrorReporter& errors) {
     SymbolTable types(&errors);
-    Parser parser(program.fSource->c_str(), program.fSource->length(), types, errors);
+    ASTArena arena(0);
+    Parser parser(program.fSource->c_str(), program.fSource->length(), types, errors, &arena);
     for (;;) {
         Token header = parser.nextRawToken();
         switch (header.fKind) {
@@ -2112,13 +2112,31 @@ void IRGenerator::convertProgram(Program::Kind kind,
                                  size_t length,
                                  SymbolTable& types,
                                  std::vector<std::unique_ptr<ProgramElement>>* out) {
-    fKind = kind;
-    fProgramElements = out;
-    Parser parser(text, length, types, fErrors);
+    ASTArena arena(length);
+    Parser parser(text, length, types, fErrors, &arena);
     std::vector<std::unique_ptr<ASTDeclaration>> parsed = parser.file();
     if (fErrors.errorCount()) {
         return;
     }
+    this->convertProgram(kind, parsed, types, out);
+}
+
+void IRGenerator::convertProgram(Program::Kind kind,
+                                 const std::vector<std::unique_ptr<ASTDeclaration>>& parsed,
+                                 SymbolTable& types,
+                                 std::vector<std::unique_ptr<ProgramElement>>* out) {
+    fKind = kind;
+    fProgramElements = out;
+    // The Parser registers enum types as it encounters them; declarations parsed against another
+    // Compiler's types still need theirs.
+    for (const auto& decl : parsed) {
+        if (decl->fKind == ASTDeclaration::kEnum_Kind) {
+            StringFragment name = ((ASTEnum&) *decl).fTypeName;
+            if (!types[name]) {
+                types.add(name, std::unique_ptr<Symbol>(new Type(name, Type::kEnum_Kind)));
+            }
+        }
+    }
     for (size_t i = 0; i < parsed.size(); i++) {
         ASTDeclaration& decl = *parsed[i];
         switch (decl.fKind) {
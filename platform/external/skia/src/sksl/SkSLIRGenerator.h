@@ -68,6 +68,15 @@ public:
                         SymbolTable& types,
                         std::vector<std::unique_ptr<ProgramElement>>* result);
 
+    /**
+     * Converts declarations that were parsed earlier, possibly against a different Compiler's
+     * types. The declarations are only read, so they may be shared between Compilers.
+     */
+    void convertProgram(Program::Kind kind,
+                        const std::vector<std::unique_ptr<ASTDeclaration>>& parsed,
+                        SymbolTable& types,
+                        std::vector<std::unique_ptr<ProgramElement>>* result);
+
     /**
      * If both operands are compile-time constants and can be folded, returns an expression
      * representing the folded value. Otherwise, returns null. Note that unlike most other functions
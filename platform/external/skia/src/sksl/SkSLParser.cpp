@@ -73,11 +73,13 @@ private:
     Parser* fParser;
 };
 
-Parser::Parser(const char* text, size_t length, SymbolTable& types, ErrorReporter& errors)
+Parser::Parser(const char* text, size_t length, SymbolTable& types, ErrorReporter& errors,
+               ASTArena* arena)
 : fText(text)
 , fPushback(Token::INVALID, -1, -1)
 , fTypes(types)
-, fErrors(errors) {
+, fErrors(errors)
+, fArena(arena) {
     fLexer.start(text, length);
 }
 
@@ -219,8 +221,8 @@ std::unique_ptr<ASTDeclaration> Parser::directive() {
         if (!this->expect(Token::IDENTIFIER, "an identifier")) {
             return nullptr;
         }
-        return std::unique_ptr<ASTDeclaration>(new ASTExtension(start.fOffset,
-                                                                String(this->text(name))));
+        return std::unique_ptr<ASTDeclaration>(new (fArena) ASTExtension(start.fOffset,
+                                                                         String(this->text(name))));
     } else {
         this->error(start, "unsupported directive '" + this->text(start) + "'");
         return nullptr;
@@ -274,10 +276,10 @@ std::unique_ptr<ASTDeclaration> Parser::section() {
     StringFragment name = this->text(start);
     ++name.fChars;
     --name.fLength;
-    return std::unique_ptr<ASTDeclaration>(new ASTSection(start.fOffset,
-                                                          String(name),
-                                                          argument,
-                                                          text));
+    return std::unique_ptr<ASTDeclaration>(new (fArena) ASTSection(start.fOffset,
+                                                                   String(name),
+                                                                   argument,
+                                                                   text));
 }
 
 /* ENUM CLASS IDENTIFIER LBRACE (IDENTIFIER (EQ expression)? (COMMA IDENTIFIER (EQ expression))*)?
@@ -336,8 +338,8 @@ std::unique_ptr<ASTDeclaration> Parser::enumDeclaration() {
         }
     }
     this->expect(Token::SEMICOLON, "';'");
-    return std::unique_ptr<ASTDeclaration>(new ASTEnum(name.fOffset, this->text(name), names,
-                                                       std::move(values)));
+    return std::unique_ptr<ASTDeclaration>(new (fArena) ASTEnum(name.fOffset, this->text(name),
+                                                                names, std::move(values)));
 }
 
 /* enumDeclaration | modifiers (structVarDeclaration | type IDENTIFIER ((LPAREN parameter
@@ -358,7 +360,7 @@ std::unique_ptr<ASTDeclaration> Parser::declaration() {
     }
     if (lookahead.fKind == Token::SEMICOLON) {
         this->nextToken();
-        return std::unique_ptr<ASTDeclaration>(new ASTModifiersDeclaration(modifiers));
+        return std::unique_ptr<ASTDeclaration>(new (fArena) ASTModifiersDeclaration(modifiers));
     }
     std::unique_ptr<ASTType> type(this->type());
     if (!type) {
@@ -393,12 +395,12 @@ std::unique_ptr<ASTDeclaration> Parser::declaration() {
                 return nullptr;
             }
         }
-        return std::unique_ptr<ASTDeclaration>(new ASTFunction(name.fOffset,
-                                                               modifiers,
-                                                               std::move(type),
-                                                               this->text(name),
-                                                               std::move(parameters),
-                                                               std::move(body)));
+        return std::unique_ptr<ASTDeclaration>(new (fArena) ASTFunction(name.fOffset,
+                                                                        modifiers,
+                                                                        std::move(type),
+                                                                        this->text(name),
+                                                                        std::move(parameters),
+                                                                        std::move(body)));
     } else {
         return this->varDeclarationEnd(modifiers, std::move(type), this->text(name));
     }
@@ -459,8 +461,9 @@ std::unique_ptr<ASTType> Parser::structDeclaration() {
     }
     fTypes.add(this->text(name), std::unique_ptr<Type>(new Type(name.fOffset, this->text(name),
                                                                 fields)));
-    return std::unique_ptr<ASTType>(new ASTType(name.fOffset, this->text(name),
-                                                ASTType::kStruct_Kind, std::vector<int>()));
+    return std::unique_ptr<ASTType>(new (fArena) ASTType(name.fOffset, this->text(name),
+                                                         ASTType::kStruct_Kind,
+                                                         std::vector<int>()));
 }
 
 /* structDeclaration ((IDENTIFIER varDeclarationEnd) | SEMICOLON) */
@@ -549,9 +552,9 @@ std::unique_ptr<ASTVarDeclarations> Parser::varDeclarationEnd(Modifiers mods,
     if (!this->expect(Token::SEMICOLON, "';'")) {
         return nullptr;
     }
-    return std::unique_ptr<ASTVarDeclarations>(new ASTVarDeclarations(std::move(mods),
-                                                                      std::move(type),
-                                                                      std::move(vars)));
+    return std::unique_ptr<ASTVarDeclarations>(new (fArena) ASTVarDeclarations(std::move(mods),
+                                                                               std::move(type),
+                                                                               std::move(vars)));
 }
 
 /* modifiers type IDENTIFIER (LBRACKET INT_LITERAL RBRACKET)? */
@@ -576,8 +579,10 @@ std::unique_ptr<ASTParameter> Parser::parameter() {
             return nullptr;
         }
     }
-    return std::unique_ptr<ASTParameter>(new ASTParameter(name.fOffset, modifiers, std::move(type),
-                                                          this->text(name), std::move(sizes)));
+    return std::unique_ptr<ASTParameter>(new (fArena) ASTParameter(name.fOffset, modifiers,
+                                                                   std::move(type),
+                                                                   this->text(name),
+                                                                   std::move(sizes)));
 }
 
 /** EQ INT_LITERAL */
@@ -945,8 +950,8 @@ std::unique_ptr<ASTStatement> Parser::statement() {
             return this->block();
         case Token::SEMICOLON:
             this->nextToken();
-            return std::unique_ptr<ASTStatement>(new ASTBlock(start.fOffset,
-                                                     std::vector<std::unique_ptr<ASTStatement>>()));
+            return std::unique_ptr<ASTStatement>(new (fArena) ASTBlock(
+                    start.fOffset, std::vector<std::unique_ptr<ASTStatement>>()));
         case Token::CONST:   // fall through
         case Token::HIGHP:   // fall through
         case Token::MEDIUMP: // fall through
@@ -955,7 +960,8 @@ std::unique_ptr<ASTStatement> Parser::statement() {
             if (!decl) {
                 return nullptr;
             }
-            return std::unique_ptr<ASTStatement>(new ASTVarDeclarationStatement(std::move(decl)));
+            return std::unique_ptr<ASTStatement>(new (fArena) ASTVarDeclarationStatement(
+                    std::move(decl)));
         }
         case Token::IDENTIFIER:
             if (this->isType(this->text(start))) {
@@ -963,8 +969,8 @@ std::unique_ptr<ASTStatement> Parser::statement() {
                 if (!decl) {
                     return nullptr;
                 }
-                return std::unique_ptr<ASTStatement>(new ASTVarDeclarationStatement(
-                                                                                  std::move(decl)));
+                return std::unique_ptr<ASTStatement>(new (fArena) ASTVarDeclarationStatement(
+                        std::move(decl)));
             }
             // fall through
         default:
@@ -996,8 +1002,8 @@ std::unique_ptr<ASTType> Parser::type() {
         }
         this->expect(Token::RBRACKET, "']'");
     }
-    return std::unique_ptr<ASTType>(new ASTType(type.fOffset, this->text(type),
-                                                ASTType::kIdentifier_Kind, sizes));
+    return std::unique_ptr<ASTType>(new (fArena) ASTType(type.fOffset, this->text(type),
+                                                         ASTType::kIdentifier_Kind, sizes));
 }
 
 /* IDENTIFIER LBRACE varDeclaration* RBRACE (IDENTIFIER (LBRACKET expression? RBRACKET)*)? */
@@ -1042,11 +1048,11 @@ std::unique_ptr<ASTDeclaration> Parser::interfaceBlock(Modifiers mods) {
         instanceName = this->text(instanceNameToken);
     }
     this->expect(Token::SEMICOLON, "';'");
-    return std::unique_ptr<ASTDeclaration>(new ASTInterfaceBlock(name.fOffset, mods,
-                                                                 this->text(name),
-                                                                 std::move(decls),
-                                                                 instanceName,
-                                                                 std::move(sizes)));
+    return std::unique_ptr<ASTDeclaration>(new (fArena) ASTInterfaceBlock(name.fOffset, mods,
+                                                                          this->text(name),
+                                                                          std::move(decls),
+                                                                          instanceName,
+                                                                          std::move(sizes)));
 }
 
 /* IF LPAREN expression RPAREN statement (ELSE statement)? */
@@ -1077,11 +1083,11 @@ std::unique_ptr<ASTIfStatement> Parser::ifStatement() {
             return nullptr;
         }
     }
-    return std::unique_ptr<ASTIfStatement>(new ASTIfStatement(start.fOffset,
-                                                              isStatic,
-                                                              std::move(test),
-                                                              std::move(ifTrue),
-                                                              std::move(ifFalse)));
+    return std::unique_ptr<ASTIfStatement>(new (fArena) ASTIfStatement(start.fOffset,
+                                                                       isStatic,
+                                                                       std::move(test),
+                                                                       std::move(ifTrue),
+                                                                       std::move(ifFalse)));
 }
 
 /* DO statement WHILE LPAREN expression RPAREN SEMICOLON */
@@ -1110,9 +1116,9 @@ std::unique_ptr<ASTDoStatement> Parser::doStatement() {
     if (!this->expect(Token::SEMICOLON, "';'")) {
         return nullptr;
     }
-    return std::unique_ptr<ASTDoStatement>(new ASTDoStatement(start.fOffset,
-                                                              std::move(statement),
-                                                              std::move(test)));
+    return std::unique_ptr<ASTDoStatement>(new (fArena) ASTDoStatement(start.fOffset,
+                                                                       std::move(statement),
+                                                                       std::move(test)));
 }
 
 /* WHILE LPAREN expression RPAREN STATEMENT */
@@ -1135,9 +1141,9 @@ std::unique_ptr<ASTWhileStatement> Parser::whileStatement() {
     if (!statement) {
         return nullptr;
     }
-    return std::unique_ptr<ASTWhileStatement>(new ASTWhileStatement(start.fOffset,
-                                                                    std::move(test),
-                                                                    std::move(statement)));
+    return std::unique_ptr<ASTWhileStatement>(new (fArena) ASTWhileStatement(start.fOffset,
+                                                                             std::move(test),
+                                                                             std::move(statement)));
 }
 
 /* CASE expression COLON statement* */
@@ -1162,8 +1168,9 @@ std::unique_ptr<ASTSwitchCase> Parser::switchCase() {
         }
         statements.push_back(std::move(s));
     }
-    return std::unique_ptr<ASTSwitchCase>(new ASTSwitchCase(start.fOffset, std::move(value),
-                                                            std::move(statements)));
+    return std::unique_ptr<ASTSwitchCase>(new (fArena) ASTSwitchCase(start.fOffset,
+                                                                     std::move(value),
+                                                                     std::move(statements)));
 }
 
 /* SWITCH LPAREN expression RPAREN LBRACE switchCase* (DEFAULT COLON statement*)? RBRACE */
@@ -1210,16 +1217,16 @@ std::unique_ptr<ASTStatement> Parser::switchStatement() {
             }
             statements.push_back(std::move(s));
         }
-        cases.emplace_back(new ASTSwitchCase(defaultStart.fOffset, nullptr,
-                                             std::move(statements)));
+        cases.emplace_back(new (fArena) ASTSwitchCase(defaultStart.fOffset, nullptr,
+                                                      std::move(statements)));
     }
     if (!this->expect(Token::RBRACE, "'}'")) {
         return nullptr;
     }
-    return std::unique_ptr<ASTStatement>(new ASTSwitchStatement(start.fOffset,
-                                                                isStatic,
-                                                                std::move(value),
-                                                                std::move(cases)));
+    return std::unique_ptr<ASTStatement>(new (fArena) ASTSwitchStatement(start.fOffset,
+                                                                         isStatic,
+                                                                         std::move(value),
+                                                                         std::move(cases)));
 }
 
 /* FOR LPAREN (declaration | expression)? SEMICOLON expression? SEMICOLON expression? RPAREN
@@ -1243,8 +1250,8 @@ std::unique_ptr<ASTForStatement> Parser::forStatement() {
             if (!vd) {
                 return nullptr;
             }
-            initializer = std::unique_ptr<ASTStatement>(new ASTVarDeclarationStatement(
-                                                                                    std::move(vd)));
+            initializer = std::unique_ptr<ASTStatement>(new (fArena) ASTVarDeclarationStatement(
+                    std::move(vd)));
             break;
         }
         case Token::IDENTIFIER: {
@@ -1253,8 +1260,8 @@ std::unique_ptr<ASTForStatement> Parser::forStatement() {
                 if (!vd) {
                     return nullptr;
                 }
-                initializer = std::unique_ptr<ASTStatement>(new ASTVarDeclarationStatement(
-                                                                                    std::move(vd)));
+                initializer = std::unique_ptr<ASTStatement>(new (fArena) ASTVarDeclarationStatement(
+                        std::move(vd)));
                 break;
             }
         } // fall through
@@ -1285,10 +1292,11 @@ std::unique_ptr<ASTForStatement> Parser::forStatement() {
     if (!statement) {
         return nullptr;
     }
-    return std::unique_ptr<ASTForStatement>(new ASTForStatement(start.fOffset,
-                                                                std::move(initializer),
-                                                                std::move(test), std::move(next),
-                                                                std::move(statement)));
+    return std::unique_ptr<ASTForStatement>(new (fArena) ASTForStatement(start.fOffset,
+                                                                         std::move(initializer),
+                                                                         std::move(test),
+                                                                         std::move(next),
+                                                                         std::move(statement)));
 }
 
 /* RETURN expression? SEMICOLON */
@@ -1307,8 +1315,8 @@ std::unique_ptr<ASTReturnStatement> Parser::returnStatement() {
     if (!this->expect(Token::SEMICOLON, "';'")) {
         return nullptr;
     }
-    return std::unique_ptr<ASTReturnStatement>(new ASTReturnStatement(start.fOffset,
-                                                                      std::move(expression)));
+    return std::unique_ptr<ASTReturnStatement>(new (fArena) ASTReturnStatement(
+            start.fOffset, std::move(expression)));
 }
 
 /* BREAK SEMICOLON */
@@ -1320,7 +1328,7 @@ std::unique_ptr<ASTBreakStatement> Parser::breakStatement() {
     if (!this->expect(Token::SEMICOLON, "';'")) {
         return nullptr;
     }
-    return std::unique_ptr<ASTBreakStatement>(new ASTBreakStatement(start.fOffset));
+    return std::unique_ptr<ASTBreakStatement>(new (fArena) ASTBreakStatement(start.fOffset));
 }
 
 /* CONTINUE SEMICOLON */
@@ -1332,7 +1340,7 @@ std::unique_ptr<ASTContinueStatement> Parser::continueStatement() {
     if (!this->expect(Token::SEMICOLON, "';'")) {
         return nullptr;
     }
-    return std::unique_ptr<ASTContinueStatement>(new ASTContinueStatement(start.fOffset));
+    return std::unique_ptr<ASTContinueStatement>(new (fArena) ASTContinueStatement(start.fOffset));
 }
 
 /* DISCARD SEMICOLON */
@@ -1344,7 +1352,7 @@ std::unique_ptr<ASTDiscardStatement> Parser::discardStatement() {
     if (!this->expect(Token::SEMICOLON, "';'")) {
         return nullptr;
     }
-    return std::unique_ptr<ASTDiscardStatement>(new ASTDiscardStatement(start.fOffset));
+    return std::unique_ptr<ASTDiscardStatement>(new (fArena) ASTDiscardStatement(start.fOffset));
 }
 
 /* LBRACE statement* RBRACE */
@@ -1362,8 +1370,8 @@ std::unique_ptr<ASTBlock> Parser::block() {
         switch (this->peek().fKind) {
             case Token::RBRACE:
                 this->nextToken();
-                return std::unique_ptr<ASTBlock>(new ASTBlock(start.fOffset,
-                                                              std::move(statements)));
+                return std::unique_ptr<ASTBlock>(new (fArena) ASTBlock(start.fOffset,
+                                                                       std::move(statements)));
             case Token::END_OF_FILE:
                 this->error(this->peek(), "expected '}', but found end of file");
                 return nullptr;
@@ -1383,7 +1391,7 @@ std::unique_ptr<ASTExpressionStatement> Parser::expressionStatement() {
     std::unique_ptr<ASTExpression> expr = this->expression();
     if (expr) {
         if (this->expect(Token::SEMICOLON, "';'")) {
-            ASTExpressionStatement* result = new ASTExpressionStatement(std::move(expr));
+            ASTExpressionStatement* result = new (fArena) ASTExpressionStatement(std::move(expr));
             return std::unique_ptr<ASTExpressionStatement>(result);
         }
     }
@@ -1411,7 +1419,8 @@ std::unique_ptr<ASTExpression> Parser::commaExpression() {
         if (!right) {
             return nullptr;
         }
-        result.reset(new ASTBinaryExpression(std::move(result), std::move(t), std::move(right)));
+        result.reset(new (fArena) ASTBinaryExpression(std::move(result), std::move(t),
+                                                      std::move(right)));
     }
     return result;
 }
@@ -1446,9 +1455,8 @@ std::unique_ptr<ASTExpression> Parser::assignmentExpression() {
                 if (!right) {
                     return nullptr;
                 }
-                result = std::unique_ptr<ASTExpression>(new ASTBinaryExpression(std::move(result),
-                                                                                std::move(t),
-                                                                                std::move(right)));
+                result = std::unique_ptr<ASTExpression>(new (fArena) ASTBinaryExpression(
+                        std::move(result), std::move(t), std::move(right)));
             }
             default:
                 return result;
@@ -1469,9 +1477,8 @@ std::unique_ptr<ASTExpression> Parser::ternaryExpression() {
         }
         if (this->expect(Token::COLON, "':'")) {
             std::unique_ptr<ASTExpression> falseExpr = this->assignmentExpression();
-            return std::unique_ptr<ASTExpression>(new ASTTernaryExpression(std::move(result),
-                                                                           std::move(trueExpr),
-                                                                           std::move(falseExpr)));
+            return std::unique_ptr<ASTExpression>(new (fArena) ASTTernaryExpression(
+                    std::move(result), std::move(trueExpr), std::move(falseExpr)));
         }
         return nullptr;
     }
@@ -1490,7 +1497,8 @@ std::unique_ptr<ASTExpression> Parser::logicalOrExpression() {
         if (!right) {
             return nullptr;
         }
-        result.reset(new ASTBinaryExpression(std::move(result), std::move(t), std::move(right)));
+        result.reset(new (fArena) ASTBinaryExpression(std::move(result), std::move(t),
+                                                      std::move(right)));
     }
     return result;
 }
@@ -1507,7 +1515,8 @@ std::unique_ptr<ASTExpression> Parser::logicalXorExpression() {
         if (!right) {
             return nullptr;
         }
-        result.reset(new ASTBinaryExpression(std::move(result), std::move(t), std::move(right)));
+        result.reset(new (fArena) ASTBinaryExpression(std::move(result), std::move(t),
+                                                      std::move(right)));
     }
     return result;
 }
@@ -1524,7 +1533,8 @@ std::unique_ptr<ASTExpression> Parser::logicalAndExpression() {
         if (!right) {
             return nullptr;
         }
-        result.reset(new ASTBinaryExpression(std::move(result), std::move(t), std::move(right)));
+        result.reset(new (fArena) ASTBinaryExpression(std::move(result), std::move(t),
+                                                      std::move(right)));
     }
     return result;
 }
@@ -1541,7 +1551,8 @@ std::unique_ptr<ASTExpression> Parser::bitwiseOrExpression() {
         if (!right) {
             return nullptr;
         }
-        result.reset(new ASTBinaryExpression(std::move(result), std::move(t), std::move(right)));
+        result.reset(new (fArena) ASTBinaryExpression(std::move(result), std::move(t),
+                                                      std::move(right)));
     }
     return result;
 }
@@ -1558,7 +1569,8 @@ std::unique_ptr<ASTExpression> Parser::bitwiseXorExpression() {
         if (!right) {
             return nullptr;
         }
-        result.reset(new ASTBinaryExpression(std::move(result), std::move(t), std::move(right)));
+        result.reset(new (fArena) ASTBinaryExpression(std::move(result), std::move(t),
+                                                      std::move(right)));
     }
     return result;
 }
@@ -1575,7 +1587,8 @@ std::unique_ptr<ASTExpression> Parser::bitwiseAndExpression() {
         if (!right) {
             return nullptr;
         }
-        result.reset(new ASTBinaryExpression(std::move(result), std::move(t), std::move(right)));
+        result.reset(new (fArena) ASTBinaryExpression(std::move(result), std::move(t),
+                                                      std::move(right)));
     }
     return result;
 }
@@ -1595,7 +1608,8 @@ std::unique_ptr<ASTExpression> Parser::equalityExpression() {
                 if (!right) {
                     return nullptr;
                 }
-                result.reset(new ASTBinaryExpression(std::move(result), std::move(t), std::move(right)));
+                result.reset(new (fArena) ASTBinaryExpression(std::move(result), std::move(t),
+                                                              std::move(right)));
                 break;
             }
             default:
@@ -1621,8 +1635,8 @@ std::unique_ptr<ASTExpression> Parser::relationalExpression() {
                 if (!right) {
                     return nullptr;
                 }
-                result.reset(new ASTBinaryExpression(std::move(result), std::move(t),
-                                                     std::move(right)));
+                result.reset(new (fArena) ASTBinaryExpression(std::move(result), std::move(t),
+                                                              std::move(right)));
                 break;
             }
             default:
@@ -1646,8 +1660,8 @@ std::unique_ptr<ASTExpression> Parser::shiftExpression() {
                 if (!right) {
                     return nullptr;
                 }
-                result.reset(new ASTBinaryExpression(std::move(result), std::move(t),
-                                                     std::move(right)));
+                result.reset(new (fArena) ASTBinaryExpression(std::move(result), std::move(t),
+                                                              std::move(right)));
                 break;
             }
             default:
@@ -1671,8 +1685,8 @@ std::unique_ptr<ASTExpression> Parser::additiveExpression() {
                 if (!right) {
                     return nullptr;
                 }
-                result.reset(new ASTBinaryExpression(std::move(result), std::move(t),
-                                                     std::move(right)));
+                result.reset(new (fArena) ASTBinaryExpression(std::move(result), std::move(t),
+                                                              std::move(right)));
                 break;
             }
             default:
@@ -1697,8 +1711,8 @@ std::unique_ptr<ASTExpression> Parser::multiplicativeExpression() {
                 if (!right) {
                     return nullptr;
                 }
-                result.reset(new ASTBinaryExpression(std::move(result), std::move(t),
-                                                     std::move(right)));
+                result.reset(new (fArena) ASTBinaryExpression(std::move(result), std::move(t),
+                                                              std::move(right)));
                 break;
             }
             default:
@@ -1721,8 +1735,8 @@ std::unique_ptr<ASTExpression> Parser::unaryExpression() {
             if (!expr) {
                 return nullptr;
             }
-            return std::unique_ptr<ASTExpression>(new ASTPrefixExpression(std::move(t),
-                                                                          std::move(expr)));
+            return std::unique_ptr<ASTExpression>(new (fArena) ASTPrefixExpression(
+                    std::move(t), std::move(expr)));
         }
         default:
             return this->postfixExpression();
@@ -1747,7 +1761,7 @@ std::unique_ptr<ASTExpression> Parser::postfixExpression() {
                 if (!s) {
                     return nullptr;
                 }
-                result.reset(new ASTSuffixExpression(std::move(result), std::move(s)));
+                result.reset(new (fArena) ASTSuffixExpression(std::move(result), std::move(s)));
                 break;
             }
             default:
@@ -1763,21 +1777,22 @@ std::unique_ptr<ASTSuffix> Parser::suffix() {
     switch (next.fKind) {
         case Token::LBRACKET: {
             if (this->checkNext(Token::RBRACKET)) {
-                return std::unique_ptr<ASTSuffix>(new ASTIndexSuffix(next.fOffset));
+                return std::unique_ptr<ASTSuffix>(new (fArena) ASTIndexSuffix(next.fOffset));
             }
             std::unique_ptr<ASTExpression> e = this->expression();
             if (!e) {
                 return nullptr;
             }
             this->expect(Token::RBRACKET, "']' to complete array access expression");
-            return std::unique_ptr<ASTSuffix>(new ASTIndexSuffix(std::move(e)));
+            return std::unique_ptr<ASTSuffix>(new (fArena) ASTIndexSuffix(std::move(e)));
         }
         case Token::DOT: // fall through
         case Token::COLONCOLON: {
             int offset = this->peek().fOffset;
             StringFragment text;
             if (this->identifier(&text)) {
-                return std::unique_ptr<ASTSuffix>(new ASTFieldSuffix(offset, std::move(text)));
+                return std::unique_ptr<ASTSuffix>(new (fArena) ASTFieldSuffix(offset,
+                                                                              std::move(text)));
             }
             return nullptr;
         }
@@ -1796,15 +1811,15 @@ std::unique_ptr<ASTSuffix> Parser::suffix() {
                 }
             }
             this->expect(Token::RPAREN, "')' to complete function parameters");
-            return std::unique_ptr<ASTSuffix>(new ASTCallSuffix(next.fOffset,
-                                                                std::move(parameters)));
+            return std::unique_ptr<ASTSuffix>(new (fArena) ASTCallSuffix(next.fOffset,
+                                                                         std::move(parameters)));
         }
         case Token::PLUSPLUS:
-            return std::unique_ptr<ASTSuffix>(new ASTSuffix(next.fOffset,
-                                                            ASTSuffix::kPostIncrement_Kind));
+            return std::unique_ptr<ASTSuffix>(new (fArena) ASTSuffix(
+                    next.fOffset, ASTSuffix::kPostIncrement_Kind));
         case Token::MINUSMINUS:
-            return std::unique_ptr<ASTSuffix>(new ASTSuffix(next.fOffset,
-                                                            ASTSuffix::kPostDecrement_Kind));
+            return std::unique_ptr<ASTSuffix>(new (fArena) ASTSuffix(
+                    next.fOffset, ASTSuffix::kPostDecrement_Kind));
         default: {
             this->error(next,  "expected expression suffix, but found '" + this->text(next) +
                                          "'\n");
@@ -1821,21 +1836,21 @@ std::unique_ptr<ASTExpression> Parser::term() {
         case Token::IDENTIFIER: {
             StringFragment text;
             if (this->identifier(&text)) {
-                result.reset(new ASTIdentifier(t.fOffset, std::move(text)));
+                result.reset(new (fArena) ASTIdentifier(t.fOffset, std::move(text)));
             }
             break;
         }
         case Token::INT_LITERAL: {
             int64_t i;
             if (this->intLiteral(&i)) {
-                result.reset(new ASTIntLiteral(t.fOffset, i));
+                result.reset(new (fArena) ASTIntLiteral(t.fOffset, i));
             }
             break;
         }
         case Token::FLOAT_LITERAL: {
             double f;
             if (this->floatLiteral(&f)) {
-                result.reset(new ASTFloatLiteral(t.fOffset, f));
+                result.reset(new (fArena) ASTFloatLiteral(t.fOffset, f));
             }
             break;
         }
@@ -1843,7 +1858,7 @@ std::unique_ptr<ASTExpression> Parser::term() {
         case Token::FALSE_LITERAL: {
             bool b;
             if (this->boolLiteral(&b)) {
-                result.reset(new ASTBoolLiteral(t.fOffset, b));
+                result.reset(new (fArena) ASTBoolLiteral(t.fOffset, b));
             }
             break;
         }
@@ -13,6 +13,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include "SkSLErrorReporter.h"
+#include "ast/SkSLASTNode.h"
 #include "ir/SkSLLayout.h"
 #include "SkSLLexer.h"
 #include "SkSLLayoutLexer.h"
@@ -48,11 +49,13 @@ struct Modifiers;
 class SymbolTable;
 
 /**
- * Consumes .sksl text and produces an abstract syntax tree describing the contents.
+ * Consumes .sksl text and produces an abstract syntax tree describing the contents. The nodes of
+ * the tree are allocated from 'arena', which must outlive them.
  */
 class Parser {
 public:
-    Parser(const char* text, size_t length, SymbolTable& types, ErrorReporter& errors);
+    Parser(const char* text, size_t length, SymbolTable& types, ErrorReporter& errors,
+           ASTArena* arena);
 
     /**
      * Consumes a complete .sksl file and produces a list of declarations. Errors are reported via
@@ -240,6 +243,7 @@ private:
     Token fPushback;
     SymbolTable& fTypes;
     ErrorReporter& fErrors;
+    ASTArena* fArena;
 
     friend class AutoDepth;
     friend class HCodeGenerator;
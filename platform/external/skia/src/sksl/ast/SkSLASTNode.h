@@ -8,18 +8,53 @@
 #ifndef SKSL_ASTNODE
 #define SKSL_ASTNODE
 
+#include <cstddef>
 #include "SkSLString.h"
 
+#ifndef SKSL_STANDALONE
+#include "SkArenaAlloc.h"
+#endif
+
 namespace SkSL {
 
+#ifdef SKSL_STANDALONE
+// skslc does not link against Skia's core, so its AST nodes come straight from the heap.
+struct ASTArena {
+    explicit ASTArena(size_t) {}
+};
+#else
+typedef SkArenaAlloc ASTArena;
+#endif
+
 /**
  * Represents a node in the abstract syntax tree (AST). The AST is based directly on the parse tree;
  * it is a parsed-but-not-yet-analyzed version of the program.
+ *
+ * Nodes are allocated by the Parser out of an ASTArena that must outlive the tree. Deleting a node
+ * runs its destructor, but its memory is only released when the arena is.
  */
 struct ASTNode {
     virtual ~ASTNode() {}
 
     virtual String description() const = 0;
+
+    static void* operator new(size_t size, ASTArena* arena) {
+#ifdef SKSL_STANDALONE
+        return ::operator new(size);
+#else
+        return arena->makeBytesAlignedTo(size, alignof(std::max_align_t));
+#endif
+    }
+
+    static void operator delete(void* ptr, ASTArena*) {
+        ASTNode::operator delete(ptr);
+    }
+
+    static void operator delete(void* ptr) {
+#ifdef SKSL_STANDALONE
+        ::operator delete(ptr);
+#endif
+    }
 };
 
 } // namespace
@@ -19,6 +19,10 @@ std::unique_ptr<SkCanvas> SkSVGCanvas::Make(const SkRect& bounds, SkXMLWriter* w
 }
 
 std::unique_ptr<SkCanvas> SkSVGCanvas::Make(const SkRect& bounds, SkWStream* writer) {
-    SkXMLStreamWriter xmlWriter(writer);
-    return Make(bounds, &xmlWriter);
+    // The device owns the xml writer, which must outlive every draw into the canvas.
+    SkISize size = bounds.roundOut().size();
+    sk_sp<SkBaseDevice> device(SkSVGDevice::Create(size,
+                                                   skstd::make_unique<SkXMLStreamWriter>(writer)));
+
+    return skstd::make_unique<SkCanvas>(device.get());
 }
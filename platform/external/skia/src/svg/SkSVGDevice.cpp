@@ -15,9 +15,12 @@
 #include "SkClipStack.h"
 #include "SkData.h"
 #include "SkDraw.h"
+#include "SkFloatToDecimal.h"
 #include "SkImageEncoder.h"
+#include "SkOpts.h"
 #include "SkPaint.h"
 #include "SkParsePath.h"
+#include "SkPathPriv.h"
 #include "SkShader.h"
 #include "SkStream.h"
 #include "SkTHash.h"
@@ -25,8 +28,27 @@
 #include "SkUtils.h"
 #include "SkXMLWriter.h"
 
+#include <vector>
+
 namespace {
 
+// Writes the shortest decimal that reads back as exactly the same float.
+static void append_scalar(SkString* str, SkScalar value) {
+    char buffer[kMaximumSkFloatToDecimalLength];
+    str->append(buffer, SkFloatToDecimal(value, buffer));
+}
+
+static SkString svg_scalars(std::initializer_list<SkScalar> values) {
+    SkString str;
+    for (SkScalar value : values) {
+        if (!str.isEmpty()) {
+            str.append(" ");
+        }
+        append_scalar(&str, value);
+    }
+    return str;
+}
+
 static SkString svg_color(SkColor color) {
     return SkStringPrintf("rgb(%u,%u,%u)",
                           SkColorGetR(color),
@@ -86,20 +108,20 @@ static SkString svg_transform(const SkMatrix& t) {
         SkDebugf("Can't handle perspective matrices.");
         break;
     case SkMatrix::kTranslate_Mask:
-        tstr.printf("translate(%g %g)", t.getTranslateX(), t.getTranslateY());
+        tstr.printf("translate(%s)",
+                    svg_scalars({ t.getTranslateX(), t.getTranslateY() }).c_str());
         break;
     case SkMatrix::kScale_Mask:
-        tstr.printf("scale(%g %g)", t.getScaleX(), t.getScaleY());
+        tstr.printf("scale(%s)", svg_scalars({ t.getScaleX(), t.getScaleY() }).c_str());
         break;
     default:
         // http://www.w3.org/TR/SVG/coords.html#TransformMatrixDefined
         //    | a c e |
         //    | b d f |
         //    | 0 0 1 |
-        tstr.printf("matrix(%g %g %g %g %g %g)",
-                    t.getScaleX(),     t.getSkewY(),
-                    t.getSkewX(),      t.getScaleY(),
-                    t.getTranslateX(), t.getTranslateY());
+        tstr.printf("matrix(%s)", svg_scalars({ t.getScaleX(),     t.getSkewY(),
+                                                t.getSkewX(),      t.getScaleY(),
+                                                t.getTranslateX(), t.getTranslateY() }).c_str());
         break;
     }
 
@@ -165,12 +187,12 @@ public:
 
         if (scalarsPerPos < 2) {
             SkASSERT(fPosY.isEmpty());
-            fPosY.appendScalar(offset.y()); // DrawText or DrawPosTextH (fixed Y).
+            append_scalar(&fPosY, offset.y()); // DrawText or DrawPosTextH (fixed Y).
         }
 
         if (scalarsPerPos < 1) {
             SkASSERT(fPosX.isEmpty());
-            fPosX.appendScalar(offset.x()); // DrawText (X also fixed).
+            append_scalar(&fPosX, offset.x()); // DrawText (X also fixed).
         }
     }
 
@@ -227,10 +249,12 @@ private:
 
     void advancePos(bool discard) {
         if (!discard && fScalarsPerPos > 0) {
-            fPosX.appendf("%.8g, ", fOffset.x() + fPos[0]);
+            append_scalar(&fPosX, fOffset.x() + fPos[0]);
+            fPosX.append(", ");
             if (fScalarsPerPos > 1) {
                 SkASSERT(fScalarsPerPos == 2);
-                fPosY.appendf("%.8g, ", fOffset.y() + fPos[1]);
+                append_scalar(&fPosY, fOffset.y() + fPos[1]);
+                fPosY.append(", ");
             }
         }
         fPos += fScalarsPerPos;
@@ -246,11 +270,13 @@ private:
 
 }
 
-// For now all this does is serve unique serial IDs, but it will eventually evolve to track
-// and deduplicate resources.
+// Serves unique serial IDs, and remembers the paths and images already written so that repeats
+// can refer back to them with <use>. Only so many of each are remembered, so memory stays bounded
+// however long the document gets.
 class SkSVGDevice::ResourceBucket : ::SkNoncopyable {
 public:
-    ResourceBucket() : fGradientCount(0), fClipCount(0), fPathCount(0), fImageCount(0) {}
+    ResourceBucket()
+        : fGradientCount(0), fClipCount(0), fPathCount(0), fImageCount(0), fTrackedPathCount(0) {}
 
     SkString addLinearGradient() {
         return SkStringPrintf("gradient_%d", fGradientCount++);
@@ -264,15 +290,94 @@ public:
         return SkStringPrintf("path_%d", fPathCount++);
     }
 
-    SkString addImage() {
-        return SkStringPrintf("img_%d", fImageCount++);
+    SkString addImage(const SkBitmap& bitmap) {
+        SkString id = SkStringPrintf("img_%d", fImageCount++);
+        if (fImages.count() < kMaxTrackedImages) {
+            fImages.set(ImageKey::Make(bitmap), id);
+        }
+        return id;
+    }
+
+    // Returns the id of an image already written with these pixels, or nullptr.
+    const SkString* findImage(const SkBitmap& bitmap) const {
+        return fImages.find(ImageKey::Make(bitmap));
+    }
+
+    // Returns false the first time a path is seen, when it should just be written inline.
+    // After that, returns true with the id of the path's <defs> entry, setting *define when the
+    // caller has yet to write that entry.
+    bool findPath(const SkPath& path, SkString* id, bool* define) {
+        if (path.isVolatile() || path.countPoints() < kMinSharedPathPoints) {
+            return false;
+        }
+
+        const uint32_t hash = path_hash(path);
+        std::vector<PathEntry>* entries = fPaths.find(hash);
+        if (entries) {
+            for (PathEntry& entry : *entries) {
+                if (entry.fPath == path) {
+                    *define = entry.fID < 0;
+                    if (*define) {
+                        entry.fID = fPathCount++;
+                    }
+                    id->printf("path_%d", entry.fID);
+                    return true;
+                }
+            }
+        }
+
+        if (fTrackedPathCount < kMaxTrackedPaths) {
+            if (!entries) {
+                entries = fPaths.set(hash, std::vector<PathEntry>());
+            }
+            entries->push_back({ path, -1 });
+            fTrackedPathCount++;
+        }
+        return false;
     }
 
 private:
+    // A <use> costs about as much as the data of a path this short.
+    static constexpr int kMinSharedPathPoints = 4;
+    static constexpr int kMaxTrackedPaths     = 4096;
+    static constexpr int kMaxTrackedImages    = 256;
+
+    struct PathEntry {
+        SkPath fPath;
+        int    fID;     // -1 until the path has a <defs> entry
+    };
+
+    struct ImageKey {
+        static ImageKey Make(const SkBitmap& bitmap) {
+            return { bitmap.getGenerationID(), bitmap.pixelRefOrigin(), bitmap.dimensions() };
+        }
+
+        bool operator==(const ImageKey& other) const {
+            return fGenID == other.fGenID && fOrigin == other.fOrigin && fSize == other.fSize;
+        }
+
+        uint32_t fGenID;
+        SkIPoint fOrigin;
+        SkISize  fSize;
+    };
+
+    static uint32_t path_hash(const SkPath& path) {
+        uint32_t hash = SkOpts::hash(SkPathPriv::PointData(path),
+                                     path.countPoints() * sizeof(SkPoint));
+        hash = SkOpts::hash(SkPathPriv::VerbData(path), path.countVerbs(), hash);
+        return SkOpts::hash(SkPathPriv::ConicWeightData(path),
+                            SkPathPriv::ConicWeightCnt(path) * sizeof(SkScalar),
+                            hash ^ path.getFillType());
+    }
+
     uint32_t fGradientCount;
     uint32_t fClipCount;
     uint32_t fPathCount;
     uint32_t fImageCount;
+
+    SkTHashMap<uint32_t, std::vector<PathEntry>> fPaths;
+    int                                          fTrackedPathCount;
+    SkTHashMap<ImageKey, SkString>               fImages;
 };
 
 struct SkSVGDevice::MxCp {
@@ -330,7 +435,9 @@ public:
     }
 
     void addAttribute(const char name[], SkScalar val) {
-        fWriter->addScalarAttribute(name, val);
+        SkString str;
+        append_scalar(&str, val);
+        fWriter->addAttribute(name, str.c_str());
     }
 
     void addText(const SkString& text) {
@@ -591,12 +698,23 @@ SkBaseDevice* SkSVGDevice::Create(const SkISize& size, SkXMLWriter* writer) {
         return nullptr;
     }
 
-    return new SkSVGDevice(size, writer);
+    return new SkSVGDevice(size, writer, nullptr);
+}
+
+SkBaseDevice* SkSVGDevice::Create(const SkISize& size, std::unique_ptr<SkXMLWriter> writer) {
+    if (!writer) {
+        return nullptr;
+    }
+
+    SkXMLWriter* writerPtr = writer.get();
+    return new SkSVGDevice(size, writerPtr, std::move(writer));
 }
 
-SkSVGDevice::SkSVGDevice(const SkISize& size, SkXMLWriter* writer)
+SkSVGDevice::SkSVGDevice(const SkISize& size, SkXMLWriter* writer,
+                         std::unique_ptr<SkXMLWriter> owned)
     : INHERITED(SkImageInfo::MakeUnknown(size.fWidth, size.fHeight),
                 SkSurfaceProps(0, kUnknown_SkPixelGeometry))
+    , fOwnedWriter(std::move(owned))
     , fWriter(writer)
     , fResourceBucket(new ResourceBucket)
 {
@@ -695,12 +813,30 @@ void SkSVGDevice::drawRRect(const SkRRect& rr, const SkPaint& paint) {
     SkPath path;
     path.addRRect(rr);
 
-    AutoElement elem("path", fWriter, fResourceBucket.get(), MxCp(this), paint);
-    elem.addPathAttributes(path);
+    this->drawPath(path, paint);
 }
 
 void SkSVGDevice::drawPath(const SkPath& path, const SkPaint& paint,
                            const SkMatrix* prePathMatrix, bool pathIsMutable) {
+    SkString pathID;
+    bool define;
+    if (fResourceBucket->findPath(path, &pathID, &define)) {
+        // Repeated paths are defined once, without paint or transform, and then referenced.
+        if (define) {
+            AutoElement defs("defs", fWriter);
+            AutoElement pathElement("path", fWriter);
+            pathElement.addAttribute("id", pathID);
+            pathElement.addPathAttributes(path);
+            if (path.getFillType() == SkPath::kEvenOdd_FillType) {
+                pathElement.addAttribute("fill-rule", "evenodd");
+            }
+        }
+
+        AutoElement pathUse("use", fWriter, fResourceBucket.get(), MxCp(this), paint);
+        pathUse.addAttribute("xlink:href", SkStringPrintf("#%s", pathID.c_str()));
+        return;
+    }
+
     AutoElement elem("path", fWriter, fResourceBucket.get(), MxCp(this), paint);
     elem.addPathAttributes(path);
 
@@ -716,6 +852,12 @@ static sk_sp<SkData> encode(const SkBitmap& src) {
 }
 
 void SkSVGDevice::drawBitmapCommon(const MxCp& mc, const SkBitmap& bm, const SkPaint& paint) {
+    if (const SkString* imageID = fResourceBucket->findImage(bm)) {
+        AutoElement imageUse("use", fWriter, fResourceBucket.get(), mc, paint);
+        imageUse.addAttribute("xlink:href", SkStringPrintf("#%s", imageID->c_str()));
+        return;
+    }
+
     sk_sp<SkData> pngData = encode(bm);
     if (!pngData) {
         return;
@@ -728,7 +870,7 @@ void SkSVGDevice::drawBitmapCommon(const MxCp& mc, const SkBitmap& bm, const SkP
     SkString svgImageData("data:image/png;base64,");
     svgImageData.append(b64Data.get(), b64Size);
 
-    SkString imageID = fResourceBucket->addImage();
+    SkString imageID = fResourceBucket->addImage(bm);
     {
         AutoElement defs("defs", fWriter);
         {
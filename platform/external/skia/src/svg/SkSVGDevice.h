@@ -17,6 +17,11 @@ class SkSVGDevice : public SkClipStackDevice {
 public:
     static SkBaseDevice* Create(const SkISize& size, SkXMLWriter* writer);
 
+    /**
+     *  As above, but the device owns the writer, and closes the document when it goes away.
+     */
+    static SkBaseDevice* Create(const SkISize& size, std::unique_ptr<SkXMLWriter> writer);
+
 protected:
     void drawPaint(const SkPaint& paint) override;
     void drawAnnotation(const SkRect& rect, const char key[], SkData* value) override;
@@ -51,7 +56,7 @@ protected:
                     const SkPaint&) override;
 
 private:
-    SkSVGDevice(const SkISize& size, SkXMLWriter* writer);
+    SkSVGDevice(const SkISize& size, SkXMLWriter* writer, std::unique_ptr<SkXMLWriter> owned);
     ~SkSVGDevice() override;
 
     struct MxCp;
@@ -60,6 +65,8 @@ private:
     class AutoElement;
     class ResourceBucket;
 
+    // Declared before fRootElement, so that the root <svg> is closed while the writer lives.
+    std::unique_ptr<SkXMLWriter>    fOwnedWriter;
     SkXMLWriter*                    fWriter;
     std::unique_ptr<AutoElement>    fRootElement;
     std::unique_ptr<ResourceBucket> fResourceBucket;
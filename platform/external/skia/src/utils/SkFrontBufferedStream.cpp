@@ -39,6 +39,9 @@ private:
     size_t                    fBufferedSoFar;
     // Total size of the buffer.
     const size_t              fBufferSize;
+    // Where the stream's bytes already are, if it is in memory. Then there is no need to copy
+    // them into fBuffer, and out of it again.
+    const char* const         fMemory;
     // FIXME: SkAutoTMalloc throws on failure. Instead, Create should return a
     // nullptr stream.
     SkAutoTMalloc<char>       fBuffer;
@@ -50,7 +53,8 @@ private:
 
     // Buffer up to size bytes from the stream, and copy to dst if non-
     // nullptr. Updates fOffset and fBufferedSoFar. Assumes that fOffset is
-    // less than fBufferedSoFar, and size is greater than 0.
+    // less than fBufferedSoFar, and size is greater than 0. If the stream
+    // is in memory, this reads straight into dst instead.
     size_t bufferAndWriteTo(char* dst, size_t size);
 
     // Read up to size bytes directly from the stream and into dst if non-
@@ -70,6 +74,13 @@ std::unique_ptr<SkStreamRewindable> SkFrontBufferedStream::Make(std::unique_ptr<
                                                                        bufferSize));
 }
 
+static const char* memory_at_position(SkStream* stream) {
+    if (!stream->getMemoryBase() || !stream->hasPosition()) {
+        return nullptr;
+    }
+    return static_cast<const char*>(stream->getMemoryBase()) + stream->getPosition();
+}
+
 FrontBufferedStream::FrontBufferedStream(std::unique_ptr<SkStream> stream, size_t bufferSize)
     : fStream(std::move(stream))
     , fHasLength(fStream->hasPosition() && fStream->hasLength())
@@ -77,7 +88,8 @@ FrontBufferedStream::FrontBufferedStream(std::unique_ptr<SkStream> stream, size_
     , fOffset(0)
     , fBufferedSoFar(0)
     , fBufferSize(bufferSize)
-    , fBuffer(bufferSize) {}
+    , fMemory(memory_at_position(fStream.get()))
+    , fBuffer(fMemory ? 0 : bufferSize) {}
 
 bool FrontBufferedStream::isAtEnd() const {
     if (fOffset < fBufferedSoFar) {
@@ -105,7 +117,7 @@ size_t FrontBufferedStream::readFromBuffer(char* dst, size_t size) {
     // data.
     const size_t bytesToCopy = SkTMin(size, fBufferedSoFar - fOffset);
     if (dst != nullptr) {
-        memcpy(dst, fBuffer + fOffset, bytesToCopy);
+        memcpy(dst, (fMemory ? fMemory : fBuffer.get()) + fOffset, bytesToCopy);
     }
 
     // Update fOffset to the new position. It is guaranteed to be
@@ -119,10 +131,18 @@ size_t FrontBufferedStream::readFromBuffer(char* dst, size_t size) {
 size_t FrontBufferedStream::bufferAndWriteTo(char* dst, size_t size) {
     SkASSERT(size > 0);
     SkASSERT(fOffset >= fBufferedSoFar);
-    SkASSERT(fBuffer);
+    SkASSERT(fBuffer || fMemory);
     // Data needs to be buffered. Buffer up to the lesser of the size requested
     // and the remainder of the max buffer size.
     const size_t bytesToBuffer = SkTMin(size, fBufferSize - fBufferedSoFar);
+    if (fMemory) {
+        // The bytes stay where they are, so only the destination needs them.
+        const size_t buffered = fStream->read(dst, bytesToBuffer);
+        fBufferedSoFar += buffered;
+        fOffset = fBufferedSoFar;
+        SkASSERT(fBufferedSoFar <= fBufferSize);
+        return buffered;
+    }
     char* buffer = fBuffer + fOffset;
     const size_t buffered = fStream->read(buffer, bytesToBuffer);
 
@@ -7,6 +7,7 @@
 
 #include "SkInsetConvexPolygon.h"
 
+#include "SkNx.h"
 #include "SkPointPriv.h"
 #include "SkTemplates.h"
 
@@ -162,6 +163,102 @@ static bool is_convex(const SkTDArray<SkPoint>& poly) {
     return true;
 }
 
+struct EdgeData {
+    InsetSegment fInset;
+    SkPoint      fIntersection;
+    SkScalar     fTValue;
+    bool         fValid;
+};
+
+static void init_edge(EdgeData* edge) {
+    edge->fIntersection = edge->fInset.fP0;
+    edge->fTValue = SK_ScalarMin;
+    edge->fValid = true;
+}
+
+// Checks that the corner at vertex 'i + 1' turns the right way, and insets the edge from 'i',
+// the same way as SkOffsetSegment.
+static bool inset_edge(const SkPoint* polygonVerts, int polygonSize, int winding, int i,
+                       SkScalar d0, SkScalar d1, EdgeData* edge) {
+    int j = (i + 1) % polygonSize;
+    int k = (i + 2) % polygonSize;
+    // check for convexity just to be sure
+    if (compute_side(polygonVerts[i], polygonVerts[j], polygonVerts[k])*winding < 0) {
+        return false;
+    }
+    SkOffsetSegment(polygonVerts[i], polygonVerts[j], d0, d1, winding,
+                    &edge->fInset.fP0, &edge->fInset.fP1);
+    init_edge(edge);
+    return true;
+}
+
+// Insets the edges by the same distance, four at a time. This gives the same results as
+// inset_edge().
+static bool inset_edges(const SkPoint* polygonVerts, int polygonSize, int winding,
+                        SkScalar inset, EdgeData* edgeData) {
+    int i = 0;
+    for (; i + 4 <= polygonSize; i += 4) {
+        float x0[4], y0[4], x1[4], y1[4], x2[4], y2[4];
+        for (int lane = 0; lane < 4; ++lane) {
+            const SkPoint& p0 = polygonVerts[i + lane];
+            const SkPoint& p1 = polygonVerts[(i + lane + 1) % polygonSize];
+            const SkPoint& p2 = polygonVerts[(i + lane + 2) % polygonSize];
+            x0[lane] = p0.fX; y0[lane] = p0.fY;
+            x1[lane] = p1.fX; y1[lane] = p1.fY;
+            x2[lane] = p2.fX; y2[lane] = p2.fY;
+        }
+        Sk4f px0 = Sk4f::Load(x0), py0 = Sk4f::Load(y0),
+             px1 = Sk4f::Load(x1), py1 = Sk4f::Load(y1),
+             px2 = Sk4f::Load(x2), py2 = Sk4f::Load(y2);
+
+        // The corners must all turn the same way (see compute_side()).
+        Sk4f perpDot = ((px1 - px0)*(py2 - py0) - (py1 - py0)*(px2 - px0)) * (float)winding;
+        if ((perpDot < -SK_ScalarNearlyZero).anyTrue()) {
+            return false;
+        }
+
+        // Scale the perpendiculars to the inset distance, as SkPoint::setLength() does.
+        Sk4f perpX = py0 - py1,
+             perpY = px1 - px0;
+        Sk4f mag2 = perpX*perpX + perpY*perpY;
+        if (!(mag2 < SK_ScalarInfinity).allTrue()) {
+            // Too big to square, let the scalar code handle it.
+            for (int lane = 0; lane < 4; ++lane) {
+                if (!inset_edge(polygonVerts, polygonSize, winding, i + lane, inset, inset,
+                                &edgeData[i + lane])) {
+                    return false;
+                }
+            }
+            continue;
+        }
+        Sk4f scale = (mag2 <= SK_ScalarNearlyZero*SK_ScalarNearlyZero).thenElse(
+                0, (inset*winding) / mag2.sqrt());
+        perpX = perpX * scale;
+        perpY = perpY * scale;
+
+        float ix0[4], iy0[4], ix1[4], iy1[4];
+        (px0 + perpX).store(ix0);
+        (py0 + perpY).store(iy0);
+        (px1 + perpX).store(ix1);
+        (py1 + perpY).store(iy1);
+        for (int lane = 0; lane < 4; ++lane) {
+            EdgeData* edge = &edgeData[i + lane];
+            edge->fInset.fP0.set(ix0[lane], iy0[lane]);
+            edge->fInset.fP1.set(ix1[lane], iy1[lane]);
+            init_edge(edge);
+        }
+    }
+    for (; i < polygonSize; ++i) {
+        if (!inset_edge(polygonVerts, polygonSize, winding, i, inset, inset, &edgeData[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool intersect_inset_edges(EdgeData* edgeData, int inputPolygonSize, int winding,
+                                  SkTDArray<SkPoint>* insetPolygon);
+
 // The objective here is to inset all of the edges by the given distance, and then
 // remove any invalid inset edges by detecting right-hand turns. In a ccw polygon,
 // we should only be making left-hand turns (for cw polygons, we use the winding
@@ -187,31 +284,38 @@ bool SkInsetConvexPolygon(const SkPoint* inputPolygonVerts, int inputPolygonSize
     }
 
     // set up
-    struct EdgeData {
-        InsetSegment fInset;
-        SkPoint      fIntersection;
-        SkScalar     fTValue;
-        bool         fValid;
-    };
-
     SkAutoSTMalloc<64, EdgeData> edgeData(inputPolygonSize);
     for (int i = 0; i < inputPolygonSize; ++i) {
-        int j = (i + 1) % inputPolygonSize;
-        int k = (i + 2) % inputPolygonSize;
-        // check for convexity just to be sure
-        if (compute_side(inputPolygonVerts[i], inputPolygonVerts[j],
-                         inputPolygonVerts[k])*winding < 0) {
+        if (!inset_edge(inputPolygonVerts, inputPolygonSize, winding, i, insetDistanceFunc(i),
+                        insetDistanceFunc((i + 1) % inputPolygonSize), &edgeData[i])) {
             return false;
         }
-        SkOffsetSegment(inputPolygonVerts[i], inputPolygonVerts[j],
-                        insetDistanceFunc(i), insetDistanceFunc(j),
-                        winding,
-                        &edgeData[i].fInset.fP0, &edgeData[i].fInset.fP1);
-        edgeData[i].fIntersection = edgeData[i].fInset.fP0;
-        edgeData[i].fTValue = SK_ScalarMin;
-        edgeData[i].fValid = true;
     }
 
+    return intersect_inset_edges(edgeData.get(), inputPolygonSize, winding, insetPolygon);
+}
+
+bool SkInsetConvexPolygon(const SkPoint* inputPolygonVerts, int inputPolygonSize,
+                          SkScalar inset, SkTDArray<SkPoint>* insetPolygon) {
+    if (inputPolygonSize < 3) {
+        return false;
+    }
+
+    int winding = get_winding(inputPolygonVerts, inputPolygonSize);
+    if (0 == winding) {
+        return false;
+    }
+
+    SkAutoSTMalloc<64, EdgeData> edgeData(inputPolygonSize);
+    if (!inset_edges(inputPolygonVerts, inputPolygonSize, winding, inset, edgeData.get())) {
+        return false;
+    }
+
+    return intersect_inset_edges(edgeData.get(), inputPolygonSize, winding, insetPolygon);
+}
+
+static bool intersect_inset_edges(EdgeData* edgeData, int inputPolygonSize, int winding,
+                                  SkTDArray<SkPoint>* insetPolygon) {
     int prevIndex = inputPolygonSize - 1;
     int currIndex = 0;
     int insetVertexCount = inputPolygonSize;
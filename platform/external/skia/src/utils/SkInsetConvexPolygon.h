@@ -28,13 +28,11 @@ bool SkInsetConvexPolygon(const SkPoint* inputPolygonVerts, int inputPolygonSize
                           std::function<SkScalar(int index)> insetDistanceFunc,
                           SkTDArray<SkPoint>* insetPolygon);
 
-inline bool SkInsetConvexPolygon(const SkPoint* inputPolygonVerts, int inputPolygonSize,
-                                 SkScalar inset,
-                                 SkTDArray<SkPoint>* insetPolygon) {
-    return SkInsetConvexPolygon(inputPolygonVerts, inputPolygonSize,
-                                [inset](int) { return inset; },
-                                insetPolygon);
-}
+/**
+ * The same, for an inset that is the same everywhere. The edges are offset several at a time.
+ */
+bool SkInsetConvexPolygon(const SkPoint* inputPolygonVerts, int inputPolygonSize,
+                          SkScalar inset, SkTDArray<SkPoint>* insetPolygon);
 
 /**
  * Offset a segment by the given distance at each point.
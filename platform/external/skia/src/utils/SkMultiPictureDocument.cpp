@@ -13,6 +13,7 @@
 #include "SkSerialProcs.h"
 #include "SkStream.h"
 #include "SkTArray.h"
+#include "SkTaskGroup.h"
 
 #include <limits.h>
 
@@ -20,13 +21,19 @@
   File format:
       BEGINNING_OF_FILE:
         kMagic
-        uint32_t version_number (==2)
+        uint32_t version_number (==3)
         uint32_t page_count
         {
           float sizeX
           float sizeY
         } * page_count
-        skp file
+        {
+          uint32_t skp_size
+          skp file, padded to a multiple of 4 bytes
+        } * page_count
+
+  Version 2, which can still be read, has one skp file in place of the pages, which draws each
+  page as a picture followed by a kEndPage annotation.
 */
 
 namespace {
@@ -35,25 +42,20 @@ static constexpr char kMagic[] = "Skia Multi-Picture Doc\n\n";
 
 static constexpr char kEndPage[] = "SkMultiPictureEndPage";
 
-const uint32_t kVersion = 2;
-
-static SkSize join(const SkTArray<SkSize>& sizes) {
-    SkSize joined = {0, 0};
-    for (SkSize s : sizes) {
-        joined = SkSize{SkTMax(joined.width(), s.width()), SkTMax(joined.height(), s.height())};
-    }
-    return joined;
-}
+const uint32_t kVersion = 3;
+const uint32_t kJoinedPagesVersion = 2;
 
 struct MultiPictureDocument final : public SkDocument {
     const SkSerialProcs fProcs;
+    const bool fParallel;
     SkPictureRecorder fPictureRecorder;
     SkSize fCurrentPageSize;
     SkTArray<sk_sp<SkPicture>> fPages;
     SkTArray<SkSize> fSizes;
-    MultiPictureDocument(SkWStream* s, const SkSerialProcs* procs)
+    MultiPictureDocument(SkWStream* s, const SkSerialProcs* procs, bool parallel)
         : SkDocument(s)
         , fProcs(procs ? *procs : SkSerialProcs())
+        , fParallel(parallel)
     {}
     ~MultiPictureDocument() override { this->close(); }
 
@@ -74,14 +76,24 @@ struct MultiPictureDocument final : public SkDocument {
         for (SkSize s : fSizes) {
             wStream->write(&s, sizeof(s));
         }
-        SkSize bigsize = join(fSizes);
-        SkCanvas* c = fPictureRecorder.beginRecording(SkRect::MakeSize(bigsize));
-        for (const sk_sp<SkPicture>& page : fPages) {
-            c->drawPicture(page);
-            c->drawAnnotation(SkRect::MakeEmpty(), kEndPage, nullptr);
+        // Each page is serialized on its own, so they can be serialized (and read back) in
+        // parallel.
+        SkTArray<sk_sp<SkData>> pageData(fPages.count());
+        pageData.push_back_n(fPages.count());
+        auto serialize = [&](int i) { pageData[i] = fPages[i]->serialize(&fProcs); };
+        if (fParallel) {
+            SkTaskGroup().batch(fPages.count(), serialize);
+        } else {
+            for (int i = 0; i < fPages.count(); ++i) {
+                serialize(i);
+            }
+        }
+        static const char kPadding[4] = { 0, 0, 0, 0 };
+        for (const sk_sp<SkData>& data : pageData) {
+            wStream->write32(SkToU32(data->size()));
+            wStream->write(data->data(), data->size());
+            wStream->write(kPadding, SkAlign4(data->size()) - data->size());
         }
-        sk_sp<SkPicture> p = fPictureRecorder.finishRecordingAsPicture();
-        p->serialize(wStream, &fProcs);
         fPages.reset();
         fSizes.reset();
         return;
@@ -93,13 +105,14 @@ struct MultiPictureDocument final : public SkDocument {
 };
 }
 
-sk_sp<SkDocument> SkMakeMultiPictureDocument(SkWStream* wStream, const SkSerialProcs* procs) {
-    return sk_make_sp<MultiPictureDocument>(wStream, procs);
+sk_sp<SkDocument> SkMakeMultiPictureDocument(SkWStream* wStream, const SkSerialProcs* procs,
+                                             bool parallel) {
+    return sk_make_sp<MultiPictureDocument>(wStream, procs, parallel);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-int SkMultiPictureDocumentReadPageCount(SkStreamSeekable* stream) {
+static int read_page_count(SkStreamSeekable* stream, uint32_t* version) {
     if (!stream) {
         return 0;
     }
@@ -111,24 +124,24 @@ int SkMultiPictureDocumentReadPageCount(SkStreamSeekable* stream) {
         return 0;
     }
     uint32_t versionNumber = stream->readU32();
-    if (versionNumber != kVersion) {
+    if (versionNumber != kVersion && versionNumber != kJoinedPagesVersion) {
         return 0;
     }
     uint32_t pageCount = stream->readU32();
     if (pageCount > INT_MAX) {
         return 0;
     }
+    *version = versionNumber;
     // leave stream position right here.
     return (int)pageCount;
 }
 
-bool SkMultiPictureDocumentReadPageSizes(SkStreamSeekable* stream,
-                                         SkDocumentPage* dstArray,
-                                         int dstArrayCount) {
+static bool read_page_sizes(SkStreamSeekable* stream, SkDocumentPage* dstArray, int dstArrayCount,
+                            uint32_t* version) {
     if (!dstArray || dstArrayCount < 1) {
         return false;
     }
-    int pageCount = SkMultiPictureDocumentReadPageCount(stream);
+    int pageCount = read_page_count(stream, version);
     if (pageCount < 1 || pageCount != dstArrayCount) {
         return false;
     }
@@ -142,6 +155,18 @@ bool SkMultiPictureDocumentReadPageSizes(SkStreamSeekable* stream,
     return true;
 }
 
+int SkMultiPictureDocumentReadPageCount(SkStreamSeekable* stream) {
+    uint32_t version;
+    return read_page_count(stream, &version);
+}
+
+bool SkMultiPictureDocumentReadPageSizes(SkStreamSeekable* stream,
+                                         SkDocumentPage* dstArray,
+                                         int dstArrayCount) {
+    uint32_t version;
+    return read_page_sizes(stream, dstArray, dstArrayCount, &version);
+}
+
 namespace {
 struct PagerCanvas : public SkNWayCanvas {
     SkPictureRecorder fRecorder;
@@ -173,13 +198,88 @@ struct PagerCanvas : public SkNWayCanvas {
 };
 }  // namespace
 
+// The size comes from the file, so without the stream's length to check it against, read in
+// chunks rather than allocate it all up front.
+static sk_sp<SkData> read_page_data(SkStream* stream, size_t size) {
+    if (stream->hasLength()) {
+        sk_sp<SkData> data = SkData::MakeUninitialized(size);
+        if (size != stream->read(data->writable_data(), size)) {
+            return nullptr;
+        }
+        return data;
+    }
+    SkDynamicMemoryWStream data;
+    char buffer[4096];
+    while (size > 0) {
+        const size_t chunk = SkTMin(size, sizeof(buffer));
+        if (chunk != stream->read(buffer, chunk)) {
+            return nullptr;
+        }
+        data.write(buffer, chunk);
+        size -= chunk;
+    }
+    return data.detachAsData();
+}
+
+static bool read_pages(SkStreamSeekable* stream,
+                       SkDocumentPage* dstArray,
+                       int dstArrayCount,
+                       const SkDeserialProcs* procs,
+                       bool parallel) {
+    // Find every page first, so that they can all be read in parallel. If the stream is in
+    // memory, read the pages where they are.
+    const char* memory = stream->hasLength() ? static_cast<const char*>(stream->getMemoryBase())
+                                             : nullptr;
+    SkTArray<sk_sp<SkData>> pageData(dstArrayCount);
+    for (int i = 0; i < dstArrayCount; ++i) {
+        uint32_t size;
+        if (sizeof(size) != stream->read(&size, sizeof(size)) ||
+            (stream->hasLength() && size > stream->getLength() - stream->getPosition())) {
+            return false;
+        }
+        if (memory) {
+            pageData.push_back(SkData::MakeWithoutCopy(memory + stream->getPosition(), size));
+            stream->skip(size);
+        } else {
+            pageData.push_back(read_page_data(stream, size));
+            if (!pageData.back()) {
+                return false;
+            }
+        }
+        stream->skip(SkAlign4(size) - size);
+    }
+
+    auto read = [&](int i) {
+        dstArray[i].fPicture = SkPicture::MakeFromData(pageData[i].get(), procs);
+    };
+    if (parallel) {
+        SkTaskGroup().batch(dstArrayCount, read);
+    } else {
+        for (int i = 0; i < dstArrayCount; ++i) {
+            read(i);
+        }
+    }
+    for (int i = 0; i < dstArrayCount; ++i) {
+        if (!dstArray[i].fPicture) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool SkMultiPictureDocumentRead(SkStreamSeekable* stream,
                                 SkDocumentPage* dstArray,
                                 int dstArrayCount,
-                                const SkDeserialProcs* procs) {
-    if (!SkMultiPictureDocumentReadPageSizes(stream, dstArray, dstArrayCount)) {
+                                const SkDeserialProcs* procs,
+                                bool parallel) {
+    uint32_t version;
+    if (!read_page_sizes(stream, dstArray, dstArrayCount, &version)) {
         return false;
     }
+    if (kVersion == version) {
+        return read_pages(stream, dstArray, dstArrayCount, procs, parallel);
+    }
+
     SkSize joined = {0.0f, 0.0f};
     for (int i = 0; i < dstArrayCount; ++i) {
         joined = SkSize{SkTMax(joined.width(), dstArray[i].fSize.width()),
@@ -16,8 +16,12 @@ class SkStreamSeekable;
 
 /**
  *  Writes into a file format that is similar to SkPicture::serialize()
+ *
+ *  If parallel is true, the pages are serialized in parallel on SkTaskGroup's threads, so the
+ *  procs must be safe to call from several threads at once.
  */
-SK_API sk_sp<SkDocument> SkMakeMultiPictureDocument(SkWStream* dst, const SkSerialProcs* = nullptr);
+SK_API sk_sp<SkDocument> SkMakeMultiPictureDocument(SkWStream* dst, const SkSerialProcs* = nullptr,
+                                                    bool parallel = false);
 
 struct SkDocumentPage {
     sk_sp<SkPicture> fPicture;
@@ -33,10 +37,15 @@ SK_API int SkMultiPictureDocumentReadPageCount(SkStreamSeekable* src);
  *  Read the SkMultiPictureDocument into the provided array of pages.
  *  dstArrayCount must equal SkMultiPictureDocumentReadPageCount().
  *  Return false on error.
+ *
+ *  If src is in memory, the pages are read where they are. If parallel is true, they are read in
+ *  parallel on SkTaskGroup's threads, so the procs must be safe to call from several threads at
+ *  once.
  */
 SK_API bool SkMultiPictureDocumentRead(SkStreamSeekable* src,
                                        SkDocumentPage* dstArray,
                                        int dstArrayCount,
-                                       const SkDeserialProcs* = nullptr);
+                                       const SkDeserialProcs* = nullptr,
+                                       bool parallel = false);
 
 #endif  // SkMultiPictureDocument_DEFINED
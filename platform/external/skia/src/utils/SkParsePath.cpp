@@ -4,6 +4,7 @@
  * Use of this source code is governed by a BSD-style license that can be
  * found in the LICENSE file.
  */
+#include "SkFloatToDecimal.h"
 #include "SkParse.h"
 #include "SkParsePath.h"
 
@@ -208,15 +209,10 @@ bool SkParsePath::FromSVGString(const char data[], SkPath* result) {
 #include "SkString.h"
 #include "SkStream.h"
 
+// The shortest decimal that parses back to exactly the same float.
 static void write_scalar(SkWStream* stream, SkScalar value) {
-    char buffer[64];
-#ifdef SK_BUILD_FOR_WIN
-    int len = _snprintf(buffer, sizeof(buffer), "%g", value);
-#else
-    int len = snprintf(buffer, sizeof(buffer), "%g", value);
-#endif
-    char* stop = buffer + len;
-    stream->write(buffer, stop - buffer);
+    char buffer[kMaximumSkFloatToDecimalLength];
+    stream->write(buffer, SkFloatToDecimal(value, buffer));
 }
 
 static void append_scalars(SkWStream* stream, char verb, const SkScalar data[],
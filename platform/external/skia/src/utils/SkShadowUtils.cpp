@@ -16,6 +16,7 @@
 #include "SkPM4f.h"
 #include "SkRandom.h"
 #include "SkRasterPipeline.h"
+#include "SkRRect.h"
 #include "SkResourceCache.h"
 #include "SkShadowTessellator.h"
 #include "SkString.h"
@@ -98,6 +99,12 @@ struct AmbientVerticesFactory {
         return true;
     }
 
+    // How far the vertices may be rotated and scaled to draw with another ctm. See
+    // CachedTessellations::Set::find().
+    SkScalar transformablePenumbra() const {
+        return SkDrawShadowMetrics::AmbientBlurRadius(fOccluderHeight);
+    }
+
     sk_sp<SkVertices> makeVertices(const SkPath& path, const SkMatrix& ctm,
                                    SkVector* translate) const {
         SkPoint3 zParams = SkPoint3::Make(0, 0, fOccluderHeight);
@@ -156,6 +163,17 @@ struct SpotVerticesFactory {
         return false;
     }
 
+    // How far the vertices may be rotated and scaled to draw with another ctm, or a negative
+    // value if they may not be. See CachedTessellations::Set::find().
+    SkScalar transformablePenumbra() const {
+        if (OccluderType::kOpaquePartialUmbra == fOccluderType) {
+            // The umbra is clipped against the occluder where the light puts it.
+            return -1;
+        }
+        return SkDrawShadowMetrics::SpotBlurRadius(fOccluderHeight, fDevLightPos.fZ,
+                                                   fLightRadius);
+    }
+
     sk_sp<SkVertices> makeVertices(const SkPath& path, const SkMatrix& ctm,
                                    SkVector* translate) const {
         bool transparent = OccluderType::kTransparent == fOccluderType;
@@ -179,6 +197,41 @@ struct SpotVerticesFactory {
     }
 };
 
+/**
+ * Computes the transform, without translation, from vertices made for 'cached' to ones for 'ctm'.
+ * Neither may have perspective. This succeeds if the transform is a rotation, possibly with a
+ * uniform scale that changes a penumbra 'penumbraWidth' wide by less than kMaxReuseError.
+ */
+static constexpr SkScalar kMaxReuseError = 0.25f;
+
+bool relative_similarity(const SkMatrix& cached, const SkMatrix& ctm, SkScalar penumbraWidth,
+                         SkMatrix* relative) {
+    if (penumbraWidth < 0) {
+        return false;
+    }
+    SkMatrix inverse;
+    inverse.setAll(cached.getScaleX(), cached.getSkewX(), 0,
+                   cached.getSkewY(), cached.getScaleY(), 0,
+                   0, 0, 1);
+    if (!inverse.invert(&inverse)) {
+        return false;
+    }
+    relative->setAll(ctm.getScaleX(), ctm.getSkewX(), 0,
+                     ctm.getSkewY(), ctm.getScaleY(), 0,
+                     0, 0, 1);
+    relative->preConcat(inverse);
+
+    // A similarity without reflection is [a -b; b a].
+    SkScalar a = relative->getScaleX(), b = relative->getSkewY();
+    SkScalar scale = SkScalarSqrt(a*a + b*b);
+    static constexpr SkScalar kSimilarityTolerance = 1.0f / 4096;
+    if (SkScalarAbs(relative->getScaleY() - a) + SkScalarAbs(relative->getSkewX() + b) >
+            kSimilarityTolerance*scale) {
+        return false;
+    }
+    return SkScalarAbs(scale - 1)*penumbraWidth <= kMaxReuseError;
+}
+
 /**
  * This manages a set of tessellations for a given shape in the cache. Because SkResourceCache
  * records are immutable this is not itself a Rec. When we need to update it we return this on
@@ -190,23 +243,23 @@ public:
     size_t size() const { return fAmbientSet.size() + fSpotSet.size(); }
 
     sk_sp<SkVertices> find(const AmbientVerticesFactory& ambient, const SkMatrix& matrix,
-                           SkVector* translate) const {
-        return fAmbientSet.find(ambient, matrix, translate);
+                           SkMatrix* transform) const {
+        return fAmbientSet.find(ambient, matrix, transform);
     }
 
     sk_sp<SkVertices> add(const SkPath& devPath, const AmbientVerticesFactory& ambient,
-                          const SkMatrix& matrix, SkVector* translate) {
-        return fAmbientSet.add(devPath, ambient, matrix, translate);
+                          const SkMatrix& matrix, SkMatrix* transform) {
+        return fAmbientSet.add(devPath, ambient, matrix, transform);
     }
 
     sk_sp<SkVertices> find(const SpotVerticesFactory& spot, const SkMatrix& matrix,
-                           SkVector* translate) const {
-        return fSpotSet.find(spot, matrix, translate);
+                           SkMatrix* transform) const {
+        return fSpotSet.find(spot, matrix, transform);
     }
 
     sk_sp<SkVertices> add(const SkPath& devPath, const SpotVerticesFactory& spot,
-                          const SkMatrix& matrix, SkVector* translate) {
-        return fSpotSet.add(devPath, spot, matrix, translate);
+                          const SkMatrix& matrix, SkMatrix* transform) {
+        return fSpotSet.add(devPath, spot, matrix, transform);
     }
 
 private:
@@ -215,20 +268,35 @@ private:
     public:
         size_t size() const { return fSize; }
 
+        /**
+         * Finds vertices that can be drawn for 'matrix', with 'transform' applied. Without
+         * perspective, the vertices are made in a canonical place that the translation is
+         * applied to afterwards. They can also be rotated, and scaled a little, for a matrix that
+         * differs from the one they were made for by a similarity, as it does while a view
+         * animates. Shadows don't scale with the matrix, so scales are only allowed while they
+         * keep the penumbra within kMaxReuseError of its width.
+         */
         sk_sp<SkVertices> find(const FACTORY& factory, const SkMatrix& matrix,
-                               SkVector* translate) const {
+                               SkMatrix* transform) const {
+            SkVector translate;
             for (int i = 0; i < MAX_ENTRIES; ++i) {
-                if (fEntries[i].fFactory.isCompatible(factory, translate)) {
+                if (fEntries[i].fFactory.isCompatible(factory, &translate)) {
                     const SkMatrix& m = fEntries[i].fMatrix;
                     if (matrix.hasPerspective() || m.hasPerspective()) {
                         if (matrix != fEntries[i].fMatrix) {
                             continue;
                         }
-                    } else if (matrix.getScaleX() != m.getScaleX() ||
-                               matrix.getSkewX() != m.getSkewX() ||
-                               matrix.getScaleY() != m.getScaleY() ||
-                               matrix.getSkewY() != m.getSkewY()) {
+                        transform->setTranslate(translate.fX, translate.fY);
+                    } else if (matrix.getScaleX() == m.getScaleX() &&
+                               matrix.getSkewX() == m.getSkewX() &&
+                               matrix.getScaleY() == m.getScaleY() &&
+                               matrix.getSkewY() == m.getSkewY()) {
+                        transform->setTranslate(translate.fX, translate.fY);
+                    } else if (!relative_similarity(m, matrix,
+                                                    factory.transformablePenumbra(), transform)) {
                         continue;
+                    } else {
+                        transform->postTranslate(translate.fX, translate.fY);
                     }
                     return fEntries[i].fVertices;
                 }
@@ -237,8 +305,10 @@ private:
         }
 
         sk_sp<SkVertices> add(const SkPath& path, const FACTORY& factory, const SkMatrix& matrix,
-                              SkVector* translate) {
-            sk_sp<SkVertices> vertices = factory.makeVertices(path, matrix, translate);
+                              SkMatrix* transform) {
+            SkVector translate;
+            sk_sp<SkVertices> vertices = factory.makeVertices(path, matrix, &translate);
+            transform->setTranslate(translate.fX, translate.fY);
             if (!vertices) {
                 return nullptr;
             }
@@ -297,8 +367,8 @@ public:
 
     template <typename FACTORY>
     sk_sp<SkVertices> find(const FACTORY& factory, const SkMatrix& matrix,
-                           SkVector* translate) const {
-        return fTessellations->find(factory, matrix, translate);
+                           SkMatrix* transform) const {
+        return fTessellations->find(factory, matrix, transform);
     }
 
 private:
@@ -308,7 +378,7 @@ private:
 
 /**
  * Used by FindVisitor to determine whether a cache entry can be reused and if so returns the
- * vertices and a translation vector. If the CachedTessellations does not contain a suitable
+ * vertices and a transform. If the CachedTessellations does not contain a suitable
  * mesh then we inform SkResourceCache to destroy the Rec and we return the CachedTessellations
  * to the caller. The caller will update it and reinsert it back into the cache.
  */
@@ -318,9 +388,9 @@ struct FindContext {
             : fViewMatrix(viewMatrix), fFactory(factory) {}
     const SkMatrix* const fViewMatrix;
     // If this is valid after Find is called then we found the vertices and they should be drawn
-    // with fTranslate applied.
+    // with fTransform applied.
     sk_sp<SkVertices> fVertices;
-    SkVector fTranslate = {0, 0};
+    SkMatrix fTransform = SkMatrix::I();
 
     // If this is valid after Find then the caller should add the vertices to the tessellation set
     // and create a new CachedTessellationsRec and insert it into SkResourceCache.
@@ -332,14 +402,14 @@ struct FindContext {
 /**
  * Function called by SkResourceCache when a matching cache key is found. The FACTORY and matrix of
  * the FindContext are used to determine if the vertices are reusable. If so the vertices and
- * necessary translation vector are set on the FindContext.
+ * the transform to draw them with are set on the FindContext.
  */
 template <typename FACTORY>
 bool FindVisitor(const SkResourceCache::Rec& baseRec, void* ctx) {
     FindContext<FACTORY>* findContext = (FindContext<FACTORY>*)ctx;
     const CachedTessellationsRec& rec = static_cast<const CachedTessellationsRec&>(baseRec);
     findContext->fVertices =
-            rec.find(*findContext->fFactory, *findContext->fViewMatrix, &findContext->fTranslate);
+            rec.find(*findContext->fFactory, *findContext->fViewMatrix, &findContext->fTransform);
     if (findContext->fVertices) {
         return true;
     }
@@ -369,9 +439,27 @@ public:
     }
     bool isRRect(SkRRect* rrect) { return fShapeForKey.asRRect(rrect, nullptr, nullptr, nullptr); }
 #else
-    int keyBytes() const { return -1; }
-    void writeKey(void* key) const { SK_ABORT("Should never be called"); }
-    bool isRRect(SkRRect* rrect) { return false; }
+    // Without GrShape, key by the path's generation ID. Paths sharing points share an ID, so this
+    // still finds the vertices for copies of the path drawn every frame.
+    int keyBytes() const { return 2 * sizeof(uint32_t); }
+    void writeKey(void* key) const {
+        uint32_t* key32 = reinterpret_cast<uint32_t*>(key);
+        key32[0] = fPath->getGenerationID();
+        key32[1] = fPath->getFillType();
+    }
+    bool isRRect(SkRRect* rrect) {
+        SkRect rect;
+        if (fPath->isRRect(rrect)) {
+            return true;
+        } else if (fPath->isOval(&rect)) {
+            rrect->setOval(rect);
+            return true;
+        } else if (fPath->isRect(&rect)) {
+            rrect->setRect(rect);
+            return true;
+        }
+        return false;
+    }
 #endif
 
 private:
@@ -392,7 +480,7 @@ static void* kNamespace;
 template <typename FACTORY>
 bool draw_shadow(const FACTORY& factory,
                  std::function<void(const SkVertices*, SkBlendMode, const SkPaint&,
-                 SkScalar tx, SkScalar ty)> drawProc, ShadowedPath& path, SkColor color) {
+                 const SkMatrix& transform)> drawProc, ShadowedPath& path, SkColor color) {
     FindContext<FACTORY> context(&path.viewMatrix(), &factory);
 
     SkResourceCache::Key* key = nullptr;
@@ -421,18 +509,19 @@ bool draw_shadow(const FACTORY& factory,
                 tessellations.reset(new CachedTessellations());
             }
             vertices = tessellations->add(path.path(), factory, path.viewMatrix(),
-                                          &context.fTranslate);
+                                          &context.fTransform);
             if (!vertices) {
                 return false;
             }
             auto rec = new CachedTessellationsRec(*key, std::move(tessellations));
             SkResourceCache::Add(rec);
         } else {
-            vertices = factory.makeVertices(path.path(), path.viewMatrix(),
-                                            &context.fTranslate);
+            SkVector translate;
+            vertices = factory.makeVertices(path.path(), path.viewMatrix(), &translate);
             if (!vertices) {
                 return false;
             }
+            context.fTransform.setTranslate(translate.fX, translate.fY);
         }
     }
 
@@ -443,8 +532,7 @@ bool draw_shadow(const FACTORY& factory,
          SkColorFilter::MakeModeFilter(color, SkBlendMode::kModulate)->makeComposed(
                                                                     SkGaussianColorFilter::Make()));
 
-    drawProc(vertices.get(), SkBlendMode::kModulate, paint,
-             context.fTranslate.fX, context.fTranslate.fY);
+    drawProc(vertices.get(), SkBlendMode::kModulate, paint, context.fTransform);
 
     return true;
 }
@@ -545,9 +633,8 @@ static bool validate_rec(const SkDrawShadowRec& rec) {
 
 void SkBaseDevice::drawShadow(const SkPath& path, const SkDrawShadowRec& rec) {
     auto drawVertsProc = [this](const SkVertices* vertices, SkBlendMode mode, const SkPaint& paint,
-                                SkScalar tx, SkScalar ty) {
-        SkAutoDeviceCTMRestore adr(this, SkMatrix::Concat(this->ctm(),
-                                                          SkMatrix::MakeTrans(tx, ty)));
+                                const SkMatrix& transform) {
+        SkAutoDeviceCTMRestore adr(this, SkMatrix::Concat(this->ctm(), transform));
         this->drawVertices(vertices, mode, paint);
     };
 
@@ -568,6 +655,100 @@ void SkBaseDevice::drawShadow(const SkPath& path, const SkDrawShadowRec& rec) {
     SkPoint3 devLightPos = map(viewMatrix, rec.fLightPos);
     float lightRadius = rec.fLightRadius;
 
+    // The blurred shapes that approximate the shadows, when the vertices can't be made or an
+    // analytic shadow is faster. 'rrect' is the occluder if it is one, else the path is used.
+    auto drawAmbientBlur = [&](const SkRRect* rrect) {
+        // The tesselator outsets by AmbientBlurRadius (or 'r') to get the outer ring of
+        // the tesselation, uses the original path as the inner ring, and sets the alpha
+        // of the inner ring to 1/AmbientRecipAlpha (or 'a').
+        //
+        // We want to emulate this with a blur. The full blur width (2*blurRadius or 'f')
+        // can be calculated by interpolating:
+        //
+        //            original edge        outer edge
+        //         |       |<---------- r ------>|
+        //         |<------|--- f -------------->|
+        //         |       |                     |
+        //    alpha = 1  alpha = a          alpha = 0
+        //
+        // Taking ratios, f/1 = r/a, so f = r/a and blurRadius = f/2.
+        //
+        // We now need to outset the path to place the new edge in the center of the
+        // blur region:
+        //
+        //             original   new
+        //         |       |<------|--- r ------>|
+        //         |<------|--- f -|------------>|
+        //         |       |<- o ->|<--- f/2 --->|
+        //
+        //     r = o + f/2, so o = r - f/2
+        //
+        // We outset by using the stroker, so the strokeWidth is o/2.
+        //
+        SkScalar devSpaceOutset = SkDrawShadowMetrics::AmbientBlurRadius(zPlaneParams.fZ);
+        SkScalar oneOverA = SkDrawShadowMetrics::AmbientRecipAlpha(zPlaneParams.fZ);
+        SkScalar blurRadius = 0.5f*devSpaceOutset*oneOverA;
+        SkScalar strokeWidth = 0.5f*(devSpaceOutset - blurRadius);
+
+        // Now draw with blur
+        SkPaint paint;
+        paint.setColor(rec.fAmbientColor);
+        SkScalar sigma = SkBlurMaskFilter::ConvertRadiusToSigma(blurRadius);
+        uint32_t flags = SkBlurMaskFilter::kIgnoreTransform_BlurFlag;
+        paint.setMaskFilter(SkBlurMaskFilter::Make(kNormal_SkBlurStyle, sigma, flags));
+        if (rrect) {
+            // The stroke outsets by half its width.
+            SkRRect devRRect;
+            if (rrect->transform(viewMatrix, &devRRect)) {
+                devRRect.outset(0.5f*strokeWidth, 0.5f*strokeWidth);
+                this->drawRRect(devRRect, paint);
+                return;
+            }
+        }
+        // Pretransform the path to avoid transforming the stroke.
+        SkPath devSpacePath;
+        path.transform(viewMatrix, &devSpacePath);
+        paint.setStrokeWidth(strokeWidth);
+        paint.setStyle(SkPaint::kStrokeAndFill_Style);
+        this->drawPath(devSpacePath, paint);
+    };
+
+    auto drawSpotBlur = [&](const SkRRect* rrect) {
+        SkScalar radius, scale;
+        SkVector translate;
+        SkDrawShadowMetrics::GetSpotParams(zPlaneParams.fZ, devLightPos.fX, devLightPos.fY,
+                                           devLightPos.fZ, lightRadius, &radius, &scale,
+                                           &translate);
+        SkMatrix shadowMatrix;
+        shadowMatrix.setScaleTranslate(scale, scale, translate.fX, translate.fY);
+        SkAutoDeviceCTMRestore adr(this, SkMatrix::Concat(shadowMatrix, viewMatrix));
+
+        SkPaint paint;
+        paint.setColor(rec.fSpotColor);
+        SkScalar sigma = SkBlurMaskFilter::ConvertRadiusToSigma(radius);
+        uint32_t flags = SkBlurMaskFilter::kIgnoreTransform_BlurFlag;
+        paint.setMaskFilter(SkBlurMaskFilter::Make(kNormal_SkBlurStyle, sigma, flags));
+        if (rrect) {
+            this->drawRRect(*rrect, paint);
+        } else {
+            this->drawPath(path, paint);
+        }
+    };
+
+    // Rects, rrects and ovals under a scale and translate are drawn with the blurred shapes, which
+    // need neither a tessellation nor a cache entry and whose masks are cached as nine-patches.
+    SkRRect rrect;
+    if (!tiltZPlane && !(rec.fFlags & SkShadowFlags::kGeometricOnly_ShadowFlag) &&
+        viewMatrix.isScaleTranslate() && shadowedPath.isRRect(&rrect)) {
+        if (SkColorGetA(rec.fAmbientColor) > 0) {
+            drawAmbientBlur(&rrect);
+        }
+        if (SkColorGetA(rec.fSpotColor) > 0) {
+            drawSpotBlur(&rrect);
+        }
+        return;
+    }
+
     if (SkColorGetA(rec.fAmbientColor) > 0) {
         bool success = false;
         if (uncached) {
@@ -599,51 +780,7 @@ void SkBaseDevice::drawShadow(const SkPath& path, const SkDrawShadowRec& rec) {
             }
 
             if (!draw_shadow(factory, drawVertsProc, shadowedPath, rec.fAmbientColor)) {
-                // Pretransform the path to avoid transforming the stroke, below.
-                SkPath devSpacePath;
-                path.transform(viewMatrix, &devSpacePath);
-
-                // The tesselator outsets by AmbientBlurRadius (or 'r') to get the outer ring of
-                // the tesselation, uses the original path as the inner ring, and sets the alpha
-                // of the inner ring to 1/AmbientRecipAlpha (or 'a').
-                //
-                // We want to emulate this with a blur. The full blur width (2*blurRadius or 'f')
-                // can be calculated by interpolating:
-                //
-                //            original edge        outer edge
-                //         |       |<---------- r ------>|
-                //         |<------|--- f -------------->|
-                //         |       |                     |
-                //    alpha = 1  alpha = a          alpha = 0
-                //
-                // Taking ratios, f/1 = r/a, so f = r/a and blurRadius = f/2.
-                //
-                // We now need to outset the path to place the new edge in the center of the
-                // blur region:
-                //
-                //             original   new
-                //         |       |<------|--- r ------>|
-                //         |<------|--- f -|------------>|
-                //         |       |<- o ->|<--- f/2 --->|
-                //
-                //     r = o + f/2, so o = r - f/2
-                //
-                // We outset by using the stroker, so the strokeWidth is o/2.
-                //
-                SkScalar devSpaceOutset = SkDrawShadowMetrics::AmbientBlurRadius(zPlaneParams.fZ);
-                SkScalar oneOverA = SkDrawShadowMetrics::AmbientRecipAlpha(zPlaneParams.fZ);
-                SkScalar blurRadius = 0.5f*devSpaceOutset*oneOverA;
-                SkScalar strokeWidth = 0.5f*(devSpaceOutset - blurRadius);
-
-                // Now draw with blur
-                SkPaint paint;
-                paint.setColor(rec.fAmbientColor);
-                paint.setStrokeWidth(strokeWidth);
-                paint.setStyle(SkPaint::kStrokeAndFill_Style);
-                SkScalar sigma = SkBlurMaskFilter::ConvertRadiusToSigma(blurRadius);
-                uint32_t flags = SkBlurMaskFilter::kIgnoreTransform_BlurFlag;
-                paint.setMaskFilter(SkBlurMaskFilter::Make(kNormal_SkBlurStyle, sigma, flags));
-                this->drawPath(devSpacePath, paint);
+                drawAmbientBlur(nullptr);
             }
         }
     }
@@ -714,21 +851,7 @@ void SkBaseDevice::drawShadow(const SkPath& path, const SkDrawShadowRec& rec) {
             }
 #endif
             if (!draw_shadow(factory, drawVertsProc, shadowedPath, color)) {
-                // draw with blur
-                SkVector translate;
-                SkDrawShadowMetrics::GetSpotParams(zPlaneParams.fZ, devLightPos.fX,
-                                                   devLightPos.fY, devLightPos.fZ,
-                                                   lightRadius, &radius, &scale, &translate);
-                SkMatrix shadowMatrix;
-                shadowMatrix.setScaleTranslate(scale, scale, translate.fX, translate.fY);
-                SkAutoDeviceCTMRestore adr(this, SkMatrix::Concat(shadowMatrix, viewMatrix));
-
-                SkPaint paint;
-                paint.setColor(rec.fSpotColor);
-                SkScalar sigma = SkBlurMaskFilter::ConvertRadiusToSigma(radius);
-                uint32_t flags = SkBlurMaskFilter::kIgnoreTransform_BlurFlag;
-                paint.setMaskFilter(SkBlurMaskFilter::Make(kNormal_SkBlurStyle, sigma, flags));
-                this->drawPath(path, paint);
+                drawSpotBlur(nullptr);
             }
         }
     }
@@ -6,6 +6,7 @@
  */
 
 #include "SkAAClip.h"
+#include "SkAAClipCache.h"
 #include "SkBitmap.h"
 #include "SkCanvas.h"
 #include "SkColor.h"
@@ -19,6 +20,7 @@
 #include "SkRasterClip.h"
 #include "SkRect.h"
 #include "SkRegion.h"
+#include "SkResourceCache.h"
 #include "SkScalar.h"
 #include "SkTypes.h"
 #include "Test.h"
@@ -429,6 +431,50 @@ static void test_huge(skiatest::Reporter* reporter) {
     clip.setRect(r);
 }
 
+// Clipping again to the same AA geometry shares the clip built the first time.
+static void test_cached_clip(skiatest::Reporter* reporter) {
+    const SkIRect bounds = SkIRect::MakeWH(200, 200);
+    SkMatrix matrix;
+    matrix.setRotate(30);
+    matrix.postTranslate(100, 0);
+    SkPath path;
+    path.addCircle(50, 50, 40);
+    path.addCircle(90, 60, 30);
+    const SkRRect rrect = SkRRect::MakeRectXY(SkRect::MakeLTRB(10.5f, 20, 170, 150), 12, 20);
+
+    SkResourceCache::PurgeAll();
+    for (SkRegion::Op op : { SkRegion::kIntersect_Op, SkRegion::kDifference_Op }) {
+        SkRasterClip first(bounds), second(bounds);
+        first.op(path, matrix, bounds, op, true);
+        REPORTER_ASSERT(reporter, first.isAA());
+        SkAAClip cached;
+        REPORTER_ASSERT(reporter,
+                        SkAAClipCache::Find(SkAAClipCache::Source(path, matrix), bounds, &cached));
+        second.op(path, matrix, bounds, op, true);
+        REPORTER_ASSERT(reporter, first == second);
+
+        SkRasterClip firstRRect(bounds), secondRRect(bounds);
+        firstRRect.op(rrect, matrix, bounds, op, true);
+        secondRRect.op(rrect, matrix, bounds, op, true);
+        REPORTER_ASSERT(reporter, firstRRect.isAA());
+        REPORTER_ASSERT(reporter, firstRRect == secondRRect);
+    }
+
+    // Volatile paths are never cached.
+    SkPath volatilePath(path);
+    volatilePath.setIsVolatile(true);
+    REPORTER_ASSERT(reporter, !SkAAClipCache::Source(volatilePath, matrix).isCacheable());
+
+    // A rect clip inside an rrect is left alone, and one outside of it is emptied, without masks.
+    SkRasterClip inside(SkIRect::MakeLTRB(20, 30, 160, 140));
+    inside.op(rrect, SkMatrix::I(), bounds, SkRegion::kIntersect_Op, true);
+    REPORTER_ASSERT(reporter, inside.isRect());
+    REPORTER_ASSERT(reporter, inside.getBounds() == SkIRect::MakeLTRB(20, 30, 160, 140));
+    SkRasterClip outside(SkIRect::MakeLTRB(180, 0, 200, 200));
+    outside.op(rrect, SkMatrix::I(), bounds, SkRegion::kIntersect_Op, true);
+    REPORTER_ASSERT(reporter, outside.isEmpty());
+}
+
 DEF_TEST(AAClip, reporter) {
     test_empty(reporter);
     test_path_bounds(reporter);
@@ -440,4 +486,5 @@ DEF_TEST(AAClip, reporter) {
     test_really_a_rect(reporter);
     test_crbug_422693(reporter);
     test_huge(reporter);
+    test_cached_clip(reporter);
 }
@@ -0,0 +1,195 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkBitmap.h"
+#include "SkBitmapCache.h"
+#include "SkBitmapScaler.h"
+#include "SkCanvas.h"
+#include "SkColorPriv.h"
+#include "SkHalf.h"
+#include "SkImage.h"
+#include "Test.h"
+
+static const SkBitmapScaler::ResizeMethod gMethods[] = {
+    SkBitmapScaler::kLanczos3_ResizeMethod,
+    SkBitmapScaler::kMitchell_ResizeMethod,
+};
+
+static SkBitmap make_bitmap(int w, int h, SkPMColor (*color)(int x, int y)) {
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(w, h);
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            *bitmap.getAddr32(x, y) = color(x, y);
+        }
+    }
+    return bitmap;
+}
+
+static SkBitmap resize(const SkBitmap& src, int w, int h, SkBitmapScaler::ResizeMethod method) {
+    SkBitmap dst;
+    dst.allocPixels(src.info().makeWH(w, h));
+    SkPixmap srcPM, dstPM;
+    SkAssertResult(src.peekPixels(&srcPM) && dst.peekPixels(&dstPM));
+    SkAssertResult(SkBitmapScaler::Resize(dstPM, srcPM, method));
+    return dst;
+}
+
+static int max_diff(SkPMColor a, SkPMColor b) {
+    int diff = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        diff = SkTMax(diff, SkAbs32((int)((a >> shift) & 0xFF) - (int)((b >> shift) & 0xFF)));
+    }
+    return diff;
+}
+
+DEF_TEST(BitmapScaler_Constant, reporter) {
+    // Normalized weights keep a flat color exactly, however it's scaled.
+    const SkBitmap src = make_bitmap(100, 70, [](int, int) {
+        return SkPackARGB32(0x80, 0x40, 0x20, 0x10);
+    });
+    for (SkBitmapScaler::ResizeMethod method : gMethods) {
+        for (SkISize size : { SkISize::Make(23, 17), SkISize::Make(100, 3), SkISize::Make(1, 1),
+                              SkISize::Make(250, 90) }) {
+            const SkBitmap dst = resize(src, size.width(), size.height(), method);
+            for (int y = 0; y < dst.height(); ++y) {
+                for (int x = 0; x < dst.width(); ++x) {
+                    REPORTER_ASSERT(reporter, *dst.getAddr32(x, y) == *src.getAddr32(0, 0));
+                }
+            }
+        }
+    }
+}
+
+DEF_TEST(BitmapScaler_Ramp, reporter) {
+    // A ramp stays a ramp, with each dst pixel centered over the source pixels it covers.
+    const SkBitmap src = make_bitmap(256, 8, [](int x, int) {
+        return SkPackARGB32(0xFF, x, 0, 0);
+    });
+    for (SkBitmapScaler::ResizeMethod method : gMethods) {
+        const SkBitmap dst = resize(src, 64, 2, method);
+        // Away from the edges, which the filter sees as clamped.
+        for (int x = 4; x < 60; ++x) {
+            const float expected = 4 * x + 1.5f;
+            REPORTER_ASSERT(reporter, SkScalarAbs(SkGetPackedR32(*dst.getAddr32(x, 1)) -
+                                                  expected) <= 1);
+        }
+    }
+}
+
+DEF_TEST(BitmapScaler_Checkerboard, reporter) {
+    // Stretched over every pixel it covers, the filter blends away detail too fine for dst
+    // rather than aliasing it, and never makes invalid premul colors out of hard edges.
+    const SkBitmap src = make_bitmap(128, 128, [](int x, int y) {
+        return ((x ^ y) & 1) ? SK_ColorWHITE : SK_ColorTRANSPARENT;
+    });
+    for (SkBitmapScaler::ResizeMethod method : gMethods) {
+        const SkBitmap dst = resize(src, 32, 29, method);
+        for (int y = 0; y < dst.height(); ++y) {
+            for (int x = 0; x < dst.width(); ++x) {
+                const SkPMColor c = *dst.getAddr32(x, y);
+                REPORTER_ASSERT(reporter, SkGetPackedR32(c) <= SkGetPackedA32(c));
+                REPORTER_ASSERT(reporter, SkGetPackedG32(c) <= SkGetPackedA32(c));
+                REPORTER_ASSERT(reporter, SkGetPackedB32(c) <= SkGetPackedA32(c));
+                REPORTER_ASSERT(reporter, max_diff(c, SkPackARGB32(0x80, 0x80, 0x80, 0x80)) <= 6);
+            }
+        }
+    }
+}
+
+DEF_TEST(BitmapScaler_F16, reporter) {
+    // F16 scales just like 8888, only more precisely.
+    const SkBitmap src = make_bitmap(90, 60, [](int x, int y) {
+        return SkPreMultiplyARGB(0x40 + 2 * y, 2 * x, 0xFF - 4 * y, (x * y) & 0xFF);
+    });
+    SkBitmap srcF16;
+    srcF16.allocPixels(src.info().makeColorType(kRGBA_F16_SkColorType));
+    SkAssertResult(src.readPixels(srcF16.pixmap()));
+
+    for (SkBitmapScaler::ResizeMethod method : gMethods) {
+        const SkBitmap dst = resize(src, 31, 47, method);
+        const SkBitmap dstF16 = resize(srcF16, 31, 47, method);
+        SkBitmap dstF16As8888;
+        dstF16As8888.allocPixels(dst.info());
+        SkAssertResult(dstF16.readPixels(dstF16As8888.pixmap()));
+        int worst = 0;
+        for (int y = 0; y < dst.height(); ++y) {
+            for (int x = 0; x < dst.width(); ++x) {
+                worst = SkTMax(worst, max_diff(*dst.getAddr32(x, y),
+                                               *dstF16As8888.getAddr32(x, y)));
+            }
+        }
+        REPORTER_ASSERT(reporter, worst <= 1);
+    }
+}
+
+DEF_TEST(BitmapScaler_Unsupported, reporter) {
+    const SkImageInfo n32 = SkImageInfo::MakeN32Premul(10, 10);
+    REPORTER_ASSERT(reporter, SkBitmapScaler::CanResize(n32.makeWH(5, 5), n32));
+    REPORTER_ASSERT(reporter, !SkBitmapScaler::CanResize(n32.makeWH(0, 5), n32));
+    REPORTER_ASSERT(reporter, !SkBitmapScaler::CanResize(n32.makeAlphaType(kOpaque_SkAlphaType),
+                                                         n32));
+    REPORTER_ASSERT(reporter, !SkBitmapScaler::CanResize(n32.makeColorType(kRGB_565_SkColorType),
+                                                         n32));
+    REPORTER_ASSERT(reporter, !SkBitmapScaler::CanResize(n32.makeColorSpace(
+                                                                 SkColorSpace::MakeSRGB()), n32));
+    const SkImageInfo a8 = SkImageInfo::MakeA8(10, 10);
+    REPORTER_ASSERT(reporter, !SkBitmapScaler::CanResize(a8.makeWH(5, 5), a8));
+}
+
+DEF_TEST(BitmapScaler_HighQualityDownscale, reporter) {
+    const SkBitmap src = make_bitmap(200, 150, [](int x, int y) {
+        return SkPreMultiplyARGB(0xFF - y, x, (x * y) & 0xFF, ((x / 7) & 1) ? 0xFF : 0);
+    });
+    const SkBitmap expected = resize(src, 50, 60, SkBitmapScaler::kLanczos3_ResizeMethod);
+
+    // scalePixels() resamples when shrinking at high quality...
+    SkBitmap scaled;
+    scaled.allocPixels(expected.info());
+    REPORTER_ASSERT(reporter, src.pixmap().scalePixels(scaled.pixmap(), kHigh_SkFilterQuality));
+    REPORTER_ASSERT(reporter, 0 == memcmp(scaled.getPixels(), expected.getPixels(),
+                                          expected.computeByteSize()));
+
+    // ... and so does drawing, when only scaled.
+    SkBitmap drawn;
+    drawn.allocPixels(expected.info());
+    SkCanvas canvas(drawn);
+    canvas.clear(SK_ColorTRANSPARENT);
+    canvas.scale(50.0f / 200, 60.0f / 150);
+    SkPaint paint;
+    paint.setFilterQuality(kHigh_SkFilterQuality);
+    canvas.drawBitmap(src, 0, 0, &paint);
+    int worst = 0;
+    for (int y = 0; y < drawn.height(); ++y) {
+        for (int x = 0; x < drawn.width(); ++x) {
+            worst = SkTMax(worst, max_diff(*drawn.getAddr32(x, y), *expected.getAddr32(x, y)));
+        }
+    }
+    REPORTER_ASSERT(reporter, worst <= 1);
+}
+
+// A draw that shrinks one axis but stretches the other shouldn't resample the image to its drawn
+// size, which can be much bigger than the image.
+DEF_TEST(BitmapScaler_HighQualityMixedScale, reporter) {
+    sk_sp<SkImage> src = SkImage::MakeFromBitmap(make_bitmap(64, 64, [](int x, int y) {
+        return SkPreMultiplyARGB(0xFF, x * 4, y * 4, 0);
+    }));
+
+    SkBitmap drawn;
+    drawn.allocN32Pixels(32, 32);
+    SkCanvas canvas(drawn);
+    canvas.scale(0.5f, 40);
+    SkPaint paint;
+    paint.setFilterQuality(kHigh_SkFilterQuality);
+    // The image shader asks for the image itself, so its scaled entry would be cached under it.
+    paint.setShader(src->makeShader());
+    canvas.drawRect(SkRect::MakeIWH(64, 64), paint);
+
+    SkBitmap cached;
+    REPORTER_ASSERT(reporter, !SkBitmapCache::Find(SkBitmapCacheDesc::Make(src.get(), 32, 64 * 40),
+                                                   &cached));
+}
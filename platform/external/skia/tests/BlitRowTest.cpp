@@ -0,0 +1,208 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkArenaAlloc.h"
+#include "SkBitmap.h"
+#include "SkBlitRow.h"
+#include "SkBlitter.h"
+#include "SkCanvas.h"
+#include "SkColorPriv.h"
+#include "SkOpts.h"
+#include "SkRandom.h"
+#include "Test.h"
+
+// Whichever of the SSE, AVX2 or portable procs SkOpts picked, they must all blend exactly like
+// these one-pixel-at-a-time references.
+
+// (x*y + x) / 256, like Sk4px::approxMulDiv255().
+static unsigned mul(unsigned x, unsigned y) {
+    return (x * y + x) >> 8;
+}
+
+static SkPMColor random_pmcolor(SkRandom* rand) {
+    switch (rand->nextU() % 4) {
+        case 0:  return 0;
+        case 1:  return SkPreMultiplyColor(rand->nextU() | 0xFF000000);
+        default: return SkPreMultiplyColor(rand->nextU());
+    }
+}
+
+static SkPMColor color32(SkPMColor dst, SkPMColor color) {
+    unsigned invA = 255 - SkGetPackedA32(color);
+    invA += invA >> 7;
+    SkPMColor result = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        unsigned d = (dst >> shift) & 0xFF,
+                 c = (color >> shift) & 0xFF;
+        result |= (((d * invA + (c << 8) + 128) & 0xFFFF) >> 8) << shift;
+    }
+    return result;
+}
+
+static SkPMColor mask_d32_a8(SkPMColor dst, SkAlpha aa, SkColor color) {
+    SkPMColor result = 0;
+    if (color == SK_ColorBLACK) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            unsigned d = (dst >> shift) & 0xFF;
+            result |= ((shift == SK_A32_SHIFT ? aa : 0) + mul(d, 255 - aa)) << shift;
+        }
+        return result;
+    }
+    const SkPMColor s = SkPreMultiplyColor(color);
+    const unsigned leftA = mul(SkGetPackedA32(s), aa);
+    const bool opaque = SkColorGetA(color) == 0xFF;
+    for (int shift = 0; shift < 32; shift += 8) {
+        unsigned d = (dst >> shift) & 0xFF,
+                 c = (s >> shift) & 0xFF;
+        result |= (mul(c, aa) + mul(d, 255 - (opaque ? aa : leftA))) << shift;
+    }
+    return result;
+}
+
+DEF_TEST(BlitRow_S32A_Opaque, reporter) {
+    SkRandom rand;
+    SkPMColor src[67], dst[67];
+    for (int count = 0; count <= 67; ++count) {
+        for (int i = 0; i < count; ++i) {
+            src[i] = random_pmcolor(&rand);
+            dst[i] = random_pmcolor(&rand);
+        }
+        // Runs of transparent and opaque pixels take the fast paths.
+        if (count > 40) {
+            sk_memset32(src + 3, 0, 20);
+            sk_memset32(src + 23, 0xFF00FF00, 17);
+        }
+        SkPMColor expected[67];
+        for (int i = 0; i < count; ++i) {
+            expected[i] = SkPMSrcOver(src[i], dst[i]);
+        }
+        SkOpts::blit_row_s32a_opaque(dst, src, count, 0xFF);
+        REPORTER_ASSERT(reporter, 0 == memcmp(dst, expected, count * sizeof(SkPMColor)),
+                        "count %d", count);
+    }
+}
+
+DEF_TEST(BlitRow_Color32, reporter) {
+    SkRandom rand;
+    SkPMColor src[43], dst[43];
+    for (int count = 1; count <= 43; ++count) {
+        const SkPMColor color = random_pmcolor(&rand);
+        SkPMColor expected[43];
+        for (int i = 0; i < count; ++i) {
+            src[i] = random_pmcolor(&rand);
+            expected[i] = color32(src[i], color);
+        }
+        SkBlitRow::Color32(dst, src, count, color);
+        REPORTER_ASSERT(reporter, 0 == memcmp(dst, expected, count * sizeof(SkPMColor)),
+                        "count %d color %08x", count, color);
+    }
+}
+
+DEF_TEST(BlitRow_MaskD32A8, reporter) {
+    SkRandom rand;
+    const int kMaskRB = 40;
+    SkAlpha mask[kMaskRB * 3];
+    for (SkAlpha& aa : mask) {
+        aa = rand.nextU() % 3 ? rand.nextU() & 0xFF : (rand.nextBool() ? 0 : 0xFF);
+    }
+    for (SkColor color : { SK_ColorBLACK, SK_ColorRED, (SkColor)0x80FF8040, (SkColor)0x01FFFFFF }) {
+        for (int width = 1; width <= kMaskRB; ++width) {
+            SkPMColor dst[3][kMaskRB], expected[3][kMaskRB];
+            for (int y = 0; y < 3; ++y) {
+                for (int x = 0; x < width; ++x) {
+                    dst[y][x] = random_pmcolor(&rand);
+                    expected[y][x] = mask_d32_a8(dst[y][x], mask[y * kMaskRB + x], color);
+                }
+            }
+            SkOpts::blit_mask_d32_a8(dst[0], sizeof(dst[0]), mask, kMaskRB, color, width, 3);
+            for (int y = 0; y < 3; ++y) {
+                REPORTER_ASSERT(reporter, 0 == memcmp(dst[y], expected[y],
+                                                      width * sizeof(SkPMColor)),
+                                "color %08x width %d", color, width);
+            }
+        }
+    }
+}
+
+DEF_TEST(BlitRow_AntiH, reporter) {
+    // Runs of equal coverage are blitted together, and short ones a pixel at a time; either
+    // way each pixel must come out just as if blended on its own.
+    const int kWidth = 64;
+    SkRandom rand;
+    for (SkColor color : { (SkColor)0x80FF8040, SK_ColorBLACK, SK_ColorBLUE }) {
+        SkBitmap bitmap;
+        bitmap.allocN32Pixels(kWidth, 1);
+        SkPMColor* pixels = bitmap.getAddr32(0, 0);
+        for (int x = 0; x < kWidth; ++x) {
+            pixels[x] = random_pmcolor(&rand);
+        }
+
+        int16_t runs[kWidth + 1];
+        SkAlpha antialias[kWidth + 1];
+        SkAlpha coverage[kWidth];
+        for (int x = 0; x < kWidth; ) {
+            const int run = SkTMin(kWidth - x, 1 + (int)(rand.nextU() % 9));
+            const unsigned r = rand.nextU() % 4;
+            const SkAlpha aa = r == 0 ? 0 : r == 1 ? 0xFF : (rand.nextBool() ? 0x80 : 0x33);
+            runs[x] = run;
+            antialias[x] = aa;
+            sk_bzero(runs + x + 1, (run - 1) * sizeof(int16_t));
+            memset(coverage + x, aa, run);
+            x += run;
+        }
+        runs[kWidth] = 0;
+
+        SkPMColor expected[kWidth];
+        const SkPMColor pm = SkPreMultiplyColor(color);
+        for (int x = 0; x < kWidth; ++x) {
+            const SkAlpha aa = coverage[x];
+            if (aa == 0) {
+                expected[x] = pixels[x];
+            } else if (aa == 0xFF && SkGetPackedA32(pm) == 0xFF) {
+                expected[x] = pm;
+            } else if (color == SK_ColorBLACK) {
+                expected[x] = (aa << SK_A32_SHIFT) + SkAlphaMulQ(pixels[x], 256 - aa);
+            } else {
+                expected[x] = color32(pixels[x], SkAlphaMulQ(pm, SkAlpha255To256(aa)));
+            }
+        }
+
+        SkPaint paint;
+        paint.setColor(color);
+        SkSTArenaAlloc<2048> alloc;
+        SkBlitter* blitter = SkBlitter::Choose(bitmap.pixmap(), SkMatrix::I(), paint, &alloc);
+        blitter->blitAntiH(0, 0, antialias, runs);
+        REPORTER_ASSERT(reporter, 0 == memcmp(pixels, expected, sizeof(expected)),
+                        "color %08x", color);
+    }
+}
+
+DEF_TEST(BlitRow_Sprite, reporter) {
+    // A sprite whose rows are packed end to end blends as one long row; it must come out just
+    // like the same sprite drawn from padded rows.
+    SkBitmap packed, padded;
+    packed.allocN32Pixels(13, 9);
+    padded.allocPixels(packed.info(), 16 * sizeof(SkPMColor));
+    SkRandom rand;
+    for (int y = 0; y < 9; ++y) {
+        for (int x = 0; x < 13; ++x) {
+            *packed.getAddr32(x, y) = *padded.getAddr32(x, y) = random_pmcolor(&rand);
+        }
+    }
+
+    SkBitmap dst[2];
+    for (int i = 0; i < 2; ++i) {
+        dst[i].allocN32Pixels(13, 9);
+        dst[i].eraseColor(0xFF336699);
+        SkCanvas canvas(dst[i]);
+        SkPaint paint;
+        paint.setAlpha(0xC0);
+        canvas.drawBitmap(i ? padded : packed, 0, 0, &paint);
+    }
+    REPORTER_ASSERT(reporter, 0 == memcmp(dst[0].getPixels(), dst[1].getPixels(),
+                                          dst[0].computeByteSize()));
+}
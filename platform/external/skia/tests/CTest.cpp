@@ -9,6 +9,7 @@
 
 #include "sk_canvas.h"
 #include "sk_paint.h"
+#include "sk_path.h"
 #include "sk_surface.h"
 #include "sk_shader.h"
 
@@ -86,3 +87,82 @@ DEF_TEST(C_API, reporter) {
     test_c(reporter);
     shader_test(reporter);
 }
+
+static void release_pixels(void* pixels, void* context) {
+    *static_cast<void**>(context) = pixels;
+}
+
+DEF_TEST(C_API_DrawRecords, reporter) {
+    sk_imageinfo_t info = { 32, 32, sk_colortype_get_default_8888(), PREMUL_SK_ALPHATYPE };
+    uint32_t batched[32 * 32], perCall[32 * 32];
+    memset(batched, 0, sizeof(batched));
+    memset(perCall, 0, sizeof(perCall));
+    void* released = nullptr;
+    sk_surface_t* batchedSurface = sk_surface_new_raster_direct_release(
+            &info, batched, sizeof(batched) / 32, release_pixels, &released, nullptr);
+    sk_surface_t* perCallSurface = sk_surface_new_raster_direct(&info, perCall,
+                                                                sizeof(perCall) / 32, nullptr);
+
+    sk_paint_t* red = sk_paint_new();
+    sk_paint_set_color(red, sk_color_set_argb(0xFF, 0xFF, 0x00, 0x00));
+    sk_paint_t* blue = sk_paint_new();
+    sk_paint_set_color(blue, sk_color_set_argb(0x80, 0x00, 0x00, 0xFF));
+    sk_paint_set_antialias(blue, true);
+    const sk_paint_t* paints[] = { red, blue };
+
+    sk_path_t* path = sk_path_new();
+    sk_path_move_to(path, 2, 30);
+    sk_path_line_to(path, 16, 4);
+    sk_path_line_to(path, 30, 30);
+    sk_path_close(path);
+
+    const sk_rect_t rect = { 4, 4, 20, 12 };
+    const sk_rect_t clip = { 0, 0, 24, 32 };
+    const sk_point_t center = { 12, 20 };
+    sk_draw_record_t records[7];
+    memset(records, 0, sizeof(records));
+    records[0].op = DRAW_RECT_SK_DRAW_OP;   records[0].paint = 0; records[0].rect = rect;
+    records[1].op = SAVE_SK_DRAW_OP;        records[1].paint = -1;
+    records[2].op = CLIP_RECT_SK_DRAW_OP;   records[2].paint = -1; records[2].rect = clip;
+    records[3].op = DRAW_PATH_SK_DRAW_OP;   records[3].paint = 1; records[3].object = path;
+    records[4].op = TRANSLATE_SK_DRAW_OP;   records[4].paint = -1; records[4].point = { 3, 1 };
+    records[5].op = DRAW_CIRCLE_SK_DRAW_OP; records[5].paint = 1; records[5].point = center;
+    records[5].radius = 6;
+    records[6].op = RESTORE_SK_DRAW_OP;     records[6].paint = -1;
+
+    sk_canvas_t* canvas = sk_surface_get_canvas(perCallSurface);
+    sk_canvas_draw_rect(canvas, &rect, red);
+    sk_canvas_save(canvas);
+    sk_canvas_clip_rect(canvas, &clip);
+    sk_canvas_draw_path(canvas, path, blue);
+    sk_canvas_translate(canvas, 3, 1);
+    sk_canvas_draw_circle(canvas, center.x, center.y, 6, blue);
+    sk_canvas_restore(canvas);
+
+    canvas = sk_surface_get_canvas(batchedSurface);
+    REPORTER_ASSERT(reporter, 7 == sk_canvas_draw_records(canvas, records, 7, paints, 2));
+    REPORTER_ASSERT(reporter, 0 == memcmp(batched, perCall, sizeof(batched)));
+
+    // Replay stops at the first bad record: here, a paint index out of range.
+    records[2].op = DRAW_OVAL_SK_DRAW_OP;
+    records[2].paint = 2;
+    REPORTER_ASSERT(reporter, 2 == sk_canvas_draw_records(canvas, records, 7, paints, 2));
+    sk_canvas_restore(canvas);
+
+    // The surface drew straight into our pixels, and hands them back once it's gone.
+    REPORTER_ASSERT(reporter, nullptr == released);
+    sk_surface_unref(batchedSurface);
+    REPORTER_ASSERT(reporter, batched == released);
+
+    // If it can't be made at all, we get the pixels back right away.
+    released = nullptr;
+    sk_imageinfo_t badInfo = { -1, 32, sk_colortype_get_default_8888(), PREMUL_SK_ALPHATYPE };
+    REPORTER_ASSERT(reporter, nullptr == sk_surface_new_raster_direct_release(
+            &badInfo, batched, sizeof(batched) / 32, release_pixels, &released, nullptr));
+    REPORTER_ASSERT(reporter, batched == released);
+
+    sk_path_delete(path);
+    sk_paint_delete(red);
+    sk_paint_delete(blue);
+    sk_surface_unref(perCallSurface);
+}
@@ -10,7 +10,10 @@
 #if SK_SUPPORT_GPU
 
 #include "GrBackendSurface.h"
+#include "GrContextPriv.h"
+#include "GrDrawingManager.h"
 #include "GrGpu.h"
+#include "GrOpArena.h"
 #include "SkCanvas.h"
 #include "SkDeferredDisplayListRecorder.h"
 #include "SkGpuDevice.h"
@@ -25,6 +28,8 @@
 #include "vk/GrVkDefines.h"
 #endif
 
+#include <thread>
+
 static GrBackendFormat create_backend_format(GrContext* context, SkColorType colorType) {
     const GrCaps* caps = context->caps();
 
@@ -470,5 +475,64 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(DDLWrapBackendTest, reporter, ctxInfo) {
     }
 }
 
+#ifndef SK_RASTER_RECORDER_IMPLEMENTATION
+// A context's op arena is only installed while it makes ops, so other contexts' ops on the same
+// thread never land in it, and a recording can be detached and destroyed on any thread.
+DEF_GPUTEST(DDLOpArena, reporter, /* options */) {
+    sk_sp<GrContext> context = GrContext::MakeMock(nullptr, GrContextOptions());
+    SkImageInfo ii = SkImageInfo::MakeN32Premul(kSize, kSize);
+    sk_sp<SkSurface> s = SkSurface::MakeRenderTarget(context.get(), SkBudgeted::kNo, ii);
+    SkSurfaceCharacterization c;
+    if (!s || !s->characterize(&c)) {
+        ERRORF(reporter, "Could not make a mock surface to record for");
+        return;
+    }
+
+    SkPaint paint;
+    auto draw_rects = [&paint](SkCanvas* canvas) {
+        for (int i = 0; i < 10; ++i) {
+            paint.setColor(0xFF000000 | (i * 0x1F1F1F));
+            canvas->drawRect(SkRect::MakeXYWH(i * 2, i, 5, 5), paint);
+        }
+    };
+
+    // The ops of a context with an arena are allocated from it, and hold it until they're gone.
+    GrDrawingManager* drawingManager = context->contextPriv().drawingManager();
+    sk_sp<GrOpArena> arena = sk_make_sp<GrOpArena>();
+    drawingManager->setOpArena(arena);
+    draw_rects(s->getCanvas());
+    REPORTER_ASSERT(reporter, !GrOpArena::Current());
+    drawingManager->setOpArena(nullptr);
+    REPORTER_ASSERT(reporter, !arena->unique());
+    s->getCanvas()->flush();
+    REPORTER_ASSERT(reporter, arena->unique());
+
+    std::unique_ptr<SkDeferredDisplayListRecorder> recorder(new SkDeferredDisplayListRecorder(c));
+    SkCanvas* canvas = recorder->getCanvas();
+    REPORTER_ASSERT(reporter, canvas);
+    if (!canvas) {
+        return;
+    }
+    draw_rects(canvas);
+    REPORTER_ASSERT(reporter, !GrOpArena::Current());
+
+    // Draws to another context in the meantime use the global pool.
+    s->getCanvas()->drawRect(SkRect::MakeWH(4, 4), paint);
+
+    std::unique_ptr<SkDeferredDisplayList> ddl;
+    std::thread([&]() { ddl = recorder->detach(); }).join();
+    std::thread([&]() { recorder.reset(); }).join();
+    REPORTER_ASSERT(reporter, ddl);
+    if (!ddl) {
+        return;
+    }
+
+    s->getCanvas()->drawRect(SkRect::MakeWH(6, 6), paint);
+    REPORTER_ASSERT(reporter, s->draw(ddl.get()));
+    s->getCanvas()->flush();
+    ddl.reset();
+    REPORTER_ASSERT(reporter, !GrOpArena::Current());
+}
+#endif
 
 #endif
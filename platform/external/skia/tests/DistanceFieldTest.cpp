@@ -0,0 +1,124 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkDistanceFieldGen.h"
+#include "SkTemplates.h"
+#include "Test.h"
+
+#include <vector>
+
+static const int kSize = 40;
+
+// Signed distance to a circle in the middle of the mask, negative inside.
+static float circle_distance(float x, float y, float radius) {
+    return SkPoint::Length(x - kSize / 2, y - kSize / 2) - radius;
+}
+
+// Covers each pixel of an antialiased circle with 16x16 samples.
+static std::vector<unsigned char> make_circle_mask(float radius) {
+    std::vector<unsigned char> mask(kSize * kSize);
+    for (int y = 0; y < kSize; ++y) {
+        for (int x = 0; x < kSize; ++x) {
+            int covered = 0;
+            for (int sy = 0; sy < 16; ++sy) {
+                for (int sx = 0; sx < 16; ++sx) {
+                    covered += circle_distance(x + (sx + 0.5f) / 16, y + (sy + 0.5f) / 16,
+                                               radius) < 0;
+                }
+            }
+            mask[y * kSize + x] = (unsigned char)((covered * 255 + 128) / 256);
+        }
+    }
+    return mask;
+}
+
+static float unpack_distance(unsigned char val) {
+    return (1 - val / 128.0f) * SK_DistanceFieldMagnitude;
+}
+
+DEF_TEST(DistanceField_Circle, reporter) {
+    const int fieldSize = kSize + 2 * SK_DistanceFieldPad;
+    for (float radius : { 2.3f, 7.5f, 15.0f }) {
+        std::vector<unsigned char> mask = make_circle_mask(radius);
+        SkAutoTMalloc<unsigned char> field(SkComputeDistanceFieldSize(kSize, kSize));
+        REPORTER_ASSERT(reporter, SkGenerateDistanceFieldFromA8Image(field.get(), mask.data(),
+                                                                     kSize, kSize, kSize));
+        float worst = 0;
+        for (int y = 0; y < fieldSize; ++y) {
+            for (int x = 0; x < fieldSize; ++x) {
+                const float distance = circle_distance(x - SK_DistanceFieldPad + 0.5f,
+                                                       y - SK_DistanceFieldPad + 0.5f, radius);
+                // beyond the magnitude the field is clamped, inside and out
+                const float expected = SkTPin(distance, -SK_DistanceFieldMagnitude * 127 / 128.0f,
+                                              (float)SK_DistanceFieldMagnitude);
+                const float actual = unpack_distance(field[y * fieldSize + x]);
+                worst = SkTMax(worst, SkScalarAbs(actual - expected));
+                if (SkScalarAbs(distance) > 1) {
+                    REPORTER_ASSERT(reporter, (distance < 0) == (actual < 0));
+                }
+            }
+        }
+        REPORTER_ASSERT(reporter, worst < 0.65f, "radius %g: off by %g", radius, worst);
+    }
+}
+
+DEF_TEST(DistanceField_Empty, reporter) {
+    // With no edges at all, everything is as far outside as the field goes.
+    const unsigned char mask[4 * 3] = { 0 };
+    const size_t size = SkComputeDistanceFieldSize(4, 3);
+    SkAutoTMalloc<unsigned char> field(size);
+    REPORTER_ASSERT(reporter, SkGenerateDistanceFieldFromA8Image(field.get(), mask, 4, 3, 4));
+    for (size_t i = 0; i < size; ++i) {
+        REPORTER_ASSERT(reporter, 0 == field[i]);
+    }
+}
+
+DEF_TEST(DistanceField_BW, reporter) {
+    // A 1-bit mask makes the same field as the 8-bit mask it expands to, whatever the row bytes.
+    const int width = 21, height = 13;
+    const size_t bwRowBytes = 4, a8RowBytes = 24;
+    unsigned char bw[bwRowBytes * height];
+    unsigned char a8[a8RowBytes * height];
+    memset(a8, 0x7F, sizeof(a8));
+    for (int y = 0; y < height; ++y) {
+        for (size_t i = 0; i < bwRowBytes; ++i) {
+            bw[y * bwRowBytes + i] = (unsigned char)((y * 37 + i * 91) ^ (0xF0 >> (y % 5)));
+        }
+        for (int x = 0; x < width; ++x) {
+            const bool on = bw[y * bwRowBytes + x / 8] & (0x80 >> (x % 8));
+            a8[y * a8RowBytes + x] = on ? 0xFF : 0;
+        }
+    }
+
+    const size_t size = SkComputeDistanceFieldSize(width, height);
+    SkAutoTMalloc<unsigned char> fromBW(size), fromA8(size);
+    REPORTER_ASSERT(reporter, SkGenerateDistanceFieldFromBWImage(fromBW.get(), bw, width, height,
+                                                                 bwRowBytes));
+    REPORTER_ASSERT(reporter, SkGenerateDistanceFieldFromA8Image(fromA8.get(), a8, width, height,
+                                                                 a8RowBytes));
+    REPORTER_ASSERT(reporter, 0 == memcmp(fromBW.get(), fromA8.get(), size));
+}
+
+DEF_TEST(DistanceField_Batch, reporter) {
+    // Generating many fields at once matches generating them one by one.
+    static const int kCount = 12;
+    std::vector<unsigned char> masks[kCount];
+    SkAutoTMalloc<unsigned char> expected[kCount], actual[kCount];
+    SkDistanceFieldRequest requests[kCount];
+    const size_t size = SkComputeDistanceFieldSize(kSize, kSize);
+    for (int i = 0; i < kCount; ++i) {
+        masks[i] = make_circle_mask(1.5f + 1.5f * i);
+        expected[i].reset(size);
+        actual[i].reset(size);
+        SkGenerateDistanceFieldFromA8Image(expected[i].get(), masks[i].data(), kSize, kSize, kSize);
+        requests[i] = { actual[i].get(), masks[i].data(), kSize, kSize, kSize, false };
+    }
+    REPORTER_ASSERT(reporter, SkGenerateDistanceFields(requests, kCount));
+    for (int i = 0; i < kCount; ++i) {
+        REPORTER_ASSERT(reporter, 0 == memcmp(expected[i].get(), actual[i].get(), size));
+    }
+}
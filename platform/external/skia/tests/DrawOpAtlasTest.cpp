@@ -10,6 +10,7 @@
 #if SK_SUPPORT_GPU
 
 #include "GrContextPriv.h"
+#include "GrGpu.h"
 #include "Test.h"
 #include "text/GrGlyphCache.h"
 
@@ -129,4 +130,224 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(DrawOpAtlas, reporter, ctxInfo) {
     check(reporter, atlas.get(), 1, 4, 1);
 }
 
+namespace {
+
+// Records what an atlas evicts and moves.
+struct AtlasEvents {
+    SkTDArray<GrDrawOpAtlas::AtlasID> fEvicted;
+    SkTDArray<GrDrawOpAtlas::AtlasID> fMovedFrom;
+    SkTDArray<GrDrawOpAtlas::AtlasID> fMovedTo;
+
+    static void Evict(GrDrawOpAtlas::AtlasID id, void* data) {
+        *static_cast<AtlasEvents*>(data)->fEvicted.append() = id;
+    }
+
+    static void Move(GrDrawOpAtlas::AtlasID from, GrDrawOpAtlas::AtlasID to, SkIPoint16,
+                     void* data) {
+        *static_cast<AtlasEvents*>(data)->fMovedFrom.append() = from;
+        *static_cast<AtlasEvents*>(data)->fMovedTo.append() = to;
+    }
+};
+
+}  // namespace
+
+static void use_and_flush(GrDrawOpAtlas* atlas, TestingUploadTarget* uploadTarget,
+                          const GrDrawOpAtlas::AtlasID* ids, int count) {
+    for (int i = 0; i < count; ++i) {
+        atlas->setLastUseToken(ids[i], uploadTarget->tokenTracker()->nextDrawToken());
+    }
+    uploadTarget->issueDrawToken();
+    uploadTarget->flushToken();
+    atlas->compact(uploadTarget->tokenTracker()->nextTokenToFlush());
+}
+
+// When the atlas is full, it should evict the plot used in the fewest recent flushes, rather than
+// the least recently used one.
+DEF_GPUTEST(DrawOpAtlasUsageEviction, reporter, /* options */) {
+    sk_sp<GrContext> context = GrContext::MakeMock(nullptr, GrContextOptions());
+    auto proxyProvider = context->contextPriv().proxyProvider();
+    auto resourceProvider = context->contextPriv().resourceProvider();
+    TestingUploadTarget uploadTarget;
+    AtlasEvents events;
+
+    std::unique_ptr<GrDrawOpAtlas> atlas = GrDrawOpAtlas::Make(
+            proxyProvider, kAlpha_8_GrPixelConfig, kAtlasSize, kAtlasSize, kNumPlots, kNumPlots,
+            GrDrawOpAtlas::AllowMultitexturing::kNo, AtlasEvents::Evict, &events);
+    REPORTER_ASSERT(reporter, atlas);
+
+    GrDrawOpAtlas::AtlasID atlasIDs[kNumPlots * kNumPlots];
+    for (int i = 0; i < kNumPlots * kNumPlots; ++i) {
+        REPORTER_ASSERT(reporter, fill_plot(atlas.get(), resourceProvider, &uploadTarget,
+                                            &atlasIDs[i], i*32));
+    }
+
+    // The last plot is only used in the last flush, after the others, so the first plot is the
+    // least recently used, though it's used in every flush.
+    for (int i = 0; i < 8; ++i) {
+        use_and_flush(atlas.get(), &uploadTarget, atlasIDs, kNumPlots * kNumPlots - 1);
+    }
+    use_and_flush(atlas.get(), &uploadTarget, atlasIDs, kNumPlots * kNumPlots);
+
+    SkTArray<GrDrawOpAtlas::PlotStats> stats;
+    atlas->getPlotStats(&stats);
+    REPORTER_ASSERT(reporter, stats.count() == kNumPlots * kNumPlots);
+    for (const GrDrawOpAtlas::PlotStats& plotStats : stats) {
+        REPORTER_ASSERT(reporter, 1 == plotStats.fRectCount);
+        REPORTER_ASSERT(reporter, 1.0f == plotStats.fPercentFull);
+    }
+
+    GrDrawOpAtlas::AtlasID atlasID;
+    REPORTER_ASSERT(reporter, fill_plot(atlas.get(), resourceProvider, &uploadTarget, &atlasID,
+                                        4*32));
+    REPORTER_ASSERT(reporter, 1 == events.fEvicted.count());
+    REPORTER_ASSERT(reporter, events.fEvicted.count() &&
+                              atlasIDs[kNumPlots * kNumPlots - 1] == events.fEvicted[0]);
+    REPORTER_ASSERT(reporter, atlas->hasID(atlasIDs[0]));
+}
+
+// Makes an atlas that can move plots, with its first page full and one plot of the second in use.
+static std::unique_ptr<GrDrawOpAtlas> make_two_page_atlas(GrContext* context,
+                                                          TestingUploadTarget* uploadTarget,
+                                                          AtlasEvents* events,
+                                                          GrDrawOpAtlas::AtlasID* lastPageID) {
+    std::unique_ptr<GrDrawOpAtlas> atlas = GrDrawOpAtlas::Make(
+            context->contextPriv().proxyProvider(), kAlpha_8_GrPixelConfig, kAtlasSize,
+            kAtlasSize, kNumPlots, kNumPlots, GrDrawOpAtlas::AllowMultitexturing::kYes,
+            AtlasEvents::Evict, events, AtlasEvents::Move);
+    if (!atlas) {
+        return nullptr;
+    }
+    auto resourceProvider = context->contextPriv().resourceProvider();
+    GrDrawOpAtlas::AtlasID atlasID;
+    for (int i = 0; i < kNumPlots * kNumPlots; ++i) {
+        if (!fill_plot(atlas.get(), resourceProvider, uploadTarget, &atlasID, i*32)) {
+            return nullptr;
+        }
+    }
+    if (!fill_plot(atlas.get(), resourceProvider, uploadTarget, lastPageID, 4*32)) {
+        return nullptr;
+    }
+    return atlas;
+}
+
+// Compaction should move the plots still in use out of the last page, rather than evict them, when
+// the clients can handle it. The moves are written at the start of the next flush, before its ops.
+DEF_GPUTEST(DrawOpAtlasMoveCompaction, reporter, /* options */) {
+    sk_sp<GrContext> context = GrContext::MakeMock(nullptr, GrContextOptions());
+    GrOnFlushResourceProvider onFlushResourceProvider(
+            context->contextPriv().drawingManager());
+    TestingUploadTarget uploadTarget;
+    AtlasEvents events;
+
+    GrDrawOpAtlas::AtlasID lastPageID;
+    std::unique_ptr<GrDrawOpAtlas> atlas = make_two_page_atlas(context.get(), &uploadTarget,
+                                                               &events, &lastPageID);
+    REPORTER_ASSERT(reporter, atlas);
+    if (!atlas) {
+        return;
+    }
+    REPORTER_ASSERT(reporter, 2 == atlas->numActivePages());
+    REPORTER_ASSERT(reporter, 1 == GrDrawOpAtlas::GetPageIndexFromID(lastPageID));
+
+#if GR_GPU_STATS
+    GrGpu* gpu = context->contextPriv().getGpu();
+    gpu->stats()->reset();
+#endif
+    // Keep using only the plot in the second page until the first page's plots age out.
+    for (int i = 0; i < 512 && 2 == atlas->numActivePages(); ++i) {
+        atlas->instantiate(&onFlushResourceProvider);
+        if (1 == atlas->numActivePages()) {
+            break;
+        }
+        // The plot isn't moved until the flush after the compaction that planned it.
+        REPORTER_ASSERT(reporter, !events.fMovedFrom.count());
+        use_and_flush(atlas.get(), &uploadTarget, &lastPageID, 1);
+    }
+    REPORTER_ASSERT(reporter, 1 == atlas->numActivePages());
+#if GR_GPU_STATS
+    // The test's upload target drops the other uploads, so this is the moved plot's write.
+    REPORTER_ASSERT(reporter, 1 == gpu->stats()->textureUploads());
+    REPORTER_ASSERT(reporter, kPlotSize * kPlotSize == gpu->stats()->textureUploadBytes());
+    atlas->instantiate(&onFlushResourceProvider);
+    REPORTER_ASSERT(reporter, 1 == gpu->stats()->textureUploads());
+#endif
+    REPORTER_ASSERT(reporter, 1 == events.fMovedFrom.count());
+    if (1 != events.fMovedFrom.count()) {
+        return;
+    }
+    REPORTER_ASSERT(reporter, lastPageID == events.fMovedFrom[0]);
+    GrDrawOpAtlas::AtlasID movedID = events.fMovedTo[0];
+    REPORTER_ASSERT(reporter, 0 == GrDrawOpAtlas::GetPageIndexFromID(movedID));
+    REPORTER_ASSERT(reporter, atlas->hasID(movedID));
+    // The plot that was moved into was evicted, and nothing else was.
+    REPORTER_ASSERT(reporter, 1 == events.fEvicted.count());
+
+    SkTArray<GrDrawOpAtlas::PlotStats> stats;
+    atlas->getPlotStats(&stats);
+    // The moved plot keeps its contents and usage. The others were never used.
+    int usedPlots = 0;
+    for (const GrDrawOpAtlas::PlotStats& plotStats : stats) {
+        if (plotStats.fUsage) {
+            ++usedPlots;
+            REPORTER_ASSERT(reporter, 0xFF == plotStats.fUsage);
+            REPORTER_ASSERT(reporter, 1 == plotStats.fRectCount);
+        }
+    }
+    REPORTER_ASSERT(reporter, 1 == usedPlots);
+}
+
+// When the direct write of a moved plot fails, e.g. because the backend would need to draw it, the
+// plot should stay where it was, and later compactions should evict it instead.
+DEF_GPUTEST(DrawOpAtlasMoveWriteFailure, reporter, /* options */) {
+    sk_sp<GrContext> context = GrContext::MakeMock(nullptr, GrContextOptions());
+    TestingUploadTarget uploadTarget;
+    AtlasEvents events;
+
+    GrDrawOpAtlas::AtlasID lastPageID;
+    std::unique_ptr<GrDrawOpAtlas> atlas = make_two_page_atlas(context.get(), &uploadTarget,
+                                                               &events, &lastPageID);
+    REPORTER_ASSERT(reporter, atlas);
+    if (!atlas) {
+        return;
+    }
+
+    int writes = 0;
+    GrDeferredTextureUploadWritePixelsFn failingWrite =
+            [&writes](GrTextureProxy*, int, int, int, int, GrColorType, const void*, size_t) {
+                ++writes;
+                return false;
+            };
+    for (int i = 0; i < 512 && !writes; ++i) {
+        use_and_flush(atlas.get(), &uploadTarget, &lastPageID, 1);
+        atlas->movePlannedPlots(failingWrite);
+    }
+    REPORTER_ASSERT(reporter, 1 == writes);
+    // Nothing moved or was evicted, and the last page is still there.
+    REPORTER_ASSERT(reporter, !events.fMovedFrom.count());
+    REPORTER_ASSERT(reporter, !events.fEvicted.count());
+    REPORTER_ASSERT(reporter, 2 == atlas->numActivePages());
+    REPORTER_ASSERT(reporter, atlas->hasID(lastPageID));
+
+    SkTArray<GrDrawOpAtlas::PlotStats> stats;
+    atlas->getPlotStats(&stats);
+    // The plot in use in the last page keeps its contents.
+    int lastPagePlotsInUse = 0;
+    for (const GrDrawOpAtlas::PlotStats& plotStats : stats) {
+        if (1 == plotStats.fPageIndex && plotStats.fRectCount) {
+            ++lastPagePlotsInUse;
+            REPORTER_ASSERT(reporter, 1 == plotStats.fRectCount);
+            REPORTER_ASSERT(reporter, 0xFF == plotStats.fUsage);
+        }
+    }
+    REPORTER_ASSERT(reporter, 1 == lastPagePlotsInUse);
+
+    // The next compaction evicts the plot and deletes the last page, without trying to move.
+    use_and_flush(atlas.get(), &uploadTarget, &lastPageID, 1);
+    atlas->movePlannedPlots(failingWrite);
+    REPORTER_ASSERT(reporter, 1 == writes);
+    REPORTER_ASSERT(reporter, !events.fMovedFrom.count());
+    REPORTER_ASSERT(reporter, events.fEvicted.count() && lastPageID == events.fEvicted[0]);
+    REPORTER_ASSERT(reporter, 1 == atlas->numActivePages());
+}
+
 #endif
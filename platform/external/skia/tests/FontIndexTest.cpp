@@ -0,0 +1,130 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Resources.h"
+#include "SkFontIndex.h"
+#include "SkOSFile.h"
+#include "SkOSPath.h"
+#include "SkPaint.h"
+#include "SkStream.h"
+#include "SkTypeface.h"
+#include "Test.h"
+
+static bool copy_resource(const char* resource, const SkString& path) {
+    sk_sp<SkData> data = GetResourceAsData(resource);
+    SkFILEWStream stream(path.c_str());
+    return data && stream.isValid() && stream.write(data->data(), data->size());
+}
+
+// The face should match what scanning the font file finds, and its coverage what the typeface
+// maps to glyphs.
+static void check_face(skiatest::Reporter* reporter, const SkFontIndex::Face* face,
+                       const SkString& path) {
+    REPORTER_ASSERT(reporter, face);
+    if (!face) {
+        return;
+    }
+    SkTypeface_FreeType::Scanner scanner;
+    std::unique_ptr<SkStreamAsset> stream = SkStream::MakeFromFile(path.c_str());
+    SkString familyName;
+    SkFontStyle style;
+    bool isFixedPitch;
+    REPORTER_ASSERT(reporter, scanner.scanFont(stream.get(), 0, &familyName, &style,
+                                               &isFixedPitch, nullptr));
+    REPORTER_ASSERT(reporter, face->fFamilyName == familyName);
+    REPORTER_ASSERT(reporter, face->fStyle == style);
+    REPORTER_ASSERT(reporter, face->fIsFixedPitch == isFixedPitch);
+
+    SkPaint paint;
+    paint.setTypeface(SkTypeface::MakeFromFile(path.c_str()));
+    paint.setTextEncoding(SkPaint::kUTF32_TextEncoding);
+    for (SkUnichar character = 0; character < 0x3000; ++character) {
+        uint16_t glyphID;
+        paint.textToGlyphs(&character, sizeof(character), &glyphID);
+        REPORTER_ASSERT(reporter,
+                        SkFontIndex::Covers(*face->fCoverage, character) == (glyphID != 0));
+    }
+}
+
+DEF_TEST(FontIndex, reporter) {
+    SkString tmpDir = skiatest::GetTmpDir();
+    if (tmpDir.isEmpty()) {
+        INFOF(reporter, "no tmp dir, skipping\n");
+        return;
+    }
+    SkString fontPath = SkOSPath::Join(tmpDir.c_str(), "FontIndexTest.ttf");
+    SkString indexPath = SkOSPath::Join(tmpDir.c_str(), "FontIndexTest.index");
+    SkString missingPath = SkOSPath::Join(tmpDir.c_str(), "FontIndexTest_missing.ttf");
+    remove(indexPath.c_str());
+    if (!copy_resource("fonts/Em.ttf", fontPath)) {
+        ERRORF(reporter, "could not write %s\n", fontPath.c_str());
+        return;
+    }
+
+    SkTypeface_FreeType::Scanner scanner;
+    {
+        // Nothing to go on, so everything is scanned.
+        SkFontIndex index(scanner, indexPath.c_str());
+        REPORTER_ASSERT(reporter, 1 == index.countFaces(fontPath.c_str()));
+        check_face(reporter, index.findFace(fontPath.c_str(), 0), fontPath);
+        REPORTER_ASSERT(reporter, !index.findFace(fontPath.c_str(), 1));
+        REPORTER_ASSERT(reporter, 0 == index.countFaces(missingPath.c_str()));
+        REPORTER_ASSERT(reporter, 0 == index.countFaces(indexPath.c_str()));
+        index.save();
+    }
+    REPORTER_ASSERT(reporter, sk_exists(indexPath.c_str()));
+    {
+        // The font file is unchanged, so the face comes from the index.
+        SkFontIndex index(scanner, indexPath.c_str());
+        REPORTER_ASSERT(reporter, 1 == index.countFaces(fontPath.c_str()));
+        check_face(reporter, index.findFace(fontPath.c_str(), 0), fontPath);
+    }
+
+    // A different font file (of a different size) in the same place is scanned again.
+    if (!copy_resource("fonts/Funkster.ttf", fontPath)) {
+        ERRORF(reporter, "could not write %s\n", fontPath.c_str());
+        return;
+    }
+    {
+        SkFontIndex index(scanner, indexPath.c_str());
+        REPORTER_ASSERT(reporter, 1 == index.countFaces(fontPath.c_str()));
+        check_face(reporter, index.findFace(fontPath.c_str(), 0), fontPath);
+        index.save();
+    }
+
+    // A damaged index is ignored.
+    {
+        // Copied out of the mapping, which won't survive the file being rewritten.
+        sk_sp<SkData> data = SkData::MakeFromFileName(indexPath.c_str());
+        REPORTER_ASSERT(reporter, data);
+        data = SkData::MakeWithCopy(data->data(), data->size());
+        SkFILEWStream stream(indexPath.c_str());
+        stream.write(data->data(), data->size() / 2);
+    }
+    {
+        SkFontIndex index(scanner, indexPath.c_str());
+        REPORTER_ASSERT(reporter, 1 == index.countFaces(fontPath.c_str()));
+        check_face(reporter, index.findFace(fontPath.c_str(), 0), fontPath);
+    }
+
+    remove(fontPath.c_str());
+    remove(indexPath.c_str());
+}
+
+DEF_TEST(FontIndex_Covers, reporter) {
+    const SkUnichar ranges[] = { 'a', 'c', 'x', 'x', 0x4E00, 0x9FFF };
+    sk_sp<SkData> coverage = SkData::MakeWithoutCopy(ranges, sizeof(ranges));
+    const SkUnichar covered[] = { 'a', 'b', 'c', 'x', 0x4E00, 0x6000, 0x9FFF };
+    for (SkUnichar character : covered) {
+        REPORTER_ASSERT(reporter, SkFontIndex::Covers(*coverage, character));
+    }
+    const SkUnichar uncovered[] = { 0, '`', 'd', 'w', 'y', 0x4DFF, 0xA000, 0x10FFFF };
+    for (SkUnichar character : uncovered) {
+        REPORTER_ASSERT(reporter, !SkFontIndex::Covers(*coverage, character));
+    }
+    REPORTER_ASSERT(reporter, !SkFontIndex::Covers(*SkData::MakeEmpty(), 'a'));
+}
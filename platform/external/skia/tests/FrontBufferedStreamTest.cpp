@@ -48,13 +48,33 @@ static void test_hasLength(skiatest::Reporter* reporter,
 // smaller than the string length.
 const char gAbcs[] = "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwx";
 
+// An SkMemoryStream that doesn't say where its memory is, so FrontBufferedStream has to copy what
+// it buffers, like it does for streams that aren't in memory.
+class HiddenMemoryStream : public SkMemoryStream {
+public:
+    HiddenMemoryStream(const void* data, size_t size) : INHERITED(data, size, false) {}
+
+    const void* getMemoryBase() override { return nullptr; }
+
+private:
+    typedef SkMemoryStream INHERITED;
+};
+
+static SkMemoryStream* make_abcs_stream(bool inMemory) {
+    if (inMemory) {
+        return SkMemoryStream::MakeDirect(gAbcs, strlen(gAbcs)).release();
+    }
+    return new HiddenMemoryStream(gAbcs, strlen(gAbcs));
+}
+
 // Tests reading the stream across boundaries of what has been buffered so far and what
 // the total buffer size is.
-static void test_incremental_buffering(skiatest::Reporter* reporter, size_t bufferSize) {
+static void test_incremental_buffering(skiatest::Reporter* reporter, size_t bufferSize,
+                                       bool inMemory) {
     // NOTE: For this and other tests in this file, we cheat and continue to refer to the
     // wrapped stream, but that's okay because we know the wrapping stream has not been
     // deleted yet (and we only call const methods in it).
-    SkMemoryStream* memStream = SkMemoryStream::MakeDirect(gAbcs, strlen(gAbcs)).release();
+    SkMemoryStream* memStream = make_abcs_stream(inMemory);
 
     auto bufferedStream = SkFrontBufferedStream::Make(std::unique_ptr<SkStream>(memStream),
                                                       bufferSize);
@@ -82,8 +102,9 @@ static void test_incremental_buffering(skiatest::Reporter* reporter, size_t buff
     test_rewind(reporter, bufferedStream.get(), false);
 }
 
-static void test_perfectly_sized_buffer(skiatest::Reporter* reporter, size_t bufferSize) {
-    SkMemoryStream* memStream = SkMemoryStream::MakeDirect(gAbcs, strlen(gAbcs)).release();
+static void test_perfectly_sized_buffer(skiatest::Reporter* reporter, size_t bufferSize,
+                                        bool inMemory) {
+    SkMemoryStream* memStream = make_abcs_stream(inMemory);
     auto bufferedStream = SkFrontBufferedStream::Make(std::unique_ptr<SkStream>(memStream),
                                                       bufferSize);
     test_hasLength(reporter, *bufferedStream, *memStream);
@@ -102,8 +123,8 @@ static void test_perfectly_sized_buffer(skiatest::Reporter* reporter, size_t buf
     test_rewind(reporter, bufferedStream.get(), false);
 }
 
-static void test_skipping(skiatest::Reporter* reporter, size_t bufferSize) {
-    SkMemoryStream* memStream = SkMemoryStream::MakeDirect(gAbcs, strlen(gAbcs)).release();
+static void test_skipping(skiatest::Reporter* reporter, size_t bufferSize, bool inMemory) {
+    SkMemoryStream* memStream = make_abcs_stream(inMemory);
     auto bufferedStream = SkFrontBufferedStream::Make(std::unique_ptr<SkStream>(memStream),
                                                       bufferSize);
     test_hasLength(reporter, *bufferedStream, *memStream);
@@ -247,9 +268,11 @@ static void test_initial_offset(skiatest::Reporter* reporter, size_t bufferSize)
 }
 
 static void test_buffers(skiatest::Reporter* reporter, size_t bufferSize) {
-    test_incremental_buffering(reporter, bufferSize);
-    test_perfectly_sized_buffer(reporter, bufferSize);
-    test_skipping(reporter, bufferSize);
+    for (bool inMemory : { true, false }) {
+        test_incremental_buffering(reporter, bufferSize, inMemory);
+        test_perfectly_sized_buffer(reporter, bufferSize, inMemory);
+        test_skipping(reporter, bufferSize, inMemory);
+    }
     test_read_beyond_buffer(reporter, bufferSize);
     test_length_combos(reporter, bufferSize);
     test_initial_offset(reporter, bufferSize);
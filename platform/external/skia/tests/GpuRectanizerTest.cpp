@@ -7,6 +7,7 @@
 
 #if SK_SUPPORT_GPU
 
+#include "GrRectanizer_maxrects.h"
 #include "GrRectanizer_pow2.h"
 #include "GrRectanizer_skyline.h"
 #include "SkRandom.h"
@@ -58,6 +59,35 @@ static void test_pow2(skiatest::Reporter* reporter, const SkTDArray<SkISize>& re
     test_rectanizer_inserts(reporter, &pow2Rectanizer, rects);
 }
 
+static void test_maxrects(skiatest::Reporter* reporter, const SkTDArray<SkISize>& rects) {
+    GrRectanizerMaxRects maxRectsRectanizer(kWidth, kHeight);
+
+    test_rectanizer_basic(reporter, &maxRectsRectanizer);
+    test_rectanizer_inserts(reporter, &maxRectsRectanizer, rects);
+}
+
+// Packs glyph-sized rects until one doesn't fit, and checks that they all lie within the
+// rectanizer without overlapping.
+static void test_rectanizer_no_overlap(skiatest::Reporter* reporter, GrRectanizer* rectanizer) {
+    SkRandom rand;
+    SkTDArray<SkIRect> placed;
+    while (true) {
+        int width = rand.nextRangeU(3, 40);
+        int height = rand.nextRangeU(3, 40);
+        SkIPoint16 loc;
+        if (!rectanizer->addRect(width, height, &loc)) {
+            break;
+        }
+        SkIRect rect = SkIRect::MakeXYWH(loc.fX, loc.fY, width, height);
+        REPORTER_ASSERT(reporter, SkIRect::MakeWH(kWidth, kHeight).contains(rect));
+        for (const SkIRect& other : placed) {
+            REPORTER_ASSERT(reporter, !SkIRect::Intersects(rect, other));
+        }
+        *placed.append() = rect;
+    }
+    REPORTER_ASSERT(reporter, placed.count() > 0);
+}
+
 DEF_GPUTEST(GpuRectanizer, reporter, factory) {
     SkTDArray<SkISize> rects;
     SkRandom rand;
@@ -69,6 +99,15 @@ DEF_GPUTEST(GpuRectanizer, reporter, factory) {
 
     test_skyline(reporter, rects);
     test_pow2(reporter, rects);
+    test_maxrects(reporter, rects);
+
+    GrRectanizerSkyline skylineRectanizer(kWidth, kHeight);
+    test_rectanizer_no_overlap(reporter, &skylineRectanizer);
+    GrRectanizerMaxRects maxRectsRectanizer(kWidth, kHeight);
+    test_rectanizer_no_overlap(reporter, &maxRectsRectanizer);
+    // The maximal free rects are what let it fill the gaps that the skyline leaves.
+    REPORTER_ASSERT(reporter,
+                    maxRectsRectanizer.percentFull() >= skylineRectanizer.percentFull());
 }
 
 #endif
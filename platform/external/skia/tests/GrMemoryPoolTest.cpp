@@ -9,11 +9,14 @@
 // This is a GPU-backend specific test
 #if SK_SUPPORT_GPU
 #include "GrMemoryPool.h"
+#include "GrOpArena.h"
 #include "SkRandom.h"
 #include "SkTArray.h"
 #include "SkTDArray.h"
 #include "SkTemplates.h"
 
+#include <thread>
+
 // A is the top of an inheritance tree of classes that overload op new and
 // and delete to use a GrMemoryPool. The objects have values of different types
 // that can be set and checked.
@@ -398,4 +401,54 @@ DEF_TEST(GrObjectMemoryPoolAPI, reporter) {
     }
 }
 
+DEF_TEST(GrOpArena, reporter) {
+    GrMemoryPool pool(0, 0);
+    auto poolAllocate = [&pool](size_t size) { return pool.allocate(size); };
+    auto poolRelease = [&pool](void* p) { pool.release(p); };
+
+    // Without an arena installed, allocations come from the pool.
+    REPORTER_ASSERT(reporter, !GrOpArena::Current());
+    void* p = GrOpArena::Allocate(40, poolAllocate);
+    REPORTER_ASSERT(reporter, !pool.isEmpty());
+    GrOpArena::Release(p, poolRelease);
+    REPORTER_ASSERT(reporter, pool.isEmpty());
+
+    sk_sp<GrOpArena> arena = sk_make_sp<GrOpArena>(1024);
+    SkTDArray<int*> allocs;
+    {
+        GrOpArena::AutoInstall install(arena.get());
+        REPORTER_ASSERT(reporter, GrOpArena::Current() == arena.get());
+        for (int i = 0; i < 200; ++i) {
+            // Some of these are larger than a block.
+            size_t count = (i % 50) ? 1 + i % 7 : 400;
+            int* values = static_cast<int*>(GrOpArena::Allocate(count * sizeof(int),
+                                                                poolAllocate));
+            REPORTER_ASSERT(reporter, !(reinterpret_cast<intptr_t>(values) % 8));
+            for (size_t j = 0; j < count; ++j) {
+                values[j] = i;
+            }
+            *allocs.append() = values;
+        }
+    }
+    REPORTER_ASSERT(reporter, !GrOpArena::Current());
+    REPORTER_ASSERT(reporter, pool.isEmpty());
+    REPORTER_ASSERT(reporter, arena->size() >= 200 * 8 + 4 * 400 * sizeof(int));
+    for (int i = 0; i < allocs.count(); ++i) {
+        REPORTER_ASSERT(reporter, allocs[i][0] == i);
+    }
+
+    // Drop the owner's ref first, then release the allocations on another thread. The last one
+    // frees the arena.
+    GrOpArena* weakArena = arena.get();
+    arena.reset();
+    std::thread([&]() {
+        for (int i = 0; i < allocs.count() - 1; ++i) {
+            GrOpArena::Release(allocs[i], poolRelease);
+        }
+    }).join();
+    REPORTER_ASSERT(reporter, weakArena->unique());
+    GrOpArena::Release(allocs.top(), poolRelease);
+    REPORTER_ASSERT(reporter, pool.isEmpty());
+}
+
 #endif
@@ -0,0 +1,207 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkTypes.h"
+#include "Test.h"
+
+#if SK_SUPPORT_GPU
+
+#include "GrContext.h"
+#include "GrOpBoundsIndex.h"
+#include "GrRect.h"
+#include "GrRenderTargetContext.h"
+#include "GrRenderTargetContextPriv.h"
+#include "SkMakeUnique.h"
+#include "SkRandom.h"
+#include "ops/GrDrawOp.h"
+
+static SkRect random_rect(SkRandom* rand) {
+    // Mostly small rects, some of them partly outside the 256x256 target, and a few large ones.
+    SkScalar size = rand->nextULessThan(16) ? rand->nextRangeScalar(1, 24)
+                                            : rand->nextRangeScalar(100, 400);
+    SkScalar x = rand->nextRangeScalar(-20, 256), y = rand->nextRangeScalar(-20, 256);
+    return SkRect::MakeXYWH(x, y, size, rand->nextRangeScalar(1, size));
+}
+
+static bool overlaps(const SkTArray<SkRect>& pieces, const SkRect& bounds) {
+    for (const SkRect& piece : pieces) {
+        if (GrRectsOverlap(piece, bounds)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+DEF_TEST(GrOpBoundsIndex, reporter) {
+    SkRandom rand;
+    GrOpBoundsIndex index;
+    index.reset(SkRect::MakeWH(256, 256));
+    // Where each op draws, as the index should see it.
+    SkTArray<SkTArray<SkRect>> ops;
+    SkTDArray<uint32_t> classes;
+
+    for (int i = 0; i < 500; ++i) {
+        SkRect query = random_rect(&rand);
+
+        int expectedLast = -1;
+        for (int j = ops.count() - 1; j >= 0; --j) {
+            if (overlaps(ops[j], query)) {
+                expectedLast = j;
+                break;
+            }
+        }
+        REPORTER_ASSERT(reporter, index.lastOverlapping(query) == expectedLast);
+
+        if (ops.count()) {
+            int opIndex = rand.nextULessThan(ops.count());
+            int expectedFirst = ops.count();
+            for (int j = opIndex + 1; j < ops.count() && expectedFirst == ops.count(); ++j) {
+                for (const SkRect& piece : ops[opIndex]) {
+                    if (overlaps(ops[j], piece)) {
+                        expectedFirst = j;
+                        break;
+                    }
+                }
+            }
+            REPORTER_ASSERT(reporter, index.firstOverlappingAfter(opIndex) == expectedFirst);
+
+            // Combine another draw into an earlier op, or an earlier op into a later one.
+            int dst = rand.nextULessThan(ops.count());
+            if (rand.nextBool()) {
+                SkRect bounds = random_rect(&rand);
+                index.addBounds(dst, bounds);
+                ops[dst].push_back(bounds);
+            } else if (dst > 0) {
+                int src = rand.nextULessThan(dst);
+                index.moveBounds(src, dst);
+                ops[dst].push_back_n(ops[src].count(), ops[src].begin());
+            }
+        }
+
+        uint32_t classID = rand.nextRangeU(1, 4);
+        index.append(query, classID);
+        ops.push_back().push_back(query);
+        *classes.append() = classID;
+    }
+    REPORTER_ASSERT(reporter, index.count() == ops.count());
+
+    for (uint32_t classID = 0; classID <= 5; ++classID) {
+        SkTDArray<int> expected;
+        for (int j = 0; j < classes.count(); ++j) {
+            if (classes[j] == classID) {
+                *expected.append() = j;
+            }
+        }
+        const SkTDArray<int>* classOps = index.opsOfClass(classID);
+        REPORTER_ASSERT(reporter, (classOps ? classOps->count() : 0) == expected.count());
+        if (classOps && classOps->count() == expected.count()) {
+            REPORTER_ASSERT(reporter, !memcmp(classOps->begin(), expected.begin(),
+                                              expected.count() * sizeof(int)));
+        }
+    }
+}
+
+namespace {
+
+// An op that combines with the other ops of the same kind, and records how many ops each of the
+// drawn ops ended up holding. Ops of a negative kind never combine. Each tag is its own op class.
+template <int kTag>
+class CombineTestOp : public GrDrawOp {
+public:
+    DEFINE_OP_CLASS_ID
+
+    CombineTestOp(const SkRect& bounds, int kind, SkTDArray<int>* drawn)
+        : INHERITED(ClassID())
+        , fKind(kind)
+        , fDrawn(drawn) {
+        this->setBounds(bounds, HasAABloat::kNo, IsZeroArea::kNo);
+    }
+
+    const char* name() const override { return "CombineTestOp"; }
+
+private:
+    FixedFunctionFlags fixedFunctionFlags() const override { return FixedFunctionFlags::kNone; }
+    RequiresDstTexture finalize(const GrCaps&, const GrAppliedClip*,
+                                GrPixelConfigIsClamped) override {
+        return RequiresDstTexture::kNo;
+    }
+    bool onCombineIfPossible(GrOp* t, const GrCaps&) override {
+        CombineTestOp<kTag>* that = t->cast<CombineTestOp<kTag>>();
+        if (fKind < 0 || fKind != that->fKind) {
+            return false;
+        }
+        fCount += that->fCount;
+        this->joinBounds(*that);
+        return true;
+    }
+    void onPrepare(GrOpFlushState*) override {}
+    void onExecute(GrOpFlushState*) override { *fDrawn->append() = fCount; }
+
+    int             fKind;
+    int             fCount = 1;
+    SkTDArray<int>* fDrawn;
+
+    typedef GrDrawOp INHERITED;
+};
+
+}  // namespace
+
+DEF_GPUTEST(GrRenderTargetOpList_IndexedCombining, reporter, /* options */) {
+    sk_sp<GrContext> ctx = GrContext::MakeMock(nullptr, GrContextOptions());
+    sk_sp<GrRenderTargetContext> rtc = ctx->makeDeferredRenderTargetContext(
+            SkBackingFit::kExact, 256, 256, kRGBA_8888_GrPixelConfig, nullptr);
+    REPORTER_ASSERT(reporter, rtc);
+
+    SkTDArray<int> drawn;
+    int box = 0;
+    auto addOp = [&](int kind) {
+        SkRect bounds = SkRect::MakeXYWH((box % 16) * 16, (box / 16) * 16, 10, 10);
+        ++box;
+        if (kind < 0) {
+            rtc->priv().testingOnly_addDrawOp(
+                    skstd::make_unique<CombineTestOp<1>>(bounds, kind, &drawn));
+        } else {
+            rtc->priv().testingOnly_addDrawOp(
+                    skstd::make_unique<CombineTestOp<0>>(bounds, kind, &drawn));
+        }
+    };
+
+    // More ops of another class than the linear search looks back over, between two groups of
+    // combinable ops. Nothing overlaps, so the groups are combined.
+    for (int i = 0; i < 5; ++i) {
+        addOp(0);
+    }
+    for (int i = 0; i < 20; ++i) {
+        addOp(-1);
+    }
+    for (int i = 0; i < 5; ++i) {
+        addOp(0);
+    }
+    ctx->flush();
+    REPORTER_ASSERT(reporter, drawn.count() == 21);
+    REPORTER_ASSERT(reporter, drawn.count() && drawn[0] == 10);
+
+    // The same, with an op in between that overlaps both groups, so neither can move past it.
+    drawn.rewind();
+    box = 0;
+    for (int i = 0; i < 5; ++i) {
+        addOp(0);
+    }
+    for (int i = 0; i < 20; ++i) {
+        addOp(-1);
+    }
+    rtc->priv().testingOnly_addDrawOp(skstd::make_unique<CombineTestOp<1>>(
+            SkRect::MakeWH(256, 32), -1, &drawn));
+    for (int i = 0; i < 5; ++i) {
+        addOp(0);
+    }
+    ctx->flush();
+    REPORTER_ASSERT(reporter, drawn.count() == 23);
+    REPORTER_ASSERT(reporter, drawn.count() == 23 && drawn[0] == 5 && drawn[22] == 5);
+}
+
+#endif
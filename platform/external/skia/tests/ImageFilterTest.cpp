@@ -10,6 +10,7 @@
 #include "SkBlurImageFilter.h"
 #include "SkCanvas.h"
 #include "SkColorFilterImageFilter.h"
+#include "SkColorData.h"
 #include "SkColorMatrixFilter.h"
 #include "SkColorSpaceXformer.h"
 #include "SkComposeImageFilter.h"
@@ -30,6 +31,7 @@
 #include "SkPictureImageFilter.h"
 #include "SkPictureRecorder.h"
 #include "SkPoint3.h"
+#include "SkRandom.h"
 #include "SkReadBuffer.h"
 #include "SkRect.h"
 #include "SkSpecialImage.h"
@@ -1175,6 +1177,197 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(ImageFilterMatrixConvolutionBigKernel_Gpu,
 }
 #endif
 
+static SkBitmap make_random_premul_bitmap(int width, int height) {
+    SkRandom rand;
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(width, height);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            U8CPU a = rand.nextULessThan(256);
+            *bitmap.getAddr32(x, y) = SkPackARGB32(a, rand.nextULessThan(a + 1),
+                                                   rand.nextULessThan(a + 1),
+                                                   rand.nextULessThan(a + 1));
+        }
+    }
+    return bitmap;
+}
+
+// Filters all of 'bitmap', on the CPU, into a bitmap of the same size. The filter needs to be
+// cropped to the bitmap, or the result may be larger.
+static bool filter_bitmap(SkImageFilter* filter, const SkBitmap& bitmap, SkBitmap* result) {
+    SkIRect bounds = SkIRect::MakeWH(bitmap.width(), bitmap.height());
+    sk_sp<SkSpecialImage> source(SkSpecialImage::MakeFromRaster(bounds, bitmap));
+    SkImageFilter::OutputProperties noColorSpace(nullptr);
+    SkImageFilter::Context ctx(SkMatrix::I(), bounds, nullptr, noColorSpace);
+    SkIPoint offset;
+    sk_sp<SkSpecialImage> image(filter->filterImage(source.get(), ctx, &offset));
+    return image && image->width() == bitmap.width() && image->height() == bitmap.height() &&
+           offset.isZero() && image->getROPixels(result);
+}
+
+static int max_channel_diff(SkPMColor a, SkPMColor b) {
+    int diff = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        diff = SkTMax(diff, SkTAbs((int)((a >> shift) & 0xFF) - (int)((b >> shift) & 0xFF)));
+    }
+    return diff;
+}
+
+DEF_TEST(ImageFilterMorphologyLargeRadius, reporter) {
+    // Large radii take a different path than small ones, whose cost doesn't grow with the radius.
+    SkBitmap bitmap = make_random_premul_bitmap(45, 31);
+    SkImageFilter::CropRect crop(SkRect::MakeIWH(bitmap.width(), bitmap.height()));
+    const SkISize radii[] = { {1, 2}, {3, 0}, {4, 5}, {0, 9}, {20, 13}, {60, 60} };
+    for (bool dilate : { true, false }) {
+        for (const SkISize& radius : radii) {
+            sk_sp<SkImageFilter> filter = dilate
+                    ? SkDilateImageFilter::Make(radius.width(), radius.height(), nullptr, &crop)
+                    : SkErodeImageFilter::Make(radius.width(), radius.height(), nullptr, &crop);
+            SkBitmap result;
+            if (!filter_bitmap(filter.get(), bitmap, &result)) {
+                ERRORF(reporter, "could not filter with radius %dx%d", radius.width(),
+                       radius.height());
+                continue;
+            }
+            int mismatches = 0;
+            for (int y = 0; y < bitmap.height(); ++y) {
+                for (int x = 0; x < bitmap.width(); ++x) {
+                    // The window is clipped to the bitmap.
+                    SkIRect window = SkIRect::MakeLTRB(x - radius.width(), y - radius.height(),
+                                                       x + radius.width() + 1,
+                                                       y + radius.height() + 1);
+                    SkAssertResult(window.intersect(SkIRect::MakeWH(bitmap.width(),
+                                                                    bitmap.height())));
+                    SkPMColor expected = 0;
+                    for (int shift = 0; shift < 32; shift += 8) {
+                        uint32_t extreme = dilate ? 0 : 0xFF;
+                        for (int wy = window.fTop; wy < window.fBottom; ++wy) {
+                            for (int wx = window.fLeft; wx < window.fRight; ++wx) {
+                                uint32_t c = (*bitmap.getAddr32(wx, wy) >> shift) & 0xFF;
+                                extreme = dilate ? SkTMax(extreme, c) : SkTMin(extreme, c);
+                            }
+                        }
+                        expected |= extreme << shift;
+                    }
+                    mismatches += *result.getAddr32(x, y) != expected;
+                }
+            }
+            REPORTER_ASSERT(reporter, !mismatches, "%s %dx%d: %d pixels differ",
+                            dilate ? "dilate" : "erode", radius.width(), radius.height(),
+                            mismatches);
+        }
+    }
+}
+
+DEF_TEST(ImageFilterMatrixConvolutionInterior, reporter) {
+    // Where the kernel stays within the bitmap, pixels are convolved several at a time. Check
+    // them against convolving one channel at a time.
+    SkBitmap bitmap = make_random_premul_bitmap(37, 23);
+    SkScalar kernel[20];
+    SkRandom rand;
+    for (SkScalar& k : kernel) {
+        k = rand.nextRangeScalar(-1, 1);
+    }
+    const SkISize kernelSize = SkISize::Make(5, 4);
+    const SkIPoint kernelOffset = SkIPoint::Make(3, 1);
+    const SkScalar gain = 0.7f, bias = 40;
+    SkImageFilter::CropRect crop(SkRect::MakeIWH(bitmap.width(), bitmap.height()));
+    sk_sp<SkImageFilter> filter(SkMatrixConvolutionImageFilter::Make(
+            kernelSize, kernel, gain, bias, kernelOffset,
+            SkMatrixConvolutionImageFilter::kClamp_TileMode, true, nullptr, &crop));
+    SkBitmap result;
+    if (!filter_bitmap(filter.get(), bitmap, &result)) {
+        ERRORF(reporter, "could not filter");
+        return;
+    }
+    int maxDiff = 0;
+    for (int y = kernelOffset.fY; y <= bitmap.height() - kernelSize.height() + kernelOffset.fY;
+         ++y) {
+        for (int x = kernelOffset.fX; x <= bitmap.width() - kernelSize.width() + kernelOffset.fX;
+             ++x) {
+            int channels[4];
+            for (int c = 0; c < 4; ++c) {
+                SkScalar sum = 0;
+                for (int ky = 0; ky < kernelSize.height(); ++ky) {
+                    for (int kx = 0; kx < kernelSize.width(); ++kx) {
+                        SkPMColor p = *bitmap.getAddr32(x + kx - kernelOffset.fX,
+                                                        y + ky - kernelOffset.fY);
+                        sum += ((p >> (8 * c)) & 0xFF) * kernel[ky * kernelSize.width() + kx];
+                    }
+                }
+                channels[c] = SkClampMax(SkScalarFloorToInt(sum * gain + bias), 255);
+            }
+            // Colors are clamped to alpha.
+            int alpha = channels[SK_A32_SHIFT / 8];
+            SkPMColor expected = 0;
+            for (int c = 0; c < 4; ++c) {
+                expected |= SkTMin(channels[c], alpha) << (8 * c);
+            }
+            maxDiff = SkTMax(maxDiff, max_channel_diff(*result.getAddr32(x, y), expected));
+        }
+    }
+    REPORTER_ASSERT(reporter, maxDiff <= 1, "max channel difference %d", maxDiff);
+}
+
+DEF_TEST(ImageFilterLightingInterior, reporter) {
+    // Pixels away from the edges are lit several at a time. Check them against lighting a
+    // surface whose alpha rises linearly, so that its normal is the same everywhere.
+    const int width = 40, height = 30;
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(width, height);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            *bitmap.getAddr32(x, y) = SkPackARGB32(4 * x + 3 * y, 0, 0, 0);
+        }
+    }
+    const SkPoint3 location = SkPoint3::Make(17, 9, 20);
+    const SkScalar surfaceScale = 25.5f, kd = 1.5f, ks = 1.2f, shininess = 5;
+    const SkColor lightColor = SkColorSetRGB(0xFF, 0xC0, 0x80);
+    // Heights are alpha in [0, 1], times the surface scale. The sobel filter gives twice the
+    // slope, and the normal leans away from it.
+    const SkScalar heightScale = surfaceScale / 255;
+    SkPoint3 normal = SkPoint3::Make(-8 * heightScale, -6 * heightScale, 1);
+    normal.normalize();
+    SkImageFilter::CropRect crop(SkRect::MakeIWH(width, height));
+
+    for (bool specular : { false, true }) {
+        sk_sp<SkImageFilter> filter = specular
+                ? SkLightingImageFilter::MakePointLitSpecular(location, lightColor, surfaceScale,
+                                                              ks, shininess, nullptr, &crop)
+                : SkLightingImageFilter::MakePointLitDiffuse(location, lightColor, surfaceScale,
+                                                             kd, nullptr, &crop);
+        SkBitmap result;
+        if (!filter_bitmap(filter.get(), bitmap, &result)) {
+            ERRORF(reporter, "could not filter");
+            continue;
+        }
+        int maxDiff = 0;
+        for (int y = 1; y < height - 1; ++y) {
+            for (int x = 1; x < width - 1; ++x) {
+                SkPoint3 toLight = location - SkPoint3::Make(x, y, (4 * x + 3 * y) * heightScale);
+                toLight.normalize();
+                SkScalar scale;
+                if (specular) {
+                    SkPoint3 halfDir = toLight + SkPoint3::Make(0, 0, 1);
+                    halfDir.normalize();
+                    scale = ks * SkScalarPow(normal.dot(halfDir), shininess);
+                } else {
+                    scale = kd * normal.dot(toLight);
+                }
+                scale = SkScalarClampMax(scale, 1);
+                int r = SkScalarRoundToInt(SkColorGetR(lightColor) * scale),
+                    g = SkScalarRoundToInt(SkColorGetG(lightColor) * scale),
+                    b = SkScalarRoundToInt(SkColorGetB(lightColor) * scale);
+                int a = specular ? SkTMax(r, SkTMax(g, b)) : 255;
+                maxDiff = SkTMax(maxDiff, max_channel_diff(*result.getAddr32(x, y),
+                                                           SkPackARGB32(a, r, g, b)));
+            }
+        }
+        REPORTER_ASSERT(reporter, maxDiff <= 2, "%s: max channel difference %d",
+                        specular ? "specular" : "diffuse", maxDiff);
+    }
+}
+
 DEF_TEST(ImageFilterCropRect, reporter) {
     test_crop_rects(reporter, nullptr);
 }
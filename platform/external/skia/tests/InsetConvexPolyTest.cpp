@@ -6,6 +6,8 @@
  */
 #include "Test.h"
 #include "SkInsetConvexPolygon.h"
+#include "SkPointPriv.h"
+#include "SkRandom.h"
 
 static bool is_convex(const SkTDArray<SkPoint>& poly) {
     if (poly.count() < 3) {
@@ -127,3 +129,34 @@ DEF_TEST(InsetConvexPoly, reporter) {
     REPORTER_ASSERT(reporter, result);
     REPORTER_ASSERT(reporter, is_convex(insetPoly));
 }
+
+// The constant inset offsets the edges several at a time. It should match the general version.
+DEF_TEST(InsetConvexPolyConstant, reporter) {
+    SkRandom rand;
+    for (int i = 0; i < 100; ++i) {
+        // An ellipse, with the points in either direction.
+        int count = 3 + rand.nextULessThan(30);
+        SkScalar rx = rand.nextRangeScalar(5, 200), ry = rand.nextRangeScalar(5, 200);
+        SkScalar start = rand.nextRangeScalar(0, 2*SK_ScalarPI);
+        SkScalar dir = rand.nextBool() ? 1 : -1;
+        SkTDArray<SkPoint> poly;
+        for (int j = 0; j < count; ++j) {
+            SkScalar angle = start + dir*j*2*SK_ScalarPI/count;
+            *poly.push() = SkPoint::Make(300 + rx*SkScalarCos(angle), 200 + ry*SkScalarSin(angle));
+        }
+
+        SkScalar inset = rand.nextRangeScalar(0.5f, 0.5f*SkTMin(rx, ry));
+        SkTDArray<SkPoint> constantPoly, generalPoly;
+        bool constantResult = SkInsetConvexPolygon(poly.begin(), count, inset, &constantPoly);
+        bool generalResult = SkInsetConvexPolygon(poly.begin(), count,
+                                                  [inset](int) { return inset; }, &generalPoly);
+        REPORTER_ASSERT(reporter, constantResult == generalResult);
+        REPORTER_ASSERT(reporter, constantPoly.count() == generalPoly.count());
+        if (constantPoly.count() == generalPoly.count()) {
+            for (int j = 0; j < constantPoly.count(); ++j) {
+                REPORTER_ASSERT(reporter, SkPointPriv::EqualsWithinTolerance(constantPoly[j],
+                                                                             generalPoly[j]));
+            }
+        }
+    }
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkBitmap.h"
+#include "SkCanvas.h"
+#include "SkMultiPictureDocument.h"
+#include "SkPicture.h"
+#include "SkPictureRecorder.h"
+#include "SkStream.h"
+#include "Test.h"
+
+#include <functional>
+
+static const int kPageCount = 5;
+
+static SkSize page_size(int page) {
+    return SkSize::Make(100 + 10 * page, 80 + 5 * page);
+}
+
+static void draw_page(SkCanvas* canvas, int page) {
+    canvas->clear(SK_ColorWHITE);
+    SkPaint paint;
+    paint.setColor(SkColorSetARGB(0xFF, 40 * page, 255 - 40 * page, 0x80));
+    canvas->drawRect(SkRect::MakeXYWH(5 * page, 10, 40, 30), paint);
+    paint.setAntiAlias(true);
+    canvas->drawCircle(60, 40 + 3 * page, 10 + page, paint);
+}
+
+static SkBitmap draw_to_bitmap(const SkSize& size, std::function<void(SkCanvas*)> draw) {
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(SkScalarCeilToInt(size.width()), SkScalarCeilToInt(size.height()));
+    SkCanvas canvas(bitmap);
+    draw(&canvas);
+    return bitmap;
+}
+
+static bool equal_pixels(const SkBitmap& a, const SkBitmap& b) {
+    if (a.dimensions() != b.dimensions()) {
+        return false;
+    }
+    for (int y = 0; y < a.height(); ++y) {
+        if (memcmp(a.getAddr32(0, y), b.getAddr32(0, y), a.width() * sizeof(uint32_t))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void check_pages(skiatest::Reporter* reporter, SkStreamSeekable* stream,
+                        bool parallel = false) {
+    REPORTER_ASSERT(reporter, kPageCount == SkMultiPictureDocumentReadPageCount(stream));
+    SkDocumentPage pages[kPageCount];
+    REPORTER_ASSERT(reporter, SkMultiPictureDocumentRead(stream, pages, kPageCount, nullptr,
+                                                         parallel));
+    for (int i = 0; i < kPageCount; ++i) {
+        REPORTER_ASSERT(reporter, pages[i].fSize == page_size(i));
+        REPORTER_ASSERT(reporter, pages[i].fPicture);
+        if (!pages[i].fPicture) {
+            continue;
+        }
+        SkBitmap expected = draw_to_bitmap(page_size(i), [i](SkCanvas* c) { draw_page(c, i); });
+        SkBitmap actual = draw_to_bitmap(page_size(i), [&](SkCanvas* c) {
+            c->drawPicture(pages[i].fPicture);
+        });
+        REPORTER_ASSERT(reporter, equal_pixels(expected, actual));
+    }
+}
+
+static sk_sp<SkData> make_document(bool parallel) {
+    SkDynamicMemoryWStream stream;
+    sk_sp<SkDocument> doc = SkMakeMultiPictureDocument(&stream, nullptr, parallel);
+    for (int i = 0; i < kPageCount; ++i) {
+        SkSize size = page_size(i);
+        draw_page(doc->beginPage(size.width(), size.height()), i);
+        doc->endPage();
+    }
+    doc->close();
+    return stream.detachAsData();
+}
+
+namespace {
+    class NotInMemoryStream : public SkMemoryStream {
+    public:
+        using SkMemoryStream::SkMemoryStream;
+        const void* getMemoryBase() override { return nullptr; }
+    };
+
+    class NoLengthStream : public NotInMemoryStream {
+    public:
+        using NotInMemoryStream::NotInMemoryStream;
+        bool hasLength() const override { return false; }
+    };
+}
+
+DEF_TEST(MultiPictureDocument, reporter) {
+    sk_sp<SkData> data = make_document(false);
+
+    // The pages are read where they are from memory, and copied out of other streams.
+    SkMemoryStream memoryStream(data);
+    check_pages(reporter, &memoryStream);
+    NotInMemoryStream notInMemoryStream(data);
+    check_pages(reporter, &notInMemoryStream);
+    NoLengthStream noLengthStream(data);
+    check_pages(reporter, &noLengthStream);
+
+    // A truncated document can't be read.
+    SkMemoryStream truncated(data->data(), data->size() - 8);
+    SkDocumentPage pages[kPageCount];
+    REPORTER_ASSERT(reporter, !SkMultiPictureDocumentRead(&truncated, pages, kPageCount));
+    NoLengthStream truncatedNoLength(data->data(), data->size() - 8);
+    REPORTER_ASSERT(reporter, !SkMultiPictureDocumentRead(&truncatedNoLength, pages, kPageCount));
+
+    // Nor can one claiming a page far bigger than the stream, which mustn't be allocated first.
+    sk_sp<SkData> huge = SkData::MakeWithCopy(data->data(), data->size());
+    const size_t offset = sizeof("Skia Multi-Picture Doc\n\n") - 1 +
+                                 2 * sizeof(uint32_t) + kPageCount * sizeof(SkSize);
+    *reinterpret_cast<uint32_t*>(static_cast<char*>(huge->writable_data()) + offset) =
+            0xFFFFFFF0;
+    for (bool hasLength : { true, false }) {
+        std::unique_ptr<SkStreamSeekable> stream;
+        if (hasLength) {
+            stream.reset(new NotInMemoryStream(huge));
+        } else {
+            stream.reset(new NoLengthStream(huge));
+        }
+        REPORTER_ASSERT(reporter, !SkMultiPictureDocumentRead(stream.get(), pages, kPageCount));
+    }
+}
+
+DEF_TEST(MultiPictureDocument_Parallel, reporter) {
+    // Writing and reading the pages in parallel, when asked to, makes the same document.
+    sk_sp<SkData> data = make_document(true);
+    REPORTER_ASSERT(reporter, data->equals(make_document(false).get()));
+    SkMemoryStream memoryStream(data);
+    check_pages(reporter, &memoryStream, true);
+    NotInMemoryStream notInMemoryStream(data);
+    check_pages(reporter, &notInMemoryStream, true);
+}
+
+// Version 2 documents draw every page into one picture, ending each with an annotation.
+DEF_TEST(MultiPictureDocument_Version2, reporter) {
+    SkDynamicMemoryWStream stream;
+    static const char kMagic[] = "Skia Multi-Picture Doc\n\n";
+    stream.writeText(kMagic);
+    stream.write32(2);
+    stream.write32(kPageCount);
+    for (int i = 0; i < kPageCount; ++i) {
+        SkSize size = page_size(i);
+        stream.write(&size, sizeof(size));
+    }
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(SkRect::MakeSize(page_size(kPageCount - 1)));
+    for (int i = 0; i < kPageCount; ++i) {
+        SkPictureRecorder pageRecorder;
+        draw_page(pageRecorder.beginRecording(SkRect::MakeSize(page_size(i))), i);
+        canvas->drawPicture(pageRecorder.finishRecordingAsPicture());
+        canvas->drawAnnotation(SkRect::MakeEmpty(), "SkMultiPictureEndPage", nullptr);
+    }
+    recorder.finishRecordingAsPicture()->serialize(&stream);
+
+    SkMemoryStream memoryStream(stream.detachAsData());
+    check_pages(reporter, &memoryStream);
+}
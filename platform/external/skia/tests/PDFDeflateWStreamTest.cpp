@@ -28,7 +28,8 @@ void skia_free_func(void*, void* address) { sk_free(address); }
  *  Use the un-deflate compression algorithm to decompress the data in src,
  *  returning the result.  Returns nullptr if an error occurs.
  */
-std::unique_ptr<SkStreamAsset> stream_inflate(skiatest::Reporter* reporter, SkStream* src) {
+std::unique_ptr<SkStreamAsset> stream_inflate(skiatest::Reporter* reporter, SkStream* src,
+                                              bool gzip = false) {
     SkDynamicMemoryWStream decompressedDynamicMemoryWStream;
     SkWStream* dst = &decompressedDynamicMemoryWStream;
 
@@ -44,7 +45,7 @@ std::unique_ptr<SkStreamAsset> stream_inflate(skiatest::Reporter* reporter, SkSt
     flateData.next_out = outputBuffer;
     flateData.avail_out = kBufferSize;
     int rc;
-    rc = inflateInit(&flateData);
+    rc = gzip ? inflateInit2(&flateData, 0x1F) : inflateInit(&flateData);
     if (rc != Z_OK) {
         ERRORF(reporter, "Zlib: inflateInit failed");
         return nullptr;
@@ -166,4 +167,52 @@ DEF_TEST(SkPDF_DeflateWStream, r) {
     REPORTER_ASSERT(r, !emptyDeflateWStream.writeText("FOO"));
 }
 
+DEF_TEST(SkPDF_DeflateWStream_Threads, r) {
+    // Compressible, PDF-like input, spanning several chunks.
+    SkRandom random(7890);
+    SkDynamicMemoryWStream text;
+    while (text.bytesWritten() < 700000) {
+        text.writeScalarAsText(random.nextRangeScalar(0, 612));
+        text.writeText(" ");
+        text.writeScalarAsText(random.nextRangeScalar(0, 792));
+        text.writeText(random.nextBool() ? " l\n" : " m\n");
+    }
+    sk_sp<SkData> input = text.detachAsData();
+
+    // Sizes on, around and between the 128KB chunk boundaries.
+    for (size_t size : { (size_t)0, (size_t)1000, (size_t)131072, (size_t)262144,
+                         (size_t)262145, input->size() }) {
+        for (bool gzip : { false, true }) {
+            sk_sp<SkData> expected;
+            for (int threads : { 2, 3, 8 }) {
+                SkDynamicMemoryWStream dynamicMemoryWStream;
+                {
+                    SkDeflateWStream deflateWStream(&dynamicMemoryWStream, -1, gzip, threads);
+                    for (size_t j = 0; j < size; j += 50000) {
+                        deflateWStream.write(input->bytes() + j, SkTMin(size - j, (size_t)50000));
+                    }
+                    REPORTER_ASSERT(r, deflateWStream.bytesWritten() == size);
+                }
+                sk_sp<SkData> compressed = dynamicMemoryWStream.detachAsData();
+                SkMemoryStream compressedStream(compressed);
+                std::unique_ptr<SkStreamAsset> decompressed(
+                        stream_inflate(r, &compressedStream, gzip));
+                REPORTER_ASSERT(r, decompressed && decompressed->getLength() == size);
+                if (size && decompressed && decompressed->getLength() == size) {
+                    SkAutoTMalloc<uint8_t> output(size);
+                    REPORTER_ASSERT(r, decompressed->read(output.get(), size) == size);
+                    REPORTER_ASSERT(r, 0 == memcmp(output.get(), input->data(), size));
+                }
+
+                // The output does not depend on the number of threads.
+                if (!expected) {
+                    expected = compressed;
+                } else {
+                    REPORTER_ASSERT(r, expected->equals(compressed.get()));
+                }
+            }
+        }
+    }
+}
+
 #endif
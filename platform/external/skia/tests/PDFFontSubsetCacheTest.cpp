@@ -0,0 +1,90 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Test.h"
+
+#ifdef SK_SUPPORT_PDF
+
+#include "Resources.h"
+#include "SkCanvas.h"
+#include "SkDocument.h"
+#include "SkPDFFontSubsetCache.h"
+#include "SkResourceCache.h"
+#include "SkStream.h"
+
+DEF_TEST(PDFFontSubsetCache, reporter) {
+    SkResourceCache cache(1024 * 1024);
+
+    SkTDArray<SkGlyphID> glyphs;
+    glyphs.push(0);
+    glyphs.push(3);
+    glyphs.push(5);
+    SkPDFFontSubsetCache::Subset subset;
+    subset.fFontFile = SkData::MakeWithCString("font");
+    subset.fWidths = SkData::MakeWithCString("widths");
+    subset.fDefaultWidth = 500;
+    SkPDFFontSubsetCache::Add(7, 1, 100, glyphs, subset, &cache);
+
+    SkPDFFontSubsetCache::Subset found;
+    REPORTER_ASSERT(reporter, SkPDFFontSubsetCache::Find(7, 1, 100, glyphs, &found, &cache));
+    REPORTER_ASSERT(reporter, found.fFontFile->equals(subset.fFontFile.get()));
+    REPORTER_ASSERT(reporter, found.fWidths->equals(subset.fWidths.get()));
+    REPORTER_ASSERT(reporter, !found.fToUnicode);
+    REPORTER_ASSERT(reporter, 500 == found.fDefaultWidth);
+
+    // Any other typeface, range of glyphs or set of glyphs misses.
+    REPORTER_ASSERT(reporter, !SkPDFFontSubsetCache::Find(8, 1, 100, glyphs, &found, &cache));
+    REPORTER_ASSERT(reporter, !SkPDFFontSubsetCache::Find(7, 1, 101, glyphs, &found, &cache));
+    SkTDArray<SkGlyphID> otherGlyphs(glyphs);
+    otherGlyphs[2] = 6;
+    REPORTER_ASSERT(reporter, !SkPDFFontSubsetCache::Find(7, 1, 100, otherGlyphs, &found,
+                                                          &cache));
+    otherGlyphs.pop();
+    REPORTER_ASSERT(reporter, !SkPDFFontSubsetCache::Find(7, 1, 100, otherGlyphs, &found,
+                                                          &cache));
+
+    // A subset too big for its share of the cache isn't kept.
+    SkPDFFontSubsetCache::Subset big;
+    big.fFontFile = SkData::MakeUninitialized(cache.getTotalByteLimit() / 8);
+    SkPDFFontSubsetCache::Add(9, 1, 100, glyphs, big, &cache);
+    REPORTER_ASSERT(reporter, !SkPDFFontSubsetCache::Find(9, 1, 100, glyphs, &found, &cache));
+    REPORTER_ASSERT(reporter, SkPDFFontSubsetCache::Find(7, 1, 100, glyphs, &found, &cache));
+}
+
+static sk_sp<SkData> make_pdf(sk_sp<SkTypeface> typeface, const char* text) {
+    SkDynamicMemoryWStream stream;
+    sk_sp<SkDocument> doc = SkDocument::MakePDF(&stream);
+    SkCanvas* canvas = doc->beginPage(200, 100);
+    SkPaint paint;
+    paint.setTypeface(std::move(typeface));
+    paint.setTextSize(20);
+    canvas->drawString(text, 10, 50, paint);
+    doc->close();
+    return stream.detachAsData();
+}
+
+// A document which uses the same glyphs of the same fonts as one made before it embeds the same
+// font subsets, whether or not they come from the cache.
+DEF_TEST(PDFFontSubsetCache_Document, reporter) {
+    sk_sp<SkTypeface> typeface = MakeResourceAsTypeface("fonts/Em.ttf");
+    if (!typeface) {
+        INFOF(reporter, "no typeface, skipping\n");
+        return;
+    }
+    sk_sp<SkData> first = make_pdf(typeface, "Hello");
+    sk_sp<SkData> again = make_pdf(typeface, "Hello");
+    REPORTER_ASSERT(reporter, first->equals(again.get()));
+
+    // The same font loaded again has another ID, so its subsets aren't in the cache yet.
+    sk_sp<SkData> uncached = make_pdf(MakeResourceAsTypeface("fonts/Em.ttf"), "Hello");
+    REPORTER_ASSERT(reporter, first->equals(uncached.get()));
+
+    sk_sp<SkData> other = make_pdf(typeface, "World");
+    REPORTER_ASSERT(reporter, !first->equals(other.get()));
+}
+
+#endif
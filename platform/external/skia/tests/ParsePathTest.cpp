@@ -64,6 +64,23 @@ DEF_TEST(ParsePath, reporter) {
     test_to_from(reporter, p);
 }
 
+DEF_TEST(ParsePath_exact, reporter) {
+    // Coordinates survive the trip through a string exactly.
+    SkPath path;
+    path.moveTo(0.1f, -1e-7f);
+    path.lineTo(123456.79f, 3.4e38f);
+    path.quadTo(1.0f / 3, -2.0f / 3, 1e-30f, 7);
+    path.cubicTo(-0.5f, 16777217.0f, 5.877472e-39f, 1, 2, 3);
+
+    SkString str;
+    SkParsePath::ToSVGString(path, &str);
+    REPORTER_ASSERT(reporter, !strchr(str.c_str(), 'e'), "%s", str.c_str());
+
+    SkPath path2;
+    REPORTER_ASSERT(reporter, SkParsePath::FromSVGString(str.c_str(), &path2));
+    REPORTER_ASSERT(reporter, path == path2, "%s", str.c_str());
+}
+
 DEF_TEST(ParsePath_invalid, r) {
     SkPath path;
     // This is an invalid SVG string, but the test verifies that we do not
@@ -7,6 +7,7 @@
 
 #include "Test.h"
 
+#include "SkExecutor.h"
 #include "SkPath.h"
 
 #if SK_SUPPORT_GPU
@@ -73,8 +74,9 @@ static void test_path(skiatest::Reporter* reporter,
                       std::function<GrPathRenderer*(GrContext*)> createPathRenderer,
                       int expected,
                       GrAAType aaType = GrAAType::kNone,
-                      GrStyle style = GrStyle(SkStrokeRec::kFill_InitStyle)) {
-    sk_sp<GrContext> ctx = GrContext::MakeMock(nullptr);
+                      GrStyle style = GrStyle(SkStrokeRec::kFill_InitStyle),
+                      const GrContextOptions& options = GrContextOptions()) {
+    sk_sp<GrContext> ctx = GrContext::MakeMock(nullptr, options);
     // The cache needs to be big enough that nothing gets flushed, or our expectations can be wrong
     ctx->setResourceCacheLimits(100, 8000000);
     GrResourceCache* cache = ctx->contextPriv().getResourceCache();
@@ -129,6 +131,35 @@ DEF_GPUTEST(TessellatingPathRendererCacheTest, reporter, /* options */) {
     test_path(reporter, create_concave_path, createPR, kExpectedResources, GrAAType::kNone, style);
 }
 
+// Same, with the paths tessellated on an executor's threads ahead of the flush.
+DEF_GPUTEST(TessellatingPathRendererThreadedCacheTest, reporter, /* options */) {
+    auto createPR = [](GrContext*) {
+        return new GrTessellatingPathRenderer();
+    };
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    GrContextOptions options;
+    options.fExecutor = executor.get();
+
+    const int kExpectedResources = 1;
+    test_path(reporter, create_concave_path, createPR, kExpectedResources, GrAAType::kNone,
+              GrStyle(SkStrokeRec::kFill_InitStyle), options);
+
+    // AA tessellations are in device space, so they are drawn but never cached.
+    sk_sp<GrContext> ctx = GrContext::MakeMock(nullptr, options);
+    sk_sp<GrRenderTargetContext> rtc(ctx->makeDeferredRenderTargetContext(
+            SkBackingFit::kApprox, 800, 800, kRGBA_8888_GrPixelConfig, nullptr, 1, GrMipMapped::kNo,
+            kTopLeft_GrSurfaceOrigin));
+    if (!rtc) {
+        return;
+    }
+    GrTessellatingPathRenderer tess;
+    draw_path(ctx.get(), rtc.get(), create_concave_path(), &tess, GrAAType::kCoverage,
+              GrStyle(SkStrokeRec::kFill_InitStyle));
+    ctx->flush();
+    REPORTER_ASSERT(reporter,
+                    cache_non_scratch_resources_equals(ctx->contextPriv().getResourceCache(), 0));
+}
+
 // Test that deleting the original path invalidates the textures cached by the SW path renderer
 DEF_GPUTEST(SoftwarePathRendererCacheTest, reporter, /* options */) {
     auto createPR = [](GrContext* ctx) {
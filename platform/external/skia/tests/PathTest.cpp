@@ -4899,3 +4899,109 @@ DEF_TEST(ClipPath_nonfinite, reporter) {
     REPORTER_ASSERT(reporter, !canvas->isClipEmpty());
 }
 
+static SkPath make_icon_path() {
+    SkPath path;
+    SkAssertResult(SkParsePath::FromSVGString(
+            "M12 2C6.48 2 2 6.48 2 12s4.48 10 10 10 10-4.48 10-10S17.52 2 12 2zm-2 15l-5-5 "
+            "1.41-1.41L10 14.17l7.59-7.59L19 8l-9 9z", &path));
+    return path;
+}
+
+DEF_TEST(Path_Intern, reporter) {
+    // Identical paths, built separately, share storage once interned.
+    SkPath a = make_icon_path(), b = make_icon_path();
+    REPORTER_ASSERT(reporter, a.getGenerationID() != b.getGenerationID());
+    a.intern();
+    b.intern();
+    REPORTER_ASSERT(reporter, a == b);
+    REPORTER_ASSERT(reporter, a.getGenerationID() == b.getGenerationID());
+    REPORTER_ASSERT(reporter, SkPathRef::CountInterned() > 0);
+
+    // Editing one leaves the other, and the interned storage, alone.
+    const SkPath original = make_icon_path();
+    b.lineTo(40, 40);
+    REPORTER_ASSERT(reporter, a == original);
+    REPORTER_ASSERT(reporter, b != original);
+    SkPath c = make_icon_path();
+    c.intern();
+    REPORTER_ASSERT(reporter, a.getGenerationID() == c.getGenerationID());
+
+    // The same verbs and points, but not known to be an oval, are kept apart from an oval.
+    SkPath oval, conics;
+    oval.addOval(SkRect::MakeWH(10, 10));
+    SkPath::RawIter iter(oval);
+    SkPoint pts[4];
+    for (SkPath::Verb verb; (verb = iter.next(pts)) != SkPath::kDone_Verb;) {
+        switch (verb) {
+            case SkPath::kMove_Verb:  conics.moveTo(pts[0]); break;
+            case SkPath::kConic_Verb: conics.conicTo(pts[1], pts[2], iter.conicWeight()); break;
+            case SkPath::kClose_Verb: conics.close(); break;
+            default: SkASSERT(false);
+        }
+    }
+    REPORTER_ASSERT(reporter, conics == oval && !conics.isOval(nullptr));
+    conics.intern();
+    oval.intern();
+    REPORTER_ASSERT(reporter, oval.isOval(nullptr));
+    REPORTER_ASSERT(reporter, conics.getGenerationID() != oval.getGenerationID());
+
+    // Empty paths are left as they are.
+    SkPath empty;
+    empty.intern();
+    REPORTER_ASSERT(reporter, empty.isEmpty());
+
+    // Once no path uses it, interned storage can be purged.
+    {
+        SkPath unused;
+        unused.moveTo(1234, 5678);
+        unused.lineTo(-9, 3);
+        unused.intern();
+    }
+    REPORTER_ASSERT(reporter, SkPathRef::PurgeInterned() > 0);
+    c.lineTo(1, 1);
+    REPORTER_ASSERT(reporter, a == original);
+}
+
+DEF_TEST(Path_CompactSerialization, reporter) {
+    // Points that fit 16-bit fixed point exactly are written in less space, and all points come
+    // back exactly as they were.
+    auto round_trip = [reporter](const SkPath& path) {
+        sk_sp<SkData> data = path.serialize();
+        SkPath readBack;
+        REPORTER_ASSERT(reporter, readBack.readFromMemory(data->data(), data->size()) ==
+                                  data->size());
+        REPORTER_ASSERT(reporter, readBack == path);
+        REPORTER_ASSERT(reporter, !readBack.readFromMemory(data->data(), data->size() - 4));
+        return data->size();
+    };
+
+    SkPath icon;
+    SkAssertResult(SkParsePath::FromSVGString("M12 2.5L2.5 11H5v8.25h5.5v-5h3v5H19V11h2.5z",
+                                              &icon));
+    SkPath general = icon;
+    general.lineTo(0.1f, 100000);
+    REPORTER_ASSERT(reporter, round_trip(icon) + icon.countPoints() * sizeof(SkIPoint16) <
+                              round_trip(general));
+
+    // Compact points came with version 5 of the format; as version 4 they make no sense.
+    auto reads_as_version_4 = [reporter](const SkPath& path) {
+        sk_sp<SkData> data = path.serialize();
+        uint32_t* packed = static_cast<uint32_t*>(data->writable_data());
+        REPORTER_ASSERT(reporter, 5 == (*packed & 0xFF));
+        *packed = (*packed & ~0xFF) | 4;
+        SkPath readBack;
+        return 0 != readBack.readFromMemory(data->data(), data->size());
+    };
+    REPORTER_ASSERT(reporter, !reads_as_version_4(icon));
+    REPORTER_ASSERT(reporter,  reads_as_version_4(general));
+
+    // Coordinates that don't fit, or wouldn't come back bit for bit, are written as they are.
+    for (SkScalar x : { 32767.0f, -32767.0f, 0.5f, 1 / 32768.0f, 32768.0f, 0.1f, -0.0f,
+                        SK_ScalarNaN, SK_ScalarInfinity }) {
+        SkPath path;
+        path.moveTo(0, 3.25f);
+        path.conicTo(x, 1, 7, -x, 0.5f);
+        path.close();
+        round_trip(path);
+    }
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkBitmap.h"
+#include "SkCanvas.h"
+#include "SkPerlinNoiseShader.h"
+#include "Test.h"
+
+// The noise shaders are drawn by raster pipeline stages, which replaced a scalar shader context.
+// These are the colors that context produced at a few points, for each shader and matrix below.
+static const SkIPoint kPoints[] = { {0, 0}, {7, 3}, {19, 29}, {20, 30}, {33, 11}, {47, 47} };
+static const SkPMColor kExpected[][SK_ARRAY_COUNT(kPoints)] = {
+    { 0x7e3f4040, 0x7f26383e, 0x7f3f3f3f, 0x6f3b323b, 0x8a62593b, 0x9a5a453f, },
+    { 0x0c010001, 0x3712090a, 0x35150314, 0x230d000c, 0x560c100b, 0x2b04030d, },
+    { 0x7d3f403f, 0x63353f2d, 0x7f3f3f3f, 0x7e3f4040, 0xa83f4d79, 0x74593f43, },
+    { 0x07010001, 0x32120908, 0x00000000, 0x07010001, 0x540d1002, 0x1e060302, },
+    { 0x8c4d4646, 0xcc736849, 0x7f4f5f3f, 0x794d5d3a, 0x7d594533, 0x7462394f, },
+    { 0x7a374140, 0x87273341, 0x7f3f3f3f, 0x7d41413e, 0x74534934, 0xa460504e, },
+    { 0x2c0e040b, 0x77362d1e, 0x35150314, 0x3923081a, 0x871a252f, 0x681e133e, },
+    { 0x7a384240, 0x6a383c2f, 0x7f3f3f3f, 0x7a374140, 0xc0495991, 0x7860444a, },
+    { 0x1c090307, 0x672c241f, 0x00000000, 0x1c090307, 0x621e1c0b, 0x491b1c0b, },
+    { 0xac6e5256, 0xe964632f, 0x7f4f5f3f, 0x7a476046, 0x98776530, 0x5d56263a, },
+    { 0x6e3b3931, 0xaf3c5073, 0x7248452c, 0x7a464534, 0x8960464c, 0x6e42353b, },
+    { 0x64092202, 0x1d0d0604, 0x1f000001, 0x1c010101, 0x04000000, 0x680e1908, },
+    { 0x6e3b3931, 0xa0464959, 0x62363a28, 0x6e3b3b30, 0x7f2a3b4e, 0xa5415750, },
+    { 0x5e031f04, 0x31110410, 0x67102507, 0x67082406, 0x07020100, 0x01000000, },
+    { 0x7c482c5f, 0x8b582d5d, 0x95414839, 0x8d40433c, 0x623c4919, 0x4c272c2a, },
+    { 0x7e413c30, 0xb7395a84, 0x54333520, 0x713a452e, 0x8b614546, 0x75434746, },
+    { 0x7210391d, 0x331f130f, 0x4a141413, 0x48110f0f, 0x19020704, 0xa43a4d30, },
+    { 0x7e413c30, 0xa7435368, 0x693d3721, 0x78423b2c, 0x7e2b3952, 0xae476244, },
+    { 0x98213d2a, 0x5826192e, 0x79253c24, 0x82213e25, 0x451c190c, 0x09050200, },
+    { 0x6c382958, 0xa46e1e79, 0x943b4535, 0x923d423e, 0x60384715, 0x662b363f, },
+    { 0x71354132, 0x893c3e4a, 0xb737528a, 0xb439508a, 0x832d292e, 0x935e524e, },
+    { 0x00000000, 0x370d0505, 0x15060400, 0x1d080500, 0x2b020906, 0x13020200, },
+    { 0x71354132, 0x893e3f49, 0xa24c4753, 0xa74e4854, 0x5e353c28, 0x792a394b, },
+    { 0x06000002, 0x390e0505, 0x09010101, 0x14020300, 0x4a081105, 0x12040401, },
+    { 0x53192b25, 0x8e4c5537, 0xa0544e66, 0x9a54565f, 0x6b3f3132, 0x7f543e49, },
+    { 0x652d3f28, 0x882b364e, 0xd12b6a8c, 0xc4346887, 0x8f311f37, 0xa9695b5e, },
+    { 0x0b030207, 0x76421319, 0x32171008, 0x461c160c, 0x88132a32, 0x43161a07, },
+    { 0x652d3f28, 0x882d374d, 0xbc475e51, 0xb64b5d4d, 0x5430381e, 0x832f3650, },
+    { 0x1404030d, 0x77431318, 0x260e080b, 0x1f0b0a08, 0xa4284d1c, 0x441f200e, },
+    { 0x3e0a1e18, 0xa25d7c21, 0xb7775a69, 0xb67f6067, 0x6547272c, 0x7c504448, },
+};
+
+DEF_TEST(PerlinNoise_RasterPipeline, reporter) {
+    const SkISize tileSize = SkISize::Make(20, 30);
+    SkMatrix matrices[3];
+    matrices[0].reset();
+    matrices[1].setTranslate(3.25f, -7.5f);
+    matrices[2].setScale(1.5f, 2);
+    matrices[2].postTranslate(5, 5);
+
+    SkTArray<sk_sp<SkShader>> shaders;
+    for (int octaves : { 1, 4 }) {
+        for (const SkISize* tile : { (const SkISize*)nullptr, &tileSize }) {
+            shaders.push_back(SkPerlinNoiseShader::MakeFractalNoise(0.05f, 0.1f, octaves, 3, tile));
+            shaders.push_back(SkPerlinNoiseShader::MakeTurbulence(0.1f, 0.05f, octaves, 7, tile));
+        }
+        shaders.push_back(SkPerlinNoiseShader::MakeImprovedNoise(0.05f, 0.05f, octaves, 2));
+    }
+
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(48, 48);
+    SkCanvas canvas(bitmap);
+    int expected = 0;
+    for (const SkMatrix& ctm : matrices) {
+        for (const sk_sp<SkShader>& shader : shaders) {
+            SkPaint paint;
+            paint.setShader(shader);
+            paint.setBlendMode(SkBlendMode::kSrc);
+            canvas.save();
+            canvas.concat(ctm);
+            canvas.drawPaint(paint);
+            canvas.restore();
+
+            for (size_t i = 0; i < SK_ARRAY_COUNT(kPoints); ++i) {
+                SkPMColor actual = *bitmap.getAddr32(kPoints[i].fX, kPoints[i].fY);
+                // The context truncated each channel to a byte before premultiplying.
+                for (int shift = 0; shift < 32; shift += 8) {
+                    int diff = (int)((actual >> shift) & 0xFF) -
+                               (int)((kExpected[expected][i] >> shift) & 0xFF);
+                    REPORTER_ASSERT(reporter, SkTAbs(diff) <= 2,
+                                    "shader %d point %d: %08x vs %08x", expected, (int)i,
+                                    actual, kExpected[expected][i]);
+                }
+            }
+            ++expected;
+        }
+    }
+    REPORTER_ASSERT(reporter, expected == SK_ARRAY_COUNT(kExpected));
+}
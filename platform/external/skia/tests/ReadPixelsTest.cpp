@@ -612,3 +612,47 @@ DEF_TEST(ReadPixels_ValidConversion, reporter) {
         }
     }
 }
+
+// Large conversions are split into tiles of rows, converted in parallel on the default executor
+// (DM's, when it runs with threads), which should come out just as if each row were converted on
+// its own.
+DEF_TEST(ReadPixels_LargeConversion, reporter) {
+    const int kW = 700, kH = 600;
+    const SkImageInfo f16Info = SkImageInfo::Make(kW, kH, kRGBA_F16_SkColorType,
+                                                  kPremul_SkAlphaType,
+                                                  SkColorSpace::MakeSRGBLinear());
+    const SkImageInfo n32Info = SkImageInfo::Make(kW, kH, kRGBA_8888_SkColorType,
+                                                  kPremul_SkAlphaType, SkColorSpace::MakeSRGB());
+    SkBitmap n32;
+    n32.allocPixels(n32Info);
+    for (int y = 0; y < kH; ++y) {
+        for (int x = 0; x < kW; ++x) {
+            *n32.getAddr32(x, y) = SkPreMultiplyARGB((x ^ y) & 0xFF, x & 0xFF, y & 0xFF,
+                                                     (x + y) & 0xFF);
+        }
+    }
+
+    // 8888 -> F16 goes through SkColorSpaceXform, and F16 -> 8888 through the pipeline.
+    SkBitmap f16;
+    f16.allocPixels(f16Info);
+    SkBitmap n32Again;
+    n32Again.allocPixels(n32Info);
+    REPORTER_ASSERT(reporter, n32.pixmap().readPixels(f16.pixmap()));
+    REPORTER_ASSERT(reporter, f16.pixmap().readPixels(n32Again.pixmap()));
+
+    for (int y = 0; y < kH; ++y) {
+        const SkIRect row = SkIRect::MakeXYWH(0, y, kW, 1);
+        SkPixmap n32Row, f16Row;
+        REPORTER_ASSERT(reporter, n32.pixmap().extractSubset(&n32Row, row));
+        REPORTER_ASSERT(reporter, f16.pixmap().extractSubset(&f16Row, row));
+
+        uint64_t f16Pixels[kW];
+        REPORTER_ASSERT(reporter, n32Row.readPixels(f16Row.info(), f16Pixels, sizeof(f16Pixels)));
+        REPORTER_ASSERT(reporter, 0 == memcmp(f16Pixels, f16Row.addr(), sizeof(f16Pixels)));
+
+        uint32_t n32Pixels[kW];
+        REPORTER_ASSERT(reporter, f16Row.readPixels(n32Row.info(), n32Pixels, sizeof(n32Pixels)));
+        REPORTER_ASSERT(reporter, 0 == memcmp(n32Pixels, n32Again.getAddr32(0, y),
+                                              sizeof(n32Pixels)));
+    }
+}
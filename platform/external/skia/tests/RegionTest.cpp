@@ -434,3 +434,43 @@ DEF_TEST(region_inverse_union_skbug_7491, reporter) {
     REPORTER_ASSERT(reporter, clip == rgn);
 }
 
+// Ops between regions with hundreds of intervals used to size their scratch storage by the
+// product of the interval counts, which could be enormous or overflow.
+DEF_TEST(region_complex_ops, reporter) {
+    SkRandom rand;
+    SkRegion a, b;
+    for (int i = 0; i < 256; ++i) {
+        SkIRect r;
+        rand_rect(&r, rand);
+        a.op(r, SkRegion::kXOR_Op);
+        rand_rect(&r, rand);
+        b.op(r, SkRegion::kXOR_Op);
+    }
+    REPORTER_ASSERT(reporter, a.isComplex() && b.isComplex());
+
+    SkRegion unionR, sectR, diffR, xorR;
+    REPORTER_ASSERT(reporter, unionR.op(a, b, SkRegion::kUnion_Op));
+    sectR.op(a, b, SkRegion::kIntersect_Op);
+    diffR.op(a, b, SkRegion::kDifference_Op);
+    xorR.op(a, b, SkRegion::kXOR_Op);
+
+    // Building the union one rect at a time must give the same region.
+    SkRegion accum(a);
+    for (SkRegion::Iterator iter(b); !iter.done(); iter.next()) {
+        accum.op(iter.rect(), SkRegion::kUnion_Op);
+    }
+    REPORTER_ASSERT(reporter, accum == unionR);
+
+    SkRegion check;
+    check.op(unionR, sectR, SkRegion::kDifference_Op);
+    REPORTER_ASSERT(reporter, check == xorR);
+    check.op(diffR, sectR, SkRegion::kUnion_Op);
+    REPORTER_ASSERT(reporter, check == a);
+
+    // Ops into one of the operands.
+    check = a;
+    check.op(b, SkRegion::kXOR_Op);
+    REPORTER_ASSERT(reporter, check == xorR);
+    check.op(a, SkRegion::kXOR_Op);
+    REPORTER_ASSERT(reporter, check == b);
+}
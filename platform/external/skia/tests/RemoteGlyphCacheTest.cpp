@@ -0,0 +1,173 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkGlyphCache.h"
+#include "SkMakeUnique.h"
+#include "SkRemoteGlyphCache.h"
+#include "SkSurfaceProps.h"
+#include "SkTypeface_remote.h"
+#include "SkWriter32.h"
+#include "Test.h"
+
+// Counts the glyph requests that miss the batched glyphs and would cross to the glyph process.
+class CountingRemoteScalerContext : public SkRemoteScalerContext {
+public:
+    explicit CountingRemoteScalerContext(int* calls) : fCalls{calls} {}
+
+    void generateFontMetrics(const SkTypefaceProxy&, const SkScalerContextRec&,
+                             SkPaint::FontMetrics* metrics) override {
+        (*fCalls)++;
+        sk_bzero(metrics, sizeof(*metrics));
+    }
+    void generateMetrics(const SkTypefaceProxy&, const SkScalerContextRec&,
+                         SkGlyph* glyph) override {
+        (*fCalls)++;
+        glyph->zeroMetrics();
+    }
+    void generateImage(const SkTypefaceProxy&, const SkScalerContextRec&,
+                       const SkGlyph&) override {
+        (*fCalls)++;
+    }
+    void generateMetricsAndImage(const SkTypefaceProxy&, const SkScalerContextRec&,
+                                 SkArenaAlloc*, SkGlyph* glyph) override {
+        (*fCalls)++;
+        glyph->zeroMetrics();
+    }
+    void generatePath(const SkTypefaceProxy&, const SkScalerContextRec&,
+                      SkGlyphID, SkPath*) override {
+        (*fCalls)++;
+    }
+
+private:
+    int* const fCalls;
+};
+
+static sk_sp<SkData> round_trip(SkRemoteGlyphCacheGPU* client,
+                                SkRemoteGlyphCacheRenderer* server) {
+    SkWriter32 requests;
+    if (!client->writeGlyphRequests(&requests)) {
+        return nullptr;
+    }
+    sk_sp<SkData> requestData = requests.snapshotAsData();
+    SkWriter32 reply;
+    if (!server->serveGlyphRequests(requestData->data(), requestData->size(), &reply)) {
+        return nullptr;
+    }
+    return reply.snapshotAsData();
+}
+
+DEF_TEST(RemoteGlyphCache_BatchedGlyphs, reporter) {
+    int fallbackCalls = 0;
+    SkRemoteGlyphCacheRenderer server;
+    SkRemoteGlyphCacheGPU client{skstd::make_unique<CountingRemoteScalerContext>(&fallbackCalls)};
+
+    SkSerialProcs serialProcs;
+    server.prepareSerializeProcs(&serialProcs);
+    SkDeserialProcs deserialProcs;
+    client.prepareDeserializeProcs(&deserialProcs);
+
+    sk_sp<SkTypeface> serverTypeface = SkTypeface::MakeDefault();
+    sk_sp<SkData> wireTypeface =
+            serialProcs.fTypefaceProc(serverTypeface.get(), serialProcs.fTypefaceCtx);
+    sk_sp<SkTypeface> clientTypeface = deserialProcs.fTypefaceProc(
+            wireTypeface->data(), wireTypeface->size(), deserialProcs.fTypefaceCtx);
+
+    SkGlyphID glyphs[4];
+    int glyphCount = serverTypeface->charsToGlyphs("Skia", SkTypeface::kUTF8_Encoding,
+                                                   glyphs, SK_ARRAY_COUNT(glyphs));
+    REPORTER_ASSERT(reporter, glyphCount == 4);
+
+    SkPaint paint;
+    paint.setTypeface(clientTypeface);
+    paint.setTextSize(24);
+    paint.setTextEncoding(SkPaint::kGlyphID_TextEncoding);
+    SkSurfaceProps props{0, kUnknown_SkPixelGeometry};
+    SkScalerContextRec rec;
+    SkScalerContextEffects effects;
+    SkScalerContext::MakeRecAndEffects(paint, &props, &SkMatrix::I(),
+                                       SkScalerContextFlags::kNone, &rec, &effects);
+
+    client.requestGlyphs(clientTypeface.get(), rec, glyphs, glyphCount);
+    client.requestGlyphs(clientTypeface.get(), rec, glyphs, 2, true);
+    REPORTER_ASSERT(reporter, client.pendingGlyphCount() == glyphCount + 2);
+
+    sk_sp<SkData> reply = round_trip(&client, &server);
+    REPORTER_ASSERT(reporter, reply);
+    REPORTER_ASSERT(reporter, client.pendingGlyphCount() == 0);
+    REPORTER_ASSERT(reporter, client.readGlyphs(reply->data(), reply->size()));
+
+    // Asking again sends nothing.
+    client.requestGlyphs(clientTypeface.get(), rec, glyphs, glyphCount);
+    REPORTER_ASSERT(reporter, client.pendingGlyphCount() == 0);
+    REPORTER_ASSERT(reporter, !round_trip(&client, &server));
+
+    // The renderer's own strike for the same rec is the reference.
+    SkScalerContextRec serverRec = rec;
+    serverRec.fFontID = SkTypeface::UniqueID(serverTypeface.get());
+    SkAutoDescriptor serverAd;
+    SkAutoGlyphCache serverCache{
+            serverTypeface.get(), effects,
+            SkScalerContext::AutoDescriptorGivenRecAndEffects(serverRec, effects, &serverAd)};
+    SkAutoDescriptor clientAd;
+    SkAutoGlyphCache clientCache{
+            clientTypeface.get(), effects,
+            SkScalerContext::AutoDescriptorGivenRecAndEffects(rec, effects, &clientAd)};
+
+    for (int i = 0; i < glyphCount; i++) {
+        const SkGlyph& expected = serverCache->getGlyphIDMetrics(glyphs[i]);
+        const SkGlyph& actual = clientCache->getGlyphIDMetrics(glyphs[i]);
+        REPORTER_ASSERT(reporter, expected.fWidth == actual.fWidth);
+        REPORTER_ASSERT(reporter, expected.fHeight == actual.fHeight);
+        REPORTER_ASSERT(reporter, expected.fLeft == actual.fLeft);
+        REPORTER_ASSERT(reporter, expected.fTop == actual.fTop);
+        REPORTER_ASSERT(reporter, expected.fAdvanceX == actual.fAdvanceX);
+        REPORTER_ASSERT(reporter, expected.fMaskFormat == actual.fMaskFormat);
+
+        const void* expectedImage = serverCache->findImage(expected);
+        const void* actualImage = clientCache->findImage(actual);
+        REPORTER_ASSERT(reporter, SkToBool(expectedImage) == SkToBool(actualImage));
+        if (expectedImage && actualImage) {
+            REPORTER_ASSERT(reporter,
+                            0 == memcmp(expectedImage, actualImage, expected.computeImageSize()));
+        }
+
+        if (i < 2) {
+            const SkPath* expectedPath = serverCache->findPath(expected);
+            const SkPath* actualPath = clientCache->findPath(actual);
+            REPORTER_ASSERT(reporter, SkToBool(expectedPath) == SkToBool(actualPath));
+            if (expectedPath && actualPath) {
+                REPORTER_ASSERT(reporter, *expectedPath == *actualPath);
+            }
+        }
+    }
+    REPORTER_ASSERT(reporter, fallbackCalls == 0);
+}
+
+DEF_TEST(RemoteGlyphCache_MalformedBatches, reporter) {
+    int fallbackCalls = 0;
+    SkRemoteGlyphCacheRenderer server;
+    SkRemoteGlyphCacheGPU client{skstd::make_unique<CountingRemoteScalerContext>(&fallbackCalls)};
+
+    // A strike for a typeface the renderer never sent.
+    SkScalerContextRec rec;
+    sk_bzero(&rec, sizeof(rec));
+    SkWriter32 requests;
+    requests.write32(1);
+    requests.write32(12345);
+    requests.write(&rec, sizeof(rec));
+    requests.write32(0);
+    requests.write32(0);
+    sk_sp<SkData> requestData = requests.snapshotAsData();
+    SkWriter32 reply;
+    REPORTER_ASSERT(reporter,
+                    !server.serveGlyphRequests(requestData->data(), requestData->size(), &reply));
+
+    // Truncated in the middle of the rec.
+    REPORTER_ASSERT(reporter, !server.serveGlyphRequests(requestData->data(), 12, &reply));
+    REPORTER_ASSERT(reporter, !client.readGlyphs(requestData->data(), 12));
+    REPORTER_ASSERT(reporter, fallbackCalls == 0);
+}
@@ -9,10 +9,12 @@
 
 #ifdef SK_XML
 
+#include "SkBitmap.h"
 #include "SkCanvas.h"
 #include "SkData.h"
 #include "SkDOM.h"
 #include "SkParse.h"
+#include "SkPath.h"
 #include "SkStream.h"
 #include "SkSVGCanvas.h"
 #include "SkXMLWriter.h"
@@ -149,4 +151,109 @@ DEF_TEST(SVGDevice_whitespace_pos, reporter) {
     }
 }
 
+// Counts the elements named elem under node, at any depth.
+static int count_elements(const SkDOM& dom, const SkDOM::Node* node, const char elem[]) {
+    int count = 0;
+    for (const SkDOM::Node* child = dom.getFirstChild(node); child;
+         child = dom.getNextSibling(child)) {
+        if (dom.getType(child) == SkDOM::kElement_Type) {
+            count += !strcmp(dom.getName(child), elem) + count_elements(dom, child, elem);
+        }
+    }
+    return count;
+}
+
+DEF_TEST(SVGDevice_repeated_path, reporter) {
+    SkPath path;
+    path.moveTo(1, 2);
+    path.cubicTo(30, 4, 5, 60, 70, 8);
+    path.lineTo(9, 10);
+    path.setFillType(SkPath::kEvenOdd_FillType);
+
+    SkDOM dom;
+    {
+        SkXMLParserWriter writer(dom.beginParsing());
+        std::unique_ptr<SkCanvas> svgCanvas = SkSVGCanvas::Make(SkRect::MakeWH(100, 100), &writer);
+        SkPaint paint;
+        for (int i = 0; i < 4; ++i) {
+            paint.setColor(SK_ColorBLACK + 0x100 * i);
+            svgCanvas->translate(1, 1);
+            svgCanvas->drawPath(path, paint);
+        }
+    }
+    const SkDOM::Node* root = dom.finishParsing();
+    REPORTER_ASSERT(reporter, root);
+
+    // The first draw is inline. The second defines the path, which every later draw reuses.
+    REPORTER_ASSERT(reporter, 2 == count_elements(dom, root, "path"));
+    REPORTER_ASSERT(reporter, 3 == count_elements(dom, root, "use"));
+    const SkDOM::Node* defs = dom.getFirstChild(root, "defs");
+    REPORTER_ASSERT(reporter, defs);
+    if (defs) {
+        const SkDOM::Node* def = dom.getFirstChild(defs, "path");
+        REPORTER_ASSERT(reporter, def && !strcmp("path_0", dom.findAttr(def, "id")));
+        REPORTER_ASSERT(reporter, def && !strcmp("evenodd", dom.findAttr(def, "fill-rule")));
+        REPORTER_ASSERT(reporter, def && !dom.findAttr(def, "fill"));
+    }
+    for (const SkDOM::Node* use = dom.getFirstChild(root, "use"); use;
+         use = dom.getNextSibling(use, "use")) {
+        REPORTER_ASSERT(reporter, !strcmp("#path_0", dom.findAttr(use, "xlink:href")));
+        REPORTER_ASSERT(reporter, dom.findAttr(use, "fill"));
+        REPORTER_ASSERT(reporter, dom.findAttr(use, "transform"));
+    }
+}
+
+DEF_TEST(SVGDevice_repeated_image, reporter) {
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(8, 8);
+    bitmap.eraseColor(SK_ColorBLUE);
+
+    SkDOM dom;
+    {
+        SkXMLParserWriter writer(dom.beginParsing());
+        std::unique_ptr<SkCanvas> svgCanvas = SkSVGCanvas::Make(SkRect::MakeWH(100, 100), &writer);
+        for (int i = 0; i < 3; ++i) {
+            svgCanvas->drawBitmap(bitmap, 10.0f * i, 0);
+        }
+        // New pixels are a new image.
+        bitmap.eraseColor(SK_ColorRED);
+        svgCanvas->drawBitmap(bitmap, 0, 10);
+    }
+    const SkDOM::Node* root = dom.finishParsing();
+    REPORTER_ASSERT(reporter, root);
+    REPORTER_ASSERT(reporter, 2 == count_elements(dom, root, "image"));
+    REPORTER_ASSERT(reporter, 4 == count_elements(dom, root, "use"));
+}
+
+DEF_TEST(SVGDevice_stream, reporter) {
+    // The canvas writes to the stream as it goes, and closes the document when it goes away.
+    SkDynamicMemoryWStream stream;
+    {
+        std::unique_ptr<SkCanvas> svgCanvas = SkSVGCanvas::Make(SkRect::MakeWH(100, 100),
+                                                                &stream);
+        SkPaint paint;
+        svgCanvas->drawRect(SkRect::MakeXYWH(0.1f, 1e-6f, 33.333332f, 20), paint);
+        REPORTER_ASSERT(reporter, stream.bytesWritten() > 0);
+        svgCanvas->drawCircle(50, 50, 10, paint);
+    }
+
+    std::unique_ptr<SkStreamAsset> svg(stream.detachAsStream());
+    SkDOM dom;
+    const SkDOM::Node* root = dom.build(*svg);
+    REPORTER_ASSERT(reporter, root && !strcmp("svg", dom.getName(root)));
+    if (root) {
+        const SkDOM::Node* rect = dom.getFirstChild(root, "rect");
+        REPORTER_ASSERT(reporter, rect);
+        REPORTER_ASSERT(reporter, dom.getFirstChild(root, "ellipse"));
+
+        // Numbers are written exactly, without exponents.
+        SkScalar x, y, width;
+        REPORTER_ASSERT(reporter, rect && dom.findScalar(rect, "x", &x) && x == 0.1f);
+        REPORTER_ASSERT(reporter, rect && dom.findScalar(rect, "y", &y) && y == 1e-6f);
+        REPORTER_ASSERT(reporter, rect && !strchr(dom.findAttr(rect, "y"), 'e'));
+        REPORTER_ASSERT(reporter, rect && dom.findScalar(rect, "width", &width) &&
+                                  width == 33.333332f);
+    }
+}
+
 #endif
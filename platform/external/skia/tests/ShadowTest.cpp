@@ -5,8 +5,10 @@
  * found in the LICENSE file.
  */
 
+#include "SkBitmap.h"
 #include "SkCanvas.h"
 #include "SkDrawShadowInfo.h"
+#include "SkGraphics.h"
 #include "SkPath.h"
 #include "SkShadowTessellator.h"
 #include "SkShadowUtils.h"
@@ -115,3 +117,56 @@ DEF_TEST(ShadowBounds, reporter) {
     path.cubicTo(100, 50, 20, 100, 0, 0);
     check_bounds(reporter, path);
 }
+
+// Draws the shadow of 'path' rotated about the center of a raster surface.
+static void draw_rotated_shadow(SkCanvas* canvas, const SkPath& path, SkScalar degrees) {
+    SkDrawShadowRec rec;
+    rec.fZPlaneParams = SkPoint3::Make(0, 0, 8);
+    rec.fLightPos = SkPoint3::Make(128, 0, 600);
+    rec.fLightRadius = 400;
+    rec.fAmbientColor = 0x40000000;
+    rec.fSpotColor = 0x80000000;
+    rec.fFlags = SkShadowFlags::kTransparentOccluder_ShadowFlag;
+
+    canvas->clear(SK_ColorWHITE);
+    canvas->save();
+    canvas->rotate(degrees, 128, 128);
+    canvas->private_draw_shadow_rec(path, rec);
+    canvas->restore();
+}
+
+DEF_TEST(ShadowCachedRotation, reporter) {
+    // A convex polygon, which has no analytic shadow.
+    SkPath path;
+    path.moveTo(160, 128);
+    for (int i = 1; i < 7; ++i) {
+        SkScalar angle = 2 * SK_ScalarPI * i / 7;
+        path.lineTo(128 + 32 * SkScalarCos(angle), 128 + 32 * SkScalarSin(angle));
+    }
+    path.close();
+
+    SkBitmap cached, tessellated;
+    cached.allocN32Pixels(256, 256);
+    tessellated.allocN32Pixels(256, 256);
+    SkCanvas cachedCanvas(cached), tessellatedCanvas(tessellated);
+
+    // Caches the vertices and draws them rotated, then draws from a tessellation made for the
+    // rotation.
+    SkGraphics::PurgeResourceCache();
+    draw_rotated_shadow(&cachedCanvas, path, 0);
+    draw_rotated_shadow(&cachedCanvas, path, 30);
+    SkGraphics::PurgeResourceCache();
+    draw_rotated_shadow(&tessellatedCanvas, path, 30);
+
+    int maxDiff = 0;
+    for (int y = 0; y < 256; ++y) {
+        for (int x = 0; x < 256; ++x) {
+            SkPMColor a = *cached.getAddr32(x, y), b = *tessellated.getAddr32(x, y);
+            for (int shift = 0; shift < 32; shift += 8) {
+                maxDiff = SkTMax(maxDiff, SkTAbs((int)((a >> shift) & 0xFF) -
+                                                 (int)((b >> shift) & 0xFF)));
+            }
+        }
+    }
+    REPORTER_ASSERT(reporter, maxDiff <= 2);
+}
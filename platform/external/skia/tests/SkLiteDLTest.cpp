@@ -5,9 +5,13 @@
  * found in the LICENSE file.
  */
 
+#include "SkBitmap.h"
+#include "SkDrawable.h"
 #include "SkLiteDL.h"
 #include "SkLiteRecorder.h"
+#include "SkNoDrawCanvas.h"
 #include "SkRSXform.h"
+#include "SkTaskGroup.h"
 #include "Test.h"
 
 DEF_TEST(SkLiteDL_basics, r) {
@@ -88,3 +92,126 @@ DEF_TEST(SkLiteRecorder_RSXformAlignment, r) {
     // We're just checking that this recorded our draw without SkASSERTing in Debug builds.
     REPORTER_ASSERT(r, !dl.empty());
 }
+
+namespace {
+    struct CountingCanvas : public SkNoDrawCanvas {
+        CountingCanvas() : SkNoDrawCanvas(100, 100) {}
+        int rects = 0;
+        void onDrawRect(const SkRect&, const SkPaint&) override { rects++; }
+    };
+}
+
+static void record_grid(SkLiteDL* dl) {
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    for (int y = 0; y < 10; y++) {
+        for (int x = 0; x < 10; x++) {
+            paint.setColor(SkColorSetARGB(0xFF, x * 25, y * 25, 0x80));
+            dl->drawRect(SkRect::MakeXYWH(x * 10.0f, y * 10.0f, 8.5f, 8.5f), paint);
+        }
+    }
+    dl->save();
+        dl->translate(50, 50);
+        SkPath path;
+        path.addCircle(0, 0, 30);
+        paint.setColor(0x80FF0000);
+        dl->drawPath(path, paint);
+    dl->restore();
+}
+
+DEF_TEST(SkLiteDL_quickReject, r) {
+    SkLiteDL dl;
+    record_grid(&dl);
+
+    // Until it's frozen, every op reaches the canvas.
+    CountingCanvas canvas;
+    canvas.clipRect(SkRect::MakeXYWH(0, 0, 25, 15));
+    dl.draw(&canvas);
+    REPORTER_ASSERT(r, 100 == canvas.rects);
+
+    // Once it is, ops outside the clip never get there.
+    dl.makeThreadsafe();
+    canvas.rects = 0;
+    dl.draw(&canvas);
+    REPORTER_ASSERT(r, 6 == canvas.rects);
+
+    // Recording more thaws it.
+    dl.drawRect(SkRect::MakeXYWH(90, 90, 5, 5), SkPaint());
+    canvas.rects = 0;
+    dl.draw(&canvas);
+    REPORTER_ASSERT(r, 101 == canvas.rects);
+}
+
+DEF_TEST(SkLiteDL_makeThreadsafe, r) {
+    // A frozen display list draws just as it did before, from any number of threads at once.
+    SkLiteDL dl;
+    record_grid(&dl);
+
+    auto draw = [&](SkBitmap* bitmap, const SkRect& clip) {
+        bitmap->allocN32Pixels(100, 100);
+        bitmap->eraseColor(SK_ColorWHITE);
+        SkCanvas canvas(*bitmap);
+        canvas.clipRect(clip);
+        dl.draw(&canvas);
+    };
+    const SkRect clips[] = {
+        SkRect::MakeWH(100, 100), SkRect::MakeXYWH(13, 7, 40, 50), SkRect::MakeXYWH(60, 60, 9, 9),
+    };
+    const int kThreads = 8;
+
+    SkBitmap expected[SK_ARRAY_COUNT(clips)];
+    for (size_t i = 0; i < SK_ARRAY_COUNT(clips); i++) {
+        draw(&expected[i], clips[i]);
+    }
+
+    dl.makeThreadsafe();
+    SkBitmap actual[kThreads];
+    SkTaskGroup().batch(kThreads, [&](int i) {
+        draw(&actual[i], clips[i % SK_ARRAY_COUNT(clips)]);
+    });
+    for (int i = 0; i < kThreads; i++) {
+        const SkBitmap& want = expected[i % SK_ARRAY_COUNT(clips)];
+        REPORTER_ASSERT(r, 0 == memcmp(actual[i].getPixels(), want.getPixels(),
+                                       want.computeByteSize()));
+    }
+}
+
+namespace {
+    struct ColorDrawable : public SkDrawable {
+        SkColor color = SK_ColorRED;
+        SkRect onGetBounds() override { return SkRect::MakeWH(1, 1); }
+        void onDraw(SkCanvas* canvas) override { canvas->drawColor(color); }
+    };
+}
+
+DEF_TEST(SkLiteDL_makeThreadsafe_thaw, r) {
+    // A frozen display list draws the drawable as it was, and once thawed, as it is now.
+    sk_sp<ColorDrawable> drawable(new ColorDrawable);
+    SkLiteDL dl;
+    dl.drawDrawable(drawable.get(), nullptr);
+
+    auto draw = [&dl] {
+        SkBitmap bitmap;
+        bitmap.allocN32Pixels(1, 1);
+        SkCanvas canvas(bitmap);
+        dl.draw(&canvas);
+        return bitmap.getColor(0, 0);
+    };
+
+    dl.makeThreadsafe();
+    drawable->color = SK_ColorGREEN;
+    REPORTER_ASSERT(r, SK_ColorRED == draw());
+
+    // Recording anything else thaws it.
+    dl.translate(0, 0);
+    REPORTER_ASSERT(r, SK_ColorGREEN == draw());
+    drawable->color = SK_ColorBLUE;
+    REPORTER_ASSERT(r, SK_ColorBLUE == draw());
+
+    // So does reset(), and a re-recorded display list draws live until frozen again.
+    dl.makeThreadsafe();
+    dl.reset();
+    dl.drawDrawable(drawable.get(), nullptr);
+    drawable->color = SK_ColorRED;
+    REPORTER_ASSERT(r, SK_ColorRED == draw());
+}
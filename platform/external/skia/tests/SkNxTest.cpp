@@ -134,6 +134,7 @@ DEF_TEST(SkNi_min_lt, r) {
     for (int b = 0; b < (1<<8); b++) {
         Sk16b aw(a), bw(b);
         REPORTER_ASSERT(r, Sk16b::Min(aw, bw)[0] == SkTMin(a, b));
+        REPORTER_ASSERT(r, Sk16b::Max(aw, bw)[0] == SkTMax(a, b));
         REPORTER_ASSERT(r, !(aw < bw)[0] == !(a < b));
     }}
 
@@ -79,6 +79,15 @@ static void test_filestreams(skiatest::Reporter* reporter, const char* tmpDir) {
         std::unique_ptr<SkStreamAsset> stream2(stream.duplicate());
         test_loop_stream(reporter, stream2.get(), s, 26, 100);
     }
+
+    for (SkFILE_Access access : { kNormal_SkFILE_Access, kSequential_SkFILE_Access,
+                                  kRandom_SkFILE_Access }) {
+        std::unique_ptr<SkStreamAsset> stream = SkStreamMakeFromFile(path.c_str(), access);
+        REPORTER_ASSERT(reporter, stream);
+        if (stream) {
+            test_loop_stream(reporter, stream.get(), s, 26, 100);
+        }
+    }
 }
 
 static void TestWStream(skiatest::Reporter* reporter) {
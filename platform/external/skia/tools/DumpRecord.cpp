@@ -11,6 +11,7 @@
 #include "SkRecordDraw.h"
 
 #include "DumpRecord.h"
+#include "SkRecorder.h"
 #include "SkTime.h"
 
 namespace {
@@ -131,8 +132,65 @@ private:
     const bool fTimeWithCommand;
 };
 
+class Counter {
+public:
+    Counter(SkCanvas* canvas, DumpRecordOpStats stats[])
+        : fDraw(canvas, nullptr, nullptr, 0, nullptr)
+        , fRecorder(&fRecord, canvas->getBaseLayerSize().width(),
+                    canvas->getBaseLayerSize().height())
+        , fRecordDraw(&fRecorder, nullptr, nullptr, 0, nullptr)
+        , fStats(stats) {}
+
+    template <typename T>
+    void operator()(const T& command) {
+        auto start = SkTime::GetNSecs();
+        fDraw(command);
+        double ns = SkTime::GetNSecs() - start;
+
+        // Record the command again to see how many bytes it takes up.
+        size_t bytes = fRecord.bytesUsed();
+        fRecordDraw(command);
+
+        DumpRecordOpStats& stats = fStats[T::kType];
+        stats.fCount++;
+        stats.fNanos += ns;
+        stats.fBytes += fRecord.bytesUsed() - bytes;
+    }
+
+    void operator()(const SkRecords::NoOp&) {}
+
+private:
+    SkRecords::Draw    fDraw;
+    SkRecord           fRecord;
+    SkRecorder         fRecorder;
+    SkRecords::Draw    fRecordDraw;
+    DumpRecordOpStats* fStats;
+};
+
 }  // namespace
 
+int DumpRecordOpTypeCount() {
+    #define COUNT(U) +1
+    return 0 SK_RECORD_TYPES(COUNT);
+    #undef COUNT
+}
+
+const char* DumpRecordOpName(int type) {
+    #define CASE(U) case SkRecords::U##_Type: return #U;
+    switch (type) { SK_RECORD_TYPES(CASE); }
+    #undef CASE
+    return "Unknown";
+}
+
+void DumpRecordStats(const SkRecord& record,
+                     SkCanvas* canvas,
+                     DumpRecordOpStats stats[]) {
+    Counter counter(canvas, stats);
+    for (int i = 0; i < record.count(); i++) {
+        record.visit(i, counter);
+    }
+}
+
 void DumpRecord(const SkRecord& record,
                   SkCanvas* canvas,
                   bool timeWithCommand) {
@@ -7,6 +7,8 @@
 #ifndef DumpRecord_DEFINED
 #define DumpRecord_DEFINED
 
+#include <stddef.h>
+
 class SkRecord;
 class SkCanvas;
 
@@ -21,4 +23,27 @@ void DumpRecord(const SkRecord& record,
                 SkCanvas* canvas,
                 bool timeWithCommand);
 
+/** How many draw commands of one type there are, and what they cost. */
+struct DumpRecordOpStats {
+    int    fCount = 0;
+    double fNanos = 0;   // Time spent drawing them.
+    size_t fBytes = 0;   // Bytes they take up in a record.
+};
+
+/** The number of draw command types, which index the stats of DumpRecordStats(). */
+int DumpRecordOpTypeCount();
+
+/** The name of the draw command type with this index. */
+const char* DumpRecordOpName(int type);
+
+/**
+ * Draw the record to the supplied canvas via SkRecords::Draw, like DumpRecord(), but instead of
+ * printing each draw command, add its count, run time and size to its type's entry in 'stats',
+ * which has DumpRecordOpTypeCount() entries. A nested picture counts as one DrawPicture. Canvases
+ * only record a Save once something follows it, so its bytes are counted with that command.
+ */
+void DumpRecordStats(const SkRecord& record,
+                     SkCanvas* canvas,
+                     DumpRecordOpStats stats[]);
+
 #endif  // DumpRecord_DEFINED
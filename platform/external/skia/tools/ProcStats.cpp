@@ -68,3 +68,96 @@
 #else
     int sk_tools::getCurrResidentSetSizeMB() { return -1; }
 #endif
+
+#if defined(SK_BUILD_FOR_UNIX) || defined(SK_BUILD_FOR_ANDROID)
+    #include <sched.h>
+    bool sk_tools::pinCurrentThreadToCore(int core) {
+        if (core < 0 || core >= CPU_SETSIZE) {
+            return false;
+        }
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(core, &set);
+        // On Linux, pid 0 means the calling thread, not the whole process.
+        return 0 == sched_setaffinity(0, sizeof(set), &set);
+    }
+#elif defined(SK_BUILD_FOR_WIN)
+    bool sk_tools::pinCurrentThreadToCore(int core) {
+        if (core < 0 || core >= (int)(sizeof(DWORD_PTR) * 8)) {
+            return false;
+        }
+        return 0 != SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << core);
+    }
+#else
+    bool sk_tools::pinCurrentThreadToCore(int) { return false; }
+#endif
+
+#if defined(SK_BUILD_FOR_UNIX) || defined(SK_BUILD_FOR_ANDROID)
+    #include <linux/perf_event.h>
+    #include <string.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+
+    // Opens a user-space-only counter on the calling thread, on whichever core it runs.
+    // The first counter opened leads the group, so both are enabled and read together.
+    static int open_counter(uint64_t config, int groupFD) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size           = sizeof(attr);
+        attr.type           = PERF_TYPE_HARDWARE;
+        attr.config         = config;
+        attr.disabled       = groupFD < 0 ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+        return (int)syscall(__NR_perf_event_open, &attr, 0/*this thread*/, -1/*any cpu*/,
+                            groupFD, 0);
+    }
+
+    static uint64_t read_counter(int fd) {
+        uint64_t count = 0;
+        if (fd < 0 || read(fd, &count, sizeof(count)) != sizeof(count)) {
+            return 0;
+        }
+        return count;
+    }
+
+    sk_tools::HardwareCounters::HardwareCounters()
+        : fInstructionsFD(open_counter(PERF_COUNT_HW_INSTRUCTIONS, -1))
+        , fCacheMissesFD(-1)
+        , fInstructions(0)
+        , fCacheMisses(0) {
+        if (fInstructionsFD >= 0) {
+            fCacheMissesFD = open_counter(PERF_COUNT_HW_CACHE_MISSES, fInstructionsFD);
+        }
+    }
+
+    sk_tools::HardwareCounters::~HardwareCounters() {
+        if (fCacheMissesFD >= 0) {
+            close(fCacheMissesFD);
+        }
+        if (fInstructionsFD >= 0) {
+            close(fInstructionsFD);
+        }
+    }
+
+    void sk_tools::HardwareCounters::start() {
+        if (fInstructionsFD >= 0) {
+            ioctl(fInstructionsFD, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(fInstructionsFD, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+    }
+
+    void sk_tools::HardwareCounters::stop() {
+        if (fInstructionsFD >= 0) {
+            ioctl(fInstructionsFD, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+            fInstructions = read_counter(fInstructionsFD);
+            fCacheMisses  = read_counter(fCacheMissesFD);
+        }
+    }
+#else
+    sk_tools::HardwareCounters::HardwareCounters()
+        : fInstructionsFD(-1), fCacheMissesFD(-1), fInstructions(0), fCacheMisses(0) {}
+    sk_tools::HardwareCounters::~HardwareCounters() {}
+    void sk_tools::HardwareCounters::start() {}
+    void sk_tools::HardwareCounters::stop() {}
+#endif
@@ -8,6 +8,8 @@
 #ifndef ProcStats_DEFINED
 #define ProcStats_DEFINED
 
+#include <stdint.h>
+
 /**
  * ProcStats - Process Statistics Functions
  */
@@ -26,6 +28,40 @@ int getMaxResidentSetSizeMB();
  */
 int getCurrResidentSetSizeMB();
 
+/**
+ *  If implemented, pins the calling thread to the given CPU core and returns true.
+ *  If not, or if the core does not exist, returns false and leaves the affinity alone.
+ */
+bool pinCurrentThreadToCore(int core);
+
+/**
+ *  Counts hardware events (retired instructions and cache misses) for the calling thread
+ *  between start() and stop().  Where perf_event_open() is not available, or the kernel
+ *  refuses it, isValid() is false and both counts stay 0.
+ */
+class HardwareCounters {
+public:
+    HardwareCounters();
+    ~HardwareCounters();
+
+    bool isValid() const { return fInstructionsFD >= 0; }
+
+    void start();
+    void stop();
+
+    uint64_t instructions() const { return fInstructions; }
+    uint64_t cacheMisses() const { return fCacheMisses; }
+
+private:
+    int fInstructionsFD;
+    int fCacheMissesFD;
+    uint64_t fInstructions;
+    uint64_t fCacheMisses;
+
+    HardwareCounters(const HardwareCounters&) = delete;
+    HardwareCounters& operator=(const HardwareCounters&) = delete;
+};
+
 }  // namespace sk_tools
 
 #endif  // ProcStats_DEFINED
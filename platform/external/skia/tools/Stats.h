@@ -11,6 +11,8 @@
 #include "SkString.h"
 #include "SkTSort.h"
 
+#include <math.h>
+
 #ifdef SK_BUILD_FOR_WIN
     static const char* kBars[] = { ".", "o", "O" };
 #else
@@ -22,6 +24,8 @@ struct Stats {
         int n = samples.count();
         if (!n) {
             min = max = mean = var = median = 0;
+            q1 = q3 = medianLow = medianHigh = 0;
+            outliers = 0;
             return;
         }
 
@@ -49,6 +53,29 @@ struct Stats {
         SkTQSort(sorted.get(), sorted.get() + n - 1);
         median = sorted[n/2];
 
+        // Quartiles by the nearest-rank method; good enough for Tukey's fences below.
+        q1 = sorted[n/4];
+        q3 = sorted[(3*n)/4];
+
+        // A distribution-free 95% confidence interval for the median: the order statistics
+        // ranked (1-based) n/2 - 1.96*sqrt(n)/2 and 1 + n/2 + 1.96*sqrt(n)/2 bracket the true
+        // median with ~95% probability.  Unlike mean and stddev, this holds however skewed the
+        // timing distribution is.
+        const double halfWidth = 0.98 * sqrt((double)n);
+        const int lo = (int)round(    n/2.0 - halfWidth) - 1,
+                  hi = (int)round(1 + n/2.0 + halfWidth) - 1;
+        medianLow  = sorted[SkTPin(lo, 0, n-1)];
+        medianHigh = sorted[SkTPin(hi, 0, n-1)];
+
+        // Samples outside 1.5 IQR of the middle half are flagged as outliers.
+        const double iqr = q3 - q1;
+        lowFence  = q1 - 1.5 * iqr;
+        highFence = q3 + 1.5 * iqr;
+        outliers = 0;
+        for (int i = 0; i < n; i++) {
+            outliers += this->isOutlier(samples[i]) ? 1 : 0;
+        }
+
         // Normalize samples to [min, max] in as many quanta as we have distinct bars to print.
         for (int i = 0; i < n; i++) {
             if (min == max) {
@@ -67,12 +94,25 @@ struct Stats {
         }
     }
 
+    bool isOutlier(double sample) const {
+        return sample < lowFence || sample > highFence;
+    }
+
     double min;
     double max;
     double mean;    // Estimate of population mean.
     double var;     // Estimate of population variance.
     double median;
+    double q1;      // First and third quartiles.
+    double q3;
+    double medianLow;   // 95% confidence interval of the median.
+    double medianHigh;
+    int outliers;   // Number of samples outside Tukey's fences.
     SkString plot;  // A single-line bar chart (_not_ histogram) of the samples.
+
+private:
+    double lowFence  = 0;
+    double highFence = 0;
 };
 
 #endif//Stats_DEFINED
@@ -17,6 +17,7 @@
 #include "SkSurface.h"
 #include "SkTypeface.h"
 #include "SkWriteBuffer.h"
+#include "SkWriter32.h"
 
 #include <chrono>
 #include <ctype.h>
@@ -26,7 +27,9 @@
 #include <thread>
 #include <iostream>
 #include <unordered_map>
+#include <vector>
 
+#include <poll.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <unistd.h>
@@ -40,6 +43,8 @@ static const size_t kPageSize = 4096;
 static bool gUseGpu = true;
 static bool gPurgeFontCaches = true;
 static bool gUseProcess = true;
+static bool gBatchGlyphs = true;
+static int  gClientCount = 1;
 
 enum class OpCode : int32_t {
     kFontMetrics          = 0,
@@ -47,6 +52,7 @@ enum class OpCode : int32_t {
     kGlyphImage           = 2,
     kGlyphPath            = 3,
     kGlyphMetricsAndImage = 4,
+    kGlyphBatch           = 5,
 };
 
 class Op {
@@ -68,14 +74,75 @@ public:
             SkGlyphID glyphId;
             size_t pathSize;
         };
+        // op 5: the size of the request or reply that follows the op.
+        size_t batchSize;
     };
 };
 
+static bool read_fully(int fd, void* buffer, size_t size) {
+    uint8_t* bytes = (uint8_t*)buffer;
+    while (size > 0) {
+        ssize_t readSize = read(fd, bytes, size);
+        if (readSize <= 0) {
+            return false;
+        }
+        bytes += readSize;
+        size -= readSize;
+    }
+    return true;
+}
+
+static bool write_fully(int fd, const void* buffer, size_t size) {
+    const uint8_t* bytes = (const uint8_t*)buffer;
+    while (size > 0) {
+        ssize_t writeSize = write(fd, bytes, size);
+        if (writeSize <= 0) {
+            return false;
+        }
+        bytes += writeSize;
+        size -= writeSize;
+    }
+    return true;
+}
+
 class RemoteScalerContextFIFO : public SkRemoteScalerContext {
 public:
     explicit RemoteScalerContextFIFO(int readFd, int writeFd)
         : fReadFd{readFd}
         , fWriteFd{writeFd} { }
+
+    // Send the frame's glyph requests as one op and install the reply in the glyph cache.
+    // Returns the number of reply bytes.
+    size_t fetchGlyphs(SkRemoteGlyphCacheGPU* rc) {
+        SkWriter32 requests;
+        if (!rc->writeGlyphRequests(&requests)) {
+            return 0;
+        }
+        SkScalerContextRec rec;
+        sk_bzero(&rec, sizeof(rec));
+        Op* op = new (fBuffer) Op(OpCode::kGlyphBatch, 0, rec);
+        op->batchSize = requests.bytesWritten();
+        auto requestData = requests.snapshotAsData();
+        if (!write_fully(fWriteFd, fBuffer, sizeof(*op)) ||
+            !write_fully(fWriteFd, requestData->data(), requestData->size()) ||
+            !read_fully(fReadFd, fBuffer, sizeof(*op))) {
+            err(1, "glyph batch transfer failed");
+        }
+        size_t replySize = op->batchSize;
+        op->~Op();
+
+        std::unique_ptr<uint8_t[]> reply{new uint8_t[replySize]};
+        if (!read_fully(fReadFd, reply.get(), replySize)) {
+            err(1, "glyph batch reply failed");
+        }
+        if (!rc->readGlyphs(reply.get(), replySize)) {
+            SK_ABORT("Bad glyph batch reply");
+        }
+        return replySize;
+    }
+
+    int syncOpCount() const { return fSyncOpCount; }
+
     void generateFontMetrics(const SkTypefaceProxy& tf,
                              const SkScalerContextRec& rec,
                              SkPaint::FontMetrics* metrics) override {
@@ -138,19 +205,23 @@ private:
     Op* createOp(OpCode opCode, const SkTypefaceProxy& tf,
                  const SkScalerContextRec& rec) {
         Op* op = new (fBuffer) Op(opCode, tf.fontID(), rec);
+        fSyncOpCount++;
 
         return op;
     }
 
     const int fReadFd,
               fWriteFd;
+    int       fSyncOpCount{0};
     uint8_t   fBuffer[1024 * kPageSize];
 };
 
 static void final_draw(std::string outFilename,
                        SkDeserialProcs* procs,
                        uint8_t* picData,
-                       size_t picSize) {
+                       size_t picSize,
+                       SkRemoteGlyphCacheGPU* rc = nullptr,
+                       RemoteScalerContextFIFO* fifo = nullptr) {
 
     auto pic = SkPicture::MakeFromData(picData, picSize, procs);
 
@@ -161,13 +232,29 @@ static void final_draw(std::string outFilename,
     auto c = s->getCanvas();
     auto picUnderTest = SkPicture::MakeFromData(picData, picSize, procs);
 
+    SkSurfaceProps props{0, kUnknown_SkPixelGeometry};
+    c->getProps(&props);
 
+    static constexpr int kFrames = 20;
     std::chrono::duration<double> total_seconds{0.0};
-    for (int i = 0; i < 20; i++) {
+    std::chrono::duration<double> batch_seconds{0.0};
+    int batchedGlyphs = 0;
+    size_t batchBytes = 0;
+    for (int i = 0; i < kFrames; i++) {
         if (gPurgeFontCaches) {
             SkGraphics::PurgeFontCache();
+            if (rc != nullptr) {
+                rc->resetRequestedGlyphs();
+            }
         }
         auto start = std::chrono::high_resolution_clock::now();
+        if (rc != nullptr && gBatchGlyphs) {
+            rc->requestGlyphsForPicture(picUnderTest.get(), props,
+                                        SkScalerContextFlags::kFakeGammaAndBoostContrast);
+            batchedGlyphs += rc->pendingGlyphCount();
+            batchBytes += fifo->fetchGlyphs(rc);
+            batch_seconds += std::chrono::high_resolution_clock::now() - start;
+        }
         c->drawPicture(picUnderTest);
         auto end = std::chrono::high_resolution_clock::now();
         std::chrono::duration<double> elapsed_seconds = end-start;
@@ -177,8 +264,20 @@ static void final_draw(std::string outFilename,
 
     std::cout << "useProcess: " << gUseProcess
               << " useGPU: " << gUseGpu
-              << " purgeCache: " << gPurgeFontCaches << std::endl;
+              << " purgeCache: " << gPurgeFontCaches
+              << " batchGlyphs: " << gBatchGlyphs
+              << " clients: " << gClientCount << std::endl;
     std::cerr << "elapsed time: " << total_seconds.count() << "s\n";
+    if (fifo != nullptr) {
+        std::cerr << "sync glyph ops: " << fifo->syncOpCount() << "\n";
+    }
+    if (batchedGlyphs > 0) {
+        std::cerr << "batched glyphs: " << batchedGlyphs
+                  << " reply bytes: " << batchBytes
+                  << " batch latency: " << 1000 * batch_seconds.count() / kFrames << "ms/frame"
+                  << " throughput: " << batchedGlyphs / batch_seconds.count() << " glyphs/s"
+                  << " " << batchBytes / (1024 * 1024 * batch_seconds.count()) << " MB/s\n";
+    }
 
     auto i = s->makeImageSnapshot();
     auto data = i->encodeToData();
@@ -186,7 +285,7 @@ static void final_draw(std::string outFilename,
     f.write(data->data(), data->size());
 }
 
-static void gpu(int readFd, int writeFd) {
+static void gpu(int readFd, int writeFd, int client) {
 
     size_t picSize = 0;
     ssize_t r = read(readFd, &picSize, sizeof(picSize));
@@ -205,14 +304,16 @@ static void gpu(int readFd, int writeFd) {
             readSoFar += readSize;
         }
 
-        SkRemoteGlyphCacheGPU rc{
-            skstd::make_unique<RemoteScalerContextFIFO>(readFd, writeFd)
-        };
+        auto fifo = new RemoteScalerContextFIFO(readFd, writeFd);
+        SkRemoteGlyphCacheGPU rc{std::unique_ptr<SkRemoteScalerContext>(fifo)};
 
         SkDeserialProcs procs;
         rc.prepareDeserializeProcs(&procs);
 
-        final_draw("test.png", &procs, picBuffer.get(), picSize);
+        std::string outFilename = gClientCount > 1
+                                ? "test-" + std::to_string(client) + ".png"
+                                : std::string{"test.png"};
+        final_draw(outFilename, &procs, picBuffer.get(), picSize, &rc, fifo);
 
     }
 
@@ -220,8 +321,76 @@ static void gpu(int readFd, int writeFd) {
     close(readFd);
 }
 
+// Answer one op from a render process. Returns false when the render process has gone away.
+static bool serve_op(SkRemoteGlyphCacheRenderer* rc, int readFd, int writeFd,
+                     uint8_t* glyphBuffer) {
+    Op* op = (Op*)glyphBuffer;
+    if (!read_fully(readFd, glyphBuffer, sizeof(*op))) {
+        return false;
+    }
+    size_t writeSize = sizeof(*op);
+
+    if (op->opCode == OpCode::kGlyphBatch) {
+        std::unique_ptr<uint8_t[]> requests{new uint8_t[op->batchSize]};
+        if (!read_fully(readFd, requests.get(), op->batchSize)) {
+            return false;
+        }
+        SkWriter32 reply;
+        if (!rc->serveGlyphRequests(requests.get(), op->batchSize, &reply)) {
+            SK_ABORT("Bad glyph batch");
+        }
+        op->batchSize = reply.bytesWritten();
+        auto replyData = reply.snapshotAsData();
+        return write_fully(writeFd, glyphBuffer, writeSize) &&
+               write_fully(writeFd, replyData->data(), replyData->size());
+    }
+
+    auto sc = rc->generateScalerContext(op->descriptor, op->typefaceId);
+    switch (op->opCode) {
+        case OpCode::kFontMetrics : {
+            sc->getFontMetrics(&op->fontMetrics);
+            break;
+        }
+        case OpCode::kGlyphMetrics : {
+            sc->getMetrics(&op->glyph);
+            break;
+        }
+        case OpCode::kGlyphImage : {
+            // TODO: check for buffer overflow.
+            op->glyph.fImage = &glyphBuffer[sizeof(Op)];
+            sc->getImage(op->glyph);
+            writeSize += op->glyph.rowBytes() * op->glyph.fHeight;
+            break;
+        }
+        case OpCode::kGlyphPath : {
+            // TODO: check for buffer overflow.
+            SkPath path;
+            sc->getPath(op->glyphId, &path);
+            op->pathSize = path.writeToMemory(&glyphBuffer[sizeof(Op)]);
+            writeSize += op->pathSize;
+            break;
+        }
+        case OpCode::kGlyphMetricsAndImage : {
+            // TODO: check for buffer overflow.
+            sc->getMetrics(&op->glyph);
+            if (op->glyph.fWidth <= 0 || op->glyph.fWidth >= kMaxGlyphWidth) {
+                op->glyph.fImage = nullptr;
+                break;
+            }
+            op->glyph.fImage = &glyphBuffer[sizeof(Op)];
+            sc->getImage(op->glyph);
+            writeSize += op->glyph.rowBytes() * op->glyph.fHeight;
+            break;
+        }
+        default:
+            SK_ABORT("Bad op");
+    }
+
+    return write_fully(writeFd, glyphBuffer, writeSize);
+}
+
 static int renderer(
-    const std::string& skpName, int readFd, int writeFd)
+    const std::string& skpName, const std::vector<int>& readFds, const std::vector<int>& writeFds)
 {
     std::string prefix{"skps/"};
     std::string fileName{prefix + skpName + ".skp"};
@@ -247,83 +416,54 @@ static int renderer(
 
     if (!gUseGpu) {
         final_draw("test-direct.png", nullptr, picBuffer, picSize);
-        close(writeFd);
-        close(readFd);
+        for (size_t i = 0; i < readFds.size(); i++) {
+            close(writeFds[i]);
+            close(readFds[i]);
+        }
         return 0;
     }
 
-    write(writeFd, &picSize, sizeof(picSize));
-
-    size_t writeSoFar = 0;
-    while (writeSoFar < picSize) {
-        ssize_t writeSize = write(writeFd, &picBuffer[writeSoFar], picSize - writeSoFar);
-        if (writeSize <= 0) {
-            if (writeSize == 0) {
-                std::cout << "Exit" << std::endl;
-                return 1;
-            }
+    for (int writeFd : writeFds) {
+        if (!write_fully(writeFd, &picSize, sizeof(picSize)) ||
+            !write_fully(writeFd, picBuffer, picSize)) {
             perror("Can't write picture from render to GPU ");
             return 1;
         }
-        writeSoFar += writeSize;
     }
     std::cout << "Waiting for scaler context ops." << std::endl;
 
     static constexpr size_t kBufferSize = 1024 * kPageSize;
     std::unique_ptr<uint8_t[]> glyphBuffer{new uint8_t[kBufferSize]};
 
-    Op* op = (Op*)glyphBuffer.get();
-    while (true) {
-        ssize_t size = read(readFd, glyphBuffer.get(), sizeof(*op));
-        if (size <= 0) { std::cout << "Exit op loop" << std::endl; break;}
-        size_t writeSize = sizeof(*op);
-
-            auto sc = rc.generateScalerContext(op->descriptor, op->typefaceId);
-            switch (op->opCode) {
-                case OpCode::kFontMetrics : {
-                    sc->getFontMetrics(&op->fontMetrics);
-                    break;
-                }
-                case OpCode::kGlyphMetrics : {
-                    sc->getMetrics(&op->glyph);
-                    break;
-                }
-                case OpCode::kGlyphImage : {
-                    // TODO: check for buffer overflow.
-                    op->glyph.fImage = &glyphBuffer[sizeof(Op)];
-                    sc->getImage(op->glyph);
-                    writeSize += op->glyph.rowBytes() * op->glyph.fHeight;
-                    break;
-                }
-                case OpCode::kGlyphPath : {
-                    // TODO: check for buffer overflow.
-                    SkPath path;
-                    sc->getPath(op->glyphId, &path);
-                    op->pathSize = path.writeToMemory(&glyphBuffer[sizeof(Op)]);
-                    writeSize += op->pathSize;
-                    break;
-                }
-                case OpCode::kGlyphMetricsAndImage : {
-                    // TODO: check for buffer overflow.
-                    sc->getMetrics(&op->glyph);
-                    if (op->glyph.fWidth <= 0 || op->glyph.fWidth >= kMaxGlyphWidth) {
-                        op->glyph.fImage = nullptr;
-                        break;
-                    }
-                    op->glyph.fImage = &glyphBuffer[sizeof(Op)];
-                    sc->getImage(op->glyph);
-                    writeSize += op->glyph.rowBytes() * op->glyph.fHeight;
-                    break;
-                }
-                default:
-                    SK_ABORT("Bad op");
+    // One glyph process serves every render process.
+    std::vector<pollfd> fds;
+    for (int readFd : readFds) {
+        fds.push_back({readFd, POLLIN, 0});
+    }
+    size_t open = fds.size();
+    int ops = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    while (open > 0) {
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            err(1, "poll failed");
+        }
+        for (size_t i = 0; i < fds.size(); i++) {
+            if (fds[i].fd < 0 || fds[i].revents == 0) {
+                continue;
             }
-
-        write(writeFd, glyphBuffer.get(), writeSize);
+            if (serve_op(&rc, readFds[i], writeFds[i], glyphBuffer.get())) {
+                ops++;
+            } else {
+                close(readFds[i]);
+                close(writeFds[i]);
+                fds[i].fd = -1;
+                open--;
+            }
+        }
     }
-
-    close(readFd);
-    close(writeFd);
+    std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+    std::cout << "Exit op loop: served " << ops << " ops for " << fds.size()
+              << " render processes in " << elapsed.count() << "s" << std::endl;
 
     std::cout << "Returning from render" << std::endl;
 
@@ -332,65 +472,80 @@ static int renderer(
 
 enum direction : int {kRead = 0, kWrite = 1};
 
-static void start_gpu(int render_to_gpu[2], int gpu_to_render[2]) {
-    std::cout << "gpu - Starting GPU" << std::endl;
-    close(gpu_to_render[kRead]);
-    close(render_to_gpu[kWrite]);
-    gpu(render_to_gpu[kRead], gpu_to_render[kWrite]);
-}
-
-static void start_render(std::string& skpName, int render_to_gpu[2], int gpu_to_render[2]) {
-    std::cout << "renderer - Starting Renderer" << std::endl;
-    close(render_to_gpu[kRead]);
-    close(gpu_to_render[kWrite]);
-    renderer(skpName, gpu_to_render[kRead], render_to_gpu[kWrite]);
-}
-
 int main(int argc, char** argv) {
     std::string skpName = argc > 1 ? std::string{argv[1]} : std::string{"desk_nytimes"};
     int mode = argc > 2 ? atoi(argv[2]) : -1;
+    gClientCount = argc > 3 ? std::max(1, atoi(argv[3])) : 1;
     printf("skp: %s\n", skpName.c_str());
 
-    int render_to_gpu[2],
-        gpu_to_render[2];
-
-    for (int m = 0; m < 8; m++) {
-        int r = pipe(render_to_gpu);
-        if (r < 0) {
-            perror("Can't write picture from render to GPU ");
-            return 1;
-        }
-        r = pipe(gpu_to_render);
-        if (r < 0) {
-            perror("Can't write picture from render to GPU ");
-            return 1;
-        }
-
+    for (int m = 0; m < 16; m++) {
+        gBatchGlyphs = (m & 8) == 8;
         gPurgeFontCaches = (m & 4) == 4;
         gUseGpu = (m & 2) == 2;
         gUseProcess = (m & 1) == 1;
 
-        if (mode >= 0 && mode < 8 && mode != m) {
+        if (mode >= 0 && mode < 16 && mode != m) {
+            continue;
+        }
+        if (gBatchGlyphs && !gUseGpu) {
             continue;
         }
 
-        if (gUseProcess) {
-            pid_t child = fork();
-            SkGraphics::Init();
+        // Each render process (called gpu here) talks to the glyph process over its own pipes.
+        std::vector<int> rendererReadFds, rendererWriteFds, gpuReadFds, gpuWriteFds;
+        for (int i = 0; i < gClientCount; i++) {
+            int render_to_gpu[2],
+                gpu_to_render[2];
+            if (pipe(render_to_gpu) < 0 || pipe(gpu_to_render) < 0) {
+                perror("Can't write picture from render to GPU ");
+                return 1;
+            }
+            rendererReadFds.push_back(gpu_to_render[kRead]);
+            rendererWriteFds.push_back(render_to_gpu[kWrite]);
+            gpuReadFds.push_back(render_to_gpu[kRead]);
+            gpuWriteFds.push_back(gpu_to_render[kWrite]);
+        }
 
-            if (child == 0) {
-                start_gpu(render_to_gpu, gpu_to_render);
-            } else {
-                start_render(skpName, render_to_gpu, gpu_to_render);
+        SkGraphics::Init();
+        if (gUseProcess) {
+            std::vector<pid_t> children;
+            for (int i = 0; i < gClientCount; i++) {
+                pid_t child = fork();
+                if (child == 0) {
+                    std::cout << "gpu - Starting GPU " << i << std::endl;
+                    for (int j = 0; j < gClientCount; j++) {
+                        close(rendererReadFds[j]);
+                        close(rendererWriteFds[j]);
+                        if (j != i) {
+                            close(gpuReadFds[j]);
+                            close(gpuWriteFds[j]);
+                        }
+                    }
+                    gpu(gpuReadFds[i], gpuWriteFds[i], i);
+                    return 0;
+                }
+                children.push_back(child);
+            }
+            std::cout << "renderer - Starting Renderer" << std::endl;
+            for (int i = 0; i < gClientCount; i++) {
+                close(gpuReadFds[i]);
+                close(gpuWriteFds[i]);
+            }
+            renderer(skpName, rendererReadFds, rendererWriteFds);
+            for (pid_t child : children) {
                 waitpid(child, nullptr, 0);
             }
         } else {
-            SkGraphics::Init();
-            std::thread(gpu, render_to_gpu[kRead], gpu_to_render[kWrite]).detach();
-            renderer(skpName, gpu_to_render[kRead], render_to_gpu[kWrite]);
+            std::vector<std::thread> clients;
+            for (int i = 0; i < gClientCount; i++) {
+                clients.emplace_back(gpu, gpuReadFds[i], gpuWriteFds[i], i);
+            }
+            renderer(skpName, rendererReadFds, rendererWriteFds);
+            for (auto& client : clients) {
+                client.join();
+            }
         }
     }
 
     return 0;
 }
-
@@ -0,0 +1,235 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "DumpRecord.h"
+#include "SkBitmap.h"
+#include "SkCanvas.h"
+#include "SkCommandLineFlags.h"
+#include "SkJSONWriter.h"
+#include "SkMultiPictureDocument.h"
+#include "SkOSFile.h"
+#include "SkOSPath.h"
+#include "SkPicture.h"
+#include "SkRecord.h"
+#include "SkRecorder.h"
+#include "SkStream.h"
+#include "SkTaskGroup.h"
+#include "SkTime.h"
+
+#include <stdio.h>
+#include <vector>
+
+DEFINE_string2(skps, r, "", ".skp and .mskp files, or directories of them, to process.");
+DEFINE_string(match, "", "The usual filters on file names to process.");
+DEFINE_int32(threads, -1, "Threads to process files on: -1 for one per core, 0 for none.");
+DEFINE_bool(draw, true, "Draw each picture, to count, time and size each type of draw command.");
+DEFINE_int32(maxSize, 2048, "Largest width and height to draw the pictures at.");
+DEFINE_string2(json, j, "", "Write the stats to this JSON file, rather than to stdout.");
+
+// Loads (and so validates) every picture in a corpus of .skps and multi-page .mskps, on as many
+// threads as it has, and reports how fast that went, along with how many of each type of draw
+// command the pictures have, how long they took to draw and how many bytes they take up.
+//
+// The stats are written as JSON:
+//   {
+//     "files": 3, "pictures": 4, "failures": [ "bad.skp" ],
+//     "bytes": 123456, "wall_seconds": 0.1, "load_seconds": 0.2, "bytes_per_second": 617280,
+//     "ops": 1000, "draw_seconds": 0.01, "ops_per_second": 100000, "op_bytes": 40000,
+//     "op_types": {
+//       "DrawRect": { "count": 900, "seconds": 0.005, "ops_per_second": 180000, "bytes": 36000 },
+//       ...
+//     }
+//   }
+//
+// The times are added up over every thread, so the rates are per thread.
+
+namespace {
+
+struct FileStats {
+    SkString                       fPath;
+    bool                           fLoaded = false;
+    size_t                         fBytes = 0;
+    double                         fLoadNanos = 0;
+    int                            fPictures = 0;
+    std::vector<DumpRecordOpStats> fOps;
+};
+
+}  // namespace
+
+static void draw_stats(const SkPicture& picture, FileStats* stats) {
+    const int w = SkScalarCeilToInt(picture.cullRect().width());
+    const int h = SkScalarCeilToInt(picture.cullRect().height());
+
+    SkRecord record;
+    SkRecorder recorder(&record, w, h);
+    picture.playback(&recorder);
+
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(SkTPin(w, 1, FLAGS_maxSize), SkTPin(h, 1, FLAGS_maxSize));
+    SkCanvas canvas(bitmap);
+    DumpRecordStats(record, &canvas, stats->fOps.data());
+}
+
+static void process_file(FileStats* stats) {
+    stats->fOps.resize(DumpRecordOpTypeCount());
+
+    auto start = SkTime::GetNSecs();
+    sk_sp<SkData> data = SkData::MakeFromFileName(stats->fPath.c_str());
+    if (!data) {
+        return;
+    }
+    stats->fBytes = data->size();
+
+    SkMemoryStream stream(data);
+    std::vector<sk_sp<SkPicture>> pictures;
+    if (int pageCount = SkMultiPictureDocumentReadPageCount(&stream)) {
+        std::vector<SkDocumentPage> pages(pageCount);
+        // Without procs, the pages can be decoded in parallel.
+        if (!SkMultiPictureDocumentRead(&stream, pages.data(), pageCount, nullptr, true)) {
+            return;
+        }
+        for (const SkDocumentPage& page : pages) {
+            pictures.push_back(page.fPicture);
+        }
+    } else {
+        sk_sp<SkPicture> picture = SkPicture::MakeFromData(data.get());
+        if (!picture) {
+            return;
+        }
+        pictures.push_back(std::move(picture));
+    }
+    stats->fLoadNanos = SkTime::GetNSecs() - start;
+    stats->fLoaded = true;
+    stats->fPictures = SkToInt(pictures.size());
+
+    if (FLAGS_draw) {
+        for (const sk_sp<SkPicture>& picture : pictures) {
+            draw_stats(*picture, stats);
+        }
+    }
+}
+
+static void add_files(const char* path, std::vector<FileStats>* files) {
+    auto add = [files](const SkString& file) {
+        if (!SkCommandLineFlags::ShouldSkip(FLAGS_match, file.c_str())) {
+            files->emplace_back();
+            files->back().fPath = file;
+        }
+    };
+    if (sk_isdir(path)) {
+        for (const char* suffix : { ".skp", ".mskp" }) {
+            SkOSFile::Iter iter(path, suffix);
+            for (SkString file; iter.next(&file); ) {
+                add(SkOSPath::Join(path, file.c_str()));
+            }
+        }
+    } else {
+        add(SkString(path));
+    }
+}
+
+static void write_json(const std::vector<FileStats>& files, double wallNanos, SkWStream* dst) {
+    std::vector<DumpRecordOpStats> ops(DumpRecordOpTypeCount());
+    int pictures = 0;
+    size_t bytes = 0;
+    double loadNanos = 0;
+    for (const FileStats& file : files) {
+        pictures += file.fPictures;
+        bytes += file.fBytes;
+        loadNanos += file.fLoadNanos;
+        for (size_t i = 0; i < ops.size(); ++i) {
+            ops[i].fCount += file.fOps[i].fCount;
+            ops[i].fNanos += file.fOps[i].fNanos;
+            ops[i].fBytes += file.fOps[i].fBytes;
+        }
+    }
+    DumpRecordOpStats total;
+    for (const DumpRecordOpStats& op : ops) {
+        total.fCount += op.fCount;
+        total.fNanos += op.fNanos;
+        total.fBytes += op.fBytes;
+    }
+    auto perSecond = [](double amount, double nanos) {
+        return nanos > 0 ? amount * 1e9 / nanos : 0;
+    };
+
+    SkJSONWriter writer(dst, SkJSONWriter::Mode::kPretty);
+    writer.beginObject();
+    writer.appendS32("files", SkToS32(files.size()));
+    writer.appendS32("pictures", pictures);
+    writer.beginArray("failures");
+    for (const FileStats& file : files) {
+        if (!file.fLoaded) {
+            writer.appendString(file.fPath.c_str());
+        }
+    }
+    writer.endArray();
+    writer.appendU64("bytes", bytes);
+    writer.appendDouble("wall_seconds", wallNanos * 1e-9);
+    writer.appendDouble("load_seconds", loadNanos * 1e-9);
+    writer.appendDouble("bytes_per_second", perSecond(bytes, loadNanos));
+    if (FLAGS_draw) {
+        writer.appendS32("ops", total.fCount);
+        writer.appendDouble("draw_seconds", total.fNanos * 1e-9);
+        writer.appendDouble("ops_per_second", perSecond(total.fCount, total.fNanos));
+        writer.appendU64("op_bytes", total.fBytes);
+        writer.beginObject("op_types");
+        for (size_t i = 0; i < ops.size(); ++i) {
+            if (0 == ops[i].fCount) {
+                continue;
+            }
+            writer.beginObject(DumpRecordOpName(SkToInt(i)), false);
+            writer.appendS32("count", ops[i].fCount);
+            writer.appendDouble("seconds", ops[i].fNanos * 1e-9);
+            writer.appendDouble("ops_per_second", perSecond(ops[i].fCount, ops[i].fNanos));
+            writer.appendU64("bytes", ops[i].fBytes);
+            writer.endObject();
+        }
+        writer.endObject();
+    }
+    writer.endObject();
+    writer.flush();
+}
+
+int main(int argc, char** argv) {
+    SkCommandLineFlags::SetUsage("Loads, checks and reports stats on a corpus of skps.\n");
+    SkCommandLineFlags::Parse(argc, argv);
+
+    std::vector<FileStats> files;
+    for (int i = 0; i < FLAGS_skps.count(); i++) {
+        add_files(FLAGS_skps[i], &files);
+    }
+    if (files.empty()) {
+        SkDebugf("No skps to process.\n");
+        return 1;
+    }
+
+    SkTaskGroup::Enabler enabled(FLAGS_threads);
+    auto start = SkTime::GetNSecs();
+    SkTaskGroup().batch(SkToInt(files.size()), [&](int i) { process_file(&files[i]); });
+    double wallNanos = SkTime::GetNSecs() - start;
+
+    SkDynamicMemoryWStream json;
+    write_json(files, wallNanos, &json);
+    sk_sp<SkData> data = json.detachAsData();
+    if (FLAGS_json.count() > 0) {
+        SkFILEWStream out(FLAGS_json[0]);
+        if (!out.isValid() || !out.write(data->data(), data->size())) {
+            SkDebugf("Could not write %s.\n", FLAGS_json[0]);
+            return 1;
+        }
+    } else {
+        fwrite(data->data(), 1, data->size(), stdout);
+        fputs("\n", stdout);
+    }
+
+    bool anyFailed = false;
+    for (const FileStats& file : files) {
+        anyFailed = anyFailed || !file.fLoaded;
+    }
+    return anyFailed ? 2 : 0;
+}